@@ -0,0 +1,108 @@
+#include "../src/NumCpp.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// NdArray::dot 性能测试：对比分块 GEMM 内核与原先 i-j-k 三重循环的 GFLOP/s
+// 用法：dot_benchmark [n1 n2 ...]，默认测试 256 512 1024 阶方阵
+
+namespace
+{
+    // 原先 NdArray::dot 的实现，作为对照
+    template<typename dtypeOut, typename dtype>
+    nc::NdArray<dtypeOut> naiveDot(const nc::NdArray<dtype>& inArray1, const nc::NdArray<dtype>& inArray2)
+    {
+        nc::NdArray<dtypeOut> returnArray(inArray1.shape().rows, inArray2.shape().cols);
+        for (nc::uint32 i = 0; i < inArray1.shape().rows; ++i)
+        {
+            for (nc::uint32 j = 0; j < inArray2.shape().cols; ++j)
+            {
+                returnArray(i, j) = 0;
+                for (nc::uint32 k = 0; k < inArray2.shape().rows; ++k)
+                {
+                    returnArray(i, j) += static_cast<dtypeOut>(inArray1(i, k)) * static_cast<dtypeOut>(inArray2(k, j));
+                }
+            }
+        }
+        return returnArray;
+    }
+
+    template<typename dtype>
+    nc::NdArray<dtype> randomArray(nc::uint32 inSize, std::mt19937& inGenerator)
+    {
+        std::uniform_int_distribution<int> dist(-8, 8);
+        nc::NdArray<dtype> returnArray(inSize, inSize);
+        for (auto& value : returnArray)
+        {
+            value = static_cast<dtype>(dist(inGenerator));
+        }
+        return returnArray;
+    }
+
+    template<typename Function>
+    double bestSeconds(Function inFunction)
+    {
+        double best = 1e300;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+        int runs = 0;
+        do
+        {
+            const auto start = std::chrono::steady_clock::now();
+            inFunction();
+            const auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double>(stop - start).count());
+            ++runs;
+        } while (runs < 3 && std::chrono::steady_clock::now() < deadline);
+        return best;
+    }
+
+    template<typename dtype>
+    void run(const char* inName, nc::uint32 inSize)
+    {
+        std::mt19937 generator(inSize);
+        const auto a = randomArray<dtype>(inSize, generator);
+        const auto b = randomArray<dtype>(inSize, generator);
+
+        nc::NdArray<dtype> blocked;
+        nc::NdArray<dtype> naive;
+        const double blockedSeconds = bestSeconds([&]() { blocked = a.template dot<dtype>(b); });
+        const double naiveSeconds = bestSeconds([&]() { naive = naiveDot<dtype>(a, b); });
+
+        bool match = true;
+        for (nc::uint32 i = 0; i < blocked.size(); ++i)
+        {
+            match = match && blocked[i] == naive[i];
+        }
+
+        const double flops = 2.0 * inSize * inSize * inSize;
+        std::printf("%-7s n=%-5u naive %8.2f GFLOP/s   blocked %8.2f GFLOP/s   speedup %6.1fx   %s\n",
+            inName, inSize, flops / naiveSeconds * 1e-9, flops / blockedSeconds * 1e-9,
+            naiveSeconds / blockedSeconds, match ? "ok" : "MISMATCH");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<nc::uint32> sizes;
+    for (int i = 1; i < argc; ++i)
+    {
+        sizes.push_back(static_cast<nc::uint32>(std::strtoul(argv[i], nullptr, 10)));
+    }
+    if (sizes.empty())
+    {
+        sizes = { 256, 512, 1024 };
+    }
+
+    for (auto size : sizes)
+    {
+        run<float>("float", size);
+        run<double>("double", size);
+        run<nc::int32>("int32", size);
+    }
+
+    return 0;
+}
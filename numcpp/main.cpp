@@ -44,8 +44,8 @@ int main() {
     nc::NdArray<int> b1 = {{1, 2}, {3, 4}};
     cout << nc::linalg::det(b1) << endl;
 
-    // 矩阵转置
-    const nc::NdArray<int> b3 = {{1, 1, 1}, {2, 2, 2}, {3, 3, 3}};
+    // 求逆矩阵（奇异矩阵会抛出异常）
+    const nc::NdArray<int> b3 = {{1, 1, 1}, {0, 2, 2}, {3, 0, 3}};
     cout << nc::linalg::inv(b3) << endl;
 
     return 0;
@@ -4,14 +4,31 @@
 #define _CRT_SECURE_NO_WARNINGS
 #endif
 
+#include"NumCpp/Allocator.hpp"
+#include"NumCpp/AsyncIo.hpp"
+#include"NumCpp/Codec.hpp"
+#include"NumCpp/CompressedArray.hpp"
 #include"NumCpp/Constants.hpp"
+#include"NumCpp/Decomposition.hpp"
 #include"NumCpp/DtypeInfo.hpp"
+#include"NumCpp/Expression.hpp"
+#include"NumCpp/Factorization.hpp"
+#include"NumCpp/Gemm.hpp"
+#include"NumCpp/Io.hpp"
 #include"NumCpp/Linalg.hpp"
+#include"NumCpp/MappedFile.hpp"
 #include"NumCpp/Methods.hpp"
 #include"NumCpp/NdArray.hpp"
+#include"NumCpp/NdArrayView.hpp"
 #include"NumCpp/Polynomial.hpp"
+#include"NumCpp/Reduce.hpp"
 #include"NumCpp/Shape.hpp"
+#include"NumCpp/Simd.hpp"
 #include"NumCpp/Slice.hpp"
+#include"NumCpp/Spectral.hpp"
+#include"NumCpp/StreamedArray.hpp"
+#include"NumCpp/Text.hpp"
+#include"NumCpp/ThreadPool.hpp"
 #include"NumCpp/Types.hpp"
 #include"NumCpp/Utils.hpp"
 
@@ -0,0 +1,434 @@
+#pragma once
+
+#include"NumCpp/Types.hpp"
+
+#include<algorithm>
+#include<cstddef>
+#include<cstdint>
+#include<cstdlib>
+#include<cstring>
+#include<mutex>
+#include<new>
+#include<vector>
+
+// NdArray 缓冲区的内存分配器。NdArray 构造时记录当前线程的分配器（默认为 malloc/free），
+// 析构时归还给同一个分配器。用 AllocatorScope 在一段代码内切换分配器，
+// 该范围内创建的所有 NdArray（包括库内部的临时数组）都从该分配器分配
+namespace nc
+{
+    // NdArray 缓冲区的对齐字节数：一条缓存行，同时满足 AVX-512 的 64 字节向量
+    constexpr uint64 BUFFER_ALIGNMENT = 64;
+
+    class Allocator
+    {
+    public:
+        virtual ~Allocator() = default;
+
+        //============================================================================
+        /// 分配 inNumBytes 字节，起始地址按 inAlignment（2 的幂）对齐
+        ///
+        /// @param      inNumBytes
+        /// @param      inAlignment
+        ///
+        /// @return     void*
+        ///
+        virtual void* allocate(uint64 inNumBytes, uint64 inAlignment) = 0;
+
+        //============================================================================
+        /// 分配并清零，默认实现为 allocate 后 memset，能直接得到清零内存的分配器应覆盖
+        ///
+        /// @param      inNumBytes
+        /// @param      inAlignment
+        ///
+        /// @return     void*
+        ///
+        virtual void* allocateZeroed(uint64 inNumBytes, uint64 inAlignment)
+        {
+            void* ptr = allocate(inNumBytes, inAlignment);
+            std::memset(ptr, 0, static_cast<std::size_t>(inNumBytes));
+            return ptr;
+        }
+
+        //============================================================================
+        /// 归还 allocate 得到的内存，inNumBytes/inAlignment 与分配时相同
+        ///
+        /// @param      inPtr
+        /// @param      inNumBytes
+        /// @param      inAlignment
+        ///
+        virtual void deallocate(void* inPtr, uint64 inNumBytes, uint64 inAlignment) noexcept = 0;
+    };
+
+    //================================================================================
+    /// 使用 malloc/calloc/free 的默认分配器。超过 malloc 保证的对齐时多申请 inAlignment 字节，
+    /// 在对齐地址之前保存原始指针。allocateZeroed 使用 calloc，大块内存由操作系统直接
+    /// 提供清零的页面，不需要再写一遍
+    ///
+    class MallocAllocator : public Allocator
+    {
+    private:
+        static void* align(void* inRaw, uint64 inAlignment)
+        {
+            if (inRaw == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+
+            if (inAlignment <= alignof(std::max_align_t))
+            {
+                return inRaw;
+            }
+
+            const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(inRaw) + sizeof(void*);
+            void** aligned = reinterpret_cast<void**>((address + inAlignment - 1) & ~static_cast<std::uintptr_t>(inAlignment - 1));
+            aligned[-1] = inRaw;
+            return aligned;
+        }
+
+        static uint64 paddedSize(uint64 inNumBytes, uint64 inAlignment) noexcept
+        {
+            return inAlignment <= alignof(std::max_align_t) ? inNumBytes : inNumBytes + inAlignment;
+        }
+
+    public:
+        void* allocate(uint64 inNumBytes, uint64 inAlignment) override
+        {
+            return align(std::malloc(static_cast<std::size_t>(paddedSize(inNumBytes, inAlignment))), inAlignment);
+        }
+
+        void* allocateZeroed(uint64 inNumBytes, uint64 inAlignment) override
+        {
+            return align(std::calloc(static_cast<std::size_t>(paddedSize(inNumBytes, inAlignment)), 1), inAlignment);
+        }
+
+        void deallocate(void* inPtr, uint64, uint64 inAlignment) noexcept override
+        {
+            std::free(inAlignment <= alignof(std::max_align_t) ? inPtr : static_cast<void**>(inPtr)[-1]);
+        }
+    };
+
+    //============================================================================
+    /// 进程范围的默认分配器
+    ///
+    /// @return     Allocator*
+    ///
+    inline Allocator* defaultAllocator() noexcept
+    {
+        static MallocAllocator allocator;
+        return &allocator;
+    }
+
+    namespace detail
+    {
+        inline Allocator*& threadAllocator() noexcept
+        {
+            thread_local Allocator* allocator = nullptr;
+            return allocator;
+        }
+    }
+
+    //============================================================================
+    /// 当前线程新建 NdArray 使用的分配器
+    ///
+    /// @return     Allocator*
+    ///
+    inline Allocator* currentAllocator() noexcept
+    {
+        Allocator* allocator = detail::threadAllocator();
+        return allocator != nullptr ? allocator : defaultAllocator();
+    }
+
+    //================================================================================
+    /// 在对象的生命周期内把当前线程的分配器切换为 inAllocator，析构时恢复
+    ///
+    class AllocatorScope
+    {
+    private:
+        Allocator*  previous_;
+
+    public:
+        explicit AllocatorScope(Allocator& inAllocator) noexcept :
+            previous_(detail::threadAllocator())
+        {
+            detail::threadAllocator() = &inAllocator;
+        }
+
+        AllocatorScope(const AllocatorScope&) = delete;
+        AllocatorScope& operator=(const AllocatorScope&) = delete;
+
+        ~AllocatorScope()
+        {
+            detail::threadAllocator() = previous_;
+        }
+    };
+
+    //================================================================================
+    /// 线性（bump）分配器：从大块内存中顺序切分，deallocate 不做任何事，
+    /// reset() 一次性回收全部内存并保留已申请的块供下次复用。
+    /// 不是线程安全的，reset() 后从中分配的数组全部失效，适合每个请求一个 arena
+    ///
+    class ArenaAllocator : public Allocator
+    {
+    private:
+        struct Block
+        {
+            uint8*  data;
+            uint64  size;
+        };
+
+        std::vector<Block>  blocks_;
+        uint64              blockSize_;
+        uint32              currentBlock_{ 0 };
+        uint64              offset_{ 0 };
+        Allocator*          upstream_;
+
+        static uint64 alignUp(uint64 inValue, uint64 inAlignment) noexcept
+        {
+            return (inValue + inAlignment - 1) & ~(inAlignment - 1);
+        }
+
+        void* tryAllocate(uint64 inNumBytes, uint64 inAlignment) noexcept
+        {
+            const Block& block = blocks_[currentBlock_];
+            const uint64 address = reinterpret_cast<uint64>(block.data) + offset_;
+            const uint64 start = alignUp(address, inAlignment) - reinterpret_cast<uint64>(block.data);
+            if (start + inNumBytes > block.size)
+            {
+                return nullptr;
+            }
+
+            offset_ = start + inNumBytes;
+            return block.data + start;
+        }
+
+    public:
+        explicit ArenaAllocator(uint64 inBlockSize = 1 << 20, Allocator* inUpstream = defaultAllocator()) :
+            blockSize_(inBlockSize),
+            upstream_(inUpstream)
+        {}
+
+        ArenaAllocator(const ArenaAllocator&) = delete;
+        ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+        ~ArenaAllocator() override
+        {
+            release();
+        }
+
+        void* allocate(uint64 inNumBytes, uint64 inAlignment) override
+        {
+            inAlignment = std::max<uint64>(inAlignment, alignof(std::max_align_t));
+
+            for (; currentBlock_ < blocks_.size(); ++currentBlock_, offset_ = 0)
+            {
+                void* ptr = tryAllocate(inNumBytes, inAlignment);
+                if (ptr != nullptr)
+                {
+                    return ptr;
+                }
+            }
+
+            const uint64 size = std::max(blockSize_, inNumBytes + inAlignment);
+            blocks_.push_back({ static_cast<uint8*>(upstream_->allocate(size, alignof(std::max_align_t))), size });
+            currentBlock_ = static_cast<uint32>(blocks_.size() - 1);
+            offset_ = 0;
+            return tryAllocate(inNumBytes, inAlignment);
+        }
+
+        void deallocate(void*, uint64, uint64) noexcept override
+        {}
+
+        //============================================================================
+        /// 回收全部已分配内存，保留已申请的块
+        ///
+        void reset() noexcept
+        {
+            currentBlock_ = 0;
+            offset_ = 0;
+        }
+
+        //============================================================================
+        /// 回收全部内存并把块归还给上游分配器
+        ///
+        void release() noexcept
+        {
+            for (auto& block : blocks_)
+            {
+                upstream_->deallocate(block.data, block.size, alignof(std::max_align_t));
+            }
+            blocks_.clear();
+            reset();
+        }
+
+        //============================================================================
+        /// 已从上游申请的总字节数
+        ///
+        /// @return     uint64
+        ///
+        uint64 capacity() const noexcept
+        {
+            uint64 total = 0;
+            for (auto& block : blocks_)
+            {
+                total += block.size;
+            }
+            return total;
+        }
+    };
+
+    //================================================================================
+    /// 按大小分级的池分配器：请求按 2 的幂向上取整到某一级，释放的缓冲放回该级的空闲链表，
+    /// 之后同样大小的数组直接复用。超过 inMaxPooledBytes 的请求直接交给上游分配器。
+    /// 线程安全
+    ///
+    class PoolAllocator : public Allocator
+    {
+    private:
+        static constexpr uint64 MIN_CLASS_BYTES = 64;
+
+        // 池中缓冲统一按该值对齐，要求更大对齐的请求直接交给上游分配器
+        static constexpr uint64 POOL_ALIGNMENT = 64;
+
+        std::vector<std::vector<void*> >    freeLists_;
+        uint64                              maxPooledBytes_;
+        Allocator*                          upstream_;
+        std::mutex                          mutex_;
+
+        static uint32 sizeClass(uint64 inNumBytes) noexcept
+        {
+            uint32 sizeClass = 0;
+            for (uint64 classBytes = MIN_CLASS_BYTES; classBytes < inNumBytes; classBytes <<= 1)
+            {
+                ++sizeClass;
+            }
+            return sizeClass;
+        }
+
+        static uint64 classBytes(uint32 inSizeClass) noexcept
+        {
+            return MIN_CLASS_BYTES << inSizeClass;
+        }
+
+    public:
+        explicit PoolAllocator(uint64 inMaxPooledBytes = 1 << 20, Allocator* inUpstream = defaultAllocator()) :
+            freeLists_(sizeClass(inMaxPooledBytes) + 1),
+            maxPooledBytes_(classBytes(sizeClass(inMaxPooledBytes))),
+            upstream_(inUpstream)
+        {}
+
+        PoolAllocator(const PoolAllocator&) = delete;
+        PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+        ~PoolAllocator() override
+        {
+            release();
+        }
+
+        void* allocate(uint64 inNumBytes, uint64 inAlignment) override
+        {
+            if (inNumBytes > maxPooledBytes_ || inAlignment > POOL_ALIGNMENT)
+            {
+                return upstream_->allocate(inNumBytes, inAlignment);
+            }
+
+            const uint32 bucket = sizeClass(inNumBytes);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                std::vector<void*>& freeList = freeLists_[bucket];
+                if (!freeList.empty())
+                {
+                    void* ptr = freeList.back();
+                    freeList.pop_back();
+                    return ptr;
+                }
+            }
+
+            return upstream_->allocate(classBytes(bucket), POOL_ALIGNMENT);
+        }
+
+        void* allocateZeroed(uint64 inNumBytes, uint64 inAlignment) override
+        {
+            if (inNumBytes > maxPooledBytes_ || inAlignment > POOL_ALIGNMENT)
+            {
+                return upstream_->allocateZeroed(inNumBytes, inAlignment);
+            }
+
+            // 复用的缓冲里还留着上次的数据，只能分配后手动清零
+            return Allocator::allocateZeroed(inNumBytes, inAlignment);
+        }
+
+        void deallocate(void* inPtr, uint64 inNumBytes, uint64 inAlignment) noexcept override
+        {
+            if (inNumBytes > maxPooledBytes_ || inAlignment > POOL_ALIGNMENT)
+            {
+                upstream_->deallocate(inPtr, inNumBytes, inAlignment);
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            try
+            {
+                freeLists_[sizeClass(inNumBytes)].push_back(inPtr);
+            }
+            catch (const std::bad_alloc&)
+            {
+                upstream_->deallocate(inPtr, classBytes(sizeClass(inNumBytes)), POOL_ALIGNMENT);
+            }
+        }
+
+        //============================================================================
+        /// 把所有空闲缓冲归还给上游分配器
+        ///
+        void release() noexcept
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (uint32 bucket = 0; bucket < freeLists_.size(); ++bucket)
+            {
+                for (void* ptr : freeLists_[bucket])
+                {
+                    upstream_->deallocate(ptr, classBytes(bucket), POOL_ALIGNMENT);
+                }
+                freeLists_[bucket].clear();
+            }
+        }
+    };
+
+    //================================================================================
+    /// 供标准容器使用的适配器，从默认分配器按 BUFFER_ALIGNMENT 对齐分配，
+    /// 用于计算内核内部的打包缓冲等
+    ///
+    template<typename T>
+    class AlignedAllocator
+    {
+    public:
+        typedef T value_type;
+
+        AlignedAllocator() = default;
+
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U>&) noexcept
+        {}
+
+        T* allocate(std::size_t inNumElements)
+        {
+            return static_cast<T*>(defaultAllocator()->allocate(inNumElements * sizeof(T), BUFFER_ALIGNMENT));
+        }
+
+        void deallocate(T* inPtr, std::size_t inNumElements) noexcept
+        {
+            defaultAllocator()->deallocate(inPtr, inNumElements * sizeof(T), BUFFER_ALIGNMENT);
+        }
+
+        template<typename U>
+        bool operator==(const AlignedAllocator<U>&) const noexcept
+        {
+            return true;
+        }
+
+        template<typename U>
+        bool operator!=(const AlignedAllocator<U>&) const noexcept
+        {
+            return false;
+        }
+    };
+}
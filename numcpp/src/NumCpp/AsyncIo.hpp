@@ -0,0 +1,738 @@
+#pragma once
+
+#include"NumCpp/Types.hpp"
+#include"NumCpp/Utils.hpp"
+
+#include<algorithm>
+#include<atomic>
+#include<cerrno>
+#include<condition_variable>
+#include<cstdlib>
+#include<cstring>
+#include<deque>
+#include<exception>
+#include<functional>
+#include<future>
+#include<iostream>
+#include<memory>
+#include<mutex>
+#include<stdexcept>
+#include<string>
+#include<thread>
+#include<vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include<windows.h>
+#else
+#include<fcntl.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#if defined(__linux__) && !defined(NUMCPP_NO_IO_URING) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include<linux/io_uring.h>
+// <linux/fs.h>, pulled in by io_uring.h, defines these as macros
+#undef BLOCK_SIZE
+#undef BLOCK_SIZE_BITS
+#include<sys/mman.h>
+#include<sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(IORING_FEAT_RW_CUR_POS)
+#define NUMCPP_IO_URING
+#endif
+#endif
+#endif
+#endif
+
+// 异步文件读写：按文件偏移提交读写请求，完成时调用回调或兑现 future，
+// 使读下一块、计算当前块、写上一块可以同时进行。
+// Linux 上使用 io_uring（直接系统调用，不依赖 liburing），其他平台或内核不支持时
+// 退回到专用 I/O 线程执行 pread/pwrite。环境变量 NUMCPP_IO=threads 强制使用线程后端
+namespace nc
+{
+    namespace io
+    {
+        enum class FileMode
+        {
+            READ = 0,       // 只读打开已有文件
+            WRITE           // 创建（或截断）文件后只写
+        };
+
+        // 可按偏移读写的文件，读写互不影响文件位置，可被多个线程同时使用
+        class File
+        {
+        private:
+            std::string filename_;
+#ifdef _WIN32
+            HANDLE      file_{ INVALID_HANDLE_VALUE };
+#else
+            int         file_{ -1 };
+#endif
+
+            void fail(const std::string& inWhat) const
+            {
+                std::string errStr = "ERROR: File: " + inWhat + " '" + filename_ + "'.";
+                std::cerr << errStr << std::endl;
+                throw std::runtime_error(errStr);
+            }
+
+        public:
+            //============================================================================
+            /// 打开文件 inFilename
+            ///
+            /// @param      inFilename
+            /// @param      inMode
+            ///
+            File(const std::string& inFilename, FileMode inMode) :
+                filename_(inFilename)
+            {
+#ifdef _WIN32
+                file_ = CreateFileA(inFilename.c_str(), inMode == FileMode::WRITE ? GENERIC_WRITE : GENERIC_READ,
+                    FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, inMode == FileMode::WRITE ? CREATE_ALWAYS : OPEN_EXISTING,
+                    FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (file_ == INVALID_HANDLE_VALUE)
+                {
+                    fail("unable to open");
+                }
+#else
+                file_ = ::open(inFilename.c_str(), inMode == FileMode::WRITE ? O_WRONLY | O_CREAT | O_TRUNC : O_RDONLY, 0644);
+                if (file_ == -1)
+                {
+                    fail("unable to open");
+                }
+#endif
+            }
+
+            File(const File&) = delete;
+            File& operator=(const File&) = delete;
+
+            ~File()
+            {
+#ifdef _WIN32
+                CloseHandle(file_);
+#else
+                ::close(file_);
+#endif
+            }
+
+            const std::string& filename() const noexcept
+            {
+                return filename_;
+            }
+
+#ifndef _WIN32
+            int handle() const noexcept
+            {
+                return file_;
+            }
+#endif
+
+            //============================================================================
+            /// 从 inOffset 字节处读取 inNumBytes 字节到 outBuffer，文件不够长时抛出异常
+            ///
+            /// @param      outBuffer
+            /// @param      inNumBytes
+            /// @param      inOffset
+            ///
+            void readAt(void* outBuffer, uint64 inNumBytes, uint64 inOffset) const
+            {
+                uint8* buffer = static_cast<uint8*>(outBuffer);
+                while (inNumBytes > 0)
+                {
+                    // a single call transfers at most 1 GB
+                    const uint64 request = std::min<uint64>(inNumBytes, 1 << 30);
+#ifdef _WIN32
+                    OVERLAPPED position = {};
+                    position.Offset = static_cast<DWORD>(inOffset);
+                    position.OffsetHigh = static_cast<DWORD>(inOffset >> 32);
+                    DWORD count = 0;
+                    if (!ReadFile(file_, buffer, static_cast<DWORD>(request), &count, &position))
+                    {
+                        fail("unable to read");
+                    }
+#else
+                    const ssize_t count = ::pread(file_, buffer, static_cast<size_t>(request), static_cast<off_t>(inOffset));
+                    if (count < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (count < 0)
+                    {
+                        fail("unable to read");
+                    }
+#endif
+                    if (count == 0)
+                    {
+                        fail("unexpected end of file in");
+                    }
+                    buffer += count;
+                    inOffset += static_cast<uint64>(count);
+                    inNumBytes -= static_cast<uint64>(count);
+                }
+            }
+
+            //============================================================================
+            /// 把 inBuffer 的 inNumBytes 字节写到 inOffset 字节处
+            ///
+            /// @param      inBuffer
+            /// @param      inNumBytes
+            /// @param      inOffset
+            ///
+            void writeAt(const void* inBuffer, uint64 inNumBytes, uint64 inOffset) const
+            {
+                const uint8* buffer = static_cast<const uint8*>(inBuffer);
+                while (inNumBytes > 0)
+                {
+                    const uint64 request = std::min<uint64>(inNumBytes, 1 << 30);
+#ifdef _WIN32
+                    OVERLAPPED position = {};
+                    position.Offset = static_cast<DWORD>(inOffset);
+                    position.OffsetHigh = static_cast<DWORD>(inOffset >> 32);
+                    DWORD count = 0;
+                    if (!WriteFile(file_, buffer, static_cast<DWORD>(request), &count, &position) || count == 0)
+                    {
+                        fail("unable to write");
+                    }
+#else
+                    const ssize_t count = ::pwrite(file_, buffer, static_cast<size_t>(request), static_cast<off_t>(inOffset));
+                    if (count < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (count <= 0)
+                    {
+                        fail("unable to write");
+                    }
+#endif
+                    buffer += count;
+                    inOffset += static_cast<uint64>(count);
+                    inNumBytes -= static_cast<uint64>(count);
+                }
+            }
+
+            //============================================================================
+            /// 文件的字节数
+            ///
+            /// @return     uint64
+            ///
+            uint64 size() const
+            {
+#ifdef _WIN32
+                LARGE_INTEGER fileSize;
+                if (!GetFileSizeEx(file_, &fileSize))
+                {
+                    fail("unable to stat");
+                }
+                return static_cast<uint64>(fileSize.QuadPart);
+#else
+                struct stat fileStat;
+                if (fstat(file_, &fileStat) != 0)
+                {
+                    fail("unable to stat");
+                }
+                return static_cast<uint64>(fileStat.st_size);
+#endif
+            }
+        };
+
+        // 进程内共享的异步 I/O 引擎，大请求被切成 CHUNK 字节的片段并发执行
+        class AsyncIo
+        {
+        public:
+            enum class Backend
+            {
+                IO_URING = 0,
+                THREADS
+            };
+
+            // 每个片段的字节数
+            static constexpr uint64 CHUNK = 1 << 23;
+            // 线程后端的 I/O 线程数
+            static constexpr uint32 NUM_IO_THREADS = 4;
+            // io_uring 提交队列的长度，同时也是在途片段数的上限
+            static constexpr uint32 RING_ENTRIES = 64;
+
+            // 请求完成（或失败）时调用，失败时参数为异常。在 I/O 线程中执行，应尽快返回且不能再提交请求
+            typedef std::function<void(std::exception_ptr)> Callback;
+
+            struct Segment
+            {
+                void*   buffer;
+                uint64  numBytes;
+                uint64  offset;
+            };
+
+        private:
+            struct Request
+            {
+                std::shared_ptr<const File> file;
+                Callback                    onComplete;
+                bool                        write{ false };
+                std::atomic<uint64>         remaining{ 0 };
+                std::mutex                  mutex;
+                std::exception_ptr          error{ nullptr };
+            };
+
+            struct Chunk
+            {
+                std::shared_ptr<Request>    request;
+                uint8*                      buffer;
+                uint64                      numBytes;
+                uint64                      offset;
+            };
+
+            Backend                             backend_{ Backend::THREADS };
+            std::mutex                          mutex_;
+            std::condition_variable             condition_;
+            bool                                stop_{ false };
+            std::deque<Chunk>                   queue_;
+            std::vector<std::thread>            threads_;
+
+#ifdef NUMCPP_IO_URING
+            int                                 ring_{ -1 };
+            void*                               sqRing_{ nullptr };
+            void*                               cqRing_{ nullptr };
+            io_uring_sqe*                       sqes_{ nullptr };
+            size_t                              sqRingBytes_{ 0 };
+            size_t                              cqRingBytes_{ 0 };
+            unsigned*                           sqTail_{ nullptr };
+            unsigned*                           sqMask_{ nullptr };
+            unsigned*                           sqArray_{ nullptr };
+            unsigned*                           cqHead_{ nullptr };
+            unsigned*                           cqTail_{ nullptr };
+            unsigned*                           cqMask_{ nullptr };
+            io_uring_cqe*                       cqes_{ nullptr };
+            uint32                              inFlight_{ 0 };
+#endif
+
+            static bool threadsRequested() noexcept
+            {
+                const char* envValue = std::getenv("NUMCPP_IO");
+                return envValue != nullptr && std::strcmp(envValue, "threads") == 0;
+            }
+
+            //============================================================================
+            /// 片段完成，最后一个片段完成时调用请求的回调
+            ///
+            static void finishChunk(const std::shared_ptr<Request>& inRequest, std::exception_ptr inError) noexcept
+            {
+                if (inError != nullptr)
+                {
+                    std::lock_guard<std::mutex> lock(inRequest->mutex);
+                    if (inRequest->error == nullptr)
+                    {
+                        inRequest->error = inError;
+                    }
+                }
+
+                if (inRequest->remaining.fetch_sub(1) == 1)
+                {
+                    try
+                    {
+                        inRequest->onComplete(inRequest->error);
+                    }
+                    catch (...)
+                    {
+                        // a callback has nowhere to report to, it must handle its own failures
+                    }
+                    // release the buffers and the file held by the callback
+                    inRequest->onComplete = nullptr;
+                    inRequest->file.reset();
+                }
+            }
+
+            static void runChunk(const Chunk& inChunk) noexcept
+            {
+                std::exception_ptr error = nullptr;
+                try
+                {
+                    if (inChunk.request->write)
+                    {
+                        inChunk.request->file->writeAt(inChunk.buffer, inChunk.numBytes, inChunk.offset);
+                    }
+                    else
+                    {
+                        inChunk.request->file->readAt(inChunk.buffer, inChunk.numBytes, inChunk.offset);
+                    }
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                finishChunk(inChunk.request, error);
+            }
+
+            void threadLoop()
+            {
+                for (;;)
+                {
+                    Chunk chunk;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        condition_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                        if (queue_.empty())
+                        {
+                            return;
+                        }
+                        chunk = std::move(queue_.front());
+                        queue_.pop_front();
+                    }
+                    runChunk(chunk);
+                }
+            }
+
+#ifdef NUMCPP_IO_URING
+            static std::exception_ptr ioError(const Chunk& inChunk, int inErrno)
+            {
+                std::string errStr = "ERROR: AsyncIo: unable to " + std::string(inChunk.request->write ? "write" : "read") +
+                    " '" + inChunk.request->file->filename() + "' (" + std::strerror(inErrno) + ").";
+                std::cerr << errStr << std::endl;
+                return std::make_exception_ptr(std::runtime_error(errStr));
+            }
+
+            //============================================================================
+            /// 建立 io_uring 并映射提交/完成队列，内核不支持时返回 false
+            ///
+            bool setupRing() noexcept
+            {
+                io_uring_params params;
+                std::memset(&params, 0, sizeof(params));
+                const long ring = syscall(__NR_io_uring_setup, RING_ENTRIES, &params);
+                if (ring < 0)
+                {
+                    return false;
+                }
+                ring_ = static_cast<int>(ring);
+
+                // IORING_OP_READ/WRITE arrived together with this feature flag (Linux 5.6)
+                if ((params.features & IORING_FEAT_RW_CUR_POS) == 0)
+                {
+                    closeRing();
+                    return false;
+                }
+
+                sqRingBytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                cqRingBytes_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (singleMap)
+                {
+                    sqRingBytes_ = cqRingBytes_ = std::max(sqRingBytes_, cqRingBytes_);
+                }
+
+                void* sqRing = mmap(nullptr, sqRingBytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_, IORING_OFF_SQ_RING);
+                if (sqRing == MAP_FAILED)
+                {
+                    closeRing();
+                    return false;
+                }
+                sqRing_ = sqRing;
+
+                void* cqRing = singleMap ? sqRing : mmap(nullptr, cqRingBytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_, IORING_OFF_CQ_RING);
+                if (cqRing == MAP_FAILED)
+                {
+                    closeRing();
+                    return false;
+                }
+                cqRing_ = cqRing;
+
+                void* sqes = mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_, IORING_OFF_SQES);
+                if (sqes == MAP_FAILED)
+                {
+                    closeRing();
+                    return false;
+                }
+                sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+                uint8* sq = static_cast<uint8*>(sqRing_);
+                sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+                sqMask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+                sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+                uint8* cq = static_cast<uint8*>(cqRing_);
+                cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+                cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+                cqMask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+                cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+                return true;
+            }
+
+            void closeRing() noexcept
+            {
+                if (sqes_ != nullptr)
+                {
+                    munmap(sqes_, RING_ENTRIES * sizeof(io_uring_sqe));
+                }
+                if (cqRing_ != nullptr && cqRing_ != sqRing_)
+                {
+                    munmap(cqRing_, cqRingBytes_);
+                }
+                if (sqRing_ != nullptr)
+                {
+                    munmap(sqRing_, sqRingBytes_);
+                }
+                if (ring_ != -1)
+                {
+                    ::close(ring_);
+                }
+                sqes_ = nullptr;
+                sqRing_ = cqRing_ = nullptr;
+                ring_ = -1;
+            }
+
+            //============================================================================
+            /// 把一个片段放入提交队列并通知内核，调用者持有 mutex_；inChunk 为 nullptr 时提交停止标记
+            ///
+            void pushSqe(Chunk* inChunk) noexcept
+            {
+                const unsigned tail = *sqTail_;
+                const unsigned index = tail & *sqMask_;
+                io_uring_sqe* sqe = &sqes_[index];
+                std::memset(sqe, 0, sizeof(io_uring_sqe));
+                if (inChunk == nullptr)
+                {
+                    sqe->opcode = IORING_OP_NOP;
+                }
+                else
+                {
+                    sqe->opcode = inChunk->request->write ? IORING_OP_WRITE : IORING_OP_READ;
+                    sqe->fd = inChunk->request->file->handle();
+                    sqe->addr = reinterpret_cast<uint64>(inChunk->buffer);
+                    sqe->len = static_cast<uint32>(inChunk->numBytes);
+                    sqe->off = inChunk->offset;
+                }
+                sqe->user_data = reinterpret_cast<uint64>(inChunk);
+                sqArray_[index] = index;
+                __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+
+                // the kernel copies the entry during the call, so the slot is free again once it returns
+                while (syscall(__NR_io_uring_enter, ring_, 1, 0, 0, nullptr, 0) < 0)
+                {
+                    if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                    {
+                        break;
+                    }
+                    std::this_thread::yield();
+                }
+            }
+
+            void submitRing(Chunk inChunk)
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                // every submitted chunk needs room in the completion queue
+                condition_.wait(lock, [this] { return inFlight_ < RING_ENTRIES; });
+                ++inFlight_;
+                pushSqe(new Chunk(std::move(inChunk)));
+            }
+
+            //============================================================================
+            /// 完成队列的消费线程：短读写重新提交剩余部分，其余情况结束片段
+            ///
+            void reapLoop()
+            {
+                for (;;)
+                {
+                    const unsigned head = *cqHead_;
+                    if (head == __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE))
+                    {
+                        syscall(__NR_io_uring_enter, ring_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                        continue;
+                    }
+
+                    const io_uring_cqe cqe = cqes_[head & *cqMask_];
+                    __atomic_store_n(cqHead_, head + 1, __ATOMIC_RELEASE);
+
+                    Chunk* chunk = reinterpret_cast<Chunk*>(cqe.user_data);
+                    if (chunk == nullptr)
+                    {
+                        return;
+                    }
+
+                    std::exception_ptr error = nullptr;
+                    if (cqe.res == -EINTR || cqe.res == -EAGAIN)
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        pushSqe(chunk);
+                        continue;
+                    }
+                    else if (cqe.res < 0)
+                    {
+                        error = ioError(*chunk, -cqe.res);
+                    }
+                    else if (cqe.res == 0)
+                    {
+                        error = ioError(*chunk, chunk->request->write ? EIO : ENODATA);
+                    }
+                    else if (static_cast<uint64>(cqe.res) < chunk->numBytes)
+                    {
+                        chunk->buffer += cqe.res;
+                        chunk->offset += static_cast<uint64>(cqe.res);
+                        chunk->numBytes -= static_cast<uint64>(cqe.res);
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        pushSqe(chunk);
+                        continue;
+                    }
+
+                    std::shared_ptr<Request> request = std::move(chunk->request);
+                    delete chunk;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        --inFlight_;
+                    }
+                    condition_.notify_all();
+                    finishChunk(request, error);
+                }
+            }
+#endif
+
+            AsyncIo()
+            {
+#ifdef NUMCPP_IO_URING
+                if (!threadsRequested() && setupRing())
+                {
+                    backend_ = Backend::IO_URING;
+                    threads_.emplace_back(&AsyncIo::reapLoop, this);
+                    return;
+                }
+#endif
+                for (uint32 i = 0; i < NUM_IO_THREADS; ++i)
+                {
+                    threads_.emplace_back(&AsyncIo::threadLoop, this);
+                }
+            }
+
+        public:
+            AsyncIo(const AsyncIo&) = delete;
+            AsyncIo& operator=(const AsyncIo&) = delete;
+
+            ~AsyncIo()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stop_ = true;
+#ifdef NUMCPP_IO_URING
+                    if (backend_ == Backend::IO_URING)
+                    {
+                        pushSqe(nullptr);
+                    }
+#endif
+                }
+                condition_.notify_all();
+                for (auto& thread : threads_)
+                {
+                    thread.join();
+                }
+#ifdef NUMCPP_IO_URING
+                closeRing();
+#endif
+            }
+
+            //============================================================================
+            /// 全局实例
+            ///
+            /// @return     AsyncIo&
+            ///
+            static AsyncIo& instance()
+            {
+                static AsyncIo asyncIo;
+                return asyncIo;
+            }
+
+            Backend backend() const noexcept
+            {
+                return backend_;
+            }
+
+            //============================================================================
+            /// 提交一组读或写，全部完成后在 I/O 线程中调用 inOnComplete。
+            /// 完成前各缓冲区必须保持有效，文件由请求持有直到完成
+            ///
+            /// @param      inWrite: true 为写，false 为读
+            /// @param      inFile
+            /// @param      inSegments
+            /// @param      inOnComplete
+            ///
+            void submit(bool inWrite, std::shared_ptr<const File> inFile, const std::vector<Segment>& inSegments, Callback inOnComplete)
+            {
+                auto request = std::make_shared<Request>();
+                request->file = std::move(inFile);
+                request->onComplete = std::move(inOnComplete);
+                request->write = inWrite;
+
+                const uint64 chunkBytes = CHUNK;
+                std::vector<Chunk> chunks;
+                for (const Segment& segment : inSegments)
+                {
+                    for (uint64 done = 0; done < segment.numBytes; done += chunkBytes)
+                    {
+                        chunks.push_back({ request, static_cast<uint8*>(segment.buffer) + done,
+                            std::min(chunkBytes, segment.numBytes - done), segment.offset + done });
+                    }
+                }
+
+                // one extra count so that the callback cannot run before every chunk is queued
+                request->remaining = chunks.size() + 1;
+                if (backend_ == Backend::THREADS)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        queue_.insert(queue_.end(), chunks.begin(), chunks.end());
+                    }
+                    condition_.notify_all();
+                }
+#ifdef NUMCPP_IO_URING
+                else
+                {
+                    for (Chunk& chunk : chunks)
+                    {
+                        submitRing(std::move(chunk));
+                    }
+                }
+#endif
+                finishChunk(request, nullptr);
+            }
+
+            //============================================================================
+            /// 异步读取：从 inOffset 字节处读 inNumBytes 字节到 outBuffer
+            ///
+            /// @param      inFile
+            /// @param      outBuffer
+            /// @param      inNumBytes
+            /// @param      inOffset
+            ///
+            /// @return     std::future<void>
+            ///
+            std::future<void> read(std::shared_ptr<const File> inFile, void* outBuffer, uint64 inNumBytes, uint64 inOffset)
+            {
+                auto promise = std::make_shared<std::promise<void>>();
+                std::future<void> returnFuture = promise->get_future();
+                submit(false, std::move(inFile), { { outBuffer, inNumBytes, inOffset } }, [promise](std::exception_ptr inError)
+                {
+                    inError != nullptr ? promise->set_exception(inError) : promise->set_value();
+                });
+                return returnFuture;
+            }
+
+            //============================================================================
+            /// 异步写入：把 inBuffer 的 inNumBytes 字节写到 inOffset 字节处
+            ///
+            /// @param      inFile
+            /// @param      inBuffer
+            /// @param      inNumBytes
+            /// @param      inOffset
+            ///
+            /// @return     std::future<void>
+            ///
+            std::future<void> write(std::shared_ptr<const File> inFile, const void* inBuffer, uint64 inNumBytes, uint64 inOffset)
+            {
+                auto promise = std::make_shared<std::promise<void>>();
+                std::future<void> returnFuture = promise->get_future();
+                submit(true, std::move(inFile), { { const_cast<void*>(inBuffer), inNumBytes, inOffset } }, [promise](std::exception_ptr inError)
+                {
+                    inError != nullptr ? promise->set_exception(inError) : promise->set_value();
+                });
+                return returnFuture;
+            }
+        };
+    }
+}
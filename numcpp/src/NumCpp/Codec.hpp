@@ -0,0 +1,625 @@
+#pragma once
+
+#include"NumCpp/Io.hpp"
+#include"NumCpp/Types.hpp"
+
+#include<algorithm>
+#include<cstring>
+#include<iostream>
+#include<stdexcept>
+#include<string>
+#include<type_traits>
+#include<vector>
+
+// 压缩数组文件的块编解码器，全部内置、不依赖外部库：
+// 字节重排 + LZ77（LZ4 风格的序列格式）适合浮点数，差分 + zigzag + 按帧位压缩适合整数。
+// 编码结果与主机字节序无关（一律小端），解码对损坏的输入做边界检查并抛出异常
+namespace nc
+{
+    enum class Codec
+    {
+        NONE = 0,       // 原样存储
+        SHUFFLE_LZ,     // 按字节平面重排后 LZ77 压缩
+        DELTA_PACK,     // 差分 + zigzag + 按帧位压缩，仅用于整数
+        AUTO            // 整数用 DELTA_PACK，其他用 SHUFFLE_LZ
+    };
+
+    namespace codec
+    {
+        // DELTA_PACK 每帧的元素个数，同一帧共用一个位宽
+        constexpr uint32 FRAME = 128;
+        // LZ77 的最短匹配与最大回溯距离
+        constexpr uint32 MIN_MATCH = 4;
+        constexpr uint32 MAX_OFFSET = 65535;
+        constexpr uint32 HASH_BITS = 14;
+
+        namespace detail
+        {
+            inline uint32 load32(const uint8* inPtr) noexcept
+            {
+                uint32 value;
+                std::memcpy(&value, inPtr, sizeof(value));
+                return value;
+            }
+
+            inline uint64 load64(const uint8* inPtr) noexcept
+            {
+                uint64 value;
+                std::memcpy(&value, inPtr, sizeof(value));
+                return value;
+            }
+
+            inline uint64 load64LE(const uint8* inPtr) noexcept
+            {
+                uint64 value = load64(inPtr);
+                if (!io::nativeIsLittle())
+                {
+                    io::byteswap(&value, 1);
+                }
+                return value;
+            }
+
+            inline void store64LE(uint8* outPtr, uint64 inValue) noexcept
+            {
+                if (!io::nativeIsLittle())
+                {
+                    io::byteswap(&inValue, 1);
+                }
+                std::memcpy(outPtr, &inValue, sizeof(inValue));
+            }
+
+            inline uint32 hash(uint32 inValue) noexcept
+            {
+                return (inValue * 2654435761u) >> (32 - HASH_BITS);
+            }
+
+            inline uint32 bitWidth(uint64 inValue) noexcept
+            {
+                uint32 width = 0;
+                while (inValue != 0)
+                {
+                    ++width;
+                    inValue >>= 1;
+                }
+                return width;
+            }
+
+            inline void corrupt(const std::string& inWhat)
+            {
+                std::string errStr = "ERROR: codec: corrupt " + inWhat + " block.";
+                std::cerr << errStr << std::endl;
+                throw std::runtime_error(errStr);
+            }
+
+            //============================================================================
+            /// 长度 ≥ 15 的部分用 255 续接字节表示
+            ///
+            inline void writeLength(std::vector<uint8>& outBuffer, uint64 inLength)
+            {
+                for (; inLength >= 255; inLength -= 255)
+                {
+                    outBuffer.push_back(255);
+                }
+                outBuffer.push_back(static_cast<uint8>(inLength));
+            }
+
+            inline bool readLength(const uint8*& ioPtr, const uint8* inEnd, uint64& ioLength) noexcept
+            {
+                uint8 byte = 255;
+                while (byte == 255)
+                {
+                    if (ioPtr == inEnd)
+                    {
+                        return false;
+                    }
+                    byte = *ioPtr++;
+                    ioLength += byte;
+                }
+                return true;
+            }
+
+            inline void writeSequence(std::vector<uint8>& outBuffer, const uint8* inLiterals, uint64 inNumLiterals,
+                uint64 inOffset, uint64 inMatchLength)
+            {
+                const uint64 matchCode = inMatchLength - MIN_MATCH;
+                outBuffer.push_back(static_cast<uint8>((std::min<uint64>(inNumLiterals, 15) << 4) | std::min<uint64>(matchCode, 15)));
+                if (inNumLiterals >= 15)
+                {
+                    writeLength(outBuffer, inNumLiterals - 15);
+                }
+                outBuffer.insert(outBuffer.end(), inLiterals, inLiterals + inNumLiterals);
+                outBuffer.push_back(static_cast<uint8>(inOffset));
+                outBuffer.push_back(static_cast<uint8>(inOffset >> 8));
+                if (matchCode >= 15)
+                {
+                    writeLength(outBuffer, matchCode - 15);
+                }
+            }
+
+            inline uint64 zigzag(uint64 inValue) noexcept
+            {
+                return (inValue << 1) ^ static_cast<uint64>(static_cast<int64>(inValue) >> 63);
+            }
+
+            inline uint64 unzigzag(uint64 inValue) noexcept
+            {
+                return (inValue >> 1) ^ (0 - (inValue & 1));
+            }
+
+            //============================================================================
+            /// 第 i 个元素的参照值：有多行时为上一行同列元素，否则为前一个元素
+            ///
+            template<typename dtype>
+            uint64 reference(const dtype* inValues, uint64 inIndex, uint64 inStride) noexcept
+            {
+                if (inIndex >= inStride)
+                {
+                    return static_cast<uint64>(inValues[inIndex - inStride]);
+                }
+                return inIndex > 0 ? static_cast<uint64>(inValues[inIndex - 1]) : 0;
+            }
+        }
+
+        //============================================================================
+        /// 字节重排：把 inNumElements 个 inElementSize 字节的元素的第 k 个字节集中到第 k 个平面
+        ///
+        /// @param      inData
+        /// @param      inNumElements
+        /// @param      inElementSize
+        /// @param      outData
+        ///
+        inline void shuffle(const uint8* inData, uint64 inNumElements, uint32 inElementSize, uint8* outData) noexcept
+        {
+            for (uint32 byte = 0; byte < inElementSize; ++byte)
+            {
+                uint8* plane = outData + byte * inNumElements;
+                const uint8* source = inData + byte;
+                for (uint64 i = 0; i < inNumElements; ++i)
+                {
+                    plane[i] = source[i * inElementSize];
+                }
+            }
+        }
+
+        inline void unshuffle(const uint8* inData, uint64 inNumElements, uint32 inElementSize, uint8* outData) noexcept
+        {
+            for (uint32 byte = 0; byte < inElementSize; ++byte)
+            {
+                const uint8* plane = inData + byte * inNumElements;
+                uint8* target = outData + byte;
+                for (uint64 i = 0; i < inNumElements; ++i)
+                {
+                    target[i * inElementSize] = plane[i];
+                }
+            }
+        }
+
+        //============================================================================
+        /// LZ77 压缩：贪心匹配，哈希表记录每个 4 字节序列最近出现的位置。
+        /// 序列格式为 token(字面量长度:4 | 匹配长度-4:4)、字面量、2 字节回溯距离，最后一个序列只有字面量
+        ///
+        /// @param      inData
+        /// @param      inSize
+        /// @param      outBuffer
+        ///
+        inline void lzCompress(const uint8* inData, uint64 inSize, std::vector<uint8>& outBuffer)
+        {
+            outBuffer.clear();
+            outBuffer.reserve(inSize + inSize / 255 + 16);
+
+            uint64 anchor = 0;
+            if (inSize > 12)
+            {
+                // positions are stored plus one so that zero means empty
+                std::vector<uint32> table(static_cast<size_t>(1) << HASH_BITS, 0);
+                const uint64 matchLimit = inSize - 12;
+                const uint64 matchEnd = inSize - 5;
+                uint64 position = 0;
+                while (position < matchLimit)
+                {
+                    const uint32 sequence = detail::load32(inData + position);
+                    const uint32 bucket = detail::hash(sequence);
+                    const uint64 candidate = table[bucket];
+                    table[bucket] = static_cast<uint32>(position + 1);
+
+                    if (candidate == 0 || position - (candidate - 1) > MAX_OFFSET || detail::load32(inData + candidate - 1) != sequence)
+                    {
+                        // step faster through data that does not compress
+                        position += 1 + ((position - anchor) >> 5);
+                        continue;
+                    }
+
+                    uint64 match = candidate - 1;
+                    uint64 length = MIN_MATCH;
+                    while (position > anchor && match > 0 && inData[position - 1] == inData[match - 1])
+                    {
+                        --position;
+                        --match;
+                        ++length;
+                    }
+                    while (position + length + 8 <= matchEnd && detail::load64(inData + match + length) == detail::load64(inData + position + length))
+                    {
+                        length += 8;
+                    }
+                    while (position + length < matchEnd && inData[match + length] == inData[position + length])
+                    {
+                        ++length;
+                    }
+
+                    detail::writeSequence(outBuffer, inData + anchor, position - anchor, position - match, length);
+                    position += length;
+                    anchor = position;
+                    if (position < matchLimit)
+                    {
+                        table[detail::hash(detail::load32(inData + position - 2))] = static_cast<uint32>(position - 1);
+                    }
+                }
+            }
+
+            const uint64 numLiterals = inSize - anchor;
+            outBuffer.push_back(static_cast<uint8>(std::min<uint64>(numLiterals, 15) << 4));
+            if (numLiterals >= 15)
+            {
+                detail::writeLength(outBuffer, numLiterals - 15);
+            }
+            outBuffer.insert(outBuffer.end(), inData + anchor, inData + inSize);
+        }
+
+        //============================================================================
+        /// LZ77 解压，输出恰好 inOutSize 字节，输入损坏时返回 false
+        ///
+        /// @param      inData
+        /// @param      inSize
+        /// @param      outData
+        /// @param      inOutSize
+        ///
+        /// @return     bool
+        ///
+        inline bool lzDecompress(const uint8* inData, uint64 inSize, uint8* outData, uint64 inOutSize) noexcept
+        {
+            const uint8* input = inData;
+            const uint8* inputEnd = inData + inSize;
+            uint64 written = 0;
+            for (;;)
+            {
+                if (input == inputEnd)
+                {
+                    return false;
+                }
+                const uint8 token = *input++;
+
+                uint64 numLiterals = token >> 4;
+                if (numLiterals == 15 && !detail::readLength(input, inputEnd, numLiterals))
+                {
+                    return false;
+                }
+                if (numLiterals > static_cast<uint64>(inputEnd - input) || numLiterals > inOutSize - written)
+                {
+                    return false;
+                }
+                std::memcpy(outData + written, input, static_cast<size_t>(numLiterals));
+                input += numLiterals;
+                written += numLiterals;
+
+                if (input == inputEnd)
+                {
+                    return written == inOutSize;
+                }
+
+                if (inputEnd - input < 2)
+                {
+                    return false;
+                }
+                const uint64 offset = static_cast<uint64>(input[0]) | (static_cast<uint64>(input[1]) << 8);
+                input += 2;
+                uint64 length = token & 15;
+                if (length == 15 && !detail::readLength(input, inputEnd, length))
+                {
+                    return false;
+                }
+                length += MIN_MATCH;
+                if (offset == 0 || offset > written || length > inOutSize - written)
+                {
+                    return false;
+                }
+
+                uint8* target = outData + written;
+                const uint8* source = target - offset;
+                if (offset >= length)
+                {
+                    std::memcpy(target, source, static_cast<size_t>(length));
+                }
+                else
+                {
+                    // overlapping copy repeats the last offset bytes
+                    for (uint64 i = 0; i < length; ++i)
+                    {
+                        target[i] = source[i];
+                    }
+                }
+                written += length;
+            }
+        }
+
+        //============================================================================
+        /// 整数的差分位压缩：每个元素减去参照值（见 detail::reference）后 zigzag 编码，
+        /// 每 FRAME 个元素按其中最大值的位宽紧凑存储。输出为各帧位宽（每帧 1 字节）后接各帧的 64 位字
+        ///
+        /// @param      inValues
+        /// @param      inNumValues
+        /// @param      inStride: 行长，一行时等于元素个数
+        /// @param      outBuffer
+        ///
+        template<typename dtype>
+        void deltaPack(const dtype* inValues, uint64 inNumValues, uint64 inStride, std::vector<uint8>& outBuffer)
+        {
+            static_assert(std::is_integral<dtype>::value, "deltaPack: dtype must be an integer type.");
+
+            const uint64 numFrames = (inNumValues + FRAME - 1) / FRAME;
+            outBuffer.assign(static_cast<size_t>(numFrames), 0);
+            outBuffer.reserve(static_cast<size_t>(numFrames + inNumValues * sizeof(dtype) + 8));
+
+            uint64 deltas[FRAME];
+            for (uint64 frame = 0; frame < numFrames; ++frame)
+            {
+                const uint64 first = frame * FRAME;
+                const uint32 count = static_cast<uint32>(std::min<uint64>(FRAME, inNumValues - first));
+                uint64 combined = 0;
+                for (uint32 i = 0; i < count; ++i)
+                {
+                    // unsigned wrap-around keeps the difference exact for every integer width
+                    deltas[i] = detail::zigzag(static_cast<uint64>(inValues[first + i]) - detail::reference(inValues, first + i, inStride));
+                    combined |= deltas[i];
+                }
+
+                const uint32 width = detail::bitWidth(combined);
+                outBuffer[static_cast<size_t>(frame)] = static_cast<uint8>(width);
+                if (width == 0)
+                {
+                    continue;
+                }
+
+                uint64 word = 0;
+                uint32 filled = 0;
+                uint8 bytes[8];
+                for (uint32 i = 0; i < count; ++i)
+                {
+                    word |= deltas[i] << filled;
+                    if (filled + width >= 64)
+                    {
+                        detail::store64LE(bytes, word);
+                        outBuffer.insert(outBuffer.end(), bytes, bytes + 8);
+                        word = filled == 0 ? 0 : deltas[i] >> (64 - filled);
+                        filled = filled + width - 64;
+                    }
+                    else
+                    {
+                        filled += width;
+                    }
+                }
+                if (filled > 0)
+                {
+                    detail::store64LE(bytes, word);
+                    outBuffer.insert(outBuffer.end(), bytes, bytes + 8);
+                }
+            }
+        }
+
+        //============================================================================
+        /// deltaPack 的逆过程，输入损坏时返回 false
+        ///
+        /// @param      inData
+        /// @param      inSize
+        /// @param      inNumValues
+        /// @param      inStride
+        /// @param      outValues
+        ///
+        /// @return     bool
+        ///
+        template<typename dtype>
+        bool deltaUnpack(const uint8* inData, uint64 inSize, uint64 inNumValues, uint64 inStride, dtype* outValues) noexcept
+        {
+            static_assert(std::is_integral<dtype>::value, "deltaUnpack: dtype must be an integer type.");
+
+            const uint64 numFrames = (inNumValues + FRAME - 1) / FRAME;
+            if (inSize < numFrames)
+            {
+                return false;
+            }
+
+            const uint8* words = inData + numFrames;
+            const uint8* wordsEnd = inData + inSize;
+            uint64 frameWords[FRAME];
+            for (uint64 frame = 0; frame < numFrames; ++frame)
+            {
+                const uint64 first = frame * FRAME;
+                const uint32 count = static_cast<uint32>(std::min<uint64>(FRAME, inNumValues - first));
+                const uint32 width = inData[frame];
+                if (width > 64)
+                {
+                    return false;
+                }
+
+                const uint64 numWords = (static_cast<uint64>(count) * width + 63) / 64;
+                if (numWords * 8 > static_cast<uint64>(wordsEnd - words))
+                {
+                    return false;
+                }
+                for (uint64 i = 0; i < numWords; ++i)
+                {
+                    frameWords[i] = detail::load64LE(words + i * 8);
+                }
+                words += numWords * 8;
+
+                const uint64 mask = width == 64 ? ~static_cast<uint64>(0) : (static_cast<uint64>(1) << width) - 1;
+                uint64 bit = 0;
+                for (uint32 i = 0; i < count; ++i, bit += width)
+                {
+                    uint64 delta = 0;
+                    if (width != 0)
+                    {
+                        const uint64 index = bit >> 6;
+                        const uint32 shift = static_cast<uint32>(bit & 63);
+                        delta = frameWords[index] >> shift;
+                        if (shift + width > 64)
+                        {
+                            delta |= frameWords[index + 1] << (64 - shift);
+                        }
+                        delta &= mask;
+                    }
+                    outValues[first + i] = static_cast<dtype>(detail::unzigzag(delta) + detail::reference(outValues, first + i, inStride));
+                }
+            }
+            return words == wordsEnd;
+        }
+
+        //============================================================================
+        /// 是否可以使用 DELTA_PACK
+        ///
+        template<typename dtype>
+        constexpr bool packable() noexcept
+        {
+            return std::is_integral<dtype>::value && !std::is_same<dtype, bool>::value;
+        }
+
+        template<typename dtype>
+        Codec resolve(Codec inCodec) noexcept
+        {
+            return inCodec != Codec::AUTO ? inCodec : (packable<dtype>() ? Codec::DELTA_PACK : Codec::SHUFFLE_LZ);
+        }
+
+        namespace detail
+        {
+            template<typename dtype>
+            void deltaPack(const dtype* inValues, uint64 inNumValues, uint64 inStride, std::vector<uint8>& outBuffer, std::true_type)
+            {
+                codec::deltaPack(inValues, inNumValues, inStride, outBuffer);
+            }
+
+            template<typename dtype>
+            void deltaPack(const dtype*, uint64, uint64, std::vector<uint8>&, std::false_type)
+            {
+                std::string errStr = "ERROR: codec: DELTA_PACK is only available for integer dtypes.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+
+            template<typename dtype>
+            bool deltaUnpack(const uint8* inData, uint64 inSize, uint64 inNumValues, uint64 inStride, dtype* outValues, std::true_type) noexcept
+            {
+                return codec::deltaUnpack(inData, inSize, inNumValues, inStride, outValues);
+            }
+
+            template<typename dtype>
+            bool deltaUnpack(const uint8*, uint64, uint64, uint64, dtype*, std::false_type) noexcept
+            {
+                return false;
+            }
+        }
+
+        //============================================================================
+        /// 编码一块 inNumValues 个元素到 outBuffer，压缩后不比原始数据小时原样存储。
+        /// 返回实际使用的编解码器
+        ///
+        /// @param      inValues
+        /// @param      inNumValues
+        /// @param      inStride: 块的行长
+        /// @param      inCodec
+        /// @param      outBuffer
+        /// @param      ioScratch: 临时缓冲区，可在多次调用间复用
+        ///
+        /// @return     Codec
+        ///
+        template<typename dtype>
+        Codec encodeBlock(const dtype* inValues, uint64 inNumValues, uint64 inStride, Codec inCodec,
+            std::vector<uint8>& outBuffer, std::vector<uint8>& ioScratch)
+        {
+            const uint64 rawBytes = inNumValues * sizeof(dtype);
+            const Codec codec = resolve<dtype>(inCodec);
+            const uint8* bytes = reinterpret_cast<const uint8*>(inValues);
+            if (codec != Codec::DELTA_PACK && !io::nativeIsLittle())
+            {
+                ioScratch.resize(static_cast<size_t>(rawBytes));
+                std::memcpy(ioScratch.data(), inValues, static_cast<size_t>(rawBytes));
+                io::byteswap(reinterpret_cast<dtype*>(ioScratch.data()), inNumValues);
+                bytes = ioScratch.data();
+            }
+
+            if (codec == Codec::DELTA_PACK)
+            {
+                detail::deltaPack(inValues, inNumValues, inStride, outBuffer, std::integral_constant<bool, packable<dtype>()>());
+            }
+            else if (codec == Codec::SHUFFLE_LZ)
+            {
+                std::vector<uint8> shuffled(static_cast<size_t>(rawBytes));
+                shuffle(bytes, inNumValues, sizeof(dtype), shuffled.data());
+                lzCompress(shuffled.data(), rawBytes, outBuffer);
+            }
+
+            if (codec == Codec::NONE || outBuffer.size() >= rawBytes)
+            {
+                outBuffer.assign(bytes, bytes + rawBytes);
+                return Codec::NONE;
+            }
+            return codec;
+        }
+
+        //============================================================================
+        /// 把 encodeBlock 的输出解码为 inNumValues 个元素，输入损坏时抛出异常
+        ///
+        /// @param      inCodec
+        /// @param      inData
+        /// @param      inSize
+        /// @param      inNumValues
+        /// @param      inStride
+        /// @param      outValues
+        /// @param      ioScratch: 临时缓冲区，可在多次调用间复用
+        ///
+        template<typename dtype>
+        void decodeBlock(Codec inCodec, const uint8* inData, uint64 inSize, uint64 inNumValues, uint64 inStride,
+            dtype* outValues, std::vector<uint8>& ioScratch)
+        {
+            const uint64 rawBytes = inNumValues * sizeof(dtype);
+            uint8* bytes = reinterpret_cast<uint8*>(outValues);
+            switch (inCodec)
+            {
+                case Codec::NONE:
+                {
+                    if (inSize != rawBytes)
+                    {
+                        detail::corrupt("NONE");
+                    }
+                    std::memcpy(bytes, inData, static_cast<size_t>(rawBytes));
+                    break;
+                }
+                case Codec::SHUFFLE_LZ:
+                {
+                    ioScratch.resize(static_cast<size_t>(rawBytes));
+                    if (!lzDecompress(inData, inSize, ioScratch.data(), rawBytes))
+                    {
+                        detail::corrupt("SHUFFLE_LZ");
+                    }
+                    unshuffle(ioScratch.data(), inNumValues, sizeof(dtype), bytes);
+                    break;
+                }
+                case Codec::DELTA_PACK:
+                {
+                    if (!detail::deltaUnpack(inData, inSize, inNumValues, inStride, outValues, std::integral_constant<bool, packable<dtype>()>()))
+                    {
+                        detail::corrupt("DELTA_PACK");
+                    }
+                    return;
+                }
+                default:
+                {
+                    detail::corrupt("unknown codec");
+                }
+            }
+
+            if (!io::nativeIsLittle())
+            {
+                io::byteswap(outValues, inNumValues);
+            }
+        }
+    }
+}
@@ -0,0 +1,432 @@
+#pragma once
+
+#include"NumCpp/AsyncIo.hpp"
+#include"NumCpp/Codec.hpp"
+#include"NumCpp/Io.hpp"
+#include"NumCpp/NdArray.hpp"
+#include"NumCpp/ThreadPool.hpp"
+#include"NumCpp/Types.hpp"
+#include"NumCpp/Utils.hpp"
+
+#include<algorithm>
+#include<cstring>
+#include<future>
+#include<iostream>
+#include<memory>
+#include<stdexcept>
+#include<string>
+#include<vector>
+
+// 分块压缩的磁盘数组：按固定行数分块，每块独立编码并记录所用的编解码器，
+// 多线程并行压缩/解压，可只读取某个行范围涉及的块。
+// 文件布局（小端）：64 字节文件头、各块数据、块索引（每块 16 字节：偏移、字节数、编解码器）
+namespace nc
+{
+    template<typename dtype>
+    class CompressedArray
+    {
+    public:
+        // 每块原始数据的默认字节数
+        static constexpr uint64 BLOCK_BYTES = 1 << 20;
+        // 一次读取的压缩数据字节数，读取下一批与解压当前批重叠
+        static constexpr uint64 BATCH_BYTES = 1 << 26;
+
+    private:
+        static constexpr uint64 HEADER_BYTES = 64;
+        static constexpr uint64 INDEX_ENTRY_BYTES = 16;
+
+        struct BlockEntry
+        {
+            uint64  offset;
+            uint64  numBytes;
+            Codec   codec;
+        };
+
+        std::string                     filename_;
+        std::shared_ptr<const io::File> file_;
+        uint64                          numRows_{ 0 };
+        uint32                          numCols_{ 0 };
+        uint32                          rowsPerBlock_{ 1 };
+        std::vector<BlockEntry>         blocks_;
+
+        static const char* magic() noexcept
+        {
+            return "\x93NUMCPPZ";
+        }
+
+        static void fail(const std::string& inFilename, const std::string& inWhat)
+        {
+            std::string errStr = "ERROR: CompressedArray: '" + inFilename + "' " + inWhat;
+            std::cerr << errStr << std::endl;
+            throw std::runtime_error(errStr);
+        }
+
+        static void put(uint8* outData, uint64 inValue, uint32 inNumBytes) noexcept
+        {
+            for (uint32 i = 0; i < inNumBytes; ++i)
+            {
+                outData[i] = static_cast<uint8>(inValue >> (8 * i));
+            }
+        }
+
+        static uint64 get(const uint8* inData, uint32 inNumBytes) noexcept
+        {
+            uint64 value = 0;
+            for (uint32 i = 0; i < inNumBytes; ++i)
+            {
+                value |= static_cast<uint64>(inData[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        uint64 firstRowOf(uint64 inBlock) const noexcept
+        {
+            return inBlock * rowsPerBlock_;
+        }
+
+        uint32 rowsIn(uint64 inBlock) const noexcept
+        {
+            return static_cast<uint32>(std::min<uint64>(rowsPerBlock_, numRows_ - firstRowOf(inBlock)));
+        }
+
+    public:
+        //============================================================================
+        /// 打开 save 写出的文件，读取文件头与块索引
+        ///
+        /// @param      inFilename
+        ///
+        explicit CompressedArray(const std::string& inFilename) :
+            filename_(inFilename),
+            file_(std::make_shared<const io::File>(inFilename, io::FileMode::READ))
+        {
+            const uint64 fileBytes = file_->size();
+            if (fileBytes < HEADER_BYTES)
+            {
+                fail(filename_, "is too small to be a compressed array.");
+            }
+
+            uint8 header[HEADER_BYTES];
+            file_->readAt(header, HEADER_BYTES, 0);
+            if (std::memcmp(header, magic(), 8) != 0)
+            {
+                fail(filename_, "is not a compressed array.");
+            }
+
+            const std::string expected = io::npyDescr<dtype>(Endian::LITTLE);
+            const std::string descr(reinterpret_cast<const char*>(header + 8), strnlen(reinterpret_cast<const char*>(header + 8), 8));
+            if (descr != expected)
+            {
+                fail(filename_, "holds '" + descr + "', which does not match the requested dtype '" + expected + "'.");
+            }
+
+            numRows_ = get(header + 16, 8);
+            numCols_ = static_cast<uint32>(get(header + 24, 4));
+            rowsPerBlock_ = static_cast<uint32>(get(header + 28, 4));
+            const uint64 numBlocks = get(header + 32, 8);
+            const uint64 indexOffset = get(header + 40, 8);
+
+            const uint64 expectedBlocks = numRows_ * numCols_ == 0 ? 0 : (numRows_ + rowsPerBlock_ - 1) / std::max(rowsPerBlock_, 1u);
+            if (rowsPerBlock_ == 0 || numBlocks != expectedBlocks || indexOffset > fileBytes ||
+                (fileBytes - indexOffset) / INDEX_ENTRY_BYTES < numBlocks)
+            {
+                fail(filename_, "has a corrupt header.");
+            }
+
+            std::vector<uint8> index(static_cast<size_t>(numBlocks * INDEX_ENTRY_BYTES));
+            file_->readAt(index.data(), index.size(), indexOffset);
+            blocks_.resize(static_cast<size_t>(numBlocks));
+            uint64 expectedOffset = HEADER_BYTES;
+            for (uint64 block = 0; block < numBlocks; ++block)
+            {
+                const uint8* entry = index.data() + block * INDEX_ENTRY_BYTES;
+                BlockEntry& blockEntry = blocks_[static_cast<size_t>(block)];
+                blockEntry.offset = get(entry, 8);
+                blockEntry.numBytes = get(entry + 8, 4);
+                blockEntry.codec = static_cast<Codec>(entry[12]);
+
+                // blocks are stored back to back so that a row range is one contiguous read
+                if (blockEntry.offset != expectedOffset || blockEntry.codec >= Codec::AUTO)
+                {
+                    fail(filename_, "has a corrupt block index.");
+                }
+                expectedOffset += blockEntry.numBytes;
+            }
+            if (expectedOffset > indexOffset)
+            {
+                fail(filename_, "has a corrupt block index.");
+            }
+        }
+
+        //============================================================================
+        /// 把数组按 inRowsPerBlock 行一块压缩保存，块在线程池中并行编码，
+        /// 编码下一批块与写出上一批重叠
+        ///
+        /// @param      inFilename
+        /// @param      inArray
+        /// @param      inCodec: 整数以外的 dtype 不能使用 Codec::DELTA_PACK
+        /// @param      inRowsPerBlock: 为 0 时取约 BLOCK_BYTES 字节的行数
+        ///
+        static void save(const std::string& inFilename, const NdArray<dtype>& inArray, Codec inCodec = Codec::AUTO, uint32 inRowsPerBlock = 0)
+        {
+            if (codec::resolve<dtype>(inCodec) == Codec::DELTA_PACK && !codec::packable<dtype>())
+            {
+                std::string errStr = "ERROR: CompressedArray::save: DELTA_PACK is only available for integer dtypes.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+
+            const Shape shape = inArray.shape();
+            const uint64 rowBytes = shape.cols * sizeof(dtype);
+            const uint32 rowsPerBlock = inRowsPerBlock != 0 ? inRowsPerBlock :
+                static_cast<uint32>(std::max<uint64>(1, std::min<uint64>(BLOCK_BYTES / std::max<uint64>(rowBytes, 1), 0xFFFFFFFF)));
+            // block sizes are stored in 32 bits
+            if (static_cast<uint64>(rowsPerBlock) * rowBytes > 0x7FFFFFFF)
+            {
+                std::string errStr = "ERROR: CompressedArray::save: a block of " + utils::num2str(rowsPerBlock) + " rows exceeds 2 GB.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+
+            const uint64 numBlocks = inArray.size() == 0 ? 0 : (shape.rows + rowsPerBlock - 1) / rowsPerBlock;
+            auto file = std::make_shared<const io::File>(inFilename, io::FileMode::WRITE);
+
+            const uint32 blocksPerRound = getNumThreads() * 4;
+            std::vector<std::vector<uint8> > buffers[2];
+            buffers[0].resize(static_cast<size_t>(std::min<uint64>(blocksPerRound, numBlocks)));
+            buffers[1].resize(buffers[0].size());
+            std::vector<std::vector<uint8> > scratch(getNumThreads());
+            std::vector<uint8> index(static_cast<size_t>(numBlocks * INDEX_ENTRY_BYTES), 0);
+
+            uint64 offset = HEADER_BYTES;
+            std::future<void> pending;
+            try
+            {
+                for (uint64 roundStart = 0, round = 0; roundStart < numBlocks; roundStart += blocksPerRound, ++round)
+                {
+                    const uint32 roundBlocks = static_cast<uint32>(std::min<uint64>(blocksPerRound, numBlocks - roundStart));
+                    std::vector<std::vector<uint8> >& roundBuffers = buffers[round % 2];
+                    ThreadPool::instance().parallelFor(roundBlocks, [&](uint32 inBlock, uint32 inThread)
+                    {
+                        const uint64 block = roundStart + inBlock;
+                        const uint64 firstRow = block * rowsPerBlock;
+                        const uint64 numRows = std::min<uint64>(rowsPerBlock, shape.rows - firstRow);
+                        const Codec used = codec::encodeBlock(inArray.cbegin() + firstRow * shape.cols, numRows * shape.cols,
+                            numRows > 1 ? shape.cols : numRows * shape.cols, inCodec, roundBuffers[inBlock], scratch[inThread]);
+                        index[static_cast<size_t>(block * INDEX_ENTRY_BYTES + 12)] = static_cast<uint8>(used);
+                    });
+
+                    std::vector<io::AsyncIo::Segment> segments(roundBlocks);
+                    for (uint32 i = 0; i < roundBlocks; ++i)
+                    {
+                        uint8* entry = index.data() + (roundStart + i) * INDEX_ENTRY_BYTES;
+                        put(entry, offset, 8);
+                        put(entry + 8, roundBuffers[i].size(), 4);
+                        segments[i] = { roundBuffers[i].data(), roundBuffers[i].size(), offset };
+                        offset += roundBuffers[i].size();
+                    }
+
+                    // the previous round used the other set of buffers
+                    if (pending.valid())
+                    {
+                        pending.get();
+                    }
+                    auto promise = std::make_shared<std::promise<void> >();
+                    pending = promise->get_future();
+                    io::AsyncIo::instance().submit(true, file, segments, [promise](std::exception_ptr inError)
+                    {
+                        inError != nullptr ? promise->set_exception(inError) : promise->set_value();
+                    });
+                }
+            }
+            catch (...)
+            {
+                // the buffers must outlive the write in flight
+                if (pending.valid())
+                {
+                    pending.wait();
+                }
+                throw;
+            }
+            if (pending.valid())
+            {
+                pending.get();
+            }
+
+            uint8 header[HEADER_BYTES] = {};
+            std::memcpy(header, magic(), 8);
+            const std::string descr = io::npyDescr<dtype>(Endian::LITTLE);
+            std::memcpy(header + 8, descr.data(), std::min<size_t>(descr.size(), 8));
+            put(header + 16, shape.rows, 8);
+            put(header + 24, shape.cols, 4);
+            put(header + 28, rowsPerBlock, 4);
+            put(header + 32, numBlocks, 8);
+            put(header + 40, offset, 8);
+
+            file->writeAt(index.data(), index.size(), offset);
+            file->writeAt(header, HEADER_BYTES, 0);
+        }
+
+        //============================================================================
+        /// 读取并解压整个数组
+        ///
+        /// @return     NdArray
+        ///
+        NdArray<dtype> read() const
+        {
+            return std::move(rows(0, numRows_));
+        }
+
+        //============================================================================
+        /// 读取第 inFirstRow 行起的 inNumRows 行，只读取并解压涉及的块。
+        /// 各批块在后台读取的同时在线程池中并行解压前一批
+        ///
+        /// @param      inFirstRow
+        /// @param      inNumRows
+        ///
+        /// @return     NdArray
+        ///
+        NdArray<dtype> rows(uint64 inFirstRow, uint64 inNumRows) const
+        {
+            if (inFirstRow > numRows_ || inNumRows > numRows_ - inFirstRow)
+            {
+                std::string errStr = "ERROR: CompressedArray::rows: rows [" + utils::num2str(inFirstRow) + ", " +
+                    utils::num2str(inFirstRow + inNumRows) + ") are out of bounds for " + utils::num2str(numRows_) + " rows.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+
+            NdArray<dtype> returnArray(inNumRows, numCols_);
+            if (returnArray.isempty())
+            {
+                return std::move(returnArray);
+            }
+
+            const uint64 lastRow = inFirstRow + inNumRows;
+            const uint64 firstBlock = inFirstRow / rowsPerBlock_;
+            const uint64 endBlock = (lastRow - 1) / rowsPerBlock_ + 1;
+
+            // each batch is a run of whole blocks, the first one at least
+            auto batchEnd = [this, endBlock](uint64 inStart) -> uint64
+            {
+                uint64 end = inStart + 1;
+                uint64 bytes = blocks_[static_cast<size_t>(inStart)].numBytes;
+                while (end < endBlock && bytes + blocks_[static_cast<size_t>(end)].numBytes <= BATCH_BYTES)
+                {
+                    bytes += blocks_[static_cast<size_t>(end)].numBytes;
+                    ++end;
+                }
+                return end;
+            };
+
+            std::vector<uint8> buffers[2];
+            auto readBatch = [this, &buffers](uint64 inStart, uint64 inEnd, uint32 inBuffer) -> std::future<void>
+            {
+                const BlockEntry& first = blocks_[static_cast<size_t>(inStart)];
+                const BlockEntry& last = blocks_[static_cast<size_t>(inEnd - 1)];
+                buffers[inBuffer].resize(static_cast<size_t>(last.offset + last.numBytes - first.offset));
+                return io::AsyncIo::instance().read(file_, buffers[inBuffer].data(), buffers[inBuffer].size(), first.offset);
+            };
+
+            // only the first and the last block can stick out of the range
+            std::vector<std::vector<uint8> > scratch(getNumThreads());
+            auto partialFor = [this, inFirstRow, lastRow](uint64 inBlock) -> uint32
+            {
+                return firstRowOf(inBlock) < inFirstRow ? rowsIn(inBlock) : (firstRowOf(inBlock) + rowsIn(inBlock) > lastRow ? rowsIn(inBlock) : 0);
+            };
+            NdArray<dtype> partials[2] = { NdArray<dtype>(partialFor(firstBlock), numCols_),
+                NdArray<dtype>(endBlock - 1 != firstBlock ? partialFor(endBlock - 1) : 0, numCols_) };
+
+            uint64 start = firstBlock;
+            uint64 end = batchEnd(start);
+            std::future<void> pending = readBatch(start, end, 0);
+            try
+            {
+                for (uint32 batch = 0; start < endBlock; ++batch)
+                {
+                    pending.get();
+                    const uint64 nextEnd = end < endBlock ? batchEnd(end) : end;
+                    if (end < endBlock)
+                    {
+                        pending = readBatch(end, nextEnd, (batch + 1) % 2);
+                    }
+
+                    const uint8* data = buffers[batch % 2].data();
+                    const uint64 batchOffset = blocks_[static_cast<size_t>(start)].offset;
+                    ThreadPool::instance().parallelFor(static_cast<uint32>(end - start), [&](uint32 inTask, uint32 inThread)
+                    {
+                        const uint64 block = start + inTask;
+                        const BlockEntry& entry = blocks_[static_cast<size_t>(block)];
+                        const uint64 blockFirstRow = firstRowOf(block);
+                        const uint32 blockRows = rowsIn(block);
+                        const uint64 numValues = static_cast<uint64>(blockRows) * numCols_;
+                        const uint64 stride = blockRows > 1 ? numCols_ : numValues;
+
+                        // blocks wholly inside the range decode straight into the result
+                        const bool whole = blockFirstRow >= inFirstRow && blockFirstRow + blockRows <= lastRow;
+                        dtype* target = returnArray.begin() + (std::max(blockFirstRow, inFirstRow) - inFirstRow) * numCols_;
+                        NdArray<dtype>& partial = partials[block == firstBlock ? 0 : 1];
+                        codec::decodeBlock(entry.codec, data + (entry.offset - batchOffset), entry.numBytes, numValues, stride,
+                            whole ? target : partial.begin(), scratch[inThread]);
+
+                        if (!whole)
+                        {
+                            const uint64 copyFirst = std::max(blockFirstRow, inFirstRow);
+                            const uint64 copyLast = std::min(blockFirstRow + blockRows, lastRow);
+                            std::copy(partial.cbegin() + (copyFirst - blockFirstRow) * numCols_,
+                                partial.cbegin() + (copyLast - blockFirstRow) * numCols_, target);
+                        }
+                    });
+
+                    start = end;
+                    end = nextEnd;
+                }
+            }
+            catch (...)
+            {
+                // the buffers must outlive the read in flight
+                if (pending.valid())
+                {
+                    pending.wait();
+                }
+                throw;
+            }
+
+            return std::move(returnArray);
+        }
+
+        //============================================================================
+        /// 所有块压缩后的总字节数
+        ///
+        /// @return     uint64
+        ///
+        uint64 compressedBytes() const noexcept
+        {
+            return blocks_.empty() ? 0 : blocks_.back().offset + blocks_.back().numBytes - HEADER_BYTES;
+        }
+
+        const std::string& filename() const noexcept
+        {
+            return filename_;
+        }
+
+        uint64 numBlocks() const noexcept
+        {
+            return blocks_.size();
+        }
+
+        uint32 numCols() const noexcept
+        {
+            return numCols_;
+        }
+
+        uint64 numRows() const noexcept
+        {
+            return numRows_;
+        }
+
+        uint32 rowsPerBlock() const noexcept
+        {
+            return rowsPerBlock_;
+        }
+    };
+}
@@ -0,0 +1,955 @@
+#pragma once
+
+#include"NumCpp/Gemm.hpp"
+#include"NumCpp/ThreadPool.hpp"
+#include"NumCpp/Types.hpp"
+
+#include<algorithm>
+#include<cmath>
+#include<vector>
+
+// 稠密矩阵分解（LU、Cholesky、QR）与三角求解内核，矩阵均为行主序、行距为 ld 的原地存储。
+// 采用右视分块算法：窄面板逐列分解，面板右侧的块用三角求解（QR 为紧凑 WY 形式的块反射）更新，
+// 右下角的尾部矩阵用 GEMM 做秩 nb 更新，O(n^3) 的计算量绝大部分落在分块并行的 GEMM 上
+namespace nc
+{
+    namespace decomp
+    {
+        // 面板宽度，即尾部更新的秩
+        constexpr uint64 BLOCK_SIZE = 64;
+
+        // 按列或按行划分并行任务时每个任务的列数或行数
+        constexpr uint64 CHUNK_SIZE = 256;
+
+        // 小于该计算量的三角求解在调用线程上完成
+        constexpr uint64 PARALLEL_MIN_FLOPS = 64 * 64 * 64;
+
+        // 右端项少于该列数时三角求解不分块
+        constexpr uint64 GEMM_MIN_COLS = 8;
+
+        //============================================================================
+        /// 把 [0, inCount) 按 CHUNK_SIZE 划分为互不重叠的任务，对每个区间调用
+        /// inFunction(first, last)，计算量 inFlops 较小时在调用线程上串行执行
+        ///
+        /// @param      inCount
+        /// @param      inFlops
+        /// @param      inFunction
+        ///
+        template<typename Function>
+        void forEachChunk(uint64 inCount, uint64 inFlops, const Function& inFunction)
+        {
+            const uint64 numChunks = (inCount + CHUNK_SIZE - 1) / CHUNK_SIZE;
+            auto chunkTask = [inCount, &inFunction](uint32 inChunk, uint32)
+            {
+                const uint64 first = static_cast<uint64>(inChunk) * CHUNK_SIZE;
+                inFunction(first, std::min(inCount, first + CHUNK_SIZE));
+            };
+
+            if (numChunks <= 1 || inFlops < PARALLEL_MIN_FLOPS)
+            {
+                for (uint64 chunk = 0; chunk < numChunks; ++chunk)
+                {
+                    chunkTask(static_cast<uint32>(chunk), 0);
+                }
+            }
+            else
+            {
+                ThreadPool::instance().parallelFor(static_cast<uint32>(numChunks), chunkTask);
+            }
+        }
+
+        //============================================================================
+        /// inA[0..inN) 与间隔 inStrideB 的 inB 的内积，四路独立累加以隐藏浮点加法延迟
+        ///
+        /// @param      inA
+        /// @param      inB
+        /// @param      inStrideB
+        /// @param      inN
+        ///
+        /// @return     dtype
+        ///
+        template<typename dtype>
+        dtype dot(const dtype* inA, const dtype* inB, uint64 inStrideB, uint64 inN) noexcept
+        {
+            dtype sums[4] = {};
+            uint64 i = 0;
+            for (; i + 4 <= inN; i += 4)
+            {
+                sums[0] += inA[i] * inB[i * inStrideB];
+                sums[1] += inA[i + 1] * inB[(i + 1) * inStrideB];
+                sums[2] += inA[i + 2] * inB[(i + 2) * inStrideB];
+                sums[3] += inA[i + 3] * inB[(i + 3) * inStrideB];
+            }
+            for (; i < inN; ++i)
+            {
+                sums[0] += inA[i] * inB[i * inStrideB];
+            }
+
+            return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+        }
+
+        //============================================================================
+        /// 不分块的前代：求解 L * X = B，L 为 inN x inN 的下三角矩阵（只读取下三角部分，
+        /// inUnitDiagonal 为 true 时对角元视为 1 且不读取），B 为 inN x inCols，结果 X 覆盖 B。
+        /// 用于 BLOCK_SIZE 以内的对角块和列数很少的右端项，按列分块并行
+        ///
+        /// @param      inN
+        /// @param      inCols
+        /// @param      inL
+        /// @param      inLdl
+        /// @param      ioB
+        /// @param      inLdb
+        /// @param      inUnitDiagonal
+        ///
+        template<typename dtype>
+        void lowerKernel(uint64 inN, uint64 inCols, const dtype* inL, uint64 inLdl, dtype* ioB, uint64 inLdb, bool inUnitDiagonal)
+        {
+            if (inCols == 1)
+            {
+                // 单个右端项按行做内积，L 按行连续访问
+                for (uint64 i = 0; i < inN; ++i)
+                {
+                    const dtype value = ioB[i * inLdb] - dot(inL + i * inLdl, ioB, inLdb, i);
+                    ioB[i * inLdb] = inUnitDiagonal ? value : value / inL[i * inLdl + i];
+                }
+                return;
+            }
+
+            forEachChunk(inCols, inN * inN * inCols, [=](uint64 inFirst, uint64 inLast) noexcept
+            {
+                for (uint64 i = 0; i < inN; ++i)
+                {
+                    dtype* row = ioB + i * inLdb;
+                    for (uint64 p = 0; p < i; ++p)
+                    {
+                        const dtype l = inL[i * inLdl + p];
+                        if (l == static_cast<dtype>(0))
+                        {
+                            continue;
+                        }
+
+                        const dtype* rowP = ioB + p * inLdb;
+                        for (uint64 col = inFirst; col < inLast; ++col)
+                        {
+                            row[col] -= l * rowP[col];
+                        }
+                    }
+
+                    if (!inUnitDiagonal)
+                    {
+                        const dtype diag = inL[i * inLdl + i];
+                        for (uint64 col = inFirst; col < inLast; ++col)
+                        {
+                            row[col] /= diag;
+                        }
+                    }
+                }
+            });
+        }
+
+        //============================================================================
+        /// 不分块的回代：求解 U * X = B，U 为 inN x inN 的上三角矩阵（只读取上三角部分），
+        /// B 为 inN x inCols，结果 X 覆盖 B。用于 BLOCK_SIZE 以内的对角块和列数很少的右端项，按列分块并行
+        ///
+        /// @param      inN
+        /// @param      inCols
+        /// @param      inU
+        /// @param      inLdu
+        /// @param      ioB
+        /// @param      inLdb
+        ///
+        template<typename dtype>
+        void upperKernel(uint64 inN, uint64 inCols, const dtype* inU, uint64 inLdu, dtype* ioB, uint64 inLdb)
+        {
+            if (inCols == 1)
+            {
+                for (uint64 i = inN; i-- > 0;)
+                {
+                    const dtype value = ioB[i * inLdb] - dot(inU + i * inLdu + i + 1, ioB + (i + 1) * inLdb, inLdb, inN - i - 1);
+                    ioB[i * inLdb] = value / inU[i * inLdu + i];
+                }
+                return;
+            }
+
+            forEachChunk(inCols, inN * inN * inCols, [=](uint64 inFirst, uint64 inLast) noexcept
+            {
+                for (uint64 i = inN; i-- > 0;)
+                {
+                    dtype* row = ioB + i * inLdb;
+                    for (uint64 p = i + 1; p < inN; ++p)
+                    {
+                        const dtype u = inU[i * inLdu + p];
+                        if (u == static_cast<dtype>(0))
+                        {
+                            continue;
+                        }
+
+                        const dtype* rowP = ioB + p * inLdb;
+                        for (uint64 col = inFirst; col < inLast; ++col)
+                        {
+                            row[col] -= u * rowP[col];
+                        }
+                    }
+
+                    const dtype diag = inU[i * inLdu + i];
+                    for (uint64 col = inFirst; col < inLast; ++col)
+                    {
+                        row[col] /= diag;
+                    }
+                }
+            });
+        }
+
+        //============================================================================
+        /// 分块前代：求解 L * X = B，L 为 inN x inN 的下三角矩阵，B 为 inN x inCols，
+        /// 结果 X 覆盖 B。对角块用 lowerKernel 求解，其下方的行用 GEMM 更新；
+        /// 右端项只有几列时 GEMM 的打包开销与计算量相当，直接用 lowerKernel 求解
+        ///
+        /// @param      inN
+        /// @param      inCols
+        /// @param      inL
+        /// @param      inLdl
+        /// @param      ioB
+        /// @param      inLdb
+        /// @param      inUnitDiagonal
+        ///
+        template<typename dtype>
+        void solveLower(uint64 inN, uint64 inCols, const dtype* inL, uint64 inLdl, dtype* ioB, uint64 inLdb, bool inUnitDiagonal)
+        {
+            if (inCols < GEMM_MIN_COLS)
+            {
+                lowerKernel(inN, inCols, inL, inLdl, ioB, inLdb, inUnitDiagonal);
+                return;
+            }
+
+            for (uint64 k = 0; k < inN; k += BLOCK_SIZE)
+            {
+                const uint64 nb = std::min(BLOCK_SIZE, inN - k);
+                lowerKernel(nb, inCols, inL + k * inLdl + k, inLdl, ioB + k * inLdb, inLdb, inUnitDiagonal);
+
+                const uint64 next = k + nb;
+                gemm::gemm(inN - next, inCols, nb, inL + next * inLdl + k, inLdl, ioB + k * inLdb, inLdb,
+                    ioB + next * inLdb, inLdb, static_cast<dtype>(-1), true);
+            }
+        }
+
+        //============================================================================
+        /// 分块回代：求解 U * X = B，U 为 inN x inN 的上三角矩阵，B 为 inN x inCols，
+        /// 结果 X 覆盖 B。从最后一个对角块开始，对角块用 upperKernel 求解，其上方的行用 GEMM 更新；
+        /// 右端项只有几列时直接用 upperKernel 求解
+        ///
+        /// @param      inN
+        /// @param      inCols
+        /// @param      inU
+        /// @param      inLdu
+        /// @param      ioB
+        /// @param      inLdb
+        ///
+        template<typename dtype>
+        void solveUpper(uint64 inN, uint64 inCols, const dtype* inU, uint64 inLdu, dtype* ioB, uint64 inLdb)
+        {
+            if (inCols < GEMM_MIN_COLS)
+            {
+                upperKernel(inN, inCols, inU, inLdu, ioB, inLdb);
+                return;
+            }
+            if (inN == 0)
+            {
+                return;
+            }
+
+            for (uint64 k = (inN - 1) / BLOCK_SIZE * BLOCK_SIZE;; k -= BLOCK_SIZE)
+            {
+                const uint64 nb = std::min(BLOCK_SIZE, inN - k);
+                upperKernel(nb, inCols, inU + k * inLdu + k, inLdu, ioB + k * inLdb, inLdb);
+                gemm::gemm(k, inCols, nb, inU + k, inLdu, ioB + k * inLdb, inLdb,
+                    ioB, inLdb, static_cast<dtype>(-1), true);
+
+                if (k == 0)
+                {
+                    break;
+                }
+            }
+        }
+
+        //============================================================================
+        /// 列部分选主元分解面板，即第 inK 至 inK + inNb 列、第 inK 行以下的部分。
+        /// 选出的主元行与整行（包括左侧已分解的 L 和右侧尚未更新的列）交换
+        ///
+        /// @param      inN
+        /// @param      inK
+        /// @param      inNb
+        /// @param      ioA
+        /// @param      inLda
+        /// @param      outPivots
+        ///
+        /// @return     uint64: 0，或第一个为零的主元的下标加 1
+        ///
+        template<typename dtype>
+        uint64 luPanel(uint64 inN, uint64 inK, uint64 inNb, dtype* ioA, uint64 inLda, uint64* outPivots) noexcept
+        {
+            uint64 info = 0;
+            const uint64 end = inK + inNb;
+            for (uint64 j = inK; j < end; ++j)
+            {
+                uint64 pivot = j;
+                dtype best = std::abs(ioA[j * inLda + j]);
+                for (uint64 i = j + 1; i < inN; ++i)
+                {
+                    const dtype value = std::abs(ioA[i * inLda + j]);
+                    if (value > best)
+                    {
+                        best = value;
+                        pivot = i;
+                    }
+                }
+
+                outPivots[j] = pivot;
+                if (pivot != j)
+                {
+                    std::swap_ranges(ioA + j * inLda, ioA + j * inLda + inN, ioA + pivot * inLda);
+                }
+
+                const dtype* rowJ = ioA + j * inLda;
+                const dtype diag = rowJ[j];
+                if (diag == static_cast<dtype>(0))
+                {
+                    // 该列已全为零，跳过消元继续分解，行列式为零
+                    if (info == 0)
+                    {
+                        info = j + 1;
+                    }
+                    continue;
+                }
+
+                for (uint64 i = j + 1; i < inN; ++i)
+                {
+                    dtype* row = ioA + i * inLda;
+                    const dtype l = row[j] / diag;
+                    row[j] = l;
+                    if (l == static_cast<dtype>(0))
+                    {
+                        continue;
+                    }
+
+                    for (uint64 col = j + 1; col < end; ++col)
+                    {
+                        row[col] -= l * rowJ[col];
+                    }
+                }
+            }
+
+            return info;
+        }
+
+        //============================================================================
+        /// 原地分块 LU 分解 P * A = L * U（列部分选主元），A 为 inN x inN。
+        /// 分解后 A 的严格下三角为单位下三角矩阵 L，上三角为 U；
+        /// outPivots[i] 为第 i 步与第 i 行交换的行，依次执行这些交换即得到 P * A
+        ///
+        /// @param      inN
+        /// @param      ioA
+        /// @param      inLda
+        /// @param      outPivots: 长度为 inN
+        ///
+        /// @return     uint64: 0 表示非奇异，否则为第一个为零的主元的下标加 1
+        ///
+        template<typename dtype>
+        uint64 lu(uint64 inN, dtype* ioA, uint64 inLda, uint64* outPivots)
+        {
+            uint64 info = 0;
+            for (uint64 k = 0; k < inN; k += BLOCK_SIZE)
+            {
+                const uint64 nb = std::min(BLOCK_SIZE, inN - k);
+                const uint64 panelInfo = luPanel(inN, k, nb, ioA, inLda, outPivots);
+                if (info == 0 && panelInfo != 0)
+                {
+                    info = panelInfo;
+                }
+
+                const uint64 next = k + nb;
+                if (next == inN)
+                {
+                    break;
+                }
+
+                // U12 = L11^-1 * A12，A22 -= L21 * U12
+                lowerKernel(nb, inN - next, ioA + k * inLda + k, inLda, ioA + k * inLda + next, inLda, true);
+                gemm::gemm(inN - next, inN - next, nb, ioA + next * inLda + k, inLda, ioA + k * inLda + next, inLda,
+                    ioA + next * inLda + next, inLda, static_cast<dtype>(-1), true);
+            }
+
+            return info;
+        }
+
+        //============================================================================
+        /// 由 lu 的分解结果求逆 A^-1 = U^-1 * L^-1 * P，写入 inN x inN 的 outInv。
+        /// L^-1 仍为单位下三角，求解时跳过单位阵右上方始终为零的部分，
+        /// 连同 LU 分解总计算量约为 2n^3，与 LAPACK 的 getrf + getri 相同
+        ///
+        /// @param      inN
+        /// @param      inLu
+        /// @param      inLdLu
+        /// @param      inPivots
+        /// @param      outInv
+        /// @param      inLdInv
+        ///
+        template<typename dtype>
+        void luInverse(uint64 inN, const dtype* inLu, uint64 inLdLu, const uint64* inPivots, dtype* outInv, uint64 inLdInv)
+        {
+            for (uint64 i = 0; i < inN; ++i)
+            {
+                std::fill(outInv + i * inLdInv, outInv + i * inLdInv + inN, static_cast<dtype>(0));
+                outInv[i * inLdInv + i] = static_cast<dtype>(1);
+            }
+
+            // X = L^-1：第 k 个块行只有前 k + nb 列非零
+            for (uint64 k = 0; k < inN; k += BLOCK_SIZE)
+            {
+                const uint64 nb = std::min(BLOCK_SIZE, inN - k);
+                const uint64 next = k + nb;
+                lowerKernel(nb, next, inLu + k * inLdLu + k, inLdLu, outInv + k * inLdInv, inLdInv, true);
+                gemm::gemm(inN - next, next, nb, inLu + next * inLdLu + k, inLdLu, outInv + k * inLdInv, inLdInv,
+                    outInv + next * inLdInv, inLdInv, static_cast<dtype>(-1), true);
+            }
+
+            // X = U^-1 * L^-1
+            solveUpper(inN, inN, inLu, inLdLu, outInv, inLdInv);
+
+            // X * P：逆序交换各列，逐行进行使访问连续
+            forEachChunk(inN, inN * inN, [=](uint64 inFirst, uint64 inLast) noexcept
+            {
+                for (uint64 i = inFirst; i < inLast; ++i)
+                {
+                    dtype* row = outInv + i * inLdInv;
+                    for (uint64 j = inN; j-- > 0;)
+                    {
+                        if (inPivots[j] != j)
+                        {
+                            std::swap(row[j], row[inPivots[j]]);
+                        }
+                    }
+                }
+            });
+        }
+
+        //============================================================================
+        /// 不分块的 Cholesky 分解 A = L * L^T，只读写 inN x inN 的 A 的下三角部分
+        ///
+        /// @param      inN
+        /// @param      ioA
+        /// @param      inLda
+        ///
+        /// @return     uint64: 0，或第一个非正主元的下标加 1
+        ///
+        template<typename dtype>
+        uint64 choleskyKernel(uint64 inN, dtype* ioA, uint64 inLda) noexcept
+        {
+            for (uint64 j = 0; j < inN; ++j)
+            {
+                dtype* rowJ = ioA + j * inLda;
+                dtype diag = rowJ[j];
+                for (uint64 p = 0; p < j; ++p)
+                {
+                    diag -= rowJ[p] * rowJ[p];
+                }
+                if (!(diag > static_cast<dtype>(0)))
+                {
+                    return j + 1;
+                }
+
+                diag = std::sqrt(diag);
+                rowJ[j] = diag;
+                for (uint64 i = j + 1; i < inN; ++i)
+                {
+                    dtype* row = ioA + i * inLda;
+                    dtype value = row[j];
+                    for (uint64 p = 0; p < j; ++p)
+                    {
+                        value -= row[p] * rowJ[p];
+                    }
+                    row[j] = value / diag;
+                }
+            }
+
+            return 0;
+        }
+
+        //============================================================================
+        /// 原地分块 Cholesky 分解 A = L * L^T，A 为 inN x inN 的对称正定矩阵，
+        /// 只读写下三角部分，分解后下三角为 L。面板右侧的 L21 = A21 * L11^-T 按行并行求解，
+        /// 尾部的 A22 -= L21 * L21^T 按列块只更新下三角，交给 GEMM
+        ///
+        /// @param      inN
+        /// @param      ioA
+        /// @param      inLda
+        ///
+        /// @return     uint64: 0 表示正定，否则为第一个非正主元的下标加 1
+        ///
+        template<typename dtype>
+        uint64 cholesky(uint64 inN, dtype* ioA, uint64 inLda)
+        {
+            for (uint64 k = 0; k < inN; k += BLOCK_SIZE)
+            {
+                const uint64 nb = std::min(BLOCK_SIZE, inN - k);
+                dtype* diagBlock = ioA + k * inLda + k;
+                const uint64 blockInfo = choleskyKernel(nb, diagBlock, inLda);
+                if (blockInfo != 0)
+                {
+                    return k + blockInfo;
+                }
+
+                const uint64 next = k + nb;
+                if (next == inN)
+                {
+                    break;
+                }
+
+                forEachChunk(inN - next, (inN - next) * nb * nb, [=](uint64 inFirst, uint64 inLast) noexcept
+                {
+                    for (uint64 i = next + inFirst; i < next + inLast; ++i)
+                    {
+                        dtype* row = ioA + i * inLda + k;
+                        for (uint64 j = 0; j < nb; ++j)
+                        {
+                            const dtype* rowJ = diagBlock + j * inLda;
+                            dtype value = row[j];
+                            for (uint64 p = 0; p < j; ++p)
+                            {
+                                value -= row[p] * rowJ[p];
+                            }
+                            row[j] = value / rowJ[j];
+                        }
+                    }
+                });
+
+                for (uint64 col = next; col < inN; col += CHUNK_SIZE)
+                {
+                    const uint64 width = std::min(CHUNK_SIZE, inN - col);
+                    gemm::gemm(inN - col, width, nb, ioA + col * inLda + k, inLda, 1u, ioA + col * inLda + k, 1u, inLda,
+                        ioA + col * inLda + col, inLda, static_cast<dtype>(-1), true);
+                }
+            }
+
+            return 0;
+        }
+
+        //============================================================================
+        /// 把 Householder 反射 H = I - tau * v * v^T 作用到 B 的 inRows x inCols 块上（B = H * B）。
+        /// v 的首元为 1 不存储，其余元素从 inV 开始、间隔 inStrideV。按列分块并行，
+        /// ioWork 至少 inCols 个元素，各列块使用互不重叠的部分
+        ///
+        /// @param      inRows
+        /// @param      inCols
+        /// @param      inV
+        /// @param      inStrideV
+        /// @param      inTau
+        /// @param      ioB
+        /// @param      inLdb
+        /// @param      ioWork
+        ///
+        template<typename dtype>
+        void applyReflector(uint64 inRows, uint64 inCols, const dtype* inV, uint64 inStrideV, dtype inTau,
+            dtype* ioB, uint64 inLdb, dtype* ioWork)
+        {
+            if (inTau == static_cast<dtype>(0))
+            {
+                return;
+            }
+
+            forEachChunk(inCols, 4 * inRows * inCols, [=](uint64 inFirst, uint64 inLast) noexcept
+            {
+                // w = v^T * B，B -= tau * v * w^T
+                std::copy(ioB + inFirst, ioB + inLast, ioWork + inFirst);
+                for (uint64 i = 1; i < inRows; ++i)
+                {
+                    const dtype v = inV[(i - 1) * inStrideV];
+                    const dtype* row = ioB + i * inLdb;
+                    for (uint64 col = inFirst; col < inLast; ++col)
+                    {
+                        ioWork[col] += v * row[col];
+                    }
+                }
+
+                for (uint64 col = inFirst; col < inLast; ++col)
+                {
+                    ioWork[col] *= inTau;
+                    ioB[col] -= ioWork[col];
+                }
+                for (uint64 i = 1; i < inRows; ++i)
+                {
+                    const dtype v = inV[(i - 1) * inStrideV];
+                    dtype* row = ioB + i * inLdb;
+                    for (uint64 col = inFirst; col < inLast; ++col)
+                    {
+                        row[col] -= v * ioWork[col];
+                    }
+                }
+            });
+        }
+
+        //============================================================================
+        /// 生成 Householder 反射 H = I - tau * v * v^T，使 H * x = beta * e_0。x 为从 ioX 开始、
+        /// 间隔 inStride 的 inLength 个元素，返回后 x 的首元为 beta，其余为 v 的对应元素（v 的首元为 1）。
+        /// x 除首元外全为零时 tau 为 0，即 H = I
+        ///
+        /// @param      inLength
+        /// @param      ioX
+        /// @param      inStride
+        ///
+        /// @return     dtype: tau
+        ///
+        template<typename dtype>
+        dtype makeReflector(uint64 inLength, dtype* ioX, uint64 inStride) noexcept
+        {
+            // 先按最大绝对值缩放再求范数，避免平方和溢出
+            dtype maxAbs = 0;
+            for (uint64 i = 1; i < inLength; ++i)
+            {
+                maxAbs = std::max(maxAbs, std::abs(ioX[i * inStride]));
+            }
+            if (maxAbs == static_cast<dtype>(0))
+            {
+                return static_cast<dtype>(0);
+            }
+
+            const dtype alpha = ioX[0];
+            maxAbs = std::max(maxAbs, std::abs(alpha));
+            dtype sumSquares = 0;
+            for (uint64 i = 0; i < inLength; ++i)
+            {
+                const dtype scaled = ioX[i * inStride] / maxAbs;
+                sumSquares += scaled * scaled;
+            }
+
+            const dtype norm = maxAbs * std::sqrt(sumSquares);
+            const dtype beta = alpha > static_cast<dtype>(0) ? -norm : norm;
+            const dtype scale = static_cast<dtype>(1) / (alpha - beta);
+            for (uint64 i = 1; i < inLength; ++i)
+            {
+                ioX[i * inStride] *= scale;
+            }
+            ioX[0] = beta;
+
+            return (beta - alpha) / beta;
+        }
+
+        //============================================================================
+        /// 不分块的 Householder QR 分解，用于宽度不超过 BLOCK_SIZE 的面板。
+        /// 分解后上三角为 R，第 j 个反射向量存放在第 j 列对角线以下（首元 1 不存储）
+        ///
+        /// @param      inM
+        /// @param      inN
+        /// @param      ioA
+        /// @param      inLda
+        /// @param      outTau: 长度为 min(inM, inN)
+        ///
+        template<typename dtype>
+        void qrKernel(uint64 inM, uint64 inN, dtype* ioA, uint64 inLda, dtype* outTau)
+        {
+            const uint64 numReflectors = std::min(inM, inN);
+            std::vector<dtype> work(inN);
+            for (uint64 j = 0; j < numReflectors; ++j)
+            {
+                dtype* column = ioA + j * inLda + j;
+                outTau[j] = makeReflector(inM - j, column, inLda);
+                applyReflector(inM - j, inN - j - 1, column + inLda, inLda, outTau[j], column + 1, inLda, work.data());
+            }
+        }
+
+        //============================================================================
+        /// 把面板中存放的 inNb 个反射向量展开为显式的 V（inRows x inNb，行距 inNb），
+        /// 对角元为 1，对角线以上为 0
+        ///
+        /// @param      inRows
+        /// @param      inNb
+        /// @param      inPanel
+        /// @param      inLda
+        /// @param      outV
+        ///
+        template<typename dtype>
+        void expandReflectors(uint64 inRows, uint64 inNb, const dtype* inPanel, uint64 inLda, dtype* outV) noexcept
+        {
+            for (uint64 i = 0; i < inRows; ++i)
+            {
+                const uint64 lower = std::min(i, inNb);
+                std::copy(inPanel + i * inLda, inPanel + i * inLda + lower, outV + i * inNb);
+                std::fill(outV + i * inNb + lower, outV + (i + 1) * inNb, static_cast<dtype>(0));
+                if (i < inNb)
+                {
+                    outV[i * inNb + i] = static_cast<dtype>(1);
+                }
+            }
+        }
+
+        //============================================================================
+        /// 紧凑 WY 表示：构造 inNb x inNb 的上三角矩阵 T，使 H_0 * H_1 * ... = I - V * T * V^T
+        ///
+        /// @param      inRows
+        /// @param      inNb
+        /// @param      inV: expandReflectors 展开的 V
+        /// @param      inTau
+        /// @param      outT
+        ///
+        template<typename dtype>
+        void reflectorTriangle(uint64 inRows, uint64 inNb, const dtype* inV, const dtype* inTau, dtype* outT)
+        {
+            std::fill(outT, outT + inNb * inNb, static_cast<dtype>(0));
+            std::vector<dtype> z(inNb);
+            for (uint64 i = 0; i < inNb; ++i)
+            {
+                outT[i * inNb + i] = inTau[i];
+                if (inTau[i] == static_cast<dtype>(0))
+                {
+                    continue;
+                }
+
+                // z = V(:, 0:i)^T * v_i，v_i 在第 i 行以上为零
+                std::fill(z.begin(), z.begin() + i, static_cast<dtype>(0));
+                for (uint64 r = i; r < inRows; ++r)
+                {
+                    const dtype* row = inV + r * inNb;
+                    const dtype v = row[i];
+                    for (uint64 p = 0; p < i; ++p)
+                    {
+                        z[p] += row[p] * v;
+                    }
+                }
+
+                // T(0:i, i) = -tau_i * T(0:i, 0:i) * z
+                for (uint64 p = 0; p < i; ++p)
+                {
+                    dtype value = 0;
+                    for (uint64 q = p; q < i; ++q)
+                    {
+                        value += outT[p * inNb + q] * z[q];
+                    }
+                    outT[p * inNb + i] = -inTau[i] * value;
+                }
+            }
+        }
+
+        //============================================================================
+        /// 把块反射 H = I - V * T * V^T 作用到 B 的 inRows x inCols 块上：inTranspose 为 false 时
+        /// B = H * B，为 true 时 B = H^T * B。W = V^T * B 和 B -= V * (T * W) 两次乘法交给 GEMM
+        ///
+        /// @param      inRows
+        /// @param      inCols
+        /// @param      inNb
+        /// @param      inV
+        /// @param      inT
+        /// @param      inTranspose
+        /// @param      ioB
+        /// @param      inLdb
+        /// @param      ioWork: 至少 inNb * inCols 个元素
+        ///
+        template<typename dtype>
+        void applyBlockReflector(uint64 inRows, uint64 inCols, uint64 inNb, const dtype* inV, const dtype* inT,
+            bool inTranspose, dtype* ioB, uint64 inLdb, dtype* ioWork)
+        {
+            gemm::gemm(inNb, inCols, inRows, inV, 1u, inNb, ioB, inLdb, 1u, ioWork, inCols);
+
+            // W = T * W（T 为上三角，按行升序原地计算）或 W = T^T * W（按行降序）
+            forEachChunk(inCols, inNb * inNb * inCols, [=](uint64 inFirst, uint64 inLast) noexcept
+            {
+                for (uint64 s = 0; s < inNb; ++s)
+                {
+                    const uint64 i = inTranspose ? inNb - 1 - s : s;
+                    dtype* rowI = ioWork + i * inCols;
+                    const dtype diag = inT[i * inNb + i];
+                    for (uint64 col = inFirst; col < inLast; ++col)
+                    {
+                        rowI[col] *= diag;
+                    }
+
+                    const uint64 first = inTranspose ? 0 : i + 1;
+                    const uint64 last = inTranspose ? i : inNb;
+                    for (uint64 p = first; p < last; ++p)
+                    {
+                        const dtype t = inTranspose ? inT[p * inNb + i] : inT[i * inNb + p];
+                        if (t == static_cast<dtype>(0))
+                        {
+                            continue;
+                        }
+
+                        const dtype* rowP = ioWork + p * inCols;
+                        for (uint64 col = inFirst; col < inLast; ++col)
+                        {
+                            rowI[col] += t * rowP[col];
+                        }
+                    }
+                }
+            });
+
+            gemm::gemm(inRows, inCols, inNb, inV, inNb, ioWork, inCols, ioB, inLdb, static_cast<dtype>(-1), true);
+        }
+
+        //============================================================================
+        /// 原地分块 Householder QR 分解 A = Q * R，A 为 inM x inN。分解后上三角为 R，
+        /// 第 j 个反射向量存放在第 j 列对角线以下（首元 1 不存储），outTau 长度为 min(inM, inN)。
+        /// 每个 BLOCK_SIZE 宽的面板用 qrKernel 分解，再以紧凑 WY 形式的块反射更新右侧的尾部矩阵
+        ///
+        /// @param      inM
+        /// @param      inN
+        /// @param      ioA
+        /// @param      inLda
+        /// @param      outTau
+        ///
+        template<typename dtype>
+        void qr(uint64 inM, uint64 inN, dtype* ioA, uint64 inLda, dtype* outTau)
+        {
+            const uint64 numReflectors = std::min(inM, inN);
+            std::vector<dtype> v;
+            std::vector<dtype> t(BLOCK_SIZE * BLOCK_SIZE);
+            std::vector<dtype> work;
+            for (uint64 j = 0; j < numReflectors; j += BLOCK_SIZE)
+            {
+                const uint64 nb = std::min(BLOCK_SIZE, numReflectors - j);
+                dtype* panel = ioA + j * inLda + j;
+                qrKernel(inM - j, nb, panel, inLda, outTau + j);
+
+                const uint64 next = j + nb;
+                if (next == inN)
+                {
+                    break;
+                }
+
+                v.resize((inM - j) * nb);
+                work.resize(nb * (inN - next));
+                expandReflectors(inM - j, nb, panel, inLda, v.data());
+                reflectorTriangle(inM - j, nb, v.data(), outTau + j, t.data());
+                applyBlockReflector(inM - j, inN - next, nb, v.data(), t.data(), true, panel + nb, inLda, work.data());
+            }
+        }
+
+        //============================================================================
+        /// 把 qr 的前 inNumReflectors 个反射组成的 Q（或 Q^T）作用到 inM x inCols 的 B 上。
+        /// 右端项较多时逐块以块反射作用，只有几列时逐个反射作用
+        ///
+        /// @param      inM
+        /// @param      inNumReflectors
+        /// @param      inQr
+        /// @param      inLdQr
+        /// @param      inTau
+        /// @param      inTranspose: true 时 B = Q^T * B，否则 B = Q * B
+        /// @param      ioB
+        /// @param      inCols
+        /// @param      inLdb
+        ///
+        template<typename dtype>
+        void applyHouseholder(uint64 inM, uint64 inNumReflectors, const dtype* inQr, uint64 inLdQr, const dtype* inTau,
+            bool inTranspose, dtype* ioB, uint64 inCols, uint64 inLdb)
+        {
+            const uint64 numBlocks = (inNumReflectors + BLOCK_SIZE - 1) / BLOCK_SIZE;
+            if (inCols < GEMM_MIN_COLS)
+            {
+                std::vector<dtype> work(inCols);
+                for (uint64 s = 0; s < inNumReflectors; ++s)
+                {
+                    const uint64 j = inTranspose ? s : inNumReflectors - 1 - s;
+                    applyReflector(inM - j, inCols, inQr + (j + 1) * inLdQr + j, inLdQr, inTau[j], ioB + j * inLdb, inLdb, work.data());
+                }
+                return;
+            }
+
+            std::vector<dtype> v;
+            std::vector<dtype> t(BLOCK_SIZE * BLOCK_SIZE);
+            std::vector<dtype> work(BLOCK_SIZE * inCols);
+            for (uint64 s = 0; s < numBlocks; ++s)
+            {
+                const uint64 j = (inTranspose ? s : numBlocks - 1 - s) * BLOCK_SIZE;
+                const uint64 nb = std::min(BLOCK_SIZE, inNumReflectors - j);
+                v.resize((inM - j) * nb);
+                expandReflectors(inM - j, nb, inQr + j * inLdQr + j, inLdQr, v.data());
+                reflectorTriangle(inM - j, nb, v.data(), inTau + j, t.data());
+                applyBlockReflector(inM - j, inCols, nb, v.data(), t.data(), inTranspose, ioB + j * inLdb, inLdb, work.data());
+            }
+        }
+
+        //============================================================================
+        /// B = Q^T * B，Q 由 qr 的前 inNumReflectors 个反射给出，B 为 inM x inCols
+        ///
+        /// @param      inM
+        /// @param      inNumReflectors
+        /// @param      inQr
+        /// @param      inLdQr
+        /// @param      inTau
+        /// @param      ioB
+        /// @param      inCols
+        /// @param      inLdb
+        ///
+        template<typename dtype>
+        void applyQt(uint64 inM, uint64 inNumReflectors, const dtype* inQr, uint64 inLdQr, const dtype* inTau,
+            dtype* ioB, uint64 inCols, uint64 inLdb)
+        {
+            applyHouseholder(inM, inNumReflectors, inQr, inLdQr, inTau, true, ioB, inCols, inLdb);
+        }
+
+        //============================================================================
+        /// B = Q * B，Q 由 qr 的前 inNumReflectors 个反射给出，B 为 inM x inCols
+        ///
+        /// @param      inM
+        /// @param      inNumReflectors
+        /// @param      inQr
+        /// @param      inLdQr
+        /// @param      inTau
+        /// @param      ioB
+        /// @param      inCols
+        /// @param      inLdb
+        ///
+        template<typename dtype>
+        void applyQ(uint64 inM, uint64 inNumReflectors, const dtype* inQr, uint64 inLdQr, const dtype* inTau,
+            dtype* ioB, uint64 inCols, uint64 inLdb)
+        {
+            applyHouseholder(inM, inNumReflectors, inQr, inLdQr, inTau, false, ioB, inCols, inLdb);
+        }
+
+        //============================================================================
+        /// 由 qr 的结果原地生成 Q 的前 inK 列（inM x inK，inK <= min(inM, inN)），覆盖 A 的前 inK 列。
+        /// 从最后一块反射开始向前，第 j 块只作用于第 j 列以后的部分，其左侧各列仍是单位阵
+        ///
+        /// @param      inM
+        /// @param      inK
+        /// @param      ioA
+        /// @param      inLda
+        /// @param      inTau
+        ///
+        template<typename dtype>
+        void formQ(uint64 inM, uint64 inK, dtype* ioA, uint64 inLda, const dtype* inTau)
+        {
+            if (inK == 0)
+            {
+                return;
+            }
+
+            std::vector<dtype> v;
+            std::vector<dtype> t(BLOCK_SIZE * BLOCK_SIZE);
+            std::vector<dtype> work(BLOCK_SIZE * inK);
+            for (uint64 j = (inK - 1) / BLOCK_SIZE * BLOCK_SIZE;; j -= BLOCK_SIZE)
+            {
+                const uint64 nb = std::min(BLOCK_SIZE, inK - j);
+                dtype* panel = ioA + j * inLda + j;
+                v.resize((inM - j) * nb);
+                expandReflectors(inM - j, nb, panel, inLda, v.data());
+                reflectorTriangle(inM - j, nb, v.data(), inTau + j, t.data());
+
+                // 第 j 块的各列先置为单位阵的对应列，R 所在的上方各行清零
+                for (uint64 i = 0; i < inM; ++i)
+                {
+                    dtype* row = ioA + i * inLda + j;
+                    std::fill(row, row + nb, static_cast<dtype>(0));
+                    if (i >= j && i < j + nb)
+                    {
+                        row[i - j] = static_cast<dtype>(1);
+                    }
+                }
+                applyBlockReflector(inM - j, inK - j, nb, v.data(), t.data(), false, panel, inLda, work.data());
+
+                if (j == 0)
+                {
+                    break;
+                }
+            }
+        }
+    }
+}
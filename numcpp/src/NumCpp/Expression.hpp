@@ -0,0 +1,781 @@
+#pragma once
+
+#include"NumCpp/Shape.hpp"
+#include"NumCpp/Simd.hpp"
+#include"NumCpp/ThreadPool.hpp"
+#include"NumCpp/Types.hpp"
+#include"NumCpp/Utils.hpp"
+
+#include<algorithm>
+#include<cstddef>
+#include<iostream>
+#include<iterator>
+#include<memory>
+#include<stdexcept>
+#include<string>
+#include<type_traits>
+#include<vector>
+
+// 惰性求值的表达式模板：NdArray 之间的 + - * / 不再立即生成临时数组，
+// 而是构造表达式树，赋值给 NdArray 时按块一次遍历完成整条算式。
+// 每个块在 L1 缓存中用 simd 内核逐个运算符计算，内存只读写一遍。
+// 形状不同的操作数按 NumPy 规则广播，被广播的操作数不复制，按块读取时跨步为 0：
+// 一块落在结果的一行内时，行广播的操作数直接返回其连续的一段，列广播的操作数为常数，
+// 以标量形式交给 simd 内核。
+// 注意表达式只保存 NdArray 的引用，auto 保存的表达式不能比其引用的数组活得更久
+namespace nc
+{
+    template<typename dtype>
+    class NdArray;
+
+    template<typename dtype>
+    class NdArrayView;
+
+    namespace expr
+    {
+        // 每块的元素个数，每层表达式在栈上需要两块缓冲
+        constexpr uint32 BLOCK_SIZE = 256;
+
+        // 元素个数超过该值时把块分发到线程池并行求值
+        constexpr uint64 PARALLEL_MIN_ELEMENTS = 1 << 20;
+
+        template<typename Op>
+        struct OpSymbol;
+
+        template<> struct OpSymbol<simd::Add> { static const char* value() noexcept { return "+"; } };
+        template<> struct OpSymbol<simd::Subtract> { static const char* value() noexcept { return "-"; } };
+        template<> struct OpSymbol<simd::Multiply> { static const char* value() noexcept { return "*"; } };
+        template<> struct OpSymbol<simd::Divide> { static const char* value() noexcept { return "/"; } };
+
+        //============================================================================
+        /// 广播结果的下标到操作数下标的映射。结果按矩阵视角逐行遍历，每行对应操作数中
+        /// 连续的一段，操作数最后一维被广播时整行对应同一个元素
+        ///
+        class Broadcast
+        {
+        private:
+            uint32  ndim_{ 2 };
+            uint64  dims_[Shape::MAX_DIMS] = {};        // 结果的各维
+            uint64  strides_[Shape::MAX_DIMS] = {};     // 操作数沿结果各维的跨步，被广播的维为 0
+            bool    identity_{ true };
+
+        public:
+            Broadcast() = default;
+
+            Broadcast(const Shape& inShape, const Shape& inResultShape) noexcept :
+                ndim_(inResultShape.ndim()),
+                identity_(inShape == inResultShape)
+            {
+                const uint32 leading = ndim_ - inShape.ndim();
+                for (uint32 axis = 0; axis < ndim_; ++axis)
+                {
+                    dims_[axis] = inResultShape[axis];
+                    strides_[axis] = axis < leading || inShape[axis - leading] == 1 ? 0 : inShape.stride(axis - leading);
+                }
+            }
+
+            bool identity() const noexcept
+            {
+                return identity_;
+            }
+
+            // 操作数的最后一维被广播，结果的每一行只读取操作数的一个元素
+            bool rowConstant() const noexcept
+            {
+                return strides_[ndim_ - 1] == 0;
+            }
+
+            uint64 cols() const noexcept
+            {
+                return dims_[ndim_ - 1];
+            }
+
+            // 结果第 inRow 行（矩阵视角）的首元素在操作数中的下标
+            uint64 rowOffset(uint64 inRow) const noexcept
+            {
+                uint64 offset = 0;
+                for (uint32 axis = ndim_ - 1; axis-- > 0;)
+                {
+                    offset += inRow % dims_[axis] * strides_[axis];
+                    inRow /= dims_[axis];
+                }
+                return offset;
+            }
+
+            uint64 offset(uint64 inIndex) const noexcept
+            {
+                return identity_ ? inIndex : rowOffset(inIndex / cols()) + inIndex % cols() * strides_[ndim_ - 1];
+            }
+        };
+
+        //============================================================================
+        /// 引用一个 NdArray 的叶子节点
+        ///
+        template<typename dtype>
+        class ArrayLeaf
+        {
+        private:
+            const dtype*    array_;
+            Shape           shape_;
+
+        public:
+            typedef dtype value_type;
+            static constexpr bool IS_SCALAR = false;
+
+            explicit ArrayLeaf(const NdArray<dtype>& inArray) noexcept :
+                array_(inArray.cbegin()),
+                shape_(inArray.shape())
+            {}
+
+            Shape shape() const noexcept
+            {
+                return shape_;
+            }
+
+            dtype operator[](uint64 inIndex) const noexcept
+            {
+                return array_[inIndex];
+            }
+
+            const dtype* block(uint64 inStart, uint32, dtype*) const noexcept
+            {
+                return array_ + inStart;
+            }
+
+            bool overlaps(const void* inFirst, const void* inLast) const noexcept
+            {
+                return static_cast<const void*>(array_) < inLast && inFirst < static_cast<const void*>(array_ + shape_.size());
+            }
+
+            bool broadcastOverlaps(const void*, const void*) const noexcept
+            {
+                return false;
+            }
+        };
+
+        //============================================================================
+        /// 引用一个 NdArrayView 的叶子节点，非连续时把每块元素按跨步收集到缓冲中
+        ///
+        template<typename dtype>
+        class StridedLeaf
+        {
+        private:
+            NdArrayView<const dtype>    view_;
+
+        public:
+            typedef dtype value_type;
+            static constexpr bool IS_SCALAR = false;
+
+            explicit StridedLeaf(const NdArrayView<const dtype>& inView) noexcept :
+                view_(inView)
+            {}
+
+            Shape shape() const noexcept
+            {
+                return view_.shape();
+            }
+
+            dtype operator[](uint64 inIndex) const noexcept
+            {
+                return view_[static_cast<int64>(inIndex)];
+            }
+
+            const dtype* block(uint64 inStart, uint32 inCount, dtype* outScratch) const noexcept
+            {
+                if (view_.isContiguous())
+                {
+                    return view_.data() + inStart;
+                }
+
+                view_.gather(inStart, inCount, outScratch);
+                return outScratch;
+            }
+
+            bool overlaps(const void* inFirst, const void* inLast) const noexcept
+            {
+                // strides are never negative, so the last element has the highest address
+                return !view_.isempty() && static_cast<const void*>(view_.data()) < inLast && inFirst < static_cast<const void*>(&view_[-1] + 1);
+            }
+
+            // 与结果同形时，只有连续且起点与 inFirst 相同的视图逐元素读取结果自身的位置，
+            // 转置或带跨步的视图会读取已被覆盖的元素
+            bool broadcastOverlaps(const void* inFirst, const void* inLast) const noexcept
+            {
+                if (view_.isContiguous() && static_cast<const void*>(view_.data()) == inFirst)
+                {
+                    return false;
+                }
+                return overlaps(inFirst, inLast);
+            }
+        };
+
+        //============================================================================
+        /// 广播到所有元素的标量叶子节点
+        ///
+        template<typename dtype>
+        class ScalarLeaf
+        {
+        private:
+            dtype   value_;
+
+        public:
+            typedef dtype value_type;
+            static constexpr bool IS_SCALAR = true;
+
+            explicit ScalarLeaf(dtype inValue) noexcept :
+                value_(inValue)
+            {}
+
+            Shape shape() const noexcept
+            {
+                return Shape(1, 1);
+            }
+
+            dtype operator[](uint64) const noexcept
+            {
+                return value_;
+            }
+
+            const dtype* block(uint64, uint32, dtype*) const noexcept
+            {
+                return &value_;
+            }
+
+            bool overlaps(const void*, const void*) const noexcept
+            {
+                return false;
+            }
+
+            bool broadcastOverlaps(const void*, const void*) const noexcept
+            {
+                return false;
+            }
+        };
+
+        //============================================================================
+        /// 读取被广播的操作数在结果 [inStart, inStart + inCount) 范围内的值。
+        /// 范围落在结果的一行内时不复制：行广播返回操作数中连续的一段，
+        /// 列广播只取一个元素并置 ioScalar，否则逐行把各段写入 outScratch
+        ///
+        /// @param      inOperand
+        /// @param      inMap
+        /// @param      inStart
+        /// @param      inCount
+        /// @param      outScratch
+        /// @param      ioScalar: 为 true 时返回的指针只有第一个元素有效
+        ///
+        /// @return     const value_type*
+        ///
+        template<typename Operand>
+        const typename Operand::value_type* broadcastBlock(const Operand& inOperand, const Broadcast& inMap, uint64 inStart, uint32 inCount,
+            typename Operand::value_type* outScratch, bool& ioScalar) noexcept
+        {
+            if (Operand::IS_SCALAR || inMap.identity())
+            {
+                return inOperand.block(inStart, inCount, outScratch);
+            }
+
+            const uint64 cols = inMap.cols();
+            uint64 row = inStart / cols;
+            uint64 col = inStart % cols;
+            if (col + inCount <= cols)
+            {
+                if (inMap.rowConstant())
+                {
+                    outScratch[0] = inOperand[inMap.rowOffset(row)];
+                    ioScalar = true;
+                    return outScratch;
+                }
+                return inOperand.block(inMap.rowOffset(row) + col, inCount, outScratch);
+            }
+
+            for (uint32 done = 0; done < inCount; ++row, col = 0)
+            {
+                const uint32 length = static_cast<uint32>(std::min<uint64>(cols - col, inCount - done));
+                typename Operand::value_type* out = outScratch + done;
+                if (inMap.rowConstant())
+                {
+                    std::fill(out, out + length, inOperand[inMap.rowOffset(row)]);
+                }
+                else
+                {
+                    const typename Operand::value_type* values = inOperand.block(inMap.rowOffset(row) + col, length, out);
+                    if (values != out)
+                    {
+                        std::copy(values, values + length, out);
+                    }
+                }
+                done += length;
+            }
+            return outScratch;
+        }
+
+        //============================================================================
+        /// 按值读取表达式元素的只读随机访问迭代器，每次解引用按下标计算一个元素。
+        /// 迭代器共享表达式节点的副本，对运算结果调用 cbegin()/cend() 后仍可安全使用
+        ///
+        template<typename Expr>
+        class ValueIterator
+        {
+        private:
+            std::shared_ptr<const Expr> expr_{ nullptr };
+            int64                       index_{ 0 };
+
+        public:
+            typedef std::random_access_iterator_tag     iterator_category;
+            typedef typename Expr::value_type           value_type;
+            typedef std::ptrdiff_t                      difference_type;
+            typedef const value_type*                   pointer;
+            typedef value_type                          reference;
+
+            ValueIterator() = default;
+
+            ValueIterator(std::shared_ptr<const Expr> inExpr, int64 inIndex) noexcept :
+                expr_(std::move(inExpr)),
+                index_(inIndex)
+            {}
+
+            value_type operator*() const noexcept { return (*expr_)[static_cast<uint64>(index_)]; }
+            value_type operator[](difference_type inOffset) const noexcept { return *(*this + inOffset); }
+
+            ValueIterator& operator++() noexcept { ++index_; return *this; }
+            ValueIterator operator++(int) noexcept { ValueIterator old = *this; ++index_; return old; }
+            ValueIterator& operator--() noexcept { --index_; return *this; }
+            ValueIterator operator--(int) noexcept { ValueIterator old = *this; --index_; return old; }
+            ValueIterator& operator+=(difference_type inOffset) noexcept { index_ += inOffset; return *this; }
+            ValueIterator& operator-=(difference_type inOffset) noexcept { index_ -= inOffset; return *this; }
+            ValueIterator operator+(difference_type inOffset) const noexcept { return ValueIterator(expr_, index_ + inOffset); }
+            ValueIterator operator-(difference_type inOffset) const noexcept { return ValueIterator(expr_, index_ - inOffset); }
+            friend ValueIterator operator+(difference_type inOffset, const ValueIterator& inIter) noexcept { return inIter + inOffset; }
+            difference_type operator-(const ValueIterator& inOther) const noexcept { return static_cast<difference_type>(index_ - inOther.index_); }
+
+            bool operator==(const ValueIterator& inOther) const noexcept { return index_ == inOther.index_; }
+            bool operator!=(const ValueIterator& inOther) const noexcept { return index_ != inOther.index_; }
+            bool operator<(const ValueIterator& inOther) const noexcept { return index_ < inOther.index_; }
+            bool operator<=(const ValueIterator& inOther) const noexcept { return index_ <= inOther.index_; }
+            bool operator>(const ValueIterator& inOther) const noexcept { return index_ > inOther.index_; }
+            bool operator>=(const ValueIterator& inOther) const noexcept { return index_ >= inOther.index_; }
+        };
+
+        //============================================================================
+        /// 二元运算节点，Op 为 simd 中的运算标签
+        ///
+        template<typename Op, typename Lhs, typename Rhs>
+        class BinaryExpr
+        {
+        private:
+            Lhs         lhs_;
+            Rhs         rhs_;
+            Shape       shape_;
+            Broadcast   lhsMap_;
+            Broadcast   rhsMap_;
+
+        public:
+            typedef typename Lhs::value_type value_type;
+            typedef ValueIterator<BinaryExpr> const_iterator;
+            typedef const_iterator iterator;
+            static constexpr bool IS_SCALAR = false;
+
+            static_assert(std::is_same<typename Lhs::value_type, typename Rhs::value_type>::value,
+                "NdArray arithmetic requires both operands to have the same dtype.");
+
+            BinaryExpr(const Lhs& inLhs, const Rhs& inRhs) :
+                lhs_(inLhs),
+                rhs_(inRhs),
+                shape_(Lhs::IS_SCALAR ? rhs_.shape() : lhs_.shape())
+            {
+                if (Lhs::IS_SCALAR || Rhs::IS_SCALAR)
+                {
+                    return;
+                }
+
+                if (!lhs_.shape().broadcast(rhs_.shape(), shape_))
+                {
+                    std::string errStr = "ERROR: NdArray::operator";
+                    errStr += OpSymbol<Op>::value();
+                    errStr += ": operands could not be broadcast together with shapes ";
+                    errStr += lhs_.shape().str().substr(0, lhs_.shape().str().size() - 1) + " and ";
+                    errStr += rhs_.shape().str().substr(0, rhs_.shape().str().size() - 1) + ".";
+                    std::cerr << errStr << std::endl;
+                    throw std::invalid_argument(errStr);
+                }
+                lhsMap_ = Broadcast(lhs_.shape(), shape_);
+                rhsMap_ = Broadcast(rhs_.shape(), shape_);
+            }
+
+            Shape shape() const noexcept
+            {
+                return shape_;
+            }
+
+            uint64 size() const noexcept
+            {
+                return shape_.size();
+            }
+
+            value_type operator[](uint64 inIndex) const noexcept
+            {
+                return Op::scalar(lhs_[lhsMap_.offset(inIndex)], rhs_[rhsMap_.offset(inIndex)]);
+            }
+
+            value_type operator()(int64 inRowIndex, int64 inColIndex) const noexcept
+            {
+                if (inRowIndex < 0)
+                {
+                    inRowIndex += shape_.rows;
+                }
+
+                if (inColIndex < 0)
+                {
+                    inColIndex += shape_.cols;
+                }
+
+                return operator[](static_cast<uint64>(inRowIndex) * shape_.cols + static_cast<uint64>(inColIndex));
+            }
+
+            const_iterator begin() const noexcept
+            {
+                return cbegin();
+            }
+
+            const_iterator end() const noexcept
+            {
+                return cend();
+            }
+
+            const_iterator cbegin() const noexcept
+            {
+                return const_iterator(std::make_shared<const BinaryExpr>(*this), 0);
+            }
+
+            const_iterator cend() const noexcept
+            {
+                return const_iterator(std::make_shared<const BinaryExpr>(*this), static_cast<int64>(size()));
+            }
+
+            value_type front() const noexcept
+            {
+                return operator[](0);
+            }
+
+            value_type back() const noexcept
+            {
+                return operator[](size() - 1);
+            }
+
+            bool isempty() const noexcept
+            {
+                return size() == 0;
+            }
+
+            bool overlaps(const void* inFirst, const void* inLast) const noexcept
+            {
+                return lhs_.overlaps(inFirst, inLast) || rhs_.overlaps(inFirst, inLast);
+            }
+
+            //============================================================================
+            /// 被广播的操作数或非连续的视图是否读取 [inFirst, inLast) 中的内存。结果原地写入这段内存时，
+            /// 这些元素可能在读取之前被覆盖，只有逐元素读取结果自身位置的操作数可以原地求值
+            ///
+            /// @param      inFirst
+            /// @param      inLast
+            ///
+            /// @return     bool
+            ///
+            bool broadcastOverlaps(const void* inFirst, const void* inLast) const noexcept
+            {
+                return (lhsMap_.identity() ? lhs_.broadcastOverlaps(inFirst, inLast) : lhs_.overlaps(inFirst, inLast)) ||
+                    (rhsMap_.identity() ? rhs_.broadcastOverlaps(inFirst, inLast) : rhs_.overlaps(inFirst, inLast));
+            }
+
+            //============================================================================
+            /// 计算 [inStart, inStart + inCount) 范围的结果写入 outScratch 并返回
+            ///
+            /// @param      inStart
+            /// @param      inCount
+            /// @param      outScratch
+            ///
+            /// @return     const value_type*
+            ///
+            const value_type* block(uint64 inStart, uint32 inCount, value_type* outScratch) const noexcept
+            {
+                value_type lhsScratch[BLOCK_SIZE];
+                value_type rhsScratch[BLOCK_SIZE];
+                if (lhsMap_.identity() && rhsMap_.identity())
+                {
+                    const value_type* lhsBlock = lhs_.block(inStart, inCount, lhsScratch);
+                    const value_type* rhsBlock = rhs_.block(inStart, inCount, rhsScratch);
+                    simd::arithmetic<Op, Lhs::IS_SCALAR, Rhs::IS_SCALAR>(lhsBlock, rhsBlock, outScratch, inCount);
+                    return outScratch;
+                }
+
+                bool lhsScalar = Lhs::IS_SCALAR;
+                bool rhsScalar = Rhs::IS_SCALAR;
+                const value_type* lhsBlock = broadcastBlock(lhs_, lhsMap_, inStart, inCount, lhsScratch, lhsScalar);
+                const value_type* rhsBlock = broadcastBlock(rhs_, rhsMap_, inStart, inCount, rhsScratch, rhsScalar);
+                simd::arithmetic<Op>(lhsBlock, lhsScalar, rhsBlock, rhsScalar, outScratch, inCount);
+                return outScratch;
+            }
+
+            NdArray<value_type> eval() const
+            {
+                return NdArray<value_type>(*this);
+            }
+
+            // 以下成员与 NdArray 的同名成员相同，先求值为临时数组再调用，使对运算结果调用
+            // 成员函数的代码在运算返回表达式后仍能编译。返回类型需要完整的 NdArray，定义在 NdArray.hpp 末尾
+            NdArray<bool> all(Axis inAxis = Axis::NONE) const;
+            NdArray<bool> all(int32 inAxis) const;
+            NdArray<bool> any(Axis inAxis = Axis::NONE) const;
+            NdArray<bool> any(int32 inAxis) const;
+            NdArray<uint64> argmax(Axis inAxis = Axis::NONE) const;
+            NdArray<uint64> argmax(int32 inAxis) const;
+            NdArray<uint64> argmin(Axis inAxis = Axis::NONE) const;
+            NdArray<uint64> argmin(int32 inAxis) const;
+            NdArray<value_type> max(Axis inAxis = Axis::NONE) const;
+            NdArray<value_type> max(int32 inAxis) const;
+            NdArray<double> mean(Axis inAxis = Axis::NONE) const;
+            NdArray<double> mean(int32 inAxis) const;
+            NdArray<value_type> min(Axis inAxis = Axis::NONE) const;
+            NdArray<value_type> min(int32 inAxis) const;
+            NdArray<double> nanmean(Axis inAxis = Axis::NONE) const;
+            NdArray<double> nanmean(int32 inAxis) const;
+            NdArray<value_type> nansum(Axis inAxis = Axis::NONE) const;
+            NdArray<value_type> nansum(int32 inAxis) const;
+            NdArray<value_type> prod(Axis inAxis = Axis::NONE) const;
+            NdArray<value_type> prod(int32 inAxis) const;
+            NdArray<double> stdev(Axis inAxis = Axis::NONE) const;
+            NdArray<double> stdev(int32 inAxis) const;
+            NdArray<value_type> sum(Axis inAxis = Axis::NONE) const;
+            NdArray<value_type> sum(int32 inAxis) const;
+            NdArray<double> var(Axis inAxis = Axis::NONE) const;
+            NdArray<double> var(int32 inAxis) const;
+            NdArray<uint64> argsort(Axis inAxis = Axis::NONE) const;
+            NdArray<value_type> copy() const;
+            value_type item() const;
+            value_type at(int64 inIndex) const;
+            value_type at(int64 inRowIndex, int64 inColIndex) const;
+            NdArray<value_type> reshape(uint64 inNumRows, uint64 inNumCols) const;
+            NdArray<value_type> reshape(const Shape& inShape) const;
+            NdArray<value_type> transpose() const;
+            NdArray<value_type> transpose(const std::vector<uint32>& inAxes) const;
+
+            template<typename dtypeOut>
+            NdArray<dtypeOut> astype() const;
+
+            template<typename dtypeOut>
+            NdArray<dtypeOut> dot(const NdArray<value_type>& inOtherArray) const;
+
+            NdArray<bool> operator==(const NdArray<value_type>& inOtherArray) const;
+            NdArray<bool> operator==(value_type inScalar) const;
+            NdArray<bool> operator!=(const NdArray<value_type>& inOtherArray) const;
+            NdArray<bool> operator!=(value_type inScalar) const;
+            NdArray<bool> operator<(const NdArray<value_type>& inOtherArray) const;
+            NdArray<bool> operator<(value_type inScalar) const;
+            NdArray<bool> operator<=(const NdArray<value_type>& inOtherArray) const;
+            NdArray<bool> operator<=(value_type inScalar) const;
+            NdArray<bool> operator>(const NdArray<value_type>& inOtherArray) const;
+            NdArray<bool> operator>(value_type inScalar) const;
+            NdArray<bool> operator>=(const NdArray<value_type>& inOtherArray) const;
+            NdArray<bool> operator>=(value_type inScalar) const;
+
+            std::string str() const
+            {
+                return eval().str();
+            }
+
+            friend std::ostream& operator<<(std::ostream& inOStream, const BinaryExpr& inExpr)
+            {
+                inOStream << inExpr.str();
+                return inOStream;
+            }
+        };
+
+        //============================================================================
+        /// 把表达式的结果写入 outArray。outArray 可以是表达式引用的数组之一，前提是对应的操作数
+        /// 只读取 outArray 中与结果相同位置的元素；broadcastOverlaps 为 true 时须先求值到临时数组
+        ///
+        /// @param      inExpr
+        /// @param      outArray
+        ///
+        template<typename Expr>
+        void evaluate(const Expr& inExpr, typename Expr::value_type* outArray)
+        {
+            const uint64 size = inExpr.size();
+            auto evaluateRange = [&inExpr, outArray](uint64 inStart, uint64 inStop) noexcept
+            {
+                for (uint64 start = inStart; start < inStop; start += BLOCK_SIZE)
+                {
+                    const uint32 count = static_cast<uint32>(std::min<uint64>(BLOCK_SIZE, inStop - start));
+                    inExpr.block(start, count, outArray + start);
+                }
+            };
+
+            if (size < PARALLEL_MIN_ELEMENTS || getNumThreads() == 1)
+            {
+                evaluateRange(0, size);
+                return;
+            }
+
+            constexpr uint64 CHUNK_SIZE = 64 * BLOCK_SIZE;
+            const uint32 numChunks = static_cast<uint32>((size + CHUNK_SIZE - 1) / CHUNK_SIZE);
+            ThreadPool::instance().parallelFor(numChunks, [&evaluateRange, size](uint32 inChunk, uint32)
+            {
+                const uint64 start = static_cast<uint64>(inChunk) * CHUNK_SIZE;
+                evaluateRange(start, std::min(size, start + CHUNK_SIZE));
+            });
+        }
+
+        // 能参与表达式运算的类型（NdArray、NdArrayView 和表达式节点）对应的叶子类型
+        template<typename T>
+        struct Operand {};
+
+        template<typename dtype>
+        struct Operand<NdArray<dtype> >
+        {
+            typedef dtype value_type;
+            typedef ArrayLeaf<dtype> type;
+        };
+
+        template<typename dtype>
+        struct Operand<NdArrayView<dtype> >
+        {
+            typedef typename std::remove_const<dtype>::type value_type;
+            typedef StridedLeaf<value_type> type;
+        };
+
+        template<typename Op, typename Lhs, typename Rhs>
+        struct Operand<BinaryExpr<Op, Lhs, Rhs> >
+        {
+            typedef typename BinaryExpr<Op, Lhs, Rhs>::value_type value_type;
+            typedef BinaryExpr<Op, Lhs, Rhs> type;
+        };
+
+        template<typename T>
+        struct IsExpression : std::false_type {};
+
+        template<typename Op, typename Lhs, typename Rhs>
+        struct IsExpression<BinaryExpr<Op, Lhs, Rhs> > : std::true_type {};
+
+        // 接受 NdArray 的函数遇到表达式时先求值，NdArray 本身直接引用，不复制
+        template<typename dtype>
+        const NdArray<dtype>& materialize(const NdArray<dtype>& inArray) noexcept
+        {
+            return inArray;
+        }
+
+        template<typename Op, typename Lhs, typename Rhs>
+        NdArray<typename Lhs::value_type> materialize(const BinaryExpr<Op, Lhs, Rhs>& inExpr)
+        {
+            return inExpr.eval();
+        }
+
+        template<typename dtype>
+        ArrayLeaf<dtype> makeOperand(const NdArray<dtype>& inArray) noexcept
+        {
+            return ArrayLeaf<dtype>(inArray);
+        }
+
+        template<typename dtype>
+        StridedLeaf<typename std::remove_const<dtype>::type> makeOperand(const NdArrayView<dtype>& inView) noexcept
+        {
+            return StridedLeaf<typename std::remove_const<dtype>::type>(inView);
+        }
+
+        template<typename Op, typename Lhs, typename Rhs>
+        const BinaryExpr<Op, Lhs, Rhs>& makeOperand(const BinaryExpr<Op, Lhs, Rhs>& inExpr) noexcept
+        {
+            return inExpr;
+        }
+
+        template<typename Op, typename A, typename B>
+        using ArrayArrayExpr = BinaryExpr<Op, typename Operand<A>::type, typename Operand<B>::type>;
+
+        template<typename Op, typename A>
+        using ArrayScalarExpr = BinaryExpr<Op, typename Operand<A>::type, ScalarLeaf<typename Operand<A>::value_type> >;
+
+        template<typename Op, typename B>
+        using ScalarArrayExpr = BinaryExpr<Op, ScalarLeaf<typename Operand<B>::value_type>, typename Operand<B>::type>;
+    }
+
+    template<typename A, typename B>
+    expr::ArrayArrayExpr<simd::Add, A, B> operator+(const A& inA, const B& inB)
+    {
+        return expr::ArrayArrayExpr<simd::Add, A, B>(expr::makeOperand(inA), expr::makeOperand(inB));
+    }
+
+    template<typename A>
+    expr::ArrayScalarExpr<simd::Add, A> operator+(const A& inA, typename expr::Operand<A>::value_type inScalar)
+    {
+        return expr::ArrayScalarExpr<simd::Add, A>(expr::makeOperand(inA), expr::ScalarLeaf<typename expr::Operand<A>::value_type>(inScalar));
+    }
+
+    template<typename B>
+    expr::ScalarArrayExpr<simd::Add, B> operator+(typename expr::Operand<B>::value_type inScalar, const B& inB)
+    {
+        return expr::ScalarArrayExpr<simd::Add, B>(expr::ScalarLeaf<typename expr::Operand<B>::value_type>(inScalar), expr::makeOperand(inB));
+    }
+
+    template<typename A, typename B>
+    expr::ArrayArrayExpr<simd::Subtract, A, B> operator-(const A& inA, const B& inB)
+    {
+        return expr::ArrayArrayExpr<simd::Subtract, A, B>(expr::makeOperand(inA), expr::makeOperand(inB));
+    }
+
+    template<typename A>
+    expr::ArrayScalarExpr<simd::Subtract, A> operator-(const A& inA, typename expr::Operand<A>::value_type inScalar)
+    {
+        return expr::ArrayScalarExpr<simd::Subtract, A>(expr::makeOperand(inA), expr::ScalarLeaf<typename expr::Operand<A>::value_type>(inScalar));
+    }
+
+    template<typename B>
+    expr::ScalarArrayExpr<simd::Subtract, B> operator-(typename expr::Operand<B>::value_type inScalar, const B& inB)
+    {
+        return expr::ScalarArrayExpr<simd::Subtract, B>(expr::ScalarLeaf<typename expr::Operand<B>::value_type>(inScalar), expr::makeOperand(inB));
+    }
+
+    template<typename A, typename B>
+    expr::ArrayArrayExpr<simd::Multiply, A, B> operator*(const A& inA, const B& inB)
+    {
+        return expr::ArrayArrayExpr<simd::Multiply, A, B>(expr::makeOperand(inA), expr::makeOperand(inB));
+    }
+
+    template<typename A>
+    expr::ArrayScalarExpr<simd::Multiply, A> operator*(const A& inA, typename expr::Operand<A>::value_type inScalar)
+    {
+        return expr::ArrayScalarExpr<simd::Multiply, A>(expr::makeOperand(inA), expr::ScalarLeaf<typename expr::Operand<A>::value_type>(inScalar));
+    }
+
+    template<typename B>
+    expr::ScalarArrayExpr<simd::Multiply, B> operator*(typename expr::Operand<B>::value_type inScalar, const B& inB)
+    {
+        return expr::ScalarArrayExpr<simd::Multiply, B>(expr::ScalarLeaf<typename expr::Operand<B>::value_type>(inScalar), expr::makeOperand(inB));
+    }
+
+    template<typename A, typename B>
+    expr::ArrayArrayExpr<simd::Divide, A, B> operator/(const A& inA, const B& inB)
+    {
+        return expr::ArrayArrayExpr<simd::Divide, A, B>(expr::makeOperand(inA), expr::makeOperand(inB));
+    }
+
+    template<typename A>
+    expr::ArrayScalarExpr<simd::Divide, A> operator/(const A& inA, typename expr::Operand<A>::value_type inScalar)
+    {
+        return expr::ArrayScalarExpr<simd::Divide, A>(expr::makeOperand(inA), expr::ScalarLeaf<typename expr::Operand<A>::value_type>(inScalar));
+    }
+
+    template<typename B>
+    expr::ScalarArrayExpr<simd::Divide, B> operator/(typename expr::Operand<B>::value_type inScalar, const B& inB)
+    {
+        return expr::ScalarArrayExpr<simd::Divide, B>(expr::ScalarLeaf<typename expr::Operand<B>::value_type>(inScalar), expr::makeOperand(inB));
+    }
+
+    namespace expr
+    {
+        // 使表达式节点作为操作数时也能通过 ADL 找到上面的运算符
+        using nc::operator+;
+        using nc::operator-;
+        using nc::operator*;
+        using nc::operator/;
+    }
+}
@@ -0,0 +1,343 @@
+#pragma once
+
+#include"NumCpp/Decomposition.hpp"
+#include"NumCpp/NdArray.hpp"
+#include"NumCpp/Shape.hpp"
+#include"NumCpp/Types.hpp"
+#include"NumCpp/Utils.hpp"
+
+#include<algorithm>
+#include<cmath>
+#include<iostream>
+#include<stdexcept>
+#include<string>
+#include<type_traits>
+#include<utility>
+#include<vector>
+
+// 可重复使用的矩阵分解：分解一次后对任意多个右端项求解，每次求解只做 O(n^2 k) 的三角回代。
+// 右端项 B 为 n x k 的矩阵（每列一个右端项）或 1 x n 的向量，结果与 B 同形
+namespace nc
+{
+    namespace linalg
+    {
+        namespace detail
+        {
+            //============================================================================
+            /// 把右端项复制为 dtype 的结果数组，并给出按列看待时的列数和行距：
+            /// n x k 的矩阵保持原样，1 x n 的向量看作 n x 1
+            ///
+            /// @param      inB
+            /// @param      inOrder
+            /// @param      inFunctionName
+            /// @param      outCols
+            /// @param      outLdb
+            ///
+            /// @return     NdArray<dtype>
+            ///
+            template<typename dtype, typename dtypeIn>
+            NdArray<dtype> rhsCopy(const NdArray<dtypeIn>& inB, uint64 inOrder, const std::string& inFunctionName,
+                uint64& outCols, uint64& outLdb)
+            {
+                const Shape shape = inB.shape();
+                if (shape.ndim() == 2 && shape.rows == inOrder)
+                {
+                    outCols = shape.cols;
+                    outLdb = shape.cols;
+                }
+                else if (shape.ndim() == 2 && shape.rows == 1 && shape.cols == inOrder)
+                {
+                    outCols = 1;
+                    outLdb = 1;
+                }
+                else
+                {
+                    std::string errStr = "ERROR: linalg::" + inFunctionName + ": right-hand side with shape " + shape.str();
+                    errStr.pop_back();
+                    errStr += " does not match a matrix of order " + utils::num2str(inOrder) + ".";
+                    std::cerr << errStr << std::endl;
+                    throw std::invalid_argument(errStr);
+                }
+
+                return inB.template astype<dtype>();
+            }
+
+            //============================================================================
+            /// 迭代算法未收敛时抛出异常
+            ///
+            /// @param      inFunctionName
+            ///
+            inline void throwNotConverged(const std::string& inFunctionName)
+            {
+                std::string errStr = "ERROR: linalg::" + inFunctionName + ": iteration did not converge.";
+                std::cerr << errStr << std::endl;
+                throw std::runtime_error(errStr);
+            }
+
+            inline void checkSquare(const Shape& inShape, const std::string& inFunctionName)
+            {
+                if (inShape.ndim() != 2 || inShape.rows != inShape.cols)
+                {
+                    std::string errStr = "ERROR: linalg::" + inFunctionName + ": input array must be a square matrix.";
+                    std::cerr << errStr << std::endl;
+                    throw std::invalid_argument(errStr);
+                }
+            }
+        }
+
+        //============================================================================
+        /// 列部分选主元 LU 分解 P * A = L * U。奇异矩阵也可以分解（det 为 0），
+        /// 但 solve 和 inv 会抛出异常
+        ///
+        template<typename dtype>
+        class LUFactorization
+        {
+            static_assert(std::is_floating_point<dtype>::value, "LUFactorization: dtype must be a floating point type.");
+
+        private:
+            NdArray<dtype>      lu_;
+            std::vector<uint64> pivots_;
+            uint64              info_{ 0 };
+
+            void checkNonsingular(const std::string& inFunctionName) const
+            {
+                if (info_ != 0)
+                {
+                    std::string errStr = "ERROR: linalg::" + inFunctionName + ": matrix is singular (zero pivot in column " + utils::num2str(info_ - 1) + ").";
+                    std::cerr << errStr << std::endl;
+                    throw std::runtime_error(errStr);
+                }
+            }
+
+        public:
+            LUFactorization() = default;
+
+            //============================================================================
+            /// 复制 inArray 为 dtype 并原地分解
+            ///
+            /// @param      inArray
+            ///
+            template<typename dtypeIn>
+            explicit LUFactorization(const NdArray<dtypeIn>& inArray) :
+                lu_(inArray.template astype<dtype>()),
+                pivots_(inArray.shape().rows)
+            {
+                detail::checkSquare(inArray.shape(), "LUFactorization");
+                info_ = decomp::lu(order(), lu_.begin(), order(), pivots_.data());
+            }
+
+            uint64 order() const noexcept
+            {
+                return lu_.shape().rows;
+            }
+
+            bool singular() const noexcept
+            {
+                return info_ != 0;
+            }
+
+            //============================================================================
+            /// 分解结果：严格下三角为单位下三角矩阵 L，上三角为 U
+            ///
+            /// @return     NdArray<dtype>
+            ///
+            const NdArray<dtype>& lu() const noexcept
+            {
+                return lu_;
+            }
+
+            //============================================================================
+            /// 第 i 步与第 i 行交换的行，依次执行这些交换即得到 P * A
+            ///
+            /// @return     std::vector<uint64>
+            ///
+            const std::vector<uint64>& pivots() const noexcept
+            {
+                return pivots_;
+            }
+
+            //============================================================================
+            /// 行列式。U 的对角元的尾数和指数分开累乘，中间结果不会溢出或下溢
+            ///
+            /// @return     dtype
+            ///
+            dtype det() const
+            {
+                if (info_ != 0)
+                {
+                    return static_cast<dtype>(0);
+                }
+
+                dtype mantissa = 1;
+                int exponent = 0;
+                for (uint64 i = 0; i < order(); ++i)
+                {
+                    mantissa *= lu_(i, i);
+                    if (pivots_[i] != i)
+                    {
+                        mantissa = -mantissa;
+                    }
+
+                    int partExponent = 0;
+                    mantissa = std::frexp(mantissa, &partExponent);
+                    exponent += partExponent;
+                }
+
+                return std::ldexp(mantissa, exponent);
+            }
+
+            //============================================================================
+            /// 逆矩阵，矩阵奇异时抛出异常
+            ///
+            /// @return     NdArray<dtype>
+            ///
+            NdArray<dtype> inv() const
+            {
+                checkNonsingular("inv");
+
+                NdArray<dtype> returnArray(lu_.shape());
+                decomp::luInverse(order(), lu_.begin(), order(), pivots_.data(), returnArray.begin(), order());
+
+                return std::move(returnArray);
+            }
+
+            //============================================================================
+            /// 求解 A * X = B，矩阵奇异时抛出异常
+            ///
+            /// @param      inB: n x k 的矩阵或 1 x n 的向量
+            ///
+            /// @return     NdArray<dtype>: 与 inB 同形
+            ///
+            template<typename dtypeIn>
+            NdArray<dtype> solve(const NdArray<dtypeIn>& inB) const
+            {
+                checkNonsingular("solve");
+
+                uint64 cols = 0;
+                uint64 ldb = 0;
+                NdArray<dtype> returnArray = detail::rhsCopy<dtype>(inB, order(), "solve", cols, ldb);
+                dtype* b = returnArray.begin();
+
+                for (uint64 i = 0; i < order(); ++i)
+                {
+                    if (pivots_[i] != i)
+                    {
+                        std::swap_ranges(b + i * ldb, b + i * ldb + cols, b + pivots_[i] * ldb);
+                    }
+                }
+                decomp::solveLower(order(), cols, lu_.begin(), order(), b, ldb, true);
+                decomp::solveUpper(order(), cols, lu_.begin(), order(), b, ldb);
+
+                return std::move(returnArray);
+            }
+        };
+
+        //============================================================================
+        /// 对称正定矩阵的 Cholesky 分解 A = L * L^T，只读取 A 的下三角部分，
+        /// 矩阵不正定时构造函数抛出异常。计算量约为 LU 分解的一半
+        ///
+        template<typename dtype>
+        class CholeskyFactorization
+        {
+            static_assert(std::is_floating_point<dtype>::value, "CholeskyFactorization: dtype must be a floating point type.");
+
+        private:
+            // 下三角为 L，上三角存放 L^T，回代时可以按行连续访问
+            NdArray<dtype>      factor_;
+
+        public:
+            CholeskyFactorization() = default;
+
+            //============================================================================
+            /// 复制 inArray 为 dtype 并原地分解
+            ///
+            /// @param      inArray
+            ///
+            template<typename dtypeIn>
+            explicit CholeskyFactorization(const NdArray<dtypeIn>& inArray) :
+                factor_(inArray.template astype<dtype>())
+            {
+                detail::checkSquare(inArray.shape(), "CholeskyFactorization");
+
+                const uint64 n = order();
+                const uint64 info = decomp::cholesky(n, factor_.begin(), n);
+                if (info != 0)
+                {
+                    std::string errStr = "ERROR: linalg::CholeskyFactorization: matrix is not positive definite (leading minor of order " + utils::num2str(info) + ").";
+                    std::cerr << errStr << std::endl;
+                    throw std::runtime_error(errStr);
+                }
+
+                for (uint64 i = 0; i < n; ++i)
+                {
+                    for (uint64 j = i + 1; j < n; ++j)
+                    {
+                        factor_(i, j) = factor_(j, i);
+                    }
+                }
+            }
+
+            uint64 order() const noexcept
+            {
+                return factor_.shape().rows;
+            }
+
+            //============================================================================
+            /// 下三角因子 L，上三角为零
+            ///
+            /// @return     NdArray<dtype>
+            ///
+            NdArray<dtype> lower() const
+            {
+                NdArray<dtype> returnArray(factor_);
+                for (uint64 i = 0; i < order(); ++i)
+                {
+                    std::fill(&returnArray(i, 0) + i + 1, &returnArray(i, 0) + order(), static_cast<dtype>(0));
+                }
+
+                return std::move(returnArray);
+            }
+
+            //============================================================================
+            /// 行列式，即 L 的对角元之积的平方
+            ///
+            /// @return     dtype
+            ///
+            dtype det() const
+            {
+                dtype mantissa = 1;
+                int exponent = 0;
+                for (uint64 i = 0; i < order(); ++i)
+                {
+                    mantissa *= factor_(i, i) * factor_(i, i);
+
+                    int partExponent = 0;
+                    mantissa = std::frexp(mantissa, &partExponent);
+                    exponent += partExponent;
+                }
+
+                return std::ldexp(mantissa, exponent);
+            }
+
+            //============================================================================
+            /// 求解 A * X = B
+            ///
+            /// @param      inB: n x k 的矩阵或 1 x n 的向量
+            ///
+            /// @return     NdArray<dtype>: 与 inB 同形
+            ///
+            template<typename dtypeIn>
+            NdArray<dtype> solve(const NdArray<dtypeIn>& inB) const
+            {
+                uint64 cols = 0;
+                uint64 ldb = 0;
+                NdArray<dtype> returnArray = detail::rhsCopy<dtype>(inB, order(), "solve", cols, ldb);
+
+                decomp::solveLower(order(), cols, factor_.begin(), order(), returnArray.begin(), ldb, false);
+                decomp::solveUpper(order(), cols, factor_.begin(), order(), returnArray.begin(), ldb);
+
+                return std::move(returnArray);
+            }
+        };
+    }
+}
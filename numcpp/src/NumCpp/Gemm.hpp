@@ -0,0 +1,352 @@
+#pragma once
+
+#include"NumCpp/Allocator.hpp"
+#include"NumCpp/ThreadPool.hpp"
+#include"NumCpp/Types.hpp"
+
+#include<algorithm>
+#include<vector>
+
+// 分块矩阵乘法内核：C = A * B
+// 按 NC/KC/MC 三级分块使 B 的面板常驻 L2、A 的面板常驻 L1，
+// 面板打包为连续内存后交给 MR x NR 的寄存器分块微内核计算
+namespace nc
+{
+    namespace gemm
+    {
+        // 小于该计算量的乘法在调用线程上完成，避免线程调度开销
+        constexpr uint64 PARALLEL_MIN_FLOPS = 64 * 64 * 64;
+
+        //============================================================================
+        /// 各数据类型的分块参数，MR x NR 为微内核的寄存器分块大小
+        ///
+        template<typename dtype>
+        struct GemmTraits
+        {
+            static constexpr uint32 MR = 4;
+            static constexpr uint32 NR = 4;
+            static constexpr uint32 MC = 64;
+            static constexpr uint32 KC = 256;
+            static constexpr uint32 NC = 2048;
+        };
+
+        template<>
+        struct GemmTraits<double>
+        {
+            static constexpr uint32 MR = 4;
+            static constexpr uint32 NR = 8;
+            static constexpr uint32 MC = 96;
+            static constexpr uint32 KC = 256;
+            static constexpr uint32 NC = 2048;
+        };
+
+        template<>
+        struct GemmTraits<float>
+        {
+            static constexpr uint32 MR = 4;
+            static constexpr uint32 NR = 8;
+            static constexpr uint32 MC = 128;
+            static constexpr uint32 KC = 384;
+            static constexpr uint32 NC = 3072;
+        };
+
+        template<>
+        struct GemmTraits<int32>
+        {
+            static constexpr uint32 MR = 4;
+            static constexpr uint32 NR = 8;
+            static constexpr uint32 MC = 128;
+            static constexpr uint32 KC = 384;
+            static constexpr uint32 NC = 3072;
+        };
+
+        //============================================================================
+        /// 将 A 的 mc x kc 子块按 MR 行一组打包为列主序的连续面板，
+        /// 不足 MR 的尾部补零，打包时顺便完成类型转换并乘以 inAlpha
+        ///
+        /// @param      inA
+        /// @param      inRowStride
+        /// @param      inColStride
+        /// @param      inMc
+        /// @param      inKc
+        /// @param      outPacked
+        /// @param      inAlpha
+        ///
+        template<typename dtypeOut, typename dtypeIn>
+        void packA(const dtypeIn* inA, uint64 inRowStride, uint64 inColStride, uint32 inMc, uint32 inKc, dtypeOut* outPacked,
+            dtypeOut inAlpha = static_cast<dtypeOut>(1)) noexcept
+        {
+            constexpr uint32 MR = GemmTraits<dtypeOut>::MR;
+
+            for (uint32 i = 0; i < inMc; i += MR)
+            {
+                const uint32 mr = std::min(MR, inMc - i);
+                for (uint32 p = 0; p < inKc; ++p)
+                {
+                    for (uint32 ii = 0; ii < mr; ++ii)
+                    {
+                        outPacked[ii] = inAlpha * static_cast<dtypeOut>(inA[static_cast<uint64>(i + ii) * inRowStride + static_cast<uint64>(p) * inColStride]);
+                    }
+                    for (uint32 ii = mr; ii < MR; ++ii)
+                    {
+                        outPacked[ii] = static_cast<dtypeOut>(0);
+                    }
+                    outPacked += MR;
+                }
+            }
+        }
+
+        //============================================================================
+        /// 将 B 的 kc x nc 子块按 NR 列一组打包为行主序的连续面板，
+        /// 不足 NR 的尾部补零，打包时顺便完成类型转换
+        ///
+        /// @param      inB
+        /// @param      inRowStride
+        /// @param      inColStride
+        /// @param      inKc
+        /// @param      inNc
+        /// @param      outPacked
+        ///
+        template<typename dtypeOut, typename dtypeIn>
+        void packB(const dtypeIn* inB, uint64 inRowStride, uint64 inColStride, uint32 inKc, uint32 inNc, dtypeOut* outPacked) noexcept
+        {
+            constexpr uint32 NR = GemmTraits<dtypeOut>::NR;
+
+            for (uint32 j = 0; j < inNc; j += NR)
+            {
+                const uint32 nr = std::min(NR, inNc - j);
+                for (uint32 p = 0; p < inKc; ++p)
+                {
+                    const dtypeIn* row = inB + static_cast<uint64>(p) * inRowStride + static_cast<uint64>(j) * inColStride;
+                    if (inColStride == 1)
+                    {
+                        for (uint32 jj = 0; jj < nr; ++jj)
+                        {
+                            outPacked[jj] = static_cast<dtypeOut>(row[jj]);
+                        }
+                    }
+                    else
+                    {
+                        for (uint32 jj = 0; jj < nr; ++jj)
+                        {
+                            outPacked[jj] = static_cast<dtypeOut>(row[static_cast<uint64>(jj) * inColStride]);
+                        }
+                    }
+                    for (uint32 jj = nr; jj < NR; ++jj)
+                    {
+                        outPacked[jj] = static_cast<dtypeOut>(0);
+                    }
+                    outPacked += NR;
+                }
+            }
+        }
+
+        //============================================================================
+        /// MR x NR 寄存器分块微内核，累加器全部驻留寄存器，
+        /// inAccumulate 为 false 时覆盖写入 C，否则累加到 C 上
+        ///
+        /// @param      inKc
+        /// @param      inPackedA
+        /// @param      inPackedB
+        /// @param      outC
+        /// @param      inLdc
+        /// @param      inMr
+        /// @param      inNr
+        /// @param      inAccumulate
+        ///
+        template<typename dtype>
+        void microKernel(uint32 inKc, const dtype* inPackedA, const dtype* inPackedB,
+            dtype* outC, uint64 inLdc, uint32 inMr, uint32 inNr, bool inAccumulate) noexcept
+        {
+            constexpr uint32 MR = GemmTraits<dtype>::MR;
+            constexpr uint32 NR = GemmTraits<dtype>::NR;
+
+            dtype acc[MR][NR] = {};
+            for (uint32 p = 0; p < inKc; ++p)
+            {
+                for (uint32 i = 0; i < MR; ++i)
+                {
+                    const dtype a = inPackedA[i];
+                    for (uint32 j = 0; j < NR; ++j)
+                    {
+                        acc[i][j] += a * inPackedB[j];
+                    }
+                }
+                inPackedA += MR;
+                inPackedB += NR;
+            }
+
+            for (uint32 i = 0; i < inMr; ++i)
+            {
+                dtype* cRow = outC + static_cast<uint64>(i) * inLdc;
+                if (inAccumulate)
+                {
+                    for (uint32 j = 0; j < inNr; ++j)
+                    {
+                        cRow[j] += acc[i][j];
+                    }
+                }
+                else
+                {
+                    for (uint32 j = 0; j < inNr; ++j)
+                    {
+                        cRow[j] = acc[i][j];
+                    }
+                }
+            }
+        }
+
+        //============================================================================
+        /// 计算一个已打包的 mc x nc 宏块
+        ///
+        /// @param      inMc
+        /// @param      inNc
+        /// @param      inKc
+        /// @param      inPackedA
+        /// @param      inPackedB
+        /// @param      outC
+        /// @param      inLdc
+        /// @param      inAccumulate
+        ///
+        template<typename dtype>
+        void macroKernel(uint32 inMc, uint32 inNc, uint32 inKc, const dtype* inPackedA, const dtype* inPackedB,
+            dtype* outC, uint64 inLdc, bool inAccumulate) noexcept
+        {
+            constexpr uint32 MR = GemmTraits<dtype>::MR;
+            constexpr uint32 NR = GemmTraits<dtype>::NR;
+
+            for (uint32 j = 0; j < inNc; j += NR)
+            {
+                const uint32 nr = std::min(NR, inNc - j);
+                for (uint32 i = 0; i < inMc; i += MR)
+                {
+                    const uint32 mr = std::min(MR, inMc - i);
+                    microKernel(inKc, inPackedA + static_cast<uint64>(i) * inKc, inPackedB + static_cast<uint64>(j) * inKc,
+                        outC + static_cast<uint64>(i) * inLdc + j, inLdc, mr, nr, inAccumulate);
+                }
+            }
+        }
+
+        //============================================================================
+        /// 分块矩阵乘法 C(m x n) = A(m x k) * B(k x n)，A 和 B 可以是任意行/列步长的视图，
+        /// C 为行主序，A 和 B 的元素在打包时转换为 dtypeOut 再参与计算。
+        /// 结果乘以 inAlpha，inAccumulate 为 true 时累加到 C 上（C += alpha * A * B）
+        ///
+        /// @param      inM
+        /// @param      inN
+        /// @param      inK
+        /// @param      inA
+        /// @param      inRowStrideA
+        /// @param      inColStrideA
+        /// @param      inB
+        /// @param      inRowStrideB
+        /// @param      inColStrideB
+        /// @param      outC
+        /// @param      inLdc
+        /// @param      inAlpha
+        /// @param      inAccumulate
+        ///
+        template<typename dtypeOut, typename dtypeA, typename dtypeB>
+        void gemm(uint64 inM, uint64 inN, uint64 inK, const dtypeA* inA, uint64 inRowStrideA, uint64 inColStrideA,
+            const dtypeB* inB, uint64 inRowStrideB, uint64 inColStrideB, dtypeOut* outC, uint64 inLdc,
+            dtypeOut inAlpha = static_cast<dtypeOut>(1), bool inAccumulate = false)
+        {
+            typedef GemmTraits<dtypeOut> Traits;
+
+            if (inM == 0 || inN == 0 || (inK == 0 && inAccumulate))
+            {
+                return;
+            }
+            if (inK == 0)
+            {
+                for (uint64 i = 0; i < inM; ++i)
+                {
+                    std::fill(outC + i * inLdc, outC + i * inLdc + inN,
+                        static_cast<dtypeOut>(0));
+                }
+                return;
+            }
+
+            // 面板按 MR/NR 向上取整，尾部补零的部分也需要空间
+            const uint32 ncMax = (static_cast<uint32>(std::min<uint64>(Traits::NC, inN)) + Traits::NR - 1) / Traits::NR * Traits::NR;
+            const uint32 kcMax = static_cast<uint32>(std::min<uint64>(Traits::KC, inK));
+            const uint32 mcMax = (static_cast<uint32>(std::min<uint64>(Traits::MC, inM)) + Traits::MR - 1) / Traits::MR * Traits::MR;
+
+            // 输出按 (MC 行块, NR 整数倍的列块) 划分为互不重叠的任务，每个元素始终由同一个
+            // 微内核按相同的 k 顺序累加，因此结果与线程数无关
+            ThreadPool& pool = ThreadPool::instance();
+            const uint64 numFlops = inM * inN * inK;
+            const uint32 numThreads = numFlops < PARALLEL_MIN_FLOPS ? 1 : pool.numThreads();
+            const uint32 numIcBlocks = static_cast<uint32>((inM + Traits::MC - 1) / Traits::MC);
+
+            typedef std::vector<dtypeOut, AlignedAllocator<dtypeOut> > PackedBuffer;
+            std::vector<PackedBuffer> packedA(numThreads, PackedBuffer(static_cast<size_t>(mcMax) * kcMax));
+            PackedBuffer packedB(static_cast<size_t>(kcMax) * ncMax);
+
+            for (uint64 jc = 0; jc < inN; jc += Traits::NC)
+            {
+                const uint32 nc = static_cast<uint32>(std::min<uint64>(Traits::NC, inN - jc));
+                const uint32 numPanels = (nc + Traits::NR - 1) / Traits::NR;
+                const uint32 wantedChunks = std::min(numPanels, std::max(1u, (4 * numThreads + numIcBlocks - 1) / numIcBlocks));
+                const uint32 chunkCols = (numThreads == 1 ? numPanels : (numPanels + wantedChunks - 1) / wantedChunks) * Traits::NR;
+                const uint32 numJrChunks = (nc + chunkCols - 1) / chunkCols;
+
+                for (uint64 pc = 0; pc < inK; pc += Traits::KC)
+                {
+                    const uint32 kc = static_cast<uint32>(std::min<uint64>(Traits::KC, inK - pc));
+                    packB(inB + pc * inRowStrideB + jc * inColStrideB,
+                        inRowStrideB, inColStrideB, kc, nc, packedB.data());
+
+                    auto macroTask = [&](uint32 inTask, uint32 inThreadIndex)
+                    {
+                        const uint64 ic = static_cast<uint64>(inTask / numJrChunks) * Traits::MC;
+                        const uint32 jr = (inTask % numJrChunks) * chunkCols;
+                        const uint32 mc = static_cast<uint32>(std::min<uint64>(Traits::MC, inM - ic));
+                        const uint32 ncChunk = std::min(chunkCols, nc - jr);
+
+                        dtypeOut* threadPackedA = packedA[inThreadIndex].data();
+                        packA(inA + ic * inRowStrideA + pc * inColStrideA,
+                            inRowStrideA, inColStrideA, mc, kc, threadPackedA, inAlpha);
+                        macroKernel(mc, ncChunk, kc, threadPackedA, packedB.data() + static_cast<uint64>(jr) * kc,
+                            outC + ic * inLdc + jc + jr, inLdc, pc != 0 || inAccumulate);
+                    };
+
+                    if (numThreads == 1)
+                    {
+                        for (uint32 task = 0; task < numIcBlocks * numJrChunks; ++task)
+                        {
+                            macroTask(task, 0);
+                        }
+                    }
+                    else
+                    {
+                        pool.parallelFor(numIcBlocks * numJrChunks, macroTask);
+                    }
+                }
+            }
+        }
+
+        //============================================================================
+        /// 行主序连续存储的分块矩阵乘法 C(m x n) = A(m x k) * B(k x n)
+        ///
+        /// @param      inM
+        /// @param      inN
+        /// @param      inK
+        /// @param      inA
+        /// @param      inLda
+        /// @param      inB
+        /// @param      inLdb
+        /// @param      outC
+        /// @param      inLdc
+        /// @param      inAlpha
+        /// @param      inAccumulate
+        ///
+        template<typename dtypeOut, typename dtypeA, typename dtypeB>
+        void gemm(uint64 inM, uint64 inN, uint64 inK, const dtypeA* inA, uint64 inLda,
+            const dtypeB* inB, uint64 inLdb, dtypeOut* outC, uint64 inLdc,
+            dtypeOut inAlpha = static_cast<dtypeOut>(1), bool inAccumulate = false)
+        {
+            gemm(inM, inN, inK, inA, inLda, 1u, inB, inLdb, 1u, outC, inLdc, inAlpha, inAccumulate);
+        }
+    }
+}
@@ -0,0 +1,386 @@
+#pragma once
+
+#include"NumCpp/DtypeInfo.hpp"
+#include"NumCpp/Shape.hpp"
+#include"NumCpp/Types.hpp"
+#include"NumCpp/Utils.hpp"
+
+#include<algorithm>
+#include<complex>
+#include<cstdlib>
+#include<cstring>
+#include<iostream>
+#include<stdexcept>
+#include<string>
+#include<type_traits>
+#include<vector>
+
+// 二进制读写的公共部分：按大块读写原始缓冲区、字节序转换，以及 .npy 文件头（v1/v2/v3）的读写。
+// .npy 格式见 numpy/lib/format.py：6 字节魔数、2 字节版本、头长度、
+// 以空格补齐到 64 字节边界并以换行结尾的 Python 字典文本，之后是 C 或 Fortran 顺序的原始数据
+namespace nc
+{
+    namespace io
+    {
+        // 每次 read/write 调用的字节数，单次过大的请求在部分平台上会失败
+        constexpr uint64 CHUNK_BYTES = 1 << 26;
+
+        // .npy 数据起始位置的对齐字节数
+        constexpr uint64 NPY_ALIGNMENT = 64;
+
+        //============================================================================
+        /// 本机是否为小端字节序
+        ///
+        /// @return     bool
+        ///
+        inline bool nativeIsLittle() noexcept
+        {
+            const uint16 value = 1;
+            uint8 firstByte;
+            std::memcpy(&firstByte, &value, 1);
+            return firstByte == 1;
+        }
+
+        //============================================================================
+        /// 把 Endian::NATIVE 换成本机实际的字节序
+        ///
+        /// @param      inEndianess
+        ///
+        /// @return     Endian
+        ///
+        inline Endian resolve(Endian inEndianess) noexcept
+        {
+            if (inEndianess != Endian::NATIVE)
+            {
+                return inEndianess;
+            }
+            return nativeIsLittle() ? Endian::LITTLE : Endian::BIG;
+        }
+
+        //============================================================================
+        /// 按 inEndianess 存放的数据是否需要交换字节才能按本机字节序使用
+        ///
+        /// @param      inEndianess
+        ///
+        /// @return     bool
+        ///
+        inline bool needsSwap(Endian inEndianess) noexcept
+        {
+            return resolve(inEndianess) != resolve(Endian::NATIVE);
+        }
+
+        //============================================================================
+        /// 原地反转 inSize 个元素各自的字节顺序，复数按实部、虚部分别交换
+        ///
+        /// @param      inArray
+        /// @param      inSize
+        ///
+        template<typename dtype>
+        void byteswap(dtype* inArray, uint64 inSize) noexcept
+        {
+            constexpr uint64 WIDTH = sizeof(dtype) % 2 == 0 && std::is_class<dtype>::value ? sizeof(dtype) / 2 : sizeof(dtype);
+            if (WIDTH == 1)
+            {
+                return;
+            }
+
+            uint8* bytes = reinterpret_cast<uint8*>(inArray);
+            const uint64 numWords = inSize * (sizeof(dtype) / WIDTH);
+            for (uint64 word = 0; word < numWords; ++word)
+            {
+                std::reverse(bytes + word * WIDTH, bytes + (word + 1) * WIDTH);
+            }
+        }
+
+        //============================================================================
+        /// 分块写出 inNumBytes 字节
+        ///
+        /// @param      inStream
+        /// @param      inData
+        /// @param      inNumBytes
+        /// @param      inFilename: 仅用于错误信息
+        ///
+        inline void writeBytes(std::ostream& inStream, const void* inData, uint64 inNumBytes, const std::string& inFilename)
+        {
+            const char* data = static_cast<const char*>(inData);
+            for (uint64 offset = 0; offset < inNumBytes && inStream; offset += CHUNK_BYTES)
+            {
+                inStream.write(data + offset, static_cast<std::streamsize>(std::min(CHUNK_BYTES, inNumBytes - offset)));
+            }
+
+            if (!inStream)
+            {
+                std::string errStr = "ERROR: io::writeBytes: unable to write to '" + inFilename + "'.";
+                std::cerr << errStr << std::endl;
+                throw std::runtime_error(errStr);
+            }
+        }
+
+        //============================================================================
+        /// 分块读入 inSize 个元素，数据按 inEndianess 存放时边读边转换为本机字节序
+        ///
+        /// @param      inStream
+        /// @param      outArray
+        /// @param      inSize
+        /// @param      inEndianess
+        /// @param      inFilename: 仅用于错误信息
+        ///
+        template<typename dtype>
+        void readArray(std::istream& inStream, dtype* outArray, uint64 inSize, Endian inEndianess, const std::string& inFilename)
+        {
+            const bool swap = needsSwap(inEndianess);
+            const uint64 chunkSize = std::max<uint64>(CHUNK_BYTES / sizeof(dtype), 1);
+            for (uint64 start = 0; start < inSize; start += chunkSize)
+            {
+                const uint64 count = std::min(chunkSize, inSize - start);
+                inStream.read(reinterpret_cast<char*>(outArray + start), static_cast<std::streamsize>(count * sizeof(dtype)));
+                if (!inStream)
+                {
+                    std::string errStr = "ERROR: io::readArray: '" + inFilename + "' ended before " + utils::num2str(inSize) + " elements were read.";
+                    std::cerr << errStr << std::endl;
+                    throw std::runtime_error(errStr);
+                }
+
+                if (swap)
+                {
+                    // swap while the chunk is still in cache
+                    byteswap(outArray + start, count);
+                }
+            }
+        }
+
+        //============================================================================
+        /// dtype 对应的 .npy 类型码与每个数（复数为每个分量）的字节数
+        ///
+        template<typename dtype>
+        struct NpyType
+        {
+            static_assert(std::is_arithmetic<dtype>::value, "Only arithmetic dtypes can be stored in .npy files.");
+
+            static char kind() noexcept
+            {
+                return std::is_same<dtype, bool>::value ? 'b' : (std::is_floating_point<dtype>::value ? 'f' : (std::is_signed<dtype>::value ? 'i' : 'u'));
+            }
+        };
+
+        template<typename dtype>
+        struct NpyType<std::complex<dtype> >
+        {
+            static_assert(std::is_floating_point<dtype>::value, "Only floating point complex dtypes can be stored in .npy files.");
+
+            static char kind() noexcept
+            {
+                return 'c';
+            }
+        };
+
+        //============================================================================
+        /// dtype 的 .npy descr 字符串，如 '<f8'
+        ///
+        /// @param      inEndianess
+        ///
+        /// @return     std::string
+        ///
+        template<typename dtype>
+        std::string npyDescr(Endian inEndianess)
+        {
+            const char order = sizeof(dtype) == 1 ? '|' : (resolve(inEndianess) == Endian::LITTLE ? '<' : '>');
+            return std::string(1, order) + NpyType<dtype>::kind() + utils::num2str(sizeof(dtype));
+        }
+
+        struct NpyHeader
+        {
+            std::vector<uint64> dims;           // 各维大小，0 维时为空
+            uint64      numRows{ 0 };           // 矩阵视角：除最后一维外各维的乘积
+            uint64      numCols{ 0 };           // 矩阵视角：最后一维
+            bool        fortranOrder{ false };
+            Endian      endianess{ Endian::NATIVE };
+            uint64      dataOffset{ 0 };
+        };
+
+        //============================================================================
+        /// 写出 .npy 文件头，头长度超出 v1 的 16 位上限时改用 v2
+        ///
+        /// @param      inStream
+        /// @param      inShape
+        /// @param      inEndianess: 随后写出的数据的字节序
+        /// @param      inFilename: 仅用于错误信息
+        ///
+        template<typename dtype>
+        void writeNpyHeader(std::ostream& inStream, const Shape& inShape, Endian inEndianess, const std::string& inFilename)
+        {
+            std::string dict = "{'descr': '" + npyDescr<dtype>(inEndianess) + "', 'fortran_order': False, 'shape': (";
+            for (uint32 axis = 0; axis < inShape.ndim(); ++axis)
+            {
+                dict += utils::num2str(inShape[axis]);
+                dict += axis + 1 < inShape.ndim() ? ", " : "), }";
+            }
+
+            uint64 preambleSize = 10;
+            if (dict.size() + 1 + preambleSize > 0xFFFF)
+            {
+                preambleSize = 12;
+            }
+            const uint64 total = (preambleSize + dict.size() + 1 + NPY_ALIGNMENT - 1) / NPY_ALIGNMENT * NPY_ALIGNMENT;
+            dict.append(total - preambleSize - dict.size() - 1, ' ');
+            dict.push_back('\n');
+
+            std::string preamble("\x93NUMPY", 6);
+            const uint64 headerLength = dict.size();
+            preamble.push_back(static_cast<char>(preambleSize == 10 ? 1 : 2));
+            preamble.push_back(0);
+            for (uint64 byte = 0; byte < preambleSize - 8; ++byte)
+            {
+                // header length is always little endian
+                preamble.push_back(static_cast<char>((headerLength >> (8 * byte)) & 0xFF));
+            }
+
+            writeBytes(inStream, preamble.data(), preamble.size(), inFilename);
+            writeBytes(inStream, dict.data(), dict.size(), inFilename);
+        }
+
+        //============================================================================
+        /// 读取并校验 .npy 文件头，流停在数据起始处。descr 的类型和字节数必须与 dtype 一致，
+        /// 字节序可以不同；0 维为 1x1，1 维为 1 x n，超过 Shape::MAX_DIMS 维时抛出异常。
+        /// 各维大小不受 NdArray 索引范围的限制，可用于流式读取
+        ///
+        /// @param      inStream
+        /// @param      inFilename: 仅用于错误信息
+        ///
+        /// @return     NpyHeader
+        ///
+        template<typename dtype>
+        NpyHeader readNpyHeader(std::istream& inStream, const std::string& inFilename)
+        {
+            auto fail = [&inFilename](const std::string& inWhat)
+            {
+                std::string errStr = "ERROR: io::readNpyHeader: '" + inFilename + "' " + inWhat;
+                std::cerr << errStr << std::endl;
+                throw std::runtime_error(errStr);
+            };
+
+            char preamble[12];
+            inStream.read(preamble, 8);
+            if (!inStream || std::memcmp(preamble, "\x93NUMPY", 6) != 0)
+            {
+                fail("is not a .npy file.");
+            }
+
+            const uint8 major = static_cast<uint8>(preamble[6]);
+            if (major < 1 || major > 3)
+            {
+                fail("has unsupported .npy version " + utils::num2str(static_cast<uint32>(major)) + ".");
+            }
+
+            const uint64 lengthBytes = major == 1 ? 2 : 4;
+            inStream.read(preamble + 8, static_cast<std::streamsize>(lengthBytes));
+            uint64 headerLength = 0;
+            for (uint64 byte = 0; byte < lengthBytes; ++byte)
+            {
+                headerLength |= static_cast<uint64>(static_cast<uint8>(preamble[8 + byte])) << (8 * byte);
+            }
+
+            std::string dict(headerLength, ' ');
+            inStream.read(&dict[0], static_cast<std::streamsize>(headerLength));
+            if (!inStream)
+            {
+                fail("has a truncated header.");
+            }
+
+            auto valueOf = [&dict, &fail](const std::string& inKey) -> uint64
+            {
+                const uint64 keyPos = dict.find("'" + inKey + "'");
+                const uint64 colonPos = keyPos == std::string::npos ? std::string::npos : dict.find(':', keyPos);
+                const uint64 valuePos = colonPos == std::string::npos ? std::string::npos : dict.find_first_not_of(' ', colonPos + 1);
+                if (valuePos == std::string::npos)
+                {
+                    fail("header has no '" + inKey + "' entry.");
+                }
+                return valuePos;
+            };
+
+            NpyHeader header;
+            header.dataOffset = 8 + lengthBytes + headerLength;
+
+            // descr, e.g. '<f8'
+            uint64 pos = valueOf("descr");
+            const uint64 descrEnd = dict.find_first_of("'\"", pos + 1);
+            const std::string descr = descrEnd == std::string::npos ? std::string() : dict.substr(pos + 1, descrEnd - pos - 1);
+            const std::string expected = npyDescr<dtype>(Endian::NATIVE);
+            if (descr.size() < 2 || descr.substr(1) != expected.substr(1))
+            {
+                fail("holds '" + descr + "', which does not match the requested dtype '" + expected + "'.");
+            }
+            if (descr[0] == '<')
+            {
+                header.endianess = Endian::LITTLE;
+            }
+            else if (descr[0] == '>')
+            {
+                header.endianess = Endian::BIG;
+            }
+
+            pos = valueOf("fortran_order");
+            header.fortranOrder = dict.compare(pos, 4, "True") == 0;
+
+            // shape, e.g. (), (5,) or (3, 4)
+            pos = valueOf("shape");
+            const uint64 shapeEnd = dict.find(')', pos);
+            if (dict[pos] != '(' || shapeEnd == std::string::npos)
+            {
+                fail("header has a malformed shape.");
+            }
+
+            const char* cursor = dict.c_str() + pos + 1;
+            const char* last = dict.c_str() + shapeEnd;
+            while (cursor < last)
+            {
+                char* next = nullptr;
+                const uint64 dim = std::strtoull(cursor, &next, 10);
+                if (next == cursor)
+                {
+                    break;
+                }
+                if (header.dims.size() == Shape::MAX_DIMS)
+                {
+                    fail("has more than " + utils::num2str(Shape::MAX_DIMS) + " dimensions.");
+                }
+                header.dims.push_back(dim);
+                cursor = next;
+                while (cursor < last && (*cursor == ',' || *cursor == ' '))
+                {
+                    ++cursor;
+                }
+            }
+
+            uint64 numElements = 1;
+            for (uint64 dim : header.dims)
+            {
+                if (utils::mulOverflow(numElements, dim, numElements) || numElements > static_cast<uint64>(DtypeInfo<int64>::max()))
+                {
+                    fail("has a shape whose number of elements overflows 64-bit indexing.");
+                }
+            }
+
+            header.numRows = 1;
+            header.numCols = header.dims.empty() ? 1 : header.dims.back();
+            for (uint64 axis = 0; axis + 1 < header.dims.size(); ++axis)
+            {
+                header.numRows *= header.dims[axis];
+            }
+            return header;
+        }
+
+        //============================================================================
+        /// .npy 文件头对应的 NdArray 形状，元素个数已由 readNpyHeader 检查
+        ///
+        /// @param      inHeader
+        ///
+        /// @return     Shape
+        ///
+        inline Shape npyShape(const NpyHeader& inHeader)
+        {
+            return Shape(inHeader.dims);
+        }
+    }
+}
@@ -1,17 +1,25 @@
 #pragma once
 
+#include"NumCpp/Decomposition.hpp"
+#include"NumCpp/Factorization.hpp"
 #include"NumCpp/Methods.hpp"
 #include"NumCpp/NdArray.hpp"
 #include"NumCpp/Shape.hpp"
+#include"NumCpp/Spectral.hpp"
 #include"NumCpp/Types.hpp"
+#include"NumCpp/Utils.hpp"
 
+#include<algorithm>
 #include<cmath>
 #include<iostream>
 #include<initializer_list>
 #include<limits>
+#include<random>
 #include<stdexcept>
 #include<string>
+#include<type_traits>
 #include<utility>
+#include<vector>
 
 namespace nc
 {
@@ -24,18 +32,26 @@ namespace nc
         template<typename dtype>
         NdArray<double> inv(const NdArray<dtype>& inArray);
 
+        //============================================================================
+        /// 方阵的行列式。3x3 以内直接展开（整数输入结果精确），更大的矩阵复制到一块
+        /// double（long double 输入为 long double）缓冲区上做分块选主元 LU 分解，
+        /// 行列式为 U 的对角元之积，整数输入时四舍五入为最近的整数
+        ///
+        /// @param      inArray
+        ///
+        /// @return     dtype
+        ///
         template<typename dtype>
         dtype det(const NdArray<dtype>& inArray)
         {
             const Shape inShape = inArray.shape();
-            if (inShape.rows != inShape.cols)
+            detail::checkSquare(inShape, "det");
+
+            if (inShape.rows == 0)
             {
-                std::string errStr = "ERROR: linalg::determinant: input array must be square with size no larger than 3x3.";
-                std::cerr << errStr << std::endl;
-                throw std::invalid_argument(errStr);
+                return static_cast<dtype>(1);
             }
-
-            if (inShape.rows == 1)
+            else if (inShape.rows == 1)
             {
                 return inArray.front();
             }
@@ -54,109 +70,388 @@ namespace nc
 
                 return aei + bfg + cdh - ceg - bdi - afh;
             }
-            else
-            {
-                dtype determinant = 0;
-                NdArray<dtype> submat(inShape.rows - 1);
 
-                for (uint32 c = 0; c < inShape.rows; ++c)
-                {
-                    uint32 subi = 0;
-                    for (uint32 i = 1; i < inShape.rows; ++i)
-                    {
-                        uint32 subj = 0;
-                        for (uint32 j = 0; j < inShape.rows; ++j)
-                        {
-                            if (j == c)
-                            {
-                                continue;
-                            }
-
-                            submat(subi, subj++) = inArray(i, j);
-                        }
-                        ++subi;
-                    }
-                    determinant += (static_cast<dtype>(std::pow(-1, c)) * inArray(0, c) * det(submat));
-                }
+            typedef typename std::conditional<std::is_same<dtype, long double>::value, long double, double>::type dtypeLu;
 
-                return determinant;
+            const dtypeLu determinant = LUFactorization<dtypeLu>(inArray).det();
+            if (std::is_integral<dtype>::value)
+            {
+                return static_cast<dtype>(std::round(determinant));
             }
+            return static_cast<dtype>(determinant);
         }
 
+        //============================================================================
+        /// 方阵的逆矩阵。复制为 double 后做分块选主元 LU 分解，再由 L、U 分块求逆，
+        /// 除 LU 缓冲区外不再分配额外的工作空间。矩阵奇异（出现零主元）时抛出异常
+        ///
+        /// @param      inArray
+        ///
+        /// @return     NdArray<double>
+        ///
         template<typename dtype>
         NdArray<double> inv(const NdArray<dtype>& inArray)
         {
-            const Shape inShape = inArray.shape();
-            if (inShape.rows != inShape.cols)
+            detail::checkSquare(inArray.shape(), "inv");
+            return LUFactorization<double>(inArray).inv();
+        }
+
+        //============================================================================
+        /// 求解线性方程组 A * X = B（列部分选主元 LU 分解后三角回代），
+        /// 比先求逆再相乘更快也更精确。需要对同一个 A 反复求解时使用 LUFactorization
+        ///
+        /// @param      inA: n x n
+        /// @param      inB: n x k 的矩阵或 1 x n 的向量
+        ///
+        /// @return     NdArray<double>: 与 inB 同形
+        ///
+        template<typename dtype, typename dtypeB>
+        NdArray<double> solve(const NdArray<dtype>& inA, const NdArray<dtypeB>& inB)
+        {
+            detail::checkSquare(inA.shape(), "solve");
+            return LUFactorization<double>(inA).solve(inB);
+        }
+
+        //============================================================================
+        /// 最小二乘解：m >= n 时求 min ||A * X - B||，m < n 时求 A * X = B 的最小范数解。
+        /// 用 Householder QR 分解（m < n 时分解 A^T）求解，A 必须列满秩（m < n 时行满秩），
+        /// 否则抛出异常
+        ///
+        /// @param      inA: m x n
+        /// @param      inB: m x k 的矩阵或 1 x m 的向量
+        ///
+        /// @return     NdArray<double>: n x k 的矩阵，inB 为向量时为 1 x n 的向量
+        ///
+        template<typename dtype, typename dtypeB>
+        NdArray<double> lstsq(const NdArray<dtype>& inA, const NdArray<dtypeB>& inB)
+        {
+            const Shape inShape = inA.shape();
+            if (inShape.ndim() != 2)
             {
-                std::string errStr = "ERROR: linalg::inv: input array must be square.";
+                std::string errStr = "ERROR: linalg::lstsq: input array must be a matrix.";
                 std::cerr << errStr << std::endl;
                 throw std::invalid_argument(errStr);
             }
 
-            const uint32 order = inShape.rows;
+            const uint64 m = inShape.rows;
+            const uint64 n = inShape.cols;
+            uint64 cols = 0;
+            uint64 ldb = 0;
+            NdArray<double> b = detail::rhsCopy<double>(inB, m, "lstsq", cols, ldb);
 
-            Shape newShape(inShape);
-            newShape.rows *= 2;
-            newShape.cols *= 2;
+            // 分解 A（m >= n）或 A^T（m < n），R 为 rank x rank 的上三角矩阵
+            const bool tall = m >= n;
+            const uint64 rank = std::min(m, n);
+            const uint64 ldQr = tall ? n : m;
+            NdArray<double> qrArray = tall ? inA.template astype<double>() : inA.transpose().copy().template astype<double>();
+            std::vector<double> tau(rank);
+            decomp::qr(tall ? m : n, tall ? n : m, qrArray.begin(), ldQr, tau.data());
 
-            NdArray<double> tempArray(newShape);
-            for (uint32 row = 0; row < order; ++row)
+            double maxDiag = 0;
+            double minDiag = rank > 0 ? std::abs(qrArray(0, 0)) : 0;
+            for (uint64 i = 0; i < rank; ++i)
             {
-                for (uint32 col = 0; col < order; ++col)
-                {
-                    tempArray(row, col) = static_cast<double>(inArray(row, col));
-                }
+                maxDiag = std::max(maxDiag, std::abs(qrArray(i, i)));
+                minDiag = std::min(minDiag, std::abs(qrArray(i, i)));
+            }
+            if (rank > 0 && minDiag <= std::numeric_limits<double>::epsilon() * static_cast<double>(std::max(m, n)) * maxDiag)
+            {
+                std::string errStr = "ERROR: linalg::lstsq: matrix is rank deficient.";
+                std::cerr << errStr << std::endl;
+                throw std::runtime_error(errStr);
             }
 
-            for (uint32 row = 0; row < order; ++row)
+            const Shape outShape = inB.shape().rows != m ? Shape(1, n) : Shape(n, cols);
+            NdArray<double> returnArray(outShape);
+            if (tall)
             {
-                for (uint32 col = order; col < 2 * order; ++col)
+                // X = R^-1 * (Q^T * B) 的前 n 行
+                decomp::applyQt(m, rank, qrArray.begin(), ldQr, tau.data(), b.begin(), cols, ldb);
+                decomp::solveUpper(n, cols, qrArray.begin(), ldQr, b.begin(), ldb);
+                std::copy(b.begin(), b.begin() + n * cols, returnArray.begin());
+            }
+            else
+            {
+                // A = R^T * Q^T：X = Q * [R^-T * B; 0]
+                NdArray<double> rt(m, m);
+                for (uint64 i = 0; i < m; ++i)
                 {
-                    if (row == col - order)
+                    for (uint64 j = 0; j < m; ++j)
                     {
-                        tempArray(row, col) = 1.0;
-                    }
-                    else
-                    {
-                        tempArray(row, col) = 0.0;
+                        rt(i, j) = j <= i ? qrArray(j, i) : 0.0;
                     }
                 }
+                decomp::solveLower(m, cols, rt.begin(), m, b.begin(), ldb, false);
+
+                returnArray.zeros();
+                std::copy(b.begin(), b.begin() + m * cols, returnArray.begin());
+                decomp::applyQ(n, rank, qrArray.begin(), ldQr, tau.data(), returnArray.begin(), cols, ldb);
             }
 
-            for (uint32 row = 0; row < order; ++row)
+            return std::move(returnArray);
+        }
+
+
+        //============================================================================
+        /// 原地 Cholesky 分解 A = L * L^T：A 为对称正定矩阵（只读取下三角部分），
+        /// 分解后 ioArray 即为 L（上三角清零）。矩阵不正定时抛出异常，ioArray 的内容不再有意义
+        ///
+        /// @param      ioArray: NdArray<double> 或 NdArray<float>
+        ///
+        template<typename dtype>
+        void cholesky(NdArray<dtype>& ioArray)
+        {
+            static_assert(std::is_floating_point<dtype>::value, "linalg::cholesky: dtype must be a floating point type.");
+
+            detail::checkSquare(ioArray.shape(), "cholesky");
+
+            const uint64 order = ioArray.shape().rows;
+            const uint64 info = decomp::cholesky(order, ioArray.begin(), order);
+            if (info != 0)
             {
-                double t = tempArray(row, row);
-                for (uint32 col = row; col < 2 * order; ++col)
-                {
-                    tempArray(row, col) /= t;
-                }
+                std::string errStr = "ERROR: linalg::cholesky: matrix is not positive definite (leading minor of order " + utils::num2str(info) + ").";
+                std::cerr << errStr << std::endl;
+                throw std::runtime_error(errStr);
+            }
 
-                for (uint32 col = 0; col < order; ++col)
-                {
-                    if (row != col)
-                    {
-                        t = tempArray(col, row);
-                        for (uint32 k = 0; k < 2 * order; ++k)
-                        {
-                            tempArray(col, k) -= t * tempArray(row, k);
-                        }
-                    }
-                }
+            for (uint64 row = 0; row < order; ++row)
+            {
+                std::fill(ioArray.begin() + row * order + row + 1, ioArray.begin() + (row + 1) * order, static_cast<dtype>(0));
+            }
+        }
+
+        //============================================================================
+        /// 分块 Householder QR 分解 A = Q * R（约化形式）。A 为 m x n，k = min(m, n)，
+        /// 分解后 ioArray 为 m x k 的列正交矩阵 Q（m >= n 时在原缓冲区上生成），
+        /// outR 为 k x n 的上三角（梯形）矩阵 R
+        ///
+        /// @param      ioArray: NdArray<double> 或 NdArray<float>
+        /// @param      outR
+        ///
+        template<typename dtype>
+        void qr(NdArray<dtype>& ioArray, NdArray<dtype>& outR)
+        {
+            static_assert(std::is_floating_point<dtype>::value, "linalg::qr: dtype must be a floating point type.");
+
+            const Shape inShape = ioArray.shape();
+            if (inShape.ndim() != 2)
+            {
+                std::string errStr = "ERROR: linalg::qr: input array must be a matrix.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+
+            const uint64 m = inShape.rows;
+            const uint64 n = inShape.cols;
+            const uint64 k = std::min(m, n);
+            std::vector<dtype> tau(k);
+            decomp::qr(m, n, ioArray.begin(), n, tau.data());
+
+            outR = NdArray<dtype>(Shape(k, n));
+            for (uint64 row = 0; row < k; ++row)
+            {
+                const dtype* source = ioArray.begin() + row * n;
+                dtype* target = outR.begin() + row * n;
+                std::fill(target, target + row, static_cast<dtype>(0));
+                std::copy(source + row, source + n, target + row);
             }
 
-            NdArray<double> returnArray(inShape);
-            for (uint32 row = 0; row < order; row++)
+            decomp::formQ(m, k, ioArray.begin(), n, tau.data());
+            if (k < n)
             {
-                uint32 colCounter = 0;
-                for (uint32 col = order; col < 2 * order; ++col)
+                NdArray<dtype> q(Shape(m, k));
+                for (uint64 row = 0; row < m; ++row)
                 {
-                    returnArray(row, colCounter++) = tempArray(row, col);
+                    std::copy(ioArray.begin() + row * n, ioArray.begin() + row * n + k, q.begin() + row * k);
                 }
+                ioArray = std::move(q);
+            }
+        }
+
+        //============================================================================
+        /// 对称矩阵的特征分解 A = V * diag(w) * V^T，只读取 A 的下三角部分。
+        /// Householder 三对角化后用隐式 QL 迭代求解
+        ///
+        /// @param      inArray
+        /// @param      outEigenvalues: 1 x n，升序
+        /// @param      outEigenvectors: n x n，第 i 列为第 i 个特征值对应的单位特征向量
+        ///
+        template<typename dtype>
+        void eigh(const NdArray<dtype>& inArray, NdArray<double>& outEigenvalues, NdArray<double>& outEigenvectors)
+        {
+            detail::checkSquare(inArray.shape(), "eigh");
+
+            const uint64 order = inArray.shape().rows;
+            NdArray<double> work = inArray.template astype<double>();
+            NdArray<double> eigenvalues(Shape(1, order));
+            NdArray<double> eigenvectorRows(Shape(order, order));
+            if (!decomp::symmetricEigen(order, work.begin(), order, eigenvalues.begin(), eigenvectorRows.begin()))
+            {
+                detail::throwNotConverged("eigh");
+            }
+
+            outEigenvalues = std::move(eigenvalues);
+            outEigenvectors = eigenvectorRows.transpose().copy();
+        }
+
+        //============================================================================
+        /// 对称矩阵的特征值（升序），只读取 A 的下三角部分。不累积特征向量，计算量远小于 eigh
+        ///
+        /// @param      inArray
+        ///
+        /// @return     NdArray<double>: 1 x n
+        ///
+        template<typename dtype>
+        NdArray<double> eigvalsh(const NdArray<dtype>& inArray)
+        {
+            detail::checkSquare(inArray.shape(), "eigvalsh");
+
+            const uint64 order = inArray.shape().rows;
+            NdArray<double> work = inArray.template astype<double>();
+            NdArray<double> returnArray(Shape(1, order));
+            if (!decomp::symmetricEigen(order, work.begin(), order, returnArray.begin(), static_cast<double*>(nullptr)))
+            {
+                detail::throwNotConverged("eigvalsh");
             }
 
             return std::move(returnArray);
         }
 
+        //============================================================================
+        /// 奇异值分解 A = U * diag(s) * Vt（约化形式），k = min(m, n)。
+        /// 先 QR 分解再用单边 Jacobi 方法，奇异值精度高，适合中小规模的矩阵；
+        /// 只需要前几个分量时用 randomizedSvd
+        ///
+        /// @param      inArray: m x n
+        /// @param      outU: m x k，列正交
+        /// @param      outS: 1 x k，降序
+        /// @param      outVt: k x n，行正交
+        ///
+        template<typename dtype>
+        void svd(const NdArray<dtype>& inArray, NdArray<double>& outU, NdArray<double>& outS, NdArray<double>& outVt)
+        {
+            const Shape inShape = inArray.shape();
+            if (inShape.ndim() != 2)
+            {
+                std::string errStr = "ERROR: linalg::svd: input array must be a matrix.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+
+            // 宽矩阵分解 A^T = U' * S * V'^T，则 A = V' * S * U'^T
+            const bool tall = inShape.rows >= inShape.cols;
+            const uint64 m = tall ? inShape.rows : inShape.cols;
+            const uint64 n = tall ? inShape.cols : inShape.rows;
+            NdArray<double> work = tall ? inArray.template astype<double>() : inArray.transpose().copy().template astype<double>();
+            NdArray<double> u(Shape(m, n));
+            NdArray<double> s(Shape(1, n));
+            NdArray<double> vt(Shape(n, n));
+            if (!decomp::tallSvd(m, n, work.begin(), u.begin(), s.begin(), vt.begin()))
+            {
+                detail::throwNotConverged("svd");
+            }
+
+            outS = std::move(s);
+            if (tall)
+            {
+                outU = std::move(u);
+                outVt = std::move(vt);
+            }
+            else
+            {
+                outU = vt.transpose().copy();
+                outVt = u.transpose().copy();
+            }
+        }
+
+        //============================================================================
+        /// 随机化截断奇异值分解，只求前 inNumComponents 个分量（Halko、Martinsson、Tropp 的方法）：
+        /// 用高斯随机矩阵采样 A 的列空间并做 inPowerIterations 次幂迭代，得到 l = k + inOversamples 列的
+        /// 正交基 Q，再对 l x n 的小矩阵 Q^T * A 做完整的 SVD。主要计算量为若干次 m x n x l 的 GEMM，
+        /// 远小于完整 SVD；奇异值衰减越快结果越接近完整 SVD 的前 k 个分量
+        ///
+        /// @param      inArray: m x n
+        /// @param      inNumComponents: k，1 <= k <= min(m, n)
+        /// @param      outU: m x k
+        /// @param      outS: 1 x k，降序
+        /// @param      outVt: k x n
+        /// @param      inOversamples
+        /// @param      inPowerIterations
+        /// @param      inSeed: 随机矩阵的种子，相同的种子得到相同的结果
+        ///
+        template<typename dtype>
+        void randomizedSvd(const NdArray<dtype>& inArray, uint64 inNumComponents, NdArray<double>& outU,
+            NdArray<double>& outS, NdArray<double>& outVt, uint64 inOversamples = 10, uint32 inPowerIterations = 2,
+            uint64 inSeed = 0)
+        {
+            const Shape inShape = inArray.shape();
+            const uint64 m = inShape.rows;
+            const uint64 n = inShape.cols;
+            if (inShape.ndim() != 2 || inNumComponents == 0 || inNumComponents > std::min(m, n))
+            {
+                std::string errStr = "ERROR: linalg::randomizedSvd: the number of components must be between 1 and min(rows, cols) of a matrix.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+
+            const uint64 k = inNumComponents;
+            const uint64 l = std::min(k + inOversamples, std::min(m, n));
+            NdArray<double> a = inArray.template astype<double>();
+            std::vector<double> tau(l);
+            auto orthonormalize = [&tau, l](NdArray<double>& ioBasis, uint64 inRows)
+            {
+                decomp::qr(inRows, l, ioBasis.begin(), l, tau.data());
+                decomp::formQ(inRows, l, ioBasis.begin(), l, tau.data());
+            };
+
+            // Y = A * Omega，幂迭代 Y = A * (A^T * Y)，每次乘法后重新正交化以免丢失较小的分量
+            NdArray<double> omega(Shape(n, l));
+            std::mt19937_64 generator(inSeed);
+            std::normal_distribution<double> distribution;
+            for (double& value : omega)
+            {
+                value = distribution(generator);
+            }
+
+            NdArray<double> y(Shape(m, l));
+            NdArray<double> z(Shape(n, l));
+            gemm::gemm(m, l, n, a.begin(), n, omega.begin(), l, y.begin(), l);
+            orthonormalize(y, m);
+            for (uint32 iteration = 0; iteration < inPowerIterations; ++iteration)
+            {
+                gemm::gemm(n, l, m, a.begin(), 1u, n, y.begin(), l, 1u, z.begin(), l);
+                orthonormalize(z, n);
+                gemm::gemm(m, l, n, a.begin(), n, z.begin(), l, y.begin(), l);
+                orthonormalize(y, m);
+            }
+
+            // B = Q^T * A（l x n），B^T = U_b' * S * V_b'^T，A ≈ (Q * V_b') * S * U_b'^T
+            NdArray<double> bt(Shape(n, l));
+            gemm::gemm(n, l, m, a.begin(), 1u, n, y.begin(), l, 1u, bt.begin(), l);
+            NdArray<double> ub(Shape(n, l));
+            NdArray<double> sb(Shape(1, l));
+            NdArray<double> vtb(Shape(l, l));
+            if (!decomp::tallSvd(n, l, bt.begin(), ub.begin(), sb.begin(), vtb.begin()))
+            {
+                detail::throwNotConverged("randomizedSvd");
+            }
+
+            NdArray<double> u(Shape(m, k));
+            gemm::gemm(m, k, l, y.begin(), l, 1u, vtb.begin(), 1u, l, u.begin(), k);
+            NdArray<double> s(Shape(1, k));
+            std::copy(sb.begin(), sb.begin() + k, s.begin());
+            NdArray<double> vt(Shape(k, n));
+            for (uint64 row = 0; row < k; ++row)
+            {
+                for (uint64 col = 0; col < n; ++col)
+                {
+                    vt(row, col) = ub(col, row);
+                }
+            }
+
+            outU = std::move(u);
+            outS = std::move(s);
+            outVt = std::move(vt);
+        }
     }
 }
@@ -0,0 +1,244 @@
+#pragma once
+
+#include"NumCpp/Types.hpp"
+#include"NumCpp/Utils.hpp"
+
+#include<iostream>
+#include<stdexcept>
+#include<string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include<windows.h>
+#else
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
+
+// 把文件映射到内存，NdArray 直接在映射的页面上读写，不复制数据。
+// 以只读或共享读写方式映射时，多个进程映射同一文件共用操作系统的页缓存
+namespace nc
+{
+    enum class MapMode
+    {
+        READ_ONLY = 0,      // 只读，写入映射内存会触发访问违例
+        READ_WRITE,         // 读写，修改写回文件并对其他映射该文件的进程可见
+        COPY_ON_WRITE,      // 可写，但修改只存在于本进程，不写回文件
+        CREATE              // 创建（或截断）文件到所需大小后以读写方式映射
+    };
+
+    class MappedFile
+    {
+    private:
+        void*       data_{ nullptr };
+        uint64      size_{ 0 };
+        MapMode     mode_{ MapMode::READ_ONLY };
+#ifdef _WIN32
+        HANDLE      file_{ INVALID_HANDLE_VALUE };
+        HANDLE      mapping_{ nullptr };
+#else
+        int         file_{ -1 };
+#endif
+
+        static void fail(const std::string& inFilename, const std::string& inWhat)
+        {
+            std::string errStr = "ERROR: MappedFile: " + inWhat + " '" + inFilename + "'.";
+            std::cerr << errStr << std::endl;
+            throw std::runtime_error(errStr);
+        }
+
+        void close() noexcept
+        {
+#ifdef _WIN32
+            if (data_ != nullptr)
+            {
+                UnmapViewOfFile(data_);
+            }
+            if (mapping_ != nullptr)
+            {
+                CloseHandle(mapping_);
+            }
+            if (file_ != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(file_);
+            }
+            mapping_ = nullptr;
+            file_ = INVALID_HANDLE_VALUE;
+#else
+            if (data_ != nullptr)
+            {
+                munmap(data_, static_cast<size_t>(size_));
+            }
+            if (file_ != -1)
+            {
+                ::close(file_);
+            }
+            file_ = -1;
+#endif
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+    public:
+        //============================================================================
+        /// 映射文件 inFilename。CREATE 模式下文件被创建或截断为 inSize 字节；
+        /// 其他模式下 inSize 为 0 时映射整个文件，否则要求文件至少有 inSize 字节并只映射这部分
+        ///
+        /// @param      inFilename
+        /// @param      inMode
+        /// @param      inSize
+        ///
+        MappedFile(const std::string& inFilename, MapMode inMode, uint64 inSize = 0) :
+            mode_(inMode)
+        {
+#ifdef _WIN32
+            const bool writable = inMode == MapMode::READ_WRITE || inMode == MapMode::CREATE;
+            file_ = CreateFileA(inFilename.c_str(), GENERIC_READ | (writable ? GENERIC_WRITE : 0),
+                FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, inMode == MapMode::CREATE ? CREATE_ALWAYS : OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file_ == INVALID_HANDLE_VALUE)
+            {
+                fail(inFilename, "unable to open");
+            }
+
+            LARGE_INTEGER fileSize;
+            if (inMode == MapMode::CREATE)
+            {
+                fileSize.QuadPart = static_cast<LONGLONG>(inSize);
+                if (!SetFilePointerEx(file_, fileSize, nullptr, FILE_BEGIN) || !SetEndOfFile(file_))
+                {
+                    close();
+                    fail(inFilename, "unable to resize");
+                }
+            }
+            else if (!GetFileSizeEx(file_, &fileSize))
+            {
+                close();
+                fail(inFilename, "unable to stat");
+            }
+#else
+            const int flags = inMode == MapMode::CREATE ? O_RDWR | O_CREAT | O_TRUNC :
+                (inMode == MapMode::READ_WRITE ? O_RDWR : O_RDONLY);
+            file_ = ::open(inFilename.c_str(), flags, 0644);
+            if (file_ == -1)
+            {
+                fail(inFilename, "unable to open");
+            }
+
+            struct stat fileStat;
+            if (inMode == MapMode::CREATE)
+            {
+                if (ftruncate(file_, static_cast<off_t>(inSize)) != 0)
+                {
+                    close();
+                    fail(inFilename, "unable to resize");
+                }
+            }
+            else if (fstat(file_, &fileStat) != 0)
+            {
+                close();
+                fail(inFilename, "unable to stat");
+            }
+#endif
+
+#ifdef _WIN32
+            const uint64 fileBytes = static_cast<uint64>(fileSize.QuadPart);
+#else
+            const uint64 fileBytes = inMode == MapMode::CREATE ? inSize : static_cast<uint64>(fileStat.st_size);
+#endif
+            if (inSize > fileBytes)
+            {
+                close();
+                fail(inFilename, "file is smaller than the requested " + utils::num2str(inSize) + " bytes in");
+            }
+            size_ = inSize == 0 ? fileBytes : inSize;
+            if (size_ == 0)
+            {
+                // nothing to map, an empty file is a valid empty array
+                return;
+            }
+
+#ifdef _WIN32
+            const DWORD protect = inMode == MapMode::READ_ONLY ? PAGE_READONLY :
+                (inMode == MapMode::COPY_ON_WRITE ? PAGE_WRITECOPY : PAGE_READWRITE);
+            const DWORD access = inMode == MapMode::READ_ONLY ? FILE_MAP_READ :
+                (inMode == MapMode::COPY_ON_WRITE ? FILE_MAP_COPY : FILE_MAP_WRITE);
+            mapping_ = CreateFileMappingA(file_, nullptr, protect, 0, 0, nullptr);
+            data_ = mapping_ != nullptr ? MapViewOfFile(mapping_, access, 0, 0, static_cast<SIZE_T>(size_)) : nullptr;
+            if (data_ == nullptr)
+            {
+                const uint64 size = size_;
+                size_ = 0;
+                close();
+                fail(inFilename, "unable to map " + utils::num2str(size) + " bytes of");
+            }
+#else
+            const int protect = inMode == MapMode::READ_ONLY ? PROT_READ : PROT_READ | PROT_WRITE;
+            const int share = inMode == MapMode::COPY_ON_WRITE ? MAP_PRIVATE : MAP_SHARED;
+            data_ = mmap(nullptr, static_cast<size_t>(size_), protect, share, file_, 0);
+            if (data_ == MAP_FAILED)
+            {
+                data_ = nullptr;
+                const uint64 size = size_;
+                close();
+                fail(inFilename, "unable to map " + utils::num2str(size) + " bytes of");
+            }
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile()
+        {
+            close();
+        }
+
+        //============================================================================
+        /// 映射区域的起始地址（按页对齐）
+        ///
+        /// @return     uint8*
+        ///
+        uint8* data() const noexcept
+        {
+            return static_cast<uint8*>(data_);
+        }
+
+        //============================================================================
+        /// 把修改同步写回文件（READ_WRITE/CREATE 模式）
+        ///
+        void flush() const
+        {
+            if (data_ == nullptr || mode_ == MapMode::READ_ONLY || mode_ == MapMode::COPY_ON_WRITE)
+            {
+                return;
+            }
+
+#ifdef _WIN32
+            const bool ok = FlushViewOfFile(data_, 0) && FlushFileBuffers(file_);
+#else
+            const bool ok = msync(data_, static_cast<size_t>(size_), MS_SYNC) == 0;
+#endif
+            if (!ok)
+            {
+                std::string errStr = "ERROR: MappedFile::flush: unable to write the mapping back to disk.";
+                std::cerr << errStr << std::endl;
+                throw std::runtime_error(errStr);
+            }
+        }
+
+        MapMode mode() const noexcept
+        {
+            return mode_;
+        }
+
+        uint64 size() const noexcept
+        {
+            return size_;
+        }
+    };
+}
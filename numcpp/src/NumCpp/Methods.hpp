@@ -1,9 +1,13 @@
 #pragma once
 
+#include"NumCpp/AsyncIo.hpp"
+#include"NumCpp/CompressedArray.hpp"
 #include"NumCpp/Constants.hpp"
 #include"NumCpp/DtypeInfo.hpp"
 #include"NumCpp/NdArray.hpp"
 #include"NumCpp/Polynomial.hpp"
+#include"NumCpp/Text.hpp"
+#include"NumCpp/ThreadPool.hpp"
 #include"NumCpp/Types.hpp"
 
 #include<algorithm>
@@ -11,8 +15,10 @@
 #include<cmath>
 #include<fstream>
 #include<functional>
+#include<future>
 #include<initializer_list>
 #include<iostream>
+#include<memory>
 #include<set>
 #include<sstream>
 #include<stdexcept>
@@ -34,15 +40,27 @@ namespace nc
     template<typename dtype>
     NdArray<bool> all(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
 
+    template<typename dtype>
+    NdArray<bool> all(const NdArray<dtype>& inArray, int32 inAxis);
+
     template<typename dtype>
     NdArray<dtype> amax(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
 
+    template<typename dtype>
+    NdArray<dtype> amax(const NdArray<dtype>& inArray, int32 inAxis);
+
     template<typename dtype>
     NdArray<dtype> amin(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
 
+    template<typename dtype>
+    NdArray<dtype> amin(const NdArray<dtype>& inArray, int32 inAxis);
+
     template<typename dtype>
     NdArray<bool> any(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
 
+    template<typename dtype>
+    NdArray<bool> any(const NdArray<dtype>& inArray, int32 inAxis);
+
     template<typename dtype>
     NdArray<dtype> append(const NdArray<dtype>& inArray, const NdArray<dtype>& inAppendValues, Axis inAxis = Axis::NONE);
 
@@ -56,13 +74,19 @@ namespace nc
     NdArray<dtype> arange(const Slice& inSlice);
 
     template<typename dtype>
-    NdArray<uint32> argmax(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
+    NdArray<uint64> argmax(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
 
     template<typename dtype>
-    NdArray<uint32> argmin(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
+    NdArray<uint64> argmax(const NdArray<dtype>& inArray, int32 inAxis);
 
     template<typename dtype>
-    NdArray<uint32> argsort(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
+    NdArray<uint64> argmin(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
+
+    template<typename dtype>
+    NdArray<uint64> argmin(const NdArray<dtype>& inArray, int32 inAxis);
+
+    template<typename dtype>
+    NdArray<uint64> argsort(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
 
     template<typename dtype>
     NdArray<dtype> copy(const NdArray<dtype>& inArray);
@@ -70,6 +94,111 @@ namespace nc
     template<typename dtypeOut, typename dtype>
     NdArray<dtypeOut> dot(const NdArray<dtype>& inArray1, const NdArray<dtype>& inArray2);
 
+    template<typename dtype>
+    NdArray<dtype> empty(uint64 inNumRows, uint64 inNumCols);
+
+    template<typename dtype>
+    NdArray<dtype> empty(const Shape& inShape);
+
+    template<typename dtype>
+    NdArray<dtype> fromfile(const std::string& inFilename, Endian inEndianess = Endian::NATIVE);
+
+    template<typename dtype>
+    NdArray<dtype> full(uint64 inNumRows, uint64 inNumCols, dtype inFillValue);
+
+    template<typename dtype>
+    NdArray<dtype> full(const Shape& inShape, dtype inFillValue);
+
+    template<typename dtype>
+    NdArray<double> mean(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
+
+    template<typename dtype>
+    NdArray<double> mean(const NdArray<dtype>& inArray, int32 inAxis);
+
+    template<typename dtype>
+    NdArray<dtype> load(const std::string& inFilename);
+
+    template<typename dtype>
+    NdArray<dtype> load(const std::string& inFilename, MapMode inMode);
+
+    template<typename dtype>
+    std::future<NdArray<dtype>> loadAsync(const std::string& inFilename);
+
+    template<typename dtype>
+    NdArray<dtype> loadcompressed(const std::string& inFilename);
+
+    template<typename dtype>
+    NdArray<dtype> loadcompressed(const std::string& inFilename, uint64 inFirstRow, uint64 inNumRows);
+
+    template<typename dtype>
+    NdArray<dtype> loadtxt(const std::string& inFilename, char inDelimiter = ' ', uint64 inSkipRows = 0);
+
+    template<typename dtype>
+    NdArray<dtype> memmap(const std::string& inFilename, const Shape& inShape, MapMode inMode = MapMode::READ_ONLY, uint64 inOffset = 0);
+
+    template<typename dtype>
+    NdArray<dtype> memmap(const std::string& inFilename, MapMode inMode = MapMode::READ_ONLY, uint64 inOffset = 0);
+
+    template<typename dtype>
+    NdArray<double> nanmean(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
+
+    template<typename dtype>
+    NdArray<double> nanmean(const NdArray<dtype>& inArray, int32 inAxis);
+
+    template<typename dtype>
+    NdArray<dtype> nansum(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
+
+    template<typename dtype>
+    NdArray<dtype> nansum(const NdArray<dtype>& inArray, int32 inAxis);
+
+    template<typename dtype>
+    NdArray<dtype> ones(uint64 inNumRows, uint64 inNumCols);
+
+    template<typename dtype>
+    NdArray<dtype> ones(const Shape& inShape);
+
+    template<typename dtype>
+    NdArray<dtype> prod(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
+
+    template<typename dtype>
+    NdArray<dtype> prod(const NdArray<dtype>& inArray, int32 inAxis);
+
+    template<typename dtype>
+    void save(const std::string& inFilename, const NdArray<dtype>& inArray);
+
+    template<typename dtype>
+    std::future<void> saveAsync(const std::string& inFilename, NdArray<dtype> inArray);
+
+    template<typename dtype>
+    void savecompressed(const std::string& inFilename, const NdArray<dtype>& inArray, Codec inCodec = Codec::AUTO, uint32 inRowsPerBlock = 0);
+
+    template<typename dtype>
+    void savetxt(const std::string& inFilename, const NdArray<dtype>& inArray, char inDelimiter = ' ', const std::string& inHeader = "");
+
+    template<typename dtype>
+    NdArray<double> stdev(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
+
+    template<typename dtype>
+    NdArray<double> stdev(const NdArray<dtype>& inArray, int32 inAxis);
+
+    template<typename dtype>
+    NdArray<dtype> sum(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
+
+    template<typename dtype>
+    NdArray<dtype> sum(const NdArray<dtype>& inArray, int32 inAxis);
+
+    template<typename dtype>
+    NdArray<double> var(const NdArray<dtype>& inArray, Axis inAxis = Axis::NONE);
+
+    template<typename dtype>
+    NdArray<double> var(const NdArray<dtype>& inArray, int32 inAxis);
+
+    template<typename dtype>
+    NdArray<dtype> zeros(uint64 inNumRows, uint64 inNumCols);
+
+    template<typename dtype>
+    NdArray<dtype> zeros(const Shape& inShape);
+
     template<typename dtypeOut = double, typename dtype>
     NdArray<dtypeOut> dot(const NdArray<dtype>& inArray1, const NdArray<dtype>& inArray2)
     {
@@ -81,11 +210,23 @@ namespace nc
     {
         NdArray<double> returnArray(inArray.shape());
         std::transform(inArray.cbegin(), inArray.cend(), returnArray.begin(),
-                       [](dtype inValue) noexcept -> double { return sin(inValue); });
+                       [](dtype inValue) noexcept -> double { return std::sin(inValue); });
 
         return std::move(returnArray);
     }
 
+    template<typename dtype>
+    NdArray<typename NdArrayView<dtype>::value_type> copy(const NdArrayView<dtype>& inView)
+    {
+        return std::move(inView.copy());
+    }
+
+    template<typename dtypeOut = double, typename dtype1, typename dtype2>
+    NdArray<dtypeOut> dot(const NdArrayView<dtype1>& inView1, const NdArrayView<dtype2>& inView2)
+    {
+        return std::move(inView1.template dot<dtypeOut>(inView2));
+    }
+
     template<typename dtype>
     NdArray<dtype> copy(const NdArray<dtype>& inArray)
     {
@@ -120,24 +261,96 @@ namespace nc
         return std::move(inArray.all(inAxis));
     }
 
+    template<typename dtype>
+    NdArray<bool> all(const NdArray<dtype>& inArray, int32 inAxis)
+    {
+        return std::move(inArray.all(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<bool> all(const NdArrayView<dtype>& inView, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inView.all(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<bool> all(const NdArrayView<dtype>& inView, int32 inAxis)
+    {
+        return std::move(inView.all(inAxis));
+    }
+
     template<typename dtype>
     NdArray<dtype> amax(const NdArray<dtype>& inArray, Axis inAxis)
     {
         return std::move(inArray.max(inAxis));
     }
 
+    template<typename dtype>
+    NdArray<dtype> amax(const NdArray<dtype>& inArray, int32 inAxis)
+    {
+        return std::move(inArray.max(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<typename NdArrayView<dtype>::value_type> amax(const NdArrayView<dtype>& inView, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inView.max(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<typename NdArrayView<dtype>::value_type> amax(const NdArrayView<dtype>& inView, int32 inAxis)
+    {
+        return std::move(inView.max(inAxis));
+    }
+
     template<typename dtype>
     NdArray<dtype> amin(const NdArray<dtype>& inArray, Axis inAxis)
     {
         return std::move(inArray.min(inAxis));
     }
 
+    template<typename dtype>
+    NdArray<dtype> amin(const NdArray<dtype>& inArray, int32 inAxis)
+    {
+        return std::move(inArray.min(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<typename NdArrayView<dtype>::value_type> amin(const NdArrayView<dtype>& inView, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inView.min(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<typename NdArrayView<dtype>::value_type> amin(const NdArrayView<dtype>& inView, int32 inAxis)
+    {
+        return std::move(inView.min(inAxis));
+    }
+
     template<typename dtype>
     NdArray<bool> any(const NdArray<dtype>& inArray, Axis inAxis)
     {
         return std::move(inArray.any(inAxis));
     }
 
+    template<typename dtype>
+    NdArray<bool> any(const NdArray<dtype>& inArray, int32 inAxis)
+    {
+        return std::move(inArray.any(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<bool> any(const NdArrayView<dtype>& inView, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inView.any(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<bool> any(const NdArrayView<dtype>& inView, int32 inAxis)
+    {
+        return std::move(inView.any(inAxis));
+    }
+
     template<typename dtype>
     NdArray<dtype> append(const NdArray<dtype>& inArray, const NdArray<dtype>& inAppendValues, Axis inAxis)
     {
@@ -180,7 +393,7 @@ namespace nc
                 }
 
                 NdArray<dtype> returnArray(inShape.rows, inShape.cols + appendShape.cols);
-                for (uint32 row = 0; row < returnArray.shape().rows; ++row)
+                for (uint64 row = 0; row < returnArray.shape().rows; ++row)
                 {
                     std::copy(inArray.cbegin(row), inArray.cend(row), returnArray.begin(row));
                     std::copy(inAppendValues.cbegin(row), inAppendValues.cend(row), returnArray.begin(row) + inShape.cols);
@@ -258,21 +471,892 @@ namespace nc
     }
 
     template<typename dtype>
-    NdArray<uint32> argmax(const NdArray<dtype>& inArray, Axis inAxis)
+    NdArray<uint64> argmax(const NdArray<dtype>& inArray, Axis inAxis)
+    {
+        return std::move(inArray.argmax(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<uint64> argmax(const NdArray<dtype>& inArray, int32 inAxis)
     {
         return std::move(inArray.argmax(inAxis));
     }
 
     template<typename dtype>
-    NdArray<uint32> argmin(const NdArray<dtype>& inArray, Axis inAxis)
+    NdArray<uint64> argmax(const NdArrayView<dtype>& inView, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inView.argmax(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<uint64> argmax(const NdArrayView<dtype>& inView, int32 inAxis)
+    {
+        return std::move(inView.argmax(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<uint64> argmin(const NdArray<dtype>& inArray, Axis inAxis)
+    {
+        return std::move(inArray.argmin(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<uint64> argmin(const NdArray<dtype>& inArray, int32 inAxis)
     {
         return std::move(inArray.argmin(inAxis));
     }
 
     template<typename dtype>
-    NdArray<uint32> argsort(const NdArray<dtype>& inArray, Axis inAxis)
+    NdArray<uint64> argmin(const NdArrayView<dtype>& inView, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inView.argmin(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<uint64> argmin(const NdArrayView<dtype>& inView, int32 inAxis)
+    {
+        return std::move(inView.argmin(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<uint64> argsort(const NdArray<dtype>& inArray, Axis inAxis)
     {
         return std::move(inArray.argsort(inAxis));
     }
 
+    template<typename dtype>
+    NdArray<double> mean(const NdArray<dtype>& inArray, Axis inAxis)
+    {
+        return std::move(inArray.mean(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<double> mean(const NdArray<dtype>& inArray, int32 inAxis)
+    {
+        return std::move(inArray.mean(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<double> nanmean(const NdArray<dtype>& inArray, Axis inAxis)
+    {
+        return std::move(inArray.nanmean(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<double> nanmean(const NdArray<dtype>& inArray, int32 inAxis)
+    {
+        return std::move(inArray.nanmean(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<dtype> nansum(const NdArray<dtype>& inArray, Axis inAxis)
+    {
+        return std::move(inArray.nansum(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<dtype> nansum(const NdArray<dtype>& inArray, int32 inAxis)
+    {
+        return std::move(inArray.nansum(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<dtype> prod(const NdArray<dtype>& inArray, Axis inAxis)
+    {
+        return std::move(inArray.prod(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<dtype> prod(const NdArray<dtype>& inArray, int32 inAxis)
+    {
+        return std::move(inArray.prod(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<double> stdev(const NdArray<dtype>& inArray, Axis inAxis)
+    {
+        return std::move(inArray.stdev(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<double> stdev(const NdArray<dtype>& inArray, int32 inAxis)
+    {
+        return std::move(inArray.stdev(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<dtype> sum(const NdArray<dtype>& inArray, Axis inAxis)
+    {
+        return std::move(inArray.sum(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<dtype> sum(const NdArray<dtype>& inArray, int32 inAxis)
+    {
+        return std::move(inArray.sum(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<double> var(const NdArray<dtype>& inArray, Axis inAxis)
+    {
+        return std::move(inArray.var(inAxis));
+    }
+
+    template<typename dtype>
+    NdArray<double> var(const NdArray<dtype>& inArray, int32 inAxis)
+    {
+        return std::move(inArray.var(inAxis));
+    }
+
+    //============================================================================
+    // 运算结果为表达式时的重载：求值后转发给接受 NdArray 的版本，使 nc::amax(a * 2 + 1) 等调用仍能编译
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> all(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inExpr.all(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> all(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, int32 inAxis)
+    {
+        return std::move(inExpr.all(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename Lhs::value_type> amax(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inExpr.max(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename Lhs::value_type> amax(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, int32 inAxis)
+    {
+        return std::move(inExpr.max(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename Lhs::value_type> amin(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inExpr.min(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename Lhs::value_type> amin(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, int32 inAxis)
+    {
+        return std::move(inExpr.min(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> any(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inExpr.any(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> any(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, int32 inAxis)
+    {
+        return std::move(inExpr.any(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<uint64> argmax(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inExpr.argmax(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<uint64> argmax(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, int32 inAxis)
+    {
+        return std::move(inExpr.argmax(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<uint64> argmin(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inExpr.argmin(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<uint64> argmin(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, int32 inAxis)
+    {
+        return std::move(inExpr.argmin(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> mean(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inExpr.mean(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> mean(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, int32 inAxis)
+    {
+        return std::move(inExpr.mean(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> nanmean(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inExpr.nanmean(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> nanmean(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, int32 inAxis)
+    {
+        return std::move(inExpr.nanmean(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename Lhs::value_type> nansum(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inExpr.nansum(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename Lhs::value_type> nansum(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, int32 inAxis)
+    {
+        return std::move(inExpr.nansum(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename Lhs::value_type> prod(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inExpr.prod(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename Lhs::value_type> prod(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, int32 inAxis)
+    {
+        return std::move(inExpr.prod(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> stdev(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inExpr.stdev(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> stdev(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, int32 inAxis)
+    {
+        return std::move(inExpr.stdev(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename Lhs::value_type> sum(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inExpr.sum(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename Lhs::value_type> sum(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, int32 inAxis)
+    {
+        return std::move(inExpr.sum(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> var(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inExpr.var(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> var(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, int32 inAxis)
+    {
+        return std::move(inExpr.var(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<uint64> argsort(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr, Axis inAxis = Axis::NONE)
+    {
+        return std::move(inExpr.argsort(inAxis));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename Lhs::value_type> copy(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr)
+    {
+        return std::move(inExpr.eval());
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename Lhs::value_type> abs(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr)
+    {
+        return std::move(abs(inExpr.eval()));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> sin(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr)
+    {
+        return std::move(sin(inExpr.eval()));
+    }
+
+    template<typename dtypeOut = double, typename A, typename B,
+        typename = typename std::enable_if<expr::IsExpression<A>::value || expr::IsExpression<B>::value>::type>
+    NdArray<dtypeOut> add(const A& inArray1, const B& inArray2)
+    {
+        return std::move(add<dtypeOut>(expr::materialize(inArray1), expr::materialize(inArray2)));
+    }
+
+    template<typename A, typename B,
+        typename = typename std::enable_if<expr::IsExpression<A>::value || expr::IsExpression<B>::value>::type>
+    NdArray<typename expr::Operand<A>::value_type> append(const A& inArray, const B& inAppendValues, Axis inAxis = Axis::NONE)
+    {
+        return std::move(append(expr::materialize(inArray), expr::materialize(inAppendValues), inAxis));
+    }
+
+    template<typename dtypeOut = double, typename A, typename B,
+        typename = typename std::enable_if<expr::IsExpression<A>::value || expr::IsExpression<B>::value>::type>
+    NdArray<dtypeOut> dot(const A& inArray1, const B& inArray2)
+    {
+        return std::move(dot<dtypeOut>(expr::materialize(inArray1), expr::materialize(inArray2)));
+    }
+
+    //============================================================================
+    /// 未初始化的数组，元素值不确定
+    ///
+    /// @param      inShape
+    ///
+    /// @return     NdArray
+    ///
+    template<typename dtype>
+    NdArray<dtype> empty(const Shape& inShape)
+    {
+        return std::move(NdArray<dtype>(inShape));
+    }
+
+    template<typename dtype>
+    NdArray<dtype> empty(uint64 inNumRows, uint64 inNumCols)
+    {
+        return std::move(empty<dtype>(Shape(inNumRows, inNumCols)));
+    }
+
+    //============================================================================
+    /// 所有元素为 inFillValue 的数组，分配与填充一次完成
+    ///
+    /// @param      inShape
+    /// @param      inFillValue
+    ///
+    /// @return     NdArray
+    ///
+    template<typename dtype>
+    NdArray<dtype> full(const Shape& inShape, dtype inFillValue)
+    {
+        return std::move(NdArray<dtype>(inShape, inFillValue));
+    }
+
+    template<typename dtype>
+    NdArray<dtype> full(uint64 inNumRows, uint64 inNumCols, dtype inFillValue)
+    {
+        return std::move(full<dtype>(Shape(inNumRows, inNumCols), inFillValue));
+    }
+
+    template<typename dtype>
+    NdArray<dtype> ones(const Shape& inShape)
+    {
+        return std::move(full<dtype>(inShape, static_cast<dtype>(1)));
+    }
+
+    template<typename dtype>
+    NdArray<dtype> ones(uint64 inNumRows, uint64 inNumCols)
+    {
+        return std::move(full<dtype>(Shape(inNumRows, inNumCols), static_cast<dtype>(1)));
+    }
+
+    //============================================================================
+    /// 全零数组，直接从分配器取得清零内存（默认分配器使用 calloc），不再单独写一遍
+    ///
+    /// @param      inShape
+    ///
+    /// @return     NdArray
+    ///
+    template<typename dtype>
+    NdArray<dtype> zeros(const Shape& inShape)
+    {
+        return std::move(full<dtype>(inShape, static_cast<dtype>(0)));
+    }
+
+    template<typename dtype>
+    NdArray<dtype> zeros(uint64 inNumRows, uint64 inNumCols)
+    {
+        return std::move(full<dtype>(Shape(inNumRows, inNumCols), static_cast<dtype>(0)));
+    }
+
+    //============================================================================
+    /// 把文件 inFilename 中从 inOffset 字节开始的数据映射为 inShape 形状的数组，不复制数据。
+    /// READ_ONLY 映射的页面不可写，原地写入和取得可写视图都会抛出异常，只能通过 const 引用读取；
+    /// READ_WRITE 的修改直接写回文件，多个进程映射同一文件时共享同一份物理内存；
+    /// CREATE 创建 inOffset + 数据大小字节的文件，文件头部分由调用者写入。
+    /// 移动赋值或改变大小的赋值会让数组改用新的缓冲区，要写入文件请用 view() = 或 fill
+    ///
+    /// @param      inFilename
+    /// @param      inShape
+    /// @param      inMode
+    /// @param      inOffset: 文件头的字节数
+    ///
+    /// @return     NdArray
+    ///
+    template<typename dtype>
+    NdArray<dtype> memmap(const std::string& inFilename, const Shape& inShape, MapMode inMode, uint64 inOffset)
+    {
+        const uint64 numBytes = inOffset + static_cast<uint64>(inShape.size()) * sizeof(dtype);
+        auto mapping = std::make_shared<MappedFile>(inFilename, inMode, numBytes);
+        return std::move(NdArray<dtype>(std::move(mapping), inShape, inOffset));
+    }
+
+    //============================================================================
+    /// 把文件 inFilename 中 inOffset 字节之后的全部数据映射为 1 x n 的数组
+    ///
+    /// @param      inFilename
+    /// @param      inMode
+    /// @param      inOffset
+    ///
+    /// @return     NdArray
+    ///
+    template<typename dtype>
+    NdArray<dtype> memmap(const std::string& inFilename, MapMode inMode, uint64 inOffset)
+    {
+        if (inMode == MapMode::CREATE)
+        {
+            std::string errStr = "ERROR: memmap: a shape is required to create a mapped file.";
+            std::cerr << errStr << std::endl;
+            throw std::invalid_argument(errStr);
+        }
+
+        auto mapping = std::make_shared<MappedFile>(inFilename, inMode);
+        if (inOffset > mapping->size() || (mapping->size() - inOffset) % sizeof(dtype) != 0)
+        {
+            std::string errStr = "ERROR: memmap: file size is not a whole number of elements after the offset.";
+            std::cerr << errStr << std::endl;
+            throw std::invalid_argument(errStr);
+        }
+
+        const uint64 numElements = (mapping->size() - inOffset) / sizeof(dtype);
+        return std::move(NdArray<dtype>(std::move(mapping), Shape(1, numElements), inOffset));
+    }
+
+    //============================================================================
+    /// 读取 tofile 写出的原始二进制文件为 1 x n 的数组，
+    /// 文件按 inEndianess 字节序存放时边读边转换为本机字节序
+    ///
+    /// @param      inFilename
+    /// @param      inEndianess
+    ///
+    /// @return     NdArray
+    ///
+    template<typename dtype>
+    NdArray<dtype> fromfile(const std::string& inFilename, Endian inEndianess)
+    {
+        std::ifstream file(inFilename, std::ios::in | std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            std::string errStr = "ERROR: fromfile: unable to open '" + inFilename + "'.";
+            std::cerr << errStr << std::endl;
+            throw std::runtime_error(errStr);
+        }
+
+        const uint64 numBytes = static_cast<uint64>(file.tellg());
+        if (numBytes % sizeof(dtype) != 0)
+        {
+            std::string errStr = "ERROR: fromfile: size of '" + inFilename + "' is not a whole number of elements.";
+            std::cerr << errStr << std::endl;
+            throw std::invalid_argument(errStr);
+        }
+        file.seekg(0);
+
+        NdArray<dtype> returnArray(1, numBytes / sizeof(dtype));
+        io::readArray(file, returnArray.begin(), returnArray.size(), inEndianess, inFilename);
+
+        return std::move(returnArray);
+    }
+
+    //============================================================================
+    /// 读取 .npy 文件（v1/v2/v3），按大块直接读入数组缓冲区；
+    /// 非本机字节序的数据边读边交换，Fortran 顺序的数据读入后转置为行优先
+    ///
+    /// @param      inFilename
+    ///
+    /// @return     NdArray
+    ///
+    template<typename dtype>
+    NdArray<dtype> load(const std::string& inFilename)
+    {
+        std::ifstream file(inFilename, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+        {
+            std::string errStr = "ERROR: load: unable to open '" + inFilename + "'.";
+            std::cerr << errStr << std::endl;
+            throw std::runtime_error(errStr);
+        }
+
+        const io::NpyHeader header = io::readNpyHeader<dtype>(file, inFilename);
+        const Shape shape = io::npyShape(header);
+        if (!header.fortranOrder)
+        {
+            NdArray<dtype> returnArray(shape);
+            io::readArray(file, returnArray.begin(), returnArray.size(), header.endianess, inFilename);
+            return std::move(returnArray);
+        }
+
+        NdArray<dtype> columnMajor(shape.reversed());
+        io::readArray(file, columnMajor.begin(), columnMajor.size(), header.endianess, inFilename);
+        return std::move(NdArray<dtype>(columnMajor.transpose()));
+    }
+
+    //============================================================================
+    /// 把 .npy 文件的数据部分映射为数组，不读入内存，见 memmap。
+    /// 要求数据为行优先且为本机字节序
+    ///
+    /// @param      inFilename
+    /// @param      inMode: 不能为 MapMode::CREATE
+    ///
+    /// @return     NdArray
+    ///
+    template<typename dtype>
+    NdArray<dtype> load(const std::string& inFilename, MapMode inMode)
+    {
+        std::ifstream file(inFilename, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+        {
+            std::string errStr = "ERROR: load: unable to open '" + inFilename + "'.";
+            std::cerr << errStr << std::endl;
+            throw std::runtime_error(errStr);
+        }
+
+        const io::NpyHeader header = io::readNpyHeader<dtype>(file, inFilename);
+        file.close();
+        if (inMode == MapMode::CREATE || header.fortranOrder || io::needsSwap(header.endianess))
+        {
+            std::string errStr = "ERROR: load: '" + inFilename + "' can only be mapped when it holds native endian, C ordered data and the mode is not CREATE.";
+            std::cerr << errStr << std::endl;
+            throw std::invalid_argument(errStr);
+        }
+
+        return std::move(memmap<dtype>(inFilename, io::npyShape(header), inMode, header.dataOffset));
+    }
+
+    //============================================================================
+    /// 把数组保存为 .npy 文件，缓冲区按 inArray.endianess() 的字节序原样写出
+    ///
+    /// @param      inFilename
+    /// @param      inArray
+    ///
+    template<typename dtype>
+    void save(const std::string& inFilename, const NdArray<dtype>& inArray)
+    {
+        std::ofstream file(inFilename, std::ios::out | std::ios::binary);
+        if (!file.is_open())
+        {
+            std::string errStr = "ERROR: save: unable to open '" + inFilename + "'.";
+            std::cerr << errStr << std::endl;
+            throw std::runtime_error(errStr);
+        }
+
+        io::writeNpyHeader<dtype>(file, inArray.shape(), inArray.endianess(), inFilename);
+        io::writeBytes(file, inArray.cbegin(), static_cast<uint64>(inArray.size()) * sizeof(dtype), inFilename);
+    }
+
+    //============================================================================
+    /// 异步读取 .npy 文件，见 load。文件头在调用线程中读取并校验，
+    /// 数据由 io::AsyncIo 在后台读入，返回时读取已经开始
+    ///
+    /// @param      inFilename
+    ///
+    /// @return     std::future<NdArray>
+    ///
+    template<typename dtype>
+    std::future<NdArray<dtype>> loadAsync(const std::string& inFilename)
+    {
+        std::ifstream headerFile(inFilename, std::ios::in | std::ios::binary);
+        if (!headerFile.is_open())
+        {
+            std::string errStr = "ERROR: loadAsync: unable to open '" + inFilename + "'.";
+            std::cerr << errStr << std::endl;
+            throw std::runtime_error(errStr);
+        }
+
+        const io::NpyHeader header = io::readNpyHeader<dtype>(headerFile, inFilename);
+        const Shape shape = io::npyShape(header);
+        headerFile.close();
+
+        auto file = std::make_shared<const io::File>(inFilename, io::FileMode::READ);
+        auto array = std::make_shared<NdArray<dtype>>(header.fortranOrder ? shape.reversed() : shape);
+        auto promise = std::make_shared<std::promise<NdArray<dtype>>>();
+        std::future<NdArray<dtype>> returnFuture = promise->get_future();
+
+        io::AsyncIo::instance().submit(false, std::move(file),
+            { { array->begin(), static_cast<uint64>(array->size()) * sizeof(dtype), header.dataOffset } },
+            [array, promise, header](std::exception_ptr inError)
+            {
+                if (inError != nullptr)
+                {
+                    promise->set_exception(inError);
+                    return;
+                }
+
+                try
+                {
+                    if (io::needsSwap(header.endianess))
+                    {
+                        io::byteswap(array->begin(), array->size());
+                    }
+                    promise->set_value(header.fortranOrder ? NdArray<dtype>(array->transpose()) : std::move(*array));
+                }
+                catch (...)
+                {
+                    promise->set_exception(std::current_exception());
+                }
+            });
+
+        return returnFuture;
+    }
+
+    //============================================================================
+    /// 异步保存为 .npy 文件，见 save。inArray 按值传入（可移入以免复制），
+    /// 由写请求持有直到写完
+    ///
+    /// @param      inFilename
+    /// @param      inArray
+    ///
+    /// @return     std::future<void>
+    ///
+    template<typename dtype>
+    std::future<void> saveAsync(const std::string& inFilename, NdArray<dtype> inArray)
+    {
+        auto header = std::make_shared<std::string>();
+        {
+            std::ostringstream headerStream;
+            io::writeNpyHeader<dtype>(headerStream, inArray.shape(), inArray.endianess(), inFilename);
+            *header = headerStream.str();
+        }
+
+        auto file = std::make_shared<const io::File>(inFilename, io::FileMode::WRITE);
+        auto array = std::make_shared<NdArray<dtype>>(std::move(inArray));
+        auto promise = std::make_shared<std::promise<void>>();
+        std::future<void> returnFuture = promise->get_future();
+
+        const std::vector<io::AsyncIo::Segment> segments = {
+            { &(*header)[0], header->size(), 0 },
+            { array->begin(), static_cast<uint64>(array->size()) * sizeof(dtype), header->size() } };
+        io::AsyncIo::instance().submit(true, std::move(file), segments, [header, array, promise](std::exception_ptr inError)
+        {
+            inError != nullptr ? promise->set_exception(inError) : promise->set_value();
+        });
+
+        return returnFuture;
+    }
+
+    //============================================================================
+    /// 读取 savecompressed 写出的压缩数组
+    ///
+    /// @param      inFilename
+    ///
+    /// @return     NdArray
+    ///
+    template<typename dtype>
+    NdArray<dtype> loadcompressed(const std::string& inFilename)
+    {
+        return std::move(CompressedArray<dtype>(inFilename).read());
+    }
+
+    //============================================================================
+    /// 只读取压缩数组中第 inFirstRow 行起的 inNumRows 行，见 CompressedArray::rows
+    ///
+    /// @param      inFilename
+    /// @param      inFirstRow
+    /// @param      inNumRows
+    ///
+    /// @return     NdArray
+    ///
+    template<typename dtype>
+    NdArray<dtype> loadcompressed(const std::string& inFilename, uint64 inFirstRow, uint64 inNumRows)
+    {
+        return std::move(CompressedArray<dtype>(inFilename).rows(inFirstRow, inNumRows));
+    }
+
+    //============================================================================
+    /// 分块压缩保存数组，见 CompressedArray::save
+    ///
+    /// @param      inFilename
+    /// @param      inArray
+    /// @param      inCodec
+    /// @param      inRowsPerBlock: 为 0 时取约 1 MB 的行数
+    ///
+    template<typename dtype>
+    void savecompressed(const std::string& inFilename, const NdArray<dtype>& inArray, Codec inCodec, uint32 inRowsPerBlock)
+    {
+        CompressedArray<dtype>::save(inFilename, inArray, inCodec, inRowsPerBlock);
+    }
+
+    //============================================================================
+    /// 读取文本文件为二维数组，每个数据行为一行。空行与 '#' 开头的注释行被忽略，
+    /// 行内 '#' 之后为注释。文件被映射到内存后分块并行解析，解析结果直接写入数组
+    ///
+    /// @param      inFilename
+    /// @param      inDelimiter: 数之间的分隔符，' ' 表示任意长度的空格或制表符
+    /// @param      inSkipRows: 跳过文件开头的行数（如表头）
+    ///
+    /// @return     NdArray
+    ///
+    template<typename dtype>
+    NdArray<dtype> loadtxt(const std::string& inFilename, char inDelimiter, uint64 inSkipRows)
+    {
+        MappedFile file(inFilename, MapMode::READ_ONLY);
+        const char* first = reinterpret_cast<const char*>(file.data());
+        const char* last = first + file.size();
+
+        for (uint64 row = 0; row < inSkipRows && first != last; ++row)
+        {
+            text::lineEnd(first, last, first);
+        }
+
+        // the first data line fixes the number of columns
+        const char* firstData = first;
+        uint64 numCols = 0;
+        while (firstData != last && numCols == 0)
+        {
+            const char* next;
+            const char* stop = text::lineEnd(firstData, last, next);
+            if (text::isDataLine(firstData, stop))
+            {
+                NdArray<dtype> values(1, static_cast<uint64>(stop - firstData) / 2 + 1);
+                numCols = text::parseLine(firstData, stop, inDelimiter, values.begin(), values.size());
+            }
+            else
+            {
+                firstData = next;
+            }
+        }
+        if (numCols == 0)
+        {
+            return std::move(NdArray<dtype>());
+        }
+
+        // split into chunks that start at line boundaries
+        std::vector<const char*> bounds(1, firstData);
+        while (bounds.back() != last)
+        {
+            const char* chunkEnd = bounds.back() + std::min<uint64>(text::CHUNK_BYTES, static_cast<uint64>(last - bounds.back()));
+            if (chunkEnd != last)
+            {
+                text::lineEnd(chunkEnd, last, chunkEnd);
+            }
+            bounds.push_back(chunkEnd);
+        }
+        const uint32 numChunks = static_cast<uint32>(bounds.size() - 1);
+
+        // first pass counts the rows of every chunk, second pass parses each chunk straight into place
+        std::vector<uint64> rowOffsets(numChunks + 1, 0);
+        ThreadPool::instance().parallelFor(numChunks, [&bounds, &rowOffsets](uint32 inChunk, uint32)
+        {
+            rowOffsets[inChunk + 1] = text::countDataLines(bounds[inChunk], bounds[inChunk + 1]);
+        });
+        for (uint32 chunk = 0; chunk < numChunks; ++chunk)
+        {
+            rowOffsets[chunk + 1] += rowOffsets[chunk];
+        }
+
+        NdArray<dtype> returnArray(rowOffsets.back(), numCols);
+        dtype* values = returnArray.begin();
+        ThreadPool::instance().parallelFor(numChunks, [&bounds, &rowOffsets, values, numCols, inDelimiter](uint32 inChunk, uint32)
+        {
+            dtype* rowValues = values + rowOffsets[inChunk] * numCols;
+            const char* line = bounds[inChunk];
+            while (line != bounds[inChunk + 1])
+            {
+                const char* next;
+                const char* stop = text::lineEnd(line, bounds[inChunk + 1], next);
+                if (text::isDataLine(line, stop))
+                {
+                    if (text::parseLine(line, stop, inDelimiter, rowValues, numCols) != numCols)
+                    {
+                        std::string errStr = "ERROR: loadtxt: line \"" + std::string(line, std::min<uint64>(stop - line, 80))
+                            + "\" does not have " + utils::num2str(numCols) + " values.";
+                        std::cerr << errStr << std::endl;
+                        throw std::runtime_error(errStr);
+                    }
+                    rowValues += numCols;
+                }
+                line = next;
+            }
+        });
+
+        return std::move(returnArray);
+    }
+
+    //============================================================================
+    /// 把数组写为文本文件，每行一行，浮点数取能精确读回的最短表示。
+    /// 行块在线程池中并行格式化后按顺序写出
+    ///
+    /// @param      inFilename
+    /// @param      inArray
+    /// @param      inDelimiter
+    /// @param      inHeader: 非空时逐行加上 "# " 前缀写在文件开头
+    ///
+    template<typename dtype>
+    void savetxt(const std::string& inFilename, const NdArray<dtype>& inArray, char inDelimiter, const std::string& inHeader)
+    {
+        std::ofstream file(inFilename, std::ios::out | std::ios::binary);
+        if (!file.is_open())
+        {
+            std::string errStr = "ERROR: savetxt: unable to open '" + inFilename + "'.";
+            std::cerr << errStr << std::endl;
+            throw std::runtime_error(errStr);
+        }
+
+        if (!inHeader.empty())
+        {
+            std::string header = "# ";
+            for (char character : inHeader)
+            {
+                header += character;
+                if (character == '\n')
+                {
+                    header += "# ";
+                }
+            }
+            header += '\n';
+            io::writeBytes(file, header.data(), header.size(), inFilename);
+        }
+
+        const Shape shape = inArray.shape();
+        if (shape.cols == 0)
+        {
+            return;
+        }
+
+        const uint64 rowsPerBlock = std::max<uint64>(text::FORMAT_BLOCK / shape.cols, 1);
+        const uint64 numBlocks = (shape.rows + rowsPerBlock - 1) / rowsPerBlock;
+        const uint32 blocksPerRound = getNumThreads() * 4;
+        std::vector<std::string> buffers(std::min<uint64>(blocksPerRound, numBlocks));
+
+        for (uint64 roundStart = 0; roundStart < numBlocks; roundStart += blocksPerRound)
+        {
+            const uint32 roundBlocks = static_cast<uint32>(std::min<uint64>(blocksPerRound, numBlocks - roundStart));
+            ThreadPool::instance().parallelFor(roundBlocks, [&](uint32 inBlock, uint32)
+            {
+                const uint64 firstRow = (roundStart + inBlock) * rowsPerBlock;
+                const uint64 lastRow = std::min(firstRow + rowsPerBlock, shape.rows);
+                std::string& buffer = buffers[inBlock];
+                buffer.resize((lastRow - firstRow) * shape.cols * (text::MAX_CHARS + 1));
+
+                char* cursor = &buffer[0];
+                const dtype* values = inArray.cbegin() + firstRow * shape.cols;
+                for (uint64 row = firstRow; row < lastRow; ++row)
+                {
+                    for (uint64 col = 0; col < shape.cols; ++col)
+                    {
+                        cursor += text::format(*values++, cursor);
+                        *cursor++ = col + 1 == shape.cols ? '\n' : inDelimiter;
+                    }
+                }
+                buffer.resize(static_cast<uint64>(cursor - &buffer[0]));
+            });
+
+            for (uint32 block = 0; block < roundBlocks; ++block)
+            {
+                io::writeBytes(file, buffers[block].data(), buffers[block].size(), inFilename);
+            }
+        }
+    }
 }
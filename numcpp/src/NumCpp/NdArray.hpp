@@ -1,52 +1,293 @@
 #pragma once
 
+#include"NumCpp/Allocator.hpp"
 #include"NumCpp/DtypeInfo.hpp"
+#include"NumCpp/Expression.hpp"
+#include"NumCpp/Gemm.hpp"
+#include"NumCpp/Io.hpp"
+#include"NumCpp/MappedFile.hpp"
+#include"NumCpp/Reduce.hpp"
 #include"NumCpp/Shape.hpp"
+#include"NumCpp/Simd.hpp"
 #include"NumCpp/Slice.hpp"
+#include"NumCpp/Text.hpp"
 #include"NumCpp/Types.hpp"
 #include"NumCpp/Utils.hpp"
 #include"NumCpp/Constants.hpp"
 
 #include<algorithm>
 #include<cmath>
+#include<cstdint>
+#include<cstring>
 #include<deque>
 #include<functional>
 #include<fstream>
 #include<initializer_list>
 #include<iostream>
+#include<memory>
+#include<new>
 #include<numeric>
 #include<set>
 #include<stdexcept>
 #include<string>
+#include<type_traits>
 #include<utility>
 #include<vector>
 
 namespace nc
 {
+    template<typename dtype>
+    class NdArrayView;
+
     template<typename dtype>
     class NdArray
     {
     public:
 
+        typedef dtype			value_type;
         typedef dtype*			iterator;
         typedef const dtype*	const_iterator;
 
+        // 缓冲区起始地址的对齐字节数
+        static constexpr uint64 ALIGNMENT = alignof(dtype) > BUFFER_ALIGNMENT ? alignof(dtype) : BUFFER_ALIGNMENT;
+
     private:
 
         Shape			shape_{ 0, 0 };
-        uint32			size_{ 0 };
+        uint64			size_{ 0 };
         Endian          endianess_{ Endian::NATIVE };
+        Allocator*      allocator_{ currentAllocator() };
         dtype*			array_{ nullptr };
+        std::shared_ptr<MappedFile> mapping_;   // 非空时 array_ 指向映射的文件，不由 allocator_ 管理
+
+        dtype* allocateArray(uint64 inSize, bool inZeroed = false)
+        {
+            const uint64 numBytes = inSize * sizeof(dtype);
+            dtype* array = static_cast<dtype*>(inZeroed ? allocator_->allocateZeroed(numBytes, ALIGNMENT) : allocator_->allocate(numBytes, ALIGNMENT));
+            if (!std::is_trivially_default_constructible<dtype>::value)
+            {
+                for (uint64 i = 0; i < inSize; ++i)
+                {
+                    new (array + i) dtype();
+                }
+            }
+            return array;
+        }
+
+        static bool isZeroBits(const dtype& inValue) noexcept
+        {
+            if (!std::is_arithmetic<dtype>::value)
+            {
+                return false;
+            }
+
+            const dtype zero = static_cast<dtype>(0);
+            return std::memcmp(&inValue, &zero, sizeof(dtype)) == 0;
+        }
 
         void deleteArray() noexcept
         {
-            if (array_ != nullptr)
+            if (mapping_ != nullptr)
             {
-                delete[] array_;
+                // the pages belong to the file, dropping the last reference unmaps them
+                mapping_.reset();
                 array_ = nullptr;
                 shape_ = Shape(0, 0);
                 size_ = 0;
             }
+            else if (array_ != nullptr)
+            {
+                if (!std::is_trivially_destructible<dtype>::value)
+                {
+                    for (uint64 i = 0; i < size_; ++i)
+                    {
+                        array_[i].~dtype();
+                    }
+                }
+                allocator_->deallocate(array_, size_ * sizeof(dtype), ALIGNMENT);
+                array_ = nullptr;
+                shape_ = Shape(0, 0);
+                size_ = 0;
+            }
+        }
+
+        //============================================================================
+        /// 只读映射的页面不能写入，原地修改元素的操作先调用本函数
+        ///
+        /// @param      inFunctionName
+        ///
+        void checkWritable(const std::string& inFunctionName) const
+        {
+            if (!writable())
+            {
+                std::string errStr = "ERROR: NdArray::" + inFunctionName + ": array is a read-only memory map.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+        }
+
+        bool writable() const noexcept
+        {
+            return mapping_ == nullptr || mapping_->mode() != MapMode::READ_ONLY;
+        }
+
+        //============================================================================
+        /// 复合赋值的结果写回本数组，因此另一个操作数只能被广播到本数组的形状
+        ///
+        /// @param      inShape
+        /// @param      inFunctionName
+        ///
+        void checkBroadcastsTo(const Shape& inShape, const std::string& inFunctionName) const
+        {
+            Shape shape;
+            if (!inShape.broadcast(shape_, shape) || shape != shape_)
+            {
+                const std::string from = inShape.str();
+                const std::string to = shape_.str();
+                std::string errStr = "ERROR: NdArray::" + inFunctionName + ": operand with shape " + from.substr(0, from.size() - 1) +
+                    " cannot be broadcast to shape " + to.substr(0, to.size() - 1) + ".";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+        }
+
+        //============================================================================
+        /// 与 inOtherArray 逐元素比较，形状不同时按 NumPy 规则广播，被广播的操作数跨步为 0
+        ///
+        /// @param      inOtherArray
+        /// @param      inFunctionName
+        ///
+        /// @return     NdArray<bool>
+        ///
+        template<typename Op>
+        NdArray<bool> compareWith(const NdArray<dtype>& inOtherArray, const std::string& inFunctionName) const
+        {
+            if (shape_ == inOtherArray.shape_)
+            {
+                NdArray<bool> returnArray(shape_);
+                simd::compare<Op, false, false>(cbegin(), inOtherArray.cbegin(), returnArray.begin(), size_);
+                return std::move(returnArray);
+            }
+
+            Shape shape;
+            if (!shape_.broadcast(inOtherArray.shape_, shape))
+            {
+                const std::string lhs = shape_.str();
+                const std::string rhs = inOtherArray.shape_.str();
+                std::string errStr = "ERROR: NdArray::" + inFunctionName + ": operands could not be broadcast together with shapes " +
+                    lhs.substr(0, lhs.size() - 1) + " and " + rhs.substr(0, rhs.size() - 1) + ".";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+
+            // one kernel call per row, an operand whose last dimension is broadcast is a scalar for the row
+            NdArray<bool> returnArray(shape);
+            const expr::Broadcast lhsMap(shape_, shape);
+            const expr::Broadcast rhsMap(inOtherArray.shape_, shape);
+            for (uint64 row = 0; row < shape.rows; ++row)
+            {
+                simd::compare<Op>(array_ + lhsMap.rowOffset(row), lhsMap.rowConstant(), inOtherArray.array_ + rhsMap.rowOffset(row),
+                    rhsMap.rowConstant(), returnArray.begin() + row * shape.cols, shape.cols);
+            }
+            return std::move(returnArray);
+        }
+
+        template<typename Op, typename Map>
+        NdArray<typename Op::value_type> reduceWith(Axis inAxis, const Map& inMap) const
+        {
+            NdArray<typename Op::value_type> returnArray(reduce::resultShape(shape_, inAxis));
+            reduce::reduce<Op>(array_, shape_, inAxis, inMap, returnArray.begin());
+            return std::move(returnArray);
+        }
+
+        template<typename Op, typename Map>
+        NdArray<typename Op::value_type> reduceWith(int32 inAxis, const Map& inMap) const
+        {
+            const uint32 axis = shape_.axis(inAxis);
+            NdArray<typename Op::value_type> returnArray(reduce::resultShape(shape_, axis));
+            reduce::reduce<Op>(array_, shape_, axis, inMap, returnArray.begin());
+            return std::move(returnArray);
+        }
+
+        template<typename Better>
+        NdArray<uint64> argReduceWith(int32 inAxis, Better inBetter) const
+        {
+            const uint32 axis = shape_.axis(inAxis);
+            NdArray<uint64> returnArray(reduce::resultShape(shape_, axis));
+            reduce::argReduce(array_, shape_, axis, inBetter, returnArray.begin());
+            return std::move(returnArray);
+        }
+
+        uint64 reducedLength(Axis inAxis) const noexcept
+        {
+            switch (inAxis)
+            {
+                case Axis::COL:
+                    return shape_.cols;
+                case Axis::ROW:
+                    return shape_.rows;
+                default:
+                    return size_;
+            }
+        }
+
+        uint64 reducedLength(int32 inAxis) const
+        {
+            return shape_[shape_.axis(inAxis)];
+        }
+
+        uint64 offsetOf(std::initializer_list<int64> inIndices) const noexcept
+        {
+            uint64 offset = 0;
+            uint32 axis = 0;
+            for (int64 index : inIndices)
+            {
+                const uint64 dim = shape_[axis];
+                offset = offset * dim + static_cast<uint64>(index < 0 ? index + static_cast<int64>(dim) : index);
+                ++axis;
+            }
+            return offset;
+        }
+
+        // 二维切片按矩阵视角进行，与数组的维数无关
+        NdArrayView<dtype> matrixView() noexcept
+        {
+            return NdArrayView<dtype>(array_, Shape(shape_.rows, shape_.cols), shape_.cols, 1);
+        }
+
+        NdArrayView<const dtype> matrixView() const noexcept
+        {
+            return NdArrayView<const dtype>(array_, Shape(shape_.rows, shape_.cols), shape_.cols, 1);
+        }
+
+        // 以嵌套方括号输出第 inAxis 维及之后各维，inOffset 为该子数组首元素的下标
+        void appendStr(std::string& ioOut, uint32 inAxis, uint64 inOffset) const
+        {
+            const uint64 dim = shape_[inAxis];
+            ioOut += "[";
+            if (inAxis + 1 == shape_.ndim())
+            {
+                char buffer[text::MAX_CHARS];
+                for (uint64 i = 0; i < dim; ++i)
+                {
+                    ioOut.append(buffer, text::format(array_[inOffset + i], buffer));
+                    ioOut += ", ";
+                }
+            }
+            else
+            {
+                const uint64 stride = shape_.stride(inAxis);
+                for (uint64 i = 0; i < dim; ++i)
+                {
+                    if (i > 0)
+                    {
+                        // numpy style, one extra blank line per enclosing dimension
+                        ioOut.append(shape_.ndim() - inAxis - 1, '\n');
+                    }
+                    appendStr(ioOut, inAxis + 1, inOffset + i * stride);
+                }
+            }
+            ioOut += "]";
         }
 
         void newArray(const Shape& inShape)
@@ -56,49 +297,67 @@ namespace nc
             shape_ = inShape;
             size_ = inShape.size();
             endianess_ = Endian::NATIVE;
-            array_ = new dtype[size_];
+            array_ = allocateArray(size_);
         }
 
     public:
 
         NdArray() = default;
 
-        explicit NdArray(uint32 inSquareSize) :
+        explicit NdArray(uint64 inSquareSize) :
             shape_(inSquareSize, inSquareSize),
             size_(inSquareSize * inSquareSize),
-            array_(new dtype[size_])
+            array_(allocateArray(size_))
         {};
 
-        NdArray(uint32 inNumRows, uint32 inNumCols) :
+        NdArray(uint64 inNumRows, uint64 inNumCols) :
             shape_(inNumRows, inNumCols),
             size_(inNumRows * inNumCols),
-            array_(new dtype[size_])
+            array_(allocateArray(size_))
         {};
 
         explicit NdArray(const Shape& inShape) :
             shape_(inShape),
             size_(shape_.size()),
-            array_(new dtype[size_])
+            array_(allocateArray(size_))
         {};
 
+        //============================================================================
+        /// 构造并把所有元素设为 inFillValue。算术类型的 0 直接向分配器申请清零内存，
+        /// 其余值用 simd::fill 填充，大数组使用非临时存储
+        ///
+        /// @param      inShape
+        /// @param      inFillValue
+        ///
+        NdArray(const Shape& inShape, dtype inFillValue) :
+            shape_(inShape),
+            size_(shape_.size()),
+            array_(allocateArray(size_, isZeroBits(inFillValue)))
+        {
+            if (!isZeroBits(inFillValue))
+            {
+                fill(inFillValue);
+            }
+        }
+
         NdArray(const std::initializer_list<dtype>& inList) :
-            shape_(1, static_cast<uint32>(inList.size())),
+            shape_(1, static_cast<uint64>(inList.size())),
             size_(shape_.size()),
-            array_(new dtype[size_])
+            array_(allocateArray(size_))
         {
             std::copy(inList.begin(), inList.end(), array_);
         }
 
         NdArray(const std::initializer_list<std::initializer_list<dtype> >& inList) :
-            shape_(static_cast<uint32>(inList.size()), 0)
+            shape_(static_cast<uint64>(inList.size()), 0)
         {
             for (auto& list : inList)
             {
-                size_ += static_cast<uint32>(list.size());
+                size_ += static_cast<uint64>(list.size());
 
                 if (shape_.cols == 0)
                 {
-                    shape_.cols = static_cast<uint32>(list.size());
+                    shape_.cols = static_cast<uint64>(list.size());
                 }
                 else if (list.size() != shape_.cols)
                 {
@@ -108,8 +367,8 @@ namespace nc
                 }
             }
 
-            array_ = new dtype[size_];
-            uint32 row = 0;
+            array_ = allocateArray(size_);
+            uint64 row = 0;
             for (auto& list : inList)
             {
                 std::copy(list.begin(), list.end(), array_ + row * shape_.cols);
@@ -118,43 +377,43 @@ namespace nc
         }
 
         explicit NdArray(const std::vector<dtype>& inVector) :
-            shape_(1, static_cast<uint32>(inVector.size())),
+            shape_(1, static_cast<uint64>(inVector.size())),
             size_(shape_.size()),
-            array_(new dtype[size_])
+            array_(allocateArray(size_))
         {
             std::copy(inVector.begin(), inVector.end(), array_);
         }
 
         explicit NdArray(const std::deque<dtype>& inDeque) :
-            shape_(1, static_cast<uint32>(inDeque.size())),
+            shape_(1, static_cast<uint64>(inDeque.size())),
             size_(shape_.size()),
-            array_(new dtype[size_])
+            array_(allocateArray(size_))
         {
             std::copy(inDeque.begin(), inDeque.end(), array_);
         }
 
         explicit NdArray(const std::set<dtype>& inSet) :
-            shape_(1, static_cast<uint32>(inSet.size())),
+            shape_(1, static_cast<uint64>(inSet.size())),
             size_(shape_.size()),
-            array_(new dtype[size_])
+            array_(allocateArray(size_))
         {
             std::copy(inSet.begin(), inSet.end(), array_);
         }
 
         explicit NdArray(const_iterator inFirst, const_iterator inLast) :
-            shape_(1, static_cast<uint32>(inLast - inFirst)),
+            shape_(1, static_cast<uint64>(inLast - inFirst)),
             size_(shape_.size()),
-            array_(new dtype[size_])
+            array_(allocateArray(size_))
         {
             std::copy(inFirst, inLast, array_);
         }
 
-        NdArray(const dtype* inBeginning, uint32 inNumBytes) :
+        NdArray(const dtype* inBeginning, uint64 inNumBytes) :
             shape_(1, inNumBytes / sizeof(dtype)),
             size_(shape_.size()),
-            array_(new dtype[size_])
+            array_(allocateArray(size_))
         {
-            for (uint32 i = 0; i < size_; ++i)
+            for (uint64 i = 0; i < size_; ++i)
             {
                 array_[i] = *(inBeginning + i);
             }
@@ -164,7 +423,7 @@ namespace nc
             shape_(inOtherArray.shape_),
             size_(inOtherArray.size_),
             endianess_(inOtherArray.endianess_),
-            array_(new dtype[inOtherArray.size_])
+            array_(allocateArray(inOtherArray.size_))
         {
             std::copy(inOtherArray.cbegin(), inOtherArray.cend(), begin());
         }
@@ -173,12 +432,64 @@ namespace nc
             shape_(inOtherArray.shape_),
             size_(inOtherArray.size_),
             endianess_(inOtherArray.endianess_),
-            array_(inOtherArray.array_)
+            allocator_(inOtherArray.allocator_),
+            array_(inOtherArray.array_),
+            mapping_(std::move(inOtherArray.mapping_))
         {
-            inOtherArray.shape_.rows = inOtherArray.shape_.cols = inOtherArray.size_ = 0;
+            inOtherArray.shape_ = Shape(0, 0);
+            inOtherArray.size_ = 0;
             inOtherArray.array_ = nullptr;
         }
 
+        //============================================================================
+        /// 以 inMapping 映射的文件中从 inOffset 字节开始的数据作为数组缓冲区，不复制数据。
+        /// 多个数组可以共享同一个映射，最后一个数组销毁时解除映射
+        ///
+        /// @param      inMapping
+        /// @param      inShape
+        /// @param      inOffset: 数据在文件中的字节偏移，跳过文件头
+        ///
+        NdArray(std::shared_ptr<MappedFile> inMapping, const Shape& inShape, uint64 inOffset = 0) :
+            shape_(inShape),
+            size_(inShape.size())
+        {
+            static_assert(std::is_trivially_copyable<dtype>::value, "Only trivially copyable dtypes can be memory mapped.");
+
+            const uint64 numBytes = size_ * sizeof(dtype);
+            if (inMapping == nullptr || inOffset + numBytes > inMapping->size())
+            {
+                std::string errStr = "ERROR: NdArray: mapped file is too small for the requested shape.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+            if (inOffset % alignof(dtype) != 0)
+            {
+                std::string errStr = "ERROR: NdArray: mapped data offset must be a multiple of the dtype alignment.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+
+            if (size_ > 0)
+            {
+                array_ = reinterpret_cast<dtype*>(inMapping->data() + inOffset);
+                mapping_ = std::move(inMapping);
+            }
+            else
+            {
+                shape_ = Shape(0, 0);
+            }
+        }
+
+        template<typename Op, typename Lhs, typename Rhs>
+        NdArray(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr) :
+            shape_(inExpr.shape()),
+            size_(shape_.size()),
+            array_(allocateArray(size_))
+        {
+            static_assert(std::is_same<typename Lhs::value_type, dtype>::value, "Expression dtype does not match the NdArray dtype.");
+            expr::evaluate(inExpr, array_);
+        }
+
         ~NdArray()
         {
             deleteArray();
@@ -186,7 +497,20 @@ namespace nc
 
         NdArray<dtype>& operator=(const NdArray<dtype>& inOtherArray)
         {
-            newArray(inOtherArray.shape_);
+            if (&inOtherArray == this)
+            {
+                return *this;
+            }
+
+            if (size_ == inOtherArray.size_ && array_ != nullptr && writable())
+            {
+                // same number of elements, reuse the existing buffer (a writable mapping writes through to the file)
+                shape_ = inOtherArray.shape_;
+            }
+            else
+            {
+                newArray(inOtherArray.shape_);
+            }
             endianess_ = inOtherArray.endianess_;
 
             std::copy(inOtherArray.cbegin(), inOtherArray.cend(), begin());
@@ -196,6 +520,7 @@ namespace nc
 
         NdArray<dtype>& operator=(dtype inValue)
         {
+            checkWritable("operator=");
             std::fill(begin(), end(), inValue);
 
             return *this;
@@ -209,16 +534,33 @@ namespace nc
                 shape_ = inOtherArray.shape_;
                 size_ = inOtherArray.size_;
                 endianess_ = inOtherArray.endianess_;
+                allocator_ = inOtherArray.allocator_;
                 array_ = inOtherArray.array_;
+                mapping_ = std::move(inOtherArray.mapping_);
 
-                inOtherArray.shape_.rows = inOtherArray.shape_.cols = inOtherArray.size_ = 0;
+                inOtherArray.shape_ = Shape(0, 0);
+                inOtherArray.size_ = 0;
                 inOtherArray.array_ = nullptr;
             }
 
             return *this;
         }
 
-        dtype& operator[](int32 inIndex) noexcept
+        template<typename Op, typename Lhs, typename Rhs>
+        NdArray<dtype>& operator=(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr)
+        {
+            if (inExpr.shape() != shape_ || !writable() || inExpr.broadcastOverlaps(array_, array_ + size_))
+            {
+                // the expression may reference this array, so evaluate before releasing the buffer;
+                // a broadcast or strided operand inside this array would also read elements already overwritten
+                return *this = NdArray<dtype>(inExpr);
+            }
+
+            expr::evaluate(inExpr, array_);
+            return *this;
+        }
+
+        dtype& operator[](int64 inIndex) noexcept
         {
             if (inIndex < 0)
             {
@@ -228,7 +570,7 @@ namespace nc
             return array_[inIndex];
         }
 
-        const dtype& operator[](int32 inIndex) const noexcept
+        const dtype& operator[](int64 inIndex) const noexcept
         {
             if (inIndex < 0)
             {
@@ -238,7 +580,7 @@ namespace nc
             return array_[inIndex];
         }
 
-        dtype& operator()(int32 inRowIndex, int32 inColIndex) noexcept
+        dtype& operator()(int64 inRowIndex, int64 inColIndex) noexcept
         {
             if (inRowIndex < 0)
             {
@@ -253,7 +595,7 @@ namespace nc
             return array_[inRowIndex * shape_.cols + inColIndex];
         }
 
-        const dtype& operator()(int32 inRowIndex, int32 inColIndex) const noexcept
+        const dtype& operator()(int64 inRowIndex, int64 inColIndex) const noexcept
         {
             if (inRowIndex < 0)
             {
@@ -268,18 +610,39 @@ namespace nc
             return array_[inRowIndex * shape_.cols + inColIndex];
         }
 
-        NdArray<dtype> operator[](const Slice& inSlice) const
+        //============================================================================
+        /// 按各维下标访问元素，例如 a({ i, j, k })，下标个数须等于维数，负数从末尾倒数，不做越界检查
+        ///
+        /// @param      inIndices
+        ///
+        /// @return     dtype&
+        ///
+        dtype& operator()(std::initializer_list<int64> inIndices) noexcept
         {
-            Slice inSliceCopy(inSlice);
+            return array_[offsetOf(inIndices)];
+        }
 
-            uint32 counter = 0;
-            NdArray<dtype> returnArray(1, inSliceCopy.numElements(size_));
-            for (int32 i = inSliceCopy.start; i < inSliceCopy.stop; i += inSliceCopy.step)
-            {
-                returnArray[counter++] = at(i);
-            }
+        const dtype& operator()(std::initializer_list<int64> inIndices) const noexcept
+        {
+            return array_[offsetOf(inIndices)];
+        }
 
-            return std::move(returnArray);
+        //============================================================================
+        /// 切片返回引用本数组数据的视图，不复制元素；需要独立副本时调用视图的 copy()
+        ///
+        /// @param      inSlice
+        ///
+        /// @return     NdArrayView
+        ///
+        NdArrayView<dtype> operator[](const Slice& inSlice)
+        {
+            checkWritable("operator[]");
+            return NdArrayView<dtype>(array_, Shape(1, size_), size_, 1)(0, inSlice);
+        }
+
+        NdArrayView<const dtype> operator[](const Slice& inSlice) const
+        {
+            return NdArrayView<const dtype>(array_, Shape(1, size_), size_, 1)(0, inSlice);
         }
 
         NdArray<dtype> operator[](const NdArray<bool> inMask) const
@@ -293,7 +656,7 @@ namespace nc
 
             auto indices = inMask.nonzero();
             auto outArray = NdArray<dtype>(1, indices.size());
-            for (uint32 i = 0; i < indices.size(); ++i)
+            for (uint64 i = 0; i < indices.size(); ++i)
             {
                 outArray[i] = this->operator[](indices[i]);
             }
@@ -301,65 +664,45 @@ namespace nc
             return std::move(outArray);
         }
 
-        NdArray<dtype> operator()(const Slice& inRowSlice, const Slice& inColSlice) const
+        NdArrayView<dtype> operator()(const Slice& inRowSlice, const Slice& inColSlice)
         {
-            Slice inRowSliceCopy(inRowSlice);
-            Slice inColSliceCopy(inColSlice);
-
-            NdArray<dtype> returnArray(inRowSliceCopy.numElements(shape_.rows), inColSliceCopy.numElements(shape_.cols));
-
-            uint32 rowCounter = 0;
-            uint32 colCounter = 0;
-            for (int32 row = inRowSliceCopy.start; row < inRowSliceCopy.stop; row += inRowSliceCopy.step)
-            {
-                for (int32 col = inColSliceCopy.start; col < inColSliceCopy.stop; col += inColSliceCopy.step)
-                {
-                    returnArray(rowCounter, colCounter++) = at(row, col);
-                }
-                colCounter = 0;
-                ++rowCounter;
-            }
-
-            return std::move(returnArray);
+            checkWritable("operator()");
+            return matrixView()(inRowSlice, inColSlice);
         }
 
-        NdArray<dtype> operator()(const Slice& inRowSlice, int32 inColIndex) const
+        NdArrayView<const dtype> operator()(const Slice& inRowSlice, const Slice& inColSlice) const
         {
-            Slice inRowSliceCopy(inRowSlice);
-
-            NdArray<dtype> returnArray(inRowSliceCopy.numElements(shape_.rows), 1);
-
-            uint32 rowCounter = 0;
-            for (int32 row = inRowSliceCopy.start; row < inRowSliceCopy.stop; row += inRowSliceCopy.step)
-            {
-                returnArray(rowCounter++, 0) = at(row, inColIndex);
-            }
-
-            return std::move(returnArray);
+            return matrixView()(inRowSlice, inColSlice);
         }
 
-        NdArray<dtype> operator()(int32 inRowIndex, const Slice& inColSlice) const
+        NdArrayView<dtype> operator()(const Slice& inRowSlice, int64 inColIndex)
         {
-            Slice inColSliceCopy(inColSlice);
-
-            NdArray<dtype> returnArray(1, inColSliceCopy.numElements(shape_.cols));
+            checkWritable("operator()");
+            return matrixView()(inRowSlice, inColIndex);
+        }
 
-            uint32 colCounter = 0;
-            for (int32 col = inColSliceCopy.start; col < inColSliceCopy.stop; col += inColSliceCopy.step)
-            {
-                returnArray(0, colCounter++) = at(inRowIndex, col);
-            }
+        NdArrayView<const dtype> operator()(const Slice& inRowSlice, int64 inColIndex) const
+        {
+            return matrixView()(inRowSlice, inColIndex);
+        }
 
-            return std::move(returnArray);
+        NdArrayView<dtype> operator()(int64 inRowIndex, const Slice& inColSlice)
+        {
+            checkWritable("operator()");
+            return matrixView()(inRowIndex, inColSlice);
         }
 
+        NdArrayView<const dtype> operator()(int64 inRowIndex, const Slice& inColSlice) const
+        {
+            return matrixView()(inRowIndex, inColSlice);
+        }
 
         iterator begin() noexcept
         {
             return array_;
         }
 
-        iterator begin(uint32 inRow)
+        iterator begin(uint64 inRow)
         {
             if (inRow >= shape_.rows)
             {
@@ -376,7 +719,7 @@ namespace nc
             return cbegin();
         }
 
-        const_iterator begin(uint32 inRow) const
+        const_iterator begin(uint64 inRow) const
         {
             return cbegin(inRow);
         }
@@ -386,7 +729,7 @@ namespace nc
             return array_ + size_;
         }
 
-        iterator end(uint32 inRow)
+        iterator end(uint64 inRow)
         {
             if (inRow >= shape_.rows)
             {
@@ -403,7 +746,7 @@ namespace nc
             return cend();
         }
 
-        const_iterator end(uint32 inRow) const
+        const_iterator end(uint64 inRow) const
         {
             return cend(inRow);
         }
@@ -413,7 +756,7 @@ namespace nc
             return array_;
         }
 
-        const_iterator cbegin(uint32 inRow) const
+        const_iterator cbegin(uint64 inRow) const
         {
             if (inRow >= shape_.rows)
             {
@@ -430,7 +773,7 @@ namespace nc
             return array_ + size_;
         }
 
-        const_iterator cend(uint32 inRow) const
+        const_iterator cend(uint64 inRow) const
         {
             if (inRow >= shape_.rows)
             {
@@ -454,7 +797,7 @@ namespace nc
                 case Axis::COL:
                 {
                     NdArray<bool> returnArray(1, shape_.rows);
-                    for (uint32 row = 0; row < shape_.rows; ++row)
+                    for (uint64 row = 0; row < shape_.rows; ++row)
                     {
                         returnArray(0, row) = std::all_of(cbegin(row), cend(row),
                             [](dtype i) noexcept -> bool {return i != static_cast<dtype>(0); });
@@ -463,12 +806,17 @@ namespace nc
                 }
                 case Axis::ROW:
                 {
-                    NdArray<dtype> arrayTransposed = transpose();
-                    NdArray<bool> returnArray(1, arrayTransposed.shape_.rows);
-                    for (uint32 row = 0; row < arrayTransposed.shape_.rows; ++row)
+                    // sweep the rows in memory order, accumulating one flag per column
+                    NdArray<bool> returnArray(1, shape_.cols);
+                    returnArray.fill(true);
+                    bool* result = returnArray.begin();
+                    for (uint64 row = 0; row < shape_.rows; ++row)
                     {
-                        returnArray(0, row) = std::all_of(arrayTransposed.cbegin(row), arrayTransposed.cend(row),
-                            [](dtype i) noexcept -> bool {return i != static_cast<dtype>(0); });
+                        const dtype* rowValues = cbegin(row);
+                        for (uint64 col = 0; col < shape_.cols; ++col)
+                        {
+                            result[col] &= rowValues[col] != static_cast<dtype>(0);
+                        }
                     }
                     return std::move(returnArray);
                 }
@@ -481,6 +829,28 @@ namespace nc
             }
         }
 
+        //============================================================================
+        /// 沿第 inAxis 维判断是否全部非零，负数从最后一维倒数，结果去掉该维
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     NdArray<bool>
+        ///
+        NdArray<bool> all(int32 inAxis) const
+        {
+            return std::move(reduceWith<reduce::LogicalAnd>(inAxis, reduce::NonZero()));
+        }
+
+        //============================================================================
+        /// 分配本数组缓冲区的分配器
+        ///
+        /// @return     Allocator*
+        ///
+        Allocator* allocator() const noexcept
+        {
+            return allocator_;
+        }
+
         NdArray<bool> any(Axis inAxis = Axis::NONE) const
         {
             switch (inAxis)
@@ -494,7 +864,7 @@ namespace nc
                 case Axis::COL:
                 {
                     NdArray<bool> returnArray(1, shape_.rows);
-                    for (uint32 row = 0; row < shape_.rows; ++row)
+                    for (uint64 row = 0; row < shape_.rows; ++row)
                     {
                         returnArray(0, row) = std::any_of(cbegin(row), cend(row),
                             [](dtype i) noexcept -> bool {return i != static_cast<dtype>(0); });
@@ -503,12 +873,17 @@ namespace nc
                 }
                 case Axis::ROW:
                 {
-                    NdArray<dtype> arrayTransposed = transpose();
-                    NdArray<bool> returnArray(1, arrayTransposed.shape_.rows);
-                    for (uint32 row = 0; row < arrayTransposed.shape_.rows; ++row)
+                    // sweep the rows in memory order, accumulating one flag per column
+                    NdArray<bool> returnArray(1, shape_.cols);
+                    returnArray.fill(false);
+                    bool* result = returnArray.begin();
+                    for (uint64 row = 0; row < shape_.rows; ++row)
                     {
-                        returnArray(0, row) = std::any_of(arrayTransposed.cbegin(row), arrayTransposed.cend(row),
-                            [](dtype i) noexcept -> bool {return i != static_cast<dtype>(0); });
+                        const dtype* rowValues = cbegin(row);
+                        for (uint64 col = 0; col < shape_.cols; ++col)
+                        {
+                            result[col] |= rowValues[col] != static_cast<dtype>(0);
+                        }
                     }
                     return std::move(returnArray);
                 }
@@ -521,106 +896,146 @@ namespace nc
             }
         }
 
-        NdArray<uint32> argmax(Axis inAxis = Axis::NONE) const
+        NdArray<bool> any(int32 inAxis) const
+        {
+            return std::move(reduceWith<reduce::LogicalOr>(inAxis, reduce::NonZero()));
+        }
+
+        NdArray<uint64> argmax(Axis inAxis = Axis::NONE) const
         {
             switch (inAxis)
             {
                 case Axis::NONE:
                 {
-                    NdArray<uint32> returnArray = { static_cast<uint32>(std::max_element(cbegin(), cend()) - cbegin()) };
+                    NdArray<uint64> returnArray = { static_cast<uint64>(std::max_element(cbegin(), cend()) - cbegin()) };
                     return std::move(returnArray);
                 }
                 case Axis::COL:
                 {
-                    NdArray<uint32> returnArray(1, shape_.rows);
-                    for (uint32 row = 0; row < shape_.rows; ++row)
+                    NdArray<uint64> returnArray(1, shape_.rows);
+                    for (uint64 row = 0; row < shape_.rows; ++row)
                     {
-                        returnArray(0, row) = static_cast<uint32>(std::max_element(cbegin(row), cend(row)) - cbegin(row));
+                        returnArray(0, row) = static_cast<uint64>(std::max_element(cbegin(row), cend(row)) - cbegin(row));
                     }
                     return std::move(returnArray);;
                 }
                 case Axis::ROW:
                 {
-                    NdArray<dtype> arrayTransposed = transpose();
-                    NdArray<uint32> returnArray(1, arrayTransposed.shape_.rows);
-                    for (uint32 row = 0; row < arrayTransposed.shape_.rows; ++row)
+                    // sweep the rows in memory order, tracking the best value of each column
+                    NdArray<uint64> returnArray(1, shape_.cols);
+                    returnArray.fill(0);
+                    std::vector<dtype> bestValues(cbegin(0), cend(0));
+                    for (uint64 row = 1; row < shape_.rows; ++row)
                     {
-                        returnArray(0, row) = static_cast<uint32>(std::max_element(arrayTransposed.cbegin(row),
-                            arrayTransposed.cend(row)) - arrayTransposed.cbegin(row));
+                        const dtype* rowValues = cbegin(row);
+                        for (uint64 col = 0; col < shape_.cols; ++col)
+                        {
+                            if (bestValues[col] < rowValues[col])
+                            {
+                                bestValues[col] = rowValues[col];
+                                returnArray[col] = row;
+                            }
+                        }
                     }
-                    return std::move(returnArray);;
+                    return std::move(returnArray);
                 }
                 default:
                 {
                     // this isn't actually possible, just putting this here to get rid
                     // of the compiler warning.
-                    return std::move(NdArray<uint32>(0));
+                    return std::move(NdArray<uint64>(0));
                 }
             }
         }
 
-        NdArray<uint32> argmin(Axis inAxis = Axis::NONE) const
+        //============================================================================
+        /// 最大值在第 inAxis 维上的下标，按内存顺序扫描
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     NdArray<uint64>
+        ///
+        NdArray<uint64> argmax(int32 inAxis) const
+        {
+            return std::move(argReduceWith(inAxis, [](dtype inValue, dtype inBest) noexcept -> bool { return inBest < inValue; }));
+        }
+
+        NdArray<uint64> argmin(Axis inAxis = Axis::NONE) const
         {
             switch (inAxis)
             {
                 case Axis::NONE:
                 {
-                    NdArray<uint32> returnArray = { static_cast<uint32>(std::min_element(cbegin(), cend()) - cbegin()) };
+                    NdArray<uint64> returnArray = { static_cast<uint64>(std::min_element(cbegin(), cend()) - cbegin()) };
                     return std::move(returnArray);;
                 }
                 case Axis::COL:
                 {
-                    NdArray<uint32> returnArray(1, shape_.rows);
-                    for (uint32 row = 0; row < shape_.rows; ++row)
+                    NdArray<uint64> returnArray(1, shape_.rows);
+                    for (uint64 row = 0; row < shape_.rows; ++row)
                     {
-                        returnArray(0, row) = static_cast<uint32>(std::min_element(cbegin(row), cend(row)) - cbegin(row));
+                        returnArray(0, row) = static_cast<uint64>(std::min_element(cbegin(row), cend(row)) - cbegin(row));
                     }
                     return std::move(returnArray);;
                 }
                 case Axis::ROW:
                 {
-                    NdArray<dtype> arrayTransposed = transpose();
-                    NdArray<uint32> returnArray(1, arrayTransposed.shape_.rows);
-                    for (uint32 row = 0; row < arrayTransposed.shape_.rows; ++row)
+                    // sweep the rows in memory order, tracking the best value of each column
+                    NdArray<uint64> returnArray(1, shape_.cols);
+                    returnArray.fill(0);
+                    std::vector<dtype> bestValues(cbegin(0), cend(0));
+                    for (uint64 row = 1; row < shape_.rows; ++row)
                     {
-                        returnArray(0, row) = static_cast<uint32>(std::min_element(arrayTransposed.cbegin(row),
-                            arrayTransposed.cend(row)) - arrayTransposed.cbegin(row));
+                        const dtype* rowValues = cbegin(row);
+                        for (uint64 col = 0; col < shape_.cols; ++col)
+                        {
+                            if (rowValues[col] < bestValues[col])
+                            {
+                                bestValues[col] = rowValues[col];
+                                returnArray[col] = row;
+                            }
+                        }
                     }
-                    return std::move(returnArray);;
+                    return std::move(returnArray);
                 }
                 default:
                 {
                     // this isn't actually possible, just putting this here to get rid
                     // of the compiler warning.
-                    return std::move(NdArray<uint32>(0));
+                    return std::move(NdArray<uint64>(0));
                 }
             }
         }
 
-        NdArray<uint32> argsort(Axis inAxis = Axis::NONE) const
+        NdArray<uint64> argmin(int32 inAxis) const
+        {
+            return std::move(argReduceWith(inAxis, [](dtype inValue, dtype inBest) noexcept -> bool { return inValue < inBest; }));
+        }
+
+        NdArray<uint64> argsort(Axis inAxis = Axis::NONE) const
         {
             switch (inAxis)
             {
                 case Axis::NONE:
                 {
-                    std::vector<uint32> idx(size_);
+                    std::vector<uint64> idx(size_);
                     std::iota(idx.begin(), idx.end(), 0);
                     std::stable_sort(idx.begin(), idx.end(),
-                        [this](uint32 i1, uint32 i2) noexcept -> bool {return this->array_[i1] < this->array_[i2]; });
-                    return std::move(NdArray<uint32>(idx));
+                        [this](uint64 i1, uint64 i2) noexcept -> bool {return this->array_[i1] < this->array_[i2]; });
+                    return std::move(NdArray<uint64>(idx));
                 }
                 case Axis::COL:
                 {
-                    NdArray<uint32> returnArray(shape_);
-                    for (uint32 row = 0; row < shape_.rows; ++row)
+                    NdArray<uint64> returnArray(shape_);
+                    for (uint64 row = 0; row < shape_.rows; ++row)
                     {
-                        std::vector<uint32> idx(shape_.cols);
+                        std::vector<uint64> idx(shape_.cols);
                         std::iota(idx.begin(), idx.end(), 0);
                         std::stable_sort(idx.begin(), idx.end(),
-                            [this, row](uint32 i1, uint32 i2) noexcept -> bool
+                            [this, row](uint64 i1, uint64 i2) noexcept -> bool
                         {return this->operator()(row, i1) < this->operator()(row, i2); });
 
-                        for (uint32 col = 0; col < shape_.cols; ++col)
+                        for (uint64 col = 0; col < shape_.cols; ++col)
                         {
                             returnArray(row, col) = idx[col];
                         }
@@ -629,83 +1044,238 @@ namespace nc
                 }
                 case Axis::ROW:
                 {
-                    NdArray<dtype> arrayTransposed = transpose();
-                    NdArray<uint32> returnArray(shape_.cols, shape_.rows);
-                    for (uint32 row = 0; row < arrayTransposed.shape_.rows; ++row)
+                    NdArray<uint64> returnArray(shape_);
+                    for (uint64 col = 0; col < shape_.cols; ++col)
                     {
-                        std::vector<uint32> idx(arrayTransposed.shape_.cols);
+                        std::vector<uint64> idx(shape_.rows);
                         std::iota(idx.begin(), idx.end(), 0);
                         std::stable_sort(idx.begin(), idx.end(),
-                            [&arrayTransposed, row](uint32 i1, uint32 i2) noexcept -> bool
-                        {return arrayTransposed(row, i1) < arrayTransposed(row, i2); });
+                            [this, col](uint64 i1, uint64 i2) noexcept -> bool
+                        {return this->operator()(i1, col) < this->operator()(i2, col); });
 
-                        for (uint32 col = 0; col < arrayTransposed.shape_.cols; ++col)
+                        for (uint64 row = 0; row < shape_.rows; ++row)
                         {
-                            returnArray(row, col) = idx[col];
+                            returnArray(row, col) = idx[row];
                         }
                     }
-                    return std::move(returnArray.transpose());
+                    return std::move(returnArray);
                 }
                 default:
                 {
                     // this isn't actually possible, just putting this here to get rid
                     // of the compiler warning.
-                    return std::move(NdArray<uint32>(0));
+                    return std::move(NdArray<uint64>(0));
                 }
             }
         }
 
-        NdArray<dtype> copy() const
+        template<typename dtypeOut>
+        NdArray<dtypeOut> astype() const
         {
-            return std::move(NdArray<dtype>(*this));
+            NdArray<dtypeOut> returnArray(shape_);
+            std::transform(cbegin(), cend(), returnArray.begin(),
+                [](dtype inValue) noexcept -> dtypeOut { return static_cast<dtypeOut>(inValue); });
+
+            return std::move(returnArray);
         }
 
-        template<typename dtypeOut>
-        NdArray<dtypeOut> dot(const NdArray<dtype>& inOtherArray) const
+        //============================================================================
+        /// 原地交换每个元素的字节顺序，并把字节序标记改为相反的一种
+        ///
+        void byteswap()
         {
-            if (shape_ == inOtherArray.shape_ && (shape_.rows == 1 || shape_.cols == 1))
+            checkWritable("byteswap");
+            io::byteswap(array_, size_);
+            endianess_ = io::resolve(endianess_) == Endian::LITTLE ? Endian::BIG : Endian::LITTLE;
+        }
+
+        dtype& at(int64 inIndex)
+        {
+            if (inIndex < 0)
             {
-                dtypeOut dotProduct = std::inner_product(cbegin(), cend(), inOtherArray.cbegin(), static_cast<dtype>(0));
-                NdArray<dtypeOut> returnArray = { dotProduct };
-                return std::move(returnArray);
+                inIndex += size_;
             }
-            else if (shape_.cols == inOtherArray.shape_.rows)
-            {
-                // 2D array, use matrix multiplication
-                NdArray<dtypeOut> returnArray(shape_.rows, inOtherArray.shape_.cols);
-
-                for (uint32 i = 0; i < shape_.rows; ++i)
-                {
-                    for (uint32 j = 0; j < inOtherArray.shape_.cols; ++j)
-                    {
-                        returnArray(i, j) = 0;
-                        for (uint32 k = 0; k < inOtherArray.shape_.rows; ++k)
-                        {
-                            returnArray(i, j) += static_cast<dtypeOut>(this->operator()(i, k)) *
-                                static_cast<dtypeOut>(inOtherArray(k, j));
-                        }
-                    }
-                }
 
-                return std::move(returnArray);
-            }
-            else
+            if (inIndex < 0 || static_cast<uint64>(inIndex) >= size_)
             {
-                std::string errStr = "ERROR: NdArray::Array shapes of [" + utils::num2str(shape_.rows) + ", " + utils::num2str(shape_.cols) + "]";
-                errStr += " and [" + utils::num2str(inOtherArray.shape_.rows) + ", " + utils::num2str(inOtherArray.shape_.cols) + "]";
-                errStr += " are not consistent.";
+                std::string errStr = "ERROR: NdArray::at: Input index " + utils::num2str(inIndex) + " is out of bounds for array of size " + utils::num2str(size_) + ".";
                 std::cerr << errStr << std::endl;
                 throw std::invalid_argument(errStr);
             }
-        }
 
+            return array_[inIndex];
+        }
 
-        bool isempty() const
+        const dtype& at(int64 inIndex) const
         {
-            return size_ == 0;
+            return const_cast<NdArray<dtype>*>(this)->at(inIndex);
         }
 
-        dtype item() const
+        dtype& at(int64 inRowIndex, int64 inColIndex)
+        {
+            if (inRowIndex < 0)
+            {
+                inRowIndex += shape_.rows;
+            }
+
+            if (inColIndex < 0)
+            {
+                inColIndex += shape_.cols;
+            }
+
+            if (inRowIndex < 0 || static_cast<uint64>(inRowIndex) >= shape_.rows ||
+                inColIndex < 0 || static_cast<uint64>(inColIndex) >= shape_.cols)
+            {
+                std::string errStr = "ERROR: NdArray::at: Input index [" + utils::num2str(inRowIndex) + ", " + utils::num2str(inColIndex);
+                errStr += "] is out of bounds for array of shape [" + utils::num2str(shape_.rows) + ", " + utils::num2str(shape_.cols) + "].";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+
+            return array_[inRowIndex * shape_.cols + inColIndex];
+        }
+
+        const dtype& at(int64 inRowIndex, int64 inColIndex) const
+        {
+            return const_cast<NdArray<dtype>*>(this)->at(inRowIndex, inColIndex);
+        }
+
+        NdArray<dtype> copy() const
+        {
+            return std::move(NdArray<dtype>(*this));
+        }
+
+        template<typename dtypeOut>
+        NdArray<dtypeOut> dot(const NdArray<dtype>& inOtherArray) const
+        {
+            if (shape_ == inOtherArray.shape_ && (shape_.rows == 1 || shape_.cols == 1))
+            {
+                dtypeOut dotProduct = std::inner_product(cbegin(), cend(), inOtherArray.cbegin(), static_cast<dtype>(0));
+                NdArray<dtypeOut> returnArray = { dotProduct };
+                return std::move(returnArray);
+            }
+            else if (shape_.cols == inOtherArray.shape_.rows)
+            {
+                // 2D array, use blocked matrix multiplication
+                NdArray<dtypeOut> returnArray(shape_.rows, inOtherArray.shape_.cols);
+                gemm::gemm(shape_.rows, inOtherArray.shape_.cols, shape_.cols, array_, shape_.cols,
+                    inOtherArray.array_, inOtherArray.shape_.cols, returnArray.begin(), returnArray.shape().cols);
+
+                return std::move(returnArray);
+            }
+            else
+            {
+                std::string errStr = "ERROR: NdArray::Array shapes of [" + utils::num2str(shape_.rows) + ", " + utils::num2str(shape_.cols) + "]";
+                errStr += " and [" + utils::num2str(inOtherArray.shape_.rows) + ", " + utils::num2str(inOtherArray.shape_.cols) + "]";
+                errStr += " are not consistent.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+        }
+
+
+        //============================================================================
+        /// 缓冲区中数据的字节序，NATIVE 表示本机字节序
+        ///
+        /// @return     Endian
+        ///
+        Endian endianess() const noexcept
+        {
+            return endianess_;
+        }
+
+        void fill(dtype inFillValue)
+        {
+            checkWritable("fill");
+            simd::fill(array_, inFillValue, size_);
+        }
+
+        //============================================================================
+        /// 把映射文件上的修改同步写回磁盘，未映射文件的数组不做任何事
+        ///
+        void flush() const
+        {
+            if (mapping_ != nullptr)
+            {
+                mapping_->flush();
+            }
+        }
+
+        //============================================================================
+        /// 第一个元素，数组不能为空
+        ///
+        /// @return     dtype
+        ///
+        dtype front() const noexcept
+        {
+            return array_[0];
+        }
+
+        dtype& front() noexcept
+        {
+            return array_[0];
+        }
+
+        //============================================================================
+        /// 最后一个元素，数组不能为空
+        ///
+        /// @return     dtype
+        ///
+        dtype back() const noexcept
+        {
+            return array_[size_ - 1];
+        }
+
+        dtype& back() noexcept
+        {
+            return array_[size_ - 1];
+        }
+
+        bool isempty() const
+        {
+            return size_ == 0;
+        }
+
+        //============================================================================
+        /// 缓冲区起始地址是否按 ALIGNMENT 对齐，由分配器保证，自定义分配器未遵守时为 false
+        ///
+        /// @return     bool
+        ///
+        bool isAligned() const noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(array_) % ALIGNMENT == 0;
+        }
+
+        //============================================================================
+        /// 缓冲区是否为映射的文件
+        ///
+        /// @return     bool
+        ///
+        bool ismapped() const noexcept
+        {
+            return mapping_ != nullptr;
+        }
+
+        //============================================================================
+        /// 按 inEndianess 字节序存放的副本，字节序相同时只复制
+        ///
+        /// @param      inEndianess
+        ///
+        /// @return     NdArray
+        ///
+        NdArray<dtype> newbyteorder(Endian inEndianess) const
+        {
+            NdArray<dtype> returnArray(*this);
+            if (io::resolve(inEndianess) != io::resolve(endianess_))
+            {
+                returnArray.byteswap();
+            }
+            returnArray.endianess_ = inEndianess;
+
+            return std::move(returnArray);
+        }
+
+        dtype item() const
         {
             if (size_ == 1)
             {
@@ -731,7 +1301,7 @@ namespace nc
                 case Axis::COL:
                 {
                     NdArray<dtype> returnArray(1, shape_.rows);
-                    for (uint32 row = 0; row < shape_.rows; ++row)
+                    for (uint64 row = 0; row < shape_.rows; ++row)
                     {
                         returnArray(0, row) = *std::max_element(cbegin(row), cend(row));
                     }
@@ -740,11 +1310,11 @@ namespace nc
                 }
                 case Axis::ROW:
                 {
-                    NdArray<dtype> transposedArray = transpose();
-                    NdArray<dtype> returnArray(1, transposedArray.shape_.rows);
-                    for (uint32 row = 0; row < transposedArray.shape_.rows; ++row)
+                    // sweep the rows in memory order, the running result is one row wide
+                    NdArray<dtype> returnArray(cbegin(0), cend(0));
+                    for (uint64 row = 1; row < shape_.rows; ++row)
                     {
-                        returnArray(0, row) = *std::max_element(transposedArray.cbegin(row), transposedArray.cend(row));
+                        simd::arithmetic<simd::Maximum, false, false>(returnArray.cbegin(), cbegin(row), returnArray.begin(), shape_.cols);
                     }
 
                     return std::move(returnArray);
@@ -758,6 +1328,32 @@ namespace nc
             }
         }
 
+        NdArray<dtype> max(int32 inAxis) const
+        {
+            return std::move(reduceWith<reduce::Max<dtype> >(inAxis, reduce::Cast<dtype>()));
+        }
+
+        //============================================================================
+        /// 均值，先成对求和再除以元素个数
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     NdArray<double>
+        ///
+        NdArray<double> mean(Axis inAxis = Axis::NONE) const
+        {
+            NdArray<double> returnArray = reduceWith<reduce::Sum<double> >(inAxis, reduce::Cast<double>());
+            returnArray /= static_cast<double>(reducedLength(inAxis));
+            return std::move(returnArray);
+        }
+
+        NdArray<double> mean(int32 inAxis) const
+        {
+            NdArray<double> returnArray = reduceWith<reduce::Sum<double> >(inAxis, reduce::Cast<double>());
+            returnArray /= static_cast<double>(reducedLength(inAxis));
+            return std::move(returnArray);
+        }
+
         NdArray<dtype> min(Axis inAxis = Axis::NONE) const
         {
             switch (inAxis)
@@ -770,7 +1366,7 @@ namespace nc
                 case Axis::COL:
                 {
                     NdArray<dtype> returnArray(1, shape_.rows);
-                    for (uint32 row = 0; row < shape_.rows; ++row)
+                    for (uint64 row = 0; row < shape_.rows; ++row)
                     {
                         returnArray(0, row) = *std::min_element(cbegin(row), cend(row));
                     }
@@ -779,11 +1375,11 @@ namespace nc
                 }
                 case Axis::ROW:
                 {
-                    NdArray<dtype> transposedArray = transpose();
-                    NdArray<dtype> returnArray(1, transposedArray.shape_.rows);
-                    for (uint32 row = 0; row < transposedArray.shape_.rows; ++row)
+                    // sweep the rows in memory order, the running result is one row wide
+                    NdArray<dtype> returnArray(cbegin(0), cend(0));
+                    for (uint64 row = 1; row < shape_.rows; ++row)
                     {
-                        returnArray(0, row) = *std::min_element(transposedArray.cbegin(row), transposedArray.cend(row));
+                        simd::arithmetic<simd::Minimum, false, false>(returnArray.cbegin(), cbegin(row), returnArray.begin(), shape_.cols);
                     }
 
                     return std::move(returnArray);
@@ -797,33 +1393,115 @@ namespace nc
             }
         }
 
+        NdArray<dtype> min(int32 inAxis) const
+        {
+            return std::move(reduceWith<reduce::Min<dtype> >(inAxis, reduce::Cast<dtype>()));
+        }
+
         void nans()
         {
             fill(constants::nan);
         }
 
+        //============================================================================
+        /// 忽略 NaN 的均值
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     NdArray<double>
+        ///
+        NdArray<double> nanmean(Axis inAxis = Axis::NONE) const
+        {
+            NdArray<double> returnArray = reduceWith<reduce::Sum<double> >(inAxis, reduce::NanAsZero<double>());
+            returnArray /= reduceWith<reduce::Sum<double> >(inAxis, reduce::NotNanCount<double>());
+            return std::move(returnArray);
+        }
+
+        NdArray<double> nanmean(int32 inAxis) const
+        {
+            NdArray<double> returnArray = reduceWith<reduce::Sum<double> >(inAxis, reduce::NanAsZero<double>());
+            returnArray /= reduceWith<reduce::Sum<double> >(inAxis, reduce::NotNanCount<double>());
+            return std::move(returnArray);
+        }
+
+        //============================================================================
+        /// 忽略 NaN 的求和
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     NdArray
+        ///
+        NdArray<dtype> nansum(Axis inAxis = Axis::NONE) const
+        {
+            return std::move(reduceWith<reduce::Sum<dtype> >(inAxis, reduce::NanAsZero<dtype>()));
+        }
+
+        NdArray<dtype> nansum(int32 inAxis) const
+        {
+            return std::move(reduceWith<reduce::Sum<dtype> >(inAxis, reduce::NanAsZero<dtype>()));
+        }
+
         uint64 nbytes() const noexcept
         {
-            return static_cast<uint64>(sizeof(dtype) * size_);
+            return sizeof(dtype) * size_;
         }
 
-        void reshape(uint32 inNumRows, uint32 inNumCols)
+        NdArray<uint64> nonzero() const
         {
-            if (inNumRows * inNumCols != size_)
+            std::vector<uint64> indices;
+            for (uint64 i = 0; i < size_; ++i)
             {
-                std::string errStr = "ERROR: NdArray::reshape: Cannot reshape array of size " + utils::num2str(size_) + " into shape ";
-                errStr += "[" + utils::num2str(inNumRows) + ", " + utils::num2str(inNumCols) + "]";
+                if (array_[i] != static_cast<dtype>(0))
+                {
+                    indices.push_back(i);
+                }
+            }
+
+            return std::move(NdArray<uint64>(indices));
+        }
+
+        NdArray<dtype> prod(Axis inAxis = Axis::NONE) const
+        {
+            return std::move(reduceWith<reduce::Prod<dtype> >(inAxis, reduce::Cast<dtype>()));
+        }
+
+        NdArray<dtype> prod(int32 inAxis) const
+        {
+            return std::move(reduceWith<reduce::Prod<dtype> >(inAxis, reduce::Cast<dtype>()));
+        }
+
+        void reshape(uint64 inNumRows, uint64 inNumCols)
+        {
+            reshape(Shape(inNumRows, inNumCols));
+        }
+
+        //============================================================================
+        /// 改为任意维数的形状，元素个数必须不变，不移动数据
+        ///
+        /// @param      inShape
+        ///
+        void reshape(const Shape& inShape)
+        {
+            if (inShape.size() != size_)
+            {
+                std::string shapeStr = inShape.str();
+                shapeStr.pop_back();
+                std::string errStr = "ERROR: NdArray::reshape: Cannot reshape array of size " + utils::num2str(size_) + " into shape " + shapeStr;
                 std::cerr << errStr << std::endl;
                 throw std::runtime_error(errStr);
             }
 
-            shape_.rows = inNumRows;
-            shape_.cols = inNumCols;
+            shape_ = inShape;
         }
 
-        void reshape(const Shape& inShape)
+        //============================================================================
+        /// 相邻两行首元素之间的元素个数，NdArray 按行紧密存储，等于列数
+        ///
+        /// @return     uint64
+        ///
+        uint64 rowStride() const noexcept
         {
-            reshape(inShape.rows, inShape.cols);
+            return shape_.cols;
         }
 
         Shape shape() const noexcept
@@ -831,59 +1509,363 @@ namespace nc
             return shape_;
         }
 
-        uint32 size() const noexcept
+        uint64 size() const noexcept
         {
             return size_;
         }
 
-        std::string str() const
+        //============================================================================
+        /// 按维切片，例如 a.slice({ Slice(0, 2), Slice(1, 3) })，
+        /// 未给出的后续各维保留全部元素。返回引用本数组数据的视图
+        ///
+        /// @param      inSlices
+        ///
+        /// @return     NdArrayView
+        ///
+        NdArrayView<dtype> slice(std::initializer_list<Slice> inSlices)
         {
-            std::string out;
-            out += "[";
-            for (uint32 row = 0; row < shape_.rows; ++row)
-            {
-                out += "[";
-                for (uint32 col = 0; col < shape_.cols; ++col)
-                {
-                    out += utils::num2str(this->operator()(row, col)) + ", ";
-                }
+            checkWritable("slice");
+            return view().slice(inSlices);
+        }
 
-                if (row == shape_.rows - 1)
-                {
-                    out += "]";
-                }
-                else
-                {
-                    out += "]\n";
-                }
+        NdArrayView<const dtype> slice(std::initializer_list<Slice> inSlices) const
+        {
+            return view().slice(inSlices);
+        }
+
+        //============================================================================
+        /// 把缓冲区原样（按 endianess() 的字节序，不含形状信息）写入二进制文件
+        ///
+        /// @param      inFilename
+        ///
+        void tofile(const std::string& inFilename) const
+        {
+            std::ofstream file(inFilename, std::ios::out | std::ios::binary);
+            if (!file.is_open())
+            {
+                std::string errStr = "ERROR: NdArray::tofile: unable to open '" + inFilename + "'.";
+                std::cerr << errStr << std::endl;
+                throw std::runtime_error(errStr);
             }
-            out += "]\n";
+
+            io::writeBytes(file, array_, size_ * sizeof(dtype), inFilename);
+        }
+
+        //============================================================================
+        /// 标准差（总体标准差，ddof = 0）
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     NdArray<double>
+        ///
+        NdArray<double> stdev(Axis inAxis = Axis::NONE) const
+        {
+            NdArray<double> returnArray = var(inAxis);
+            std::transform(returnArray.cbegin(), returnArray.cend(), returnArray.begin(),
+                [](double inValue) noexcept -> double { return std::sqrt(inValue); });
+            return std::move(returnArray);
+        }
+
+        NdArray<double> stdev(int32 inAxis) const
+        {
+            NdArray<double> returnArray = var(inAxis);
+            std::transform(returnArray.cbegin(), returnArray.cend(), returnArray.begin(),
+                [](double inValue) noexcept -> double { return std::sqrt(inValue); });
+            return std::move(returnArray);
+        }
+
+        std::string str() const
+        {
+            std::string out;
+            out.reserve(size_ * 8 + shape_.rows * 3 + 3);
+            appendStr(out, 0, 0);
+            out += "\n";
             return out;
         }
 
+        //============================================================================
+        /// 求和，浮点数使用成对求和，大数组并行归约
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     NdArray
+        ///
+        NdArray<dtype> sum(Axis inAxis = Axis::NONE) const
+        {
+            return std::move(reduceWith<reduce::Sum<dtype> >(inAxis, reduce::Cast<dtype>()));
+        }
+
+        //============================================================================
+        /// 沿第 inAxis 维求和，负数从最后一维倒数，结果去掉该维。
+        /// 该维之后各维连续时逐段成对求和，否则按内存顺序逐行累加
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     NdArray
+        ///
+        NdArray<dtype> sum(int32 inAxis) const
+        {
+            return std::move(reduceWith<reduce::Sum<dtype> >(inAxis, reduce::Cast<dtype>()));
+        }
+
+        //============================================================================
+        /// 转置，返回颠倒了各维顺序的视图，不复制数据；需要连续存储时调用视图的 ascontiguous()
+        ///
+        /// @return     NdArrayView
+        ///
+        NdArrayView<dtype> transpose()
+        {
+            checkWritable("transpose");
+            return view().transpose();
+        }
+
+        NdArrayView<const dtype> transpose() const
+        {
+            return view().transpose();
+        }
+
+        //============================================================================
+        /// 按 inAxes 重排各维，结果的第 i 维为本数组的第 inAxes[i] 维，返回视图
+        ///
+        /// @param      inAxes
+        ///
+        /// @return     NdArrayView
+        ///
+        NdArrayView<dtype> transpose(const std::vector<uint32>& inAxes)
+        {
+            checkWritable("transpose");
+            return view().transpose(inAxes);
+        }
+
+        NdArrayView<const dtype> transpose(const std::vector<uint32>& inAxes) const
+        {
+            return view().transpose(inAxes);
+        }
+
+        //============================================================================
+        /// 方差（总体方差，ddof = 0），两遍算法：先求均值再累加离差平方
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     NdArray<double>
+        ///
+        NdArray<double> var(Axis inAxis = Axis::NONE) const
+        {
+            const NdArray<double> means = mean(inAxis);
+            NdArray<double> returnArray = reduceWith<reduce::Sum<double> >(inAxis, reduce::SquaredDeviation<double>{ means.cbegin() });
+            returnArray /= static_cast<double>(reducedLength(inAxis));
+            return std::move(returnArray);
+        }
+
+        NdArray<double> var(int32 inAxis) const
+        {
+            const NdArray<double> means = mean(inAxis);
+            NdArray<double> returnArray = reduceWith<reduce::Sum<double> >(inAxis, reduce::SquaredDeviation<double>{ means.cbegin() });
+            returnArray /= static_cast<double>(reducedLength(inAxis));
+            return std::move(returnArray);
+        }
+
+        //============================================================================
+        /// 返回覆盖整个数组的视图。可写的视图允许修改元素，只读映射的数组调用
+        /// 非 const 版本（包括切片和转置）抛出异常，读取时请通过 const 引用取得视图
+        ///
+        /// @return     NdArrayView
+        ///
+        NdArrayView<dtype> view()
+        {
+            checkWritable("view");
+            return NdArrayView<dtype>(array_, shape_);
+        }
+
+        NdArrayView<const dtype> view() const noexcept
+        {
+            return NdArrayView<const dtype>(array_, shape_);
+        }
+
         void zeros()
         {
+            checkWritable("zeros");
             fill(0);
         }
 
-        NdArray<dtype> operator+(const NdArray<dtype>& inOtherArray) const
+        NdArray<dtype>& operator+=(const NdArray<dtype>& inOtherArray)
+        {
+            checkWritable("operator+=");
+            checkBroadcastsTo(inOtherArray.shape_, "operator+=");
+            if (inOtherArray.shape_ != shape_)
+            {
+                return *this = *this + inOtherArray;
+            }
+            simd::arithmetic<simd::Add, false, false>(cbegin(), inOtherArray.cbegin(), begin(), size_);
+            return *this;
+        }
+
+        template<typename Op, typename Lhs, typename Rhs>
+        NdArray<dtype>& operator+=(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr)
         {
-            return std::move(NdArray<dtype>(*this) += inOtherArray);
+            checkWritable("operator+=");
+            checkBroadcastsTo(inExpr.shape(), "operator+=");
+            return *this = *this + inExpr;
         }
 
-        NdArray<dtype> operator+(dtype inScalar) const
+        NdArray<dtype>& operator+=(dtype inScalar)
         {
-            return std::move(NdArray<dtype>(*this) += inScalar);
+            checkWritable("operator+=");
+            simd::arithmetic<simd::Add, false, true>(cbegin(), &inScalar, begin(), size_);
+            return *this;
+        }
+
+        NdArray<dtype>& operator-=(const NdArray<dtype>& inOtherArray)
+        {
+            checkWritable("operator-=");
+            checkBroadcastsTo(inOtherArray.shape_, "operator-=");
+            if (inOtherArray.shape_ != shape_)
+            {
+                return *this = *this - inOtherArray;
+            }
+            simd::arithmetic<simd::Subtract, false, false>(cbegin(), inOtherArray.cbegin(), begin(), size_);
+            return *this;
+        }
+
+        template<typename Op, typename Lhs, typename Rhs>
+        NdArray<dtype>& operator-=(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr)
+        {
+            checkWritable("operator-=");
+            checkBroadcastsTo(inExpr.shape(), "operator-=");
+            return *this = *this - inExpr;
+        }
+
+        NdArray<dtype>& operator-=(dtype inScalar)
+        {
+            checkWritable("operator-=");
+            simd::arithmetic<simd::Subtract, false, true>(cbegin(), &inScalar, begin(), size_);
+            return *this;
+        }
+
+        NdArray<dtype>& operator*=(const NdArray<dtype>& inOtherArray)
+        {
+            checkWritable("operator*=");
+            checkBroadcastsTo(inOtherArray.shape_, "operator*=");
+            if (inOtherArray.shape_ != shape_)
+            {
+                return *this = *this * inOtherArray;
+            }
+            simd::arithmetic<simd::Multiply, false, false>(cbegin(), inOtherArray.cbegin(), begin(), size_);
+            return *this;
+        }
+
+        template<typename Op, typename Lhs, typename Rhs>
+        NdArray<dtype>& operator*=(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr)
+        {
+            checkWritable("operator*=");
+            checkBroadcastsTo(inExpr.shape(), "operator*=");
+            return *this = *this * inExpr;
+        }
+
+        NdArray<dtype>& operator*=(dtype inScalar)
+        {
+            checkWritable("operator*=");
+            simd::arithmetic<simd::Multiply, false, true>(cbegin(), &inScalar, begin(), size_);
+            return *this;
+        }
+
+        NdArray<dtype>& operator/=(const NdArray<dtype>& inOtherArray)
+        {
+            checkWritable("operator/=");
+            checkBroadcastsTo(inOtherArray.shape_, "operator/=");
+            if (inOtherArray.shape_ != shape_)
+            {
+                return *this = *this / inOtherArray;
+            }
+            simd::arithmetic<simd::Divide, false, false>(cbegin(), inOtherArray.cbegin(), begin(), size_);
+            return *this;
+        }
+
+        template<typename Op, typename Lhs, typename Rhs>
+        NdArray<dtype>& operator/=(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr)
+        {
+            checkWritable("operator/=");
+            checkBroadcastsTo(inExpr.shape(), "operator/=");
+            return *this = *this / inExpr;
+        }
+
+        NdArray<dtype>& operator/=(dtype inScalar)
+        {
+            checkWritable("operator/=");
+            simd::arithmetic<simd::Divide, false, true>(cbegin(), &inScalar, begin(), size_);
+            return *this;
+        }
+
+        NdArray<bool> operator==(const NdArray<dtype>& inOtherArray) const
+        {
+            return std::move(compareWith<simd::Equal>(inOtherArray, "operator=="));
+        }
+
+        NdArray<bool> operator==(dtype inScalar) const
+        {
+            NdArray<bool> returnArray(shape_);
+            simd::compare<simd::Equal, false, true>(cbegin(), &inScalar, returnArray.begin(), size_);
+            return std::move(returnArray);
+        }
+
+        NdArray<bool> operator!=(const NdArray<dtype>& inOtherArray) const
+        {
+            return std::move(compareWith<simd::NotEqual>(inOtherArray, "operator!="));
+        }
+
+        NdArray<bool> operator!=(dtype inScalar) const
+        {
+            NdArray<bool> returnArray(shape_);
+            simd::compare<simd::NotEqual, false, true>(cbegin(), &inScalar, returnArray.begin(), size_);
+            return std::move(returnArray);
+        }
+
+        NdArray<bool> operator<(const NdArray<dtype>& inOtherArray) const
+        {
+            return std::move(compareWith<simd::Less>(inOtherArray, "operator<"));
+        }
+
+        NdArray<bool> operator<(dtype inScalar) const
+        {
+            NdArray<bool> returnArray(shape_);
+            simd::compare<simd::Less, false, true>(cbegin(), &inScalar, returnArray.begin(), size_);
+            return std::move(returnArray);
         }
 
-        NdArray<dtype> operator*(const NdArray<dtype>& inOtherArray) const
+        NdArray<bool> operator<=(const NdArray<dtype>& inOtherArray) const
         {
-            return std::move(NdArray<dtype>(*this) *= inOtherArray);
+            return std::move(compareWith<simd::LessEqual>(inOtherArray, "operator<="));
         }
 
-        NdArray<dtype> operator*(dtype inScalar) const
+        NdArray<bool> operator<=(dtype inScalar) const
         {
-            return std::move(NdArray<dtype>(*this) *= inScalar);
+            NdArray<bool> returnArray(shape_);
+            simd::compare<simd::LessEqual, false, true>(cbegin(), &inScalar, returnArray.begin(), size_);
+            return std::move(returnArray);
+        }
+
+        NdArray<bool> operator>(const NdArray<dtype>& inOtherArray) const
+        {
+            return std::move(compareWith<simd::Greater>(inOtherArray, "operator>"));
+        }
+
+        NdArray<bool> operator>(dtype inScalar) const
+        {
+            NdArray<bool> returnArray(shape_);
+            simd::compare<simd::Greater, false, true>(cbegin(), &inScalar, returnArray.begin(), size_);
+            return std::move(returnArray);
+        }
+
+        NdArray<bool> operator>=(const NdArray<dtype>& inOtherArray) const
+        {
+            return std::move(compareWith<simd::GreaterEqual>(inOtherArray, "operator>="));
+        }
+
+        NdArray<bool> operator>=(dtype inScalar) const
+        {
+            NdArray<bool> returnArray(shape_);
+            simd::compare<simd::GreaterEqual, false, true>(cbegin(), &inScalar, returnArray.begin(), size_);
+            return std::move(returnArray);
         }
 
         friend std::ostream& operator<<(std::ostream& inOStream, const NdArray<dtype>& inArray)
@@ -892,4 +1874,398 @@ namespace nc
             return inOStream;
         }
 };
+
+    template<typename dtype>
+    NdArray<bool> operator==(typename NdArray<dtype>::value_type inScalar, const NdArray<dtype>& inArray)
+    {
+        NdArray<bool> returnArray(inArray.shape());
+        simd::compare<simd::Equal, true, false>(&inScalar, inArray.cbegin(), returnArray.begin(), inArray.size());
+        return std::move(returnArray);
+    }
+
+    template<typename dtype>
+    NdArray<bool> operator!=(typename NdArray<dtype>::value_type inScalar, const NdArray<dtype>& inArray)
+    {
+        NdArray<bool> returnArray(inArray.shape());
+        simd::compare<simd::NotEqual, true, false>(&inScalar, inArray.cbegin(), returnArray.begin(), inArray.size());
+        return std::move(returnArray);
+    }
+
+    template<typename dtype>
+    NdArray<bool> operator<(typename NdArray<dtype>::value_type inScalar, const NdArray<dtype>& inArray)
+    {
+        NdArray<bool> returnArray(inArray.shape());
+        simd::compare<simd::Less, true, false>(&inScalar, inArray.cbegin(), returnArray.begin(), inArray.size());
+        return std::move(returnArray);
+    }
+
+    template<typename dtype>
+    NdArray<bool> operator<=(typename NdArray<dtype>::value_type inScalar, const NdArray<dtype>& inArray)
+    {
+        NdArray<bool> returnArray(inArray.shape());
+        simd::compare<simd::LessEqual, true, false>(&inScalar, inArray.cbegin(), returnArray.begin(), inArray.size());
+        return std::move(returnArray);
+    }
+
+    template<typename dtype>
+    NdArray<bool> operator>(typename NdArray<dtype>::value_type inScalar, const NdArray<dtype>& inArray)
+    {
+        NdArray<bool> returnArray(inArray.shape());
+        simd::compare<simd::Greater, true, false>(&inScalar, inArray.cbegin(), returnArray.begin(), inArray.size());
+        return std::move(returnArray);
+    }
+
+    template<typename dtype>
+    NdArray<bool> operator>=(typename NdArray<dtype>::value_type inScalar, const NdArray<dtype>& inArray)
+    {
+        NdArray<bool> returnArray(inArray.shape());
+        simd::compare<simd::GreaterEqual, true, false>(&inScalar, inArray.cbegin(), returnArray.begin(), inArray.size());
+        return std::move(returnArray);
+    }
+
+    //============================================================================
+    // 表达式节点转发到 NdArray 的成员函数，见 Expression.hpp 中 BinaryExpr 的声明
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::all(Axis inAxis) const
+    {
+        return eval().all(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::all(int32 inAxis) const
+    {
+        return eval().all(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::any(Axis inAxis) const
+    {
+        return eval().any(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::any(int32 inAxis) const
+    {
+        return eval().any(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<uint64> expr::BinaryExpr<Op, Lhs, Rhs>::argmax(Axis inAxis) const
+    {
+        return eval().argmax(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<uint64> expr::BinaryExpr<Op, Lhs, Rhs>::argmax(int32 inAxis) const
+    {
+        return eval().argmax(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<uint64> expr::BinaryExpr<Op, Lhs, Rhs>::argmin(Axis inAxis) const
+    {
+        return eval().argmin(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<uint64> expr::BinaryExpr<Op, Lhs, Rhs>::argmin(int32 inAxis) const
+    {
+        return eval().argmin(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::max(Axis inAxis) const
+    {
+        return eval().max(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::max(int32 inAxis) const
+    {
+        return eval().max(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> expr::BinaryExpr<Op, Lhs, Rhs>::mean(Axis inAxis) const
+    {
+        return eval().mean(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> expr::BinaryExpr<Op, Lhs, Rhs>::mean(int32 inAxis) const
+    {
+        return eval().mean(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::min(Axis inAxis) const
+    {
+        return eval().min(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::min(int32 inAxis) const
+    {
+        return eval().min(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> expr::BinaryExpr<Op, Lhs, Rhs>::nanmean(Axis inAxis) const
+    {
+        return eval().nanmean(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> expr::BinaryExpr<Op, Lhs, Rhs>::nanmean(int32 inAxis) const
+    {
+        return eval().nanmean(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::nansum(Axis inAxis) const
+    {
+        return eval().nansum(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::nansum(int32 inAxis) const
+    {
+        return eval().nansum(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::prod(Axis inAxis) const
+    {
+        return eval().prod(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::prod(int32 inAxis) const
+    {
+        return eval().prod(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> expr::BinaryExpr<Op, Lhs, Rhs>::stdev(Axis inAxis) const
+    {
+        return eval().stdev(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> expr::BinaryExpr<Op, Lhs, Rhs>::stdev(int32 inAxis) const
+    {
+        return eval().stdev(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::sum(Axis inAxis) const
+    {
+        return eval().sum(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::sum(int32 inAxis) const
+    {
+        return eval().sum(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> expr::BinaryExpr<Op, Lhs, Rhs>::var(Axis inAxis) const
+    {
+        return eval().var(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<double> expr::BinaryExpr<Op, Lhs, Rhs>::var(int32 inAxis) const
+    {
+        return eval().var(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<uint64> expr::BinaryExpr<Op, Lhs, Rhs>::argsort(Axis inAxis) const
+    {
+        return eval().argsort(inAxis);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::copy() const
+    {
+        return eval();
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type expr::BinaryExpr<Op, Lhs, Rhs>::item() const
+    {
+        return eval().item();
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type expr::BinaryExpr<Op, Lhs, Rhs>::at(int64 inIndex) const
+    {
+        return eval().at(inIndex);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type expr::BinaryExpr<Op, Lhs, Rhs>::at(int64 inRowIndex, int64 inColIndex) const
+    {
+        return eval().at(inRowIndex, inColIndex);
+    }
+
+    // NdArray::reshape 原地修改形状，表达式没有可修改的存储，返回改变形状后的结果数组
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::reshape(uint64 inNumRows, uint64 inNumCols) const
+    {
+        return reshape(Shape(inNumRows, inNumCols));
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::reshape(const Shape& inShape) const
+    {
+        NdArray<value_type> returnArray = eval();
+        returnArray.reshape(inShape);
+        return returnArray;
+    }
+
+    // 视图会引用求值得到的临时数组，表达式的转置返回连续存储的副本
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::transpose() const
+    {
+        return eval().transpose().copy();
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<typename expr::BinaryExpr<Op, Lhs, Rhs>::value_type> expr::BinaryExpr<Op, Lhs, Rhs>::transpose(const std::vector<uint32>& inAxes) const
+    {
+        return eval().transpose(inAxes).copy();
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    template<typename dtypeOut>
+    NdArray<dtypeOut> expr::BinaryExpr<Op, Lhs, Rhs>::astype() const
+    {
+        return eval().template astype<dtypeOut>();
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    template<typename dtypeOut>
+    NdArray<dtypeOut> expr::BinaryExpr<Op, Lhs, Rhs>::dot(const NdArray<value_type>& inOtherArray) const
+    {
+        return eval().template dot<dtypeOut>(inOtherArray);
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::operator==(const NdArray<value_type>& inOtherArray) const
+    {
+        return eval() == inOtherArray;
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::operator==(value_type inScalar) const
+    {
+        return eval() == inScalar;
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::operator!=(const NdArray<value_type>& inOtherArray) const
+    {
+        return eval() != inOtherArray;
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::operator!=(value_type inScalar) const
+    {
+        return eval() != inScalar;
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::operator<(const NdArray<value_type>& inOtherArray) const
+    {
+        return eval() < inOtherArray;
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::operator<(value_type inScalar) const
+    {
+        return eval() < inScalar;
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::operator<=(const NdArray<value_type>& inOtherArray) const
+    {
+        return eval() <= inOtherArray;
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::operator<=(value_type inScalar) const
+    {
+        return eval() <= inScalar;
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::operator>(const NdArray<value_type>& inOtherArray) const
+    {
+        return eval() > inOtherArray;
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::operator>(value_type inScalar) const
+    {
+        return eval() > inScalar;
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::operator>=(const NdArray<value_type>& inOtherArray) const
+    {
+        return eval() >= inOtherArray;
+    }
+
+    template<typename Op, typename Lhs, typename Rhs>
+    NdArray<bool> expr::BinaryExpr<Op, Lhs, Rhs>::operator>=(value_type inScalar) const
+    {
+        return eval() >= inScalar;
+    }
+
+    namespace expr
+    {
+        // 标量在左侧的比较，放在 expr 中以便通过 ADL 找到
+        template<typename Op, typename Lhs, typename Rhs>
+        NdArray<bool> operator==(typename Lhs::value_type inScalar, const BinaryExpr<Op, Lhs, Rhs>& inExpr)
+        {
+            return inExpr.eval() == inScalar;
+        }
+
+        template<typename Op, typename Lhs, typename Rhs>
+        NdArray<bool> operator!=(typename Lhs::value_type inScalar, const BinaryExpr<Op, Lhs, Rhs>& inExpr)
+        {
+            return inExpr.eval() != inScalar;
+        }
+
+        template<typename Op, typename Lhs, typename Rhs>
+        NdArray<bool> operator<(typename Lhs::value_type inScalar, const BinaryExpr<Op, Lhs, Rhs>& inExpr)
+        {
+            return inExpr.eval() > inScalar;
+        }
+
+        template<typename Op, typename Lhs, typename Rhs>
+        NdArray<bool> operator<=(typename Lhs::value_type inScalar, const BinaryExpr<Op, Lhs, Rhs>& inExpr)
+        {
+            return inExpr.eval() >= inScalar;
+        }
+
+        template<typename Op, typename Lhs, typename Rhs>
+        NdArray<bool> operator>(typename Lhs::value_type inScalar, const BinaryExpr<Op, Lhs, Rhs>& inExpr)
+        {
+            return inExpr.eval() < inScalar;
+        }
+
+        template<typename Op, typename Lhs, typename Rhs>
+        NdArray<bool> operator>=(typename Lhs::value_type inScalar, const BinaryExpr<Op, Lhs, Rhs>& inExpr)
+        {
+            return inExpr.eval() <= inScalar;
+        }
+    }
 }
+
+// NdArrayView 的成员函数需要完整的 NdArray 类型，因此放在最后包含
+#include"NumCpp/NdArrayView.hpp"
@@ -0,0 +1,874 @@
+#pragma once
+
+#include"NumCpp/Allocator.hpp"
+#include"NumCpp/Expression.hpp"
+#include"NumCpp/Gemm.hpp"
+#include"NumCpp/NdArray.hpp"
+#include"NumCpp/Shape.hpp"
+#include"NumCpp/Slice.hpp"
+#include"NumCpp/Types.hpp"
+#include"NumCpp/Utils.hpp"
+
+#include<algorithm>
+#include<cstddef>
+#include<cstdint>
+#include<initializer_list>
+#include<iostream>
+#include<iterator>
+#include<numeric>
+#include<stdexcept>
+#include<string>
+#include<type_traits>
+#include<utility>
+#include<vector>
+
+// 不拥有内存的跨步视图，引用父数组的缓冲区，切片时不复制任何数据。
+// 每一维有各自的跨步，可以表示任意维数的切片和轴重排。二维的下标、切片和归约
+// 按形状的矩阵视角进行（行为除最后一维外各维的组合）。
+// dtype 为 const 类型时视图只读。视图不延长父数组的生命周期，
+// 父数组析构或重新分配后视图随即失效
+namespace nc
+{
+    template<typename dtype>
+    class NdArrayView
+    {
+    public:
+
+        typedef typename std::remove_const<dtype>::type value_type;
+
+        // ascontiguous() 分块复制的块边长
+        static constexpr uint32 TILE_SIZE = 32;
+
+        class iterator
+        {
+        private:
+            dtype*      ptr_{ nullptr };
+            uint64      index_{ 0 };
+            uint32      ndim_{ 0 };
+            uint64      dims_[Shape::MAX_DIMS] = {};
+            uint64      strides_[Shape::MAX_DIMS] = {};
+            uint64      counters_[Shape::MAX_DIMS] = {};
+
+        public:
+            typedef std::forward_iterator_tag   iterator_category;
+            typedef typename std::remove_const<dtype>::type value_type;
+            typedef std::ptrdiff_t              difference_type;
+            typedef dtype*                      pointer;
+            typedef dtype&                      reference;
+
+            iterator() = default;
+
+            //============================================================================
+            /// 指向按行优先顺序的第 inIndex 个元素，inIndex 等于元素个数时为尾后迭代器
+            ///
+            iterator(dtype* inArray, const Shape& inShape, const uint64* inStrides, uint64 inIndex) noexcept :
+                ptr_(inArray),
+                index_(inIndex),
+                ndim_(inShape.ndim())
+            {
+                for (uint32 axis = 0; axis < ndim_; ++axis)
+                {
+                    dims_[axis] = inShape[axis];
+                    strides_[axis] = inStrides[axis];
+                }
+
+                if (inIndex >= inShape.size())
+                {
+                    return;
+                }
+
+                for (uint32 axis = ndim_; axis-- > 0;)
+                {
+                    counters_[axis] = inIndex % dims_[axis];
+                    inIndex /= dims_[axis];
+                    ptr_ += counters_[axis] * strides_[axis];
+                }
+            }
+
+            reference operator*() const noexcept
+            {
+                return *ptr_;
+            }
+
+            pointer operator->() const noexcept
+            {
+                return ptr_;
+            }
+
+            iterator& operator++() noexcept
+            {
+                ++index_;
+                uint32 axis = ndim_ - 1;
+                ptr_ += strides_[axis];
+                while (++counters_[axis] == dims_[axis] && axis > 0)
+                {
+                    // carry into the next outer dimension
+                    ptr_ -= dims_[axis] * strides_[axis];
+                    counters_[axis] = 0;
+                    --axis;
+                    ptr_ += strides_[axis];
+                }
+                return *this;
+            }
+
+            iterator operator++(int) noexcept
+            {
+                iterator previous(*this);
+                ++(*this);
+                return previous;
+            }
+
+            // compare positions rather than addresses, a transposed view revisits addresses past its end
+            bool operator==(const iterator& inOther) const noexcept
+            {
+                return index_ == inOther.index_;
+            }
+
+            bool operator!=(const iterator& inOther) const noexcept
+            {
+                return index_ != inOther.index_;
+            }
+        };
+
+        typedef iterator const_iterator;
+
+    private:
+
+        dtype*      array_{ nullptr };
+        Shape       shape_{ 0, 0 };
+        uint64      strides_[Shape::MAX_DIMS] = {};
+
+        static uint64 wrapIndex(int64 inIndex, uint64 inSize) noexcept
+        {
+            return static_cast<uint64>(inIndex < 0 ? inIndex + static_cast<int64>(inSize) : inIndex);
+        }
+
+        // 矩阵视角下第 inRow 行首元素的偏移，多维时把行号拆成前面各维的下标
+        uint64 rowOffset(uint64 inRow) const noexcept
+        {
+            if (shape_.ndim() == 2)
+            {
+                return inRow * strides_[0];
+            }
+
+            uint64 offset = 0;
+            for (uint32 axis = shape_.ndim() - 1; axis-- > 0;)
+            {
+                const uint64 dim = shape_[axis];
+                offset += inRow % dim * strides_[axis];
+                inRow /= dim;
+            }
+            return offset;
+        }
+
+        static void requireMatrix(const Shape& inShape, const std::string& inFunctionName)
+        {
+            if (inShape.ndim() != 2)
+            {
+                std::string errStr = "ERROR: NdArrayView::" + inFunctionName + ": requires a 2D view, the view has " + utils::num2str(inShape.ndim()) + " dimensions.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+        }
+
+        // 二维视图的整数轴对应的 Axis，其余维数返回 false
+        bool matrixAxis(int32 inAxis, Axis& outAxis) const
+        {
+            const uint32 axis = shape_.axis(inAxis);
+            outAxis = axis == 0 ? Axis::ROW : Axis::COL;
+            return shape_.ndim() == 2;
+        }
+
+        template<typename Reducer>
+        NdArray<uint64> argReduce(Axis inAxis, Reducer inBetter) const
+        {
+            switch (inAxis)
+            {
+                case Axis::NONE:
+                {
+                    uint64 bestIndex = 0;
+                    for (uint64 i = 1; i < size(); ++i)
+                    {
+                        if (inBetter(this->operator[](i), this->operator[](bestIndex)))
+                        {
+                            bestIndex = i;
+                        }
+                    }
+                    NdArray<uint64> returnArray = { bestIndex };
+                    return returnArray;
+                }
+                case Axis::COL:
+                {
+                    NdArray<uint64> returnArray(1, shape_.rows);
+                    for (uint64 row = 0; row < shape_.rows; ++row)
+                    {
+                        uint64 bestCol = 0;
+                        for (uint64 col = 1; col < shape_.cols; ++col)
+                        {
+                            if (inBetter(at(row, col), at(row, bestCol)))
+                            {
+                                bestCol = col;
+                            }
+                        }
+                        returnArray[row] = bestCol;
+                    }
+                    return returnArray;
+                }
+                case Axis::ROW:
+                {
+                    NdArray<uint64> returnArray(1, shape_.cols);
+                    returnArray.fill(0);
+                    for (uint64 row = 1; row < shape_.rows; ++row)
+                    {
+                        for (uint64 col = 0; col < shape_.cols; ++col)
+                        {
+                            if (inBetter(at(row, col), at(returnArray[col], col)))
+                            {
+                                returnArray[col] = row;
+                            }
+                        }
+                    }
+                    return returnArray;
+                }
+                default:
+                {
+                    // this isn't actually possible, just putting this here to get rid
+                    // of the compiler warning.
+                    return NdArray<uint64>(0);
+                }
+            }
+        }
+
+        template<typename dtypeOut, typename Reducer>
+        NdArray<dtypeOut> reduce(Axis inAxis, Reducer inReducer) const
+        {
+            switch (inAxis)
+            {
+                case Axis::NONE:
+                {
+                    dtypeOut result = static_cast<dtypeOut>(this->operator[](0));
+                    for (uint64 i = 1; i < size(); ++i)
+                    {
+                        result = inReducer(result, this->operator[](i));
+                    }
+                    NdArray<dtypeOut> returnArray = { result };
+                    return returnArray;
+                }
+                case Axis::COL:
+                {
+                    NdArray<dtypeOut> returnArray(1, shape_.rows);
+                    for (uint64 row = 0; row < shape_.rows; ++row)
+                    {
+                        dtypeOut result = static_cast<dtypeOut>(at(row, 0));
+                        for (uint64 col = 1; col < shape_.cols; ++col)
+                        {
+                            result = inReducer(result, at(row, col));
+                        }
+                        returnArray[row] = result;
+                    }
+                    return returnArray;
+                }
+                case Axis::ROW:
+                {
+                    NdArray<dtypeOut> returnArray(1, shape_.cols);
+                    for (uint64 col = 0; col < shape_.cols; ++col)
+                    {
+                        returnArray[col] = static_cast<dtypeOut>(at(0, col));
+                    }
+                    for (uint64 row = 1; row < shape_.rows; ++row)
+                    {
+                        for (uint64 col = 0; col < shape_.cols; ++col)
+                        {
+                            returnArray[col] = inReducer(returnArray[col], at(row, col));
+                        }
+                    }
+                    return returnArray;
+                }
+                default:
+                {
+                    // this isn't actually possible, just putting this here to get rid
+                    // of the compiler warning.
+                    return NdArray<dtypeOut>(0);
+                }
+            }
+        }
+
+        // 不做越界检查和负数下标转换的内部访问
+        dtype& at(uint64 inRow, uint64 inCol) const noexcept
+        {
+            return array_[rowOffset(inRow) + inCol * colStride()];
+        }
+
+        bool overlaps(const value_type* inBegin, const value_type* inEnd) const noexcept
+        {
+            // strides are never negative, so the last element has the highest address
+            const value_type* thisBegin = array_;
+            const value_type* thisEnd = isempty() ? array_ : &(*this)[-1] + 1;
+            return thisBegin < inEnd && inBegin < thisEnd;
+        }
+
+    public:
+
+        NdArrayView() = default;
+
+        //============================================================================
+        /// 行优先连续存储的数组的视图
+        ///
+        /// @param      inArray
+        /// @param      inShape
+        ///
+        NdArrayView(dtype* inArray, const Shape& inShape) noexcept :
+            array_(inArray),
+            shape_(inShape)
+        {
+            for (uint32 axis = 0; axis < shape_.ndim(); ++axis)
+            {
+                strides_[axis] = shape_.stride(axis);
+            }
+        }
+
+        //============================================================================
+        /// 给定最后两维跨步的视图，更前面的各维按行跨步连续排列
+        ///
+        /// @param      inArray
+        /// @param      inShape
+        /// @param      inRowStride: 倒数第二维的跨步
+        /// @param      inColStride: 最后一维的跨步
+        ///
+        NdArrayView(dtype* inArray, const Shape& inShape, uint64 inRowStride, uint64 inColStride) noexcept :
+            array_(inArray),
+            shape_(inShape)
+        {
+            const uint32 ndim = shape_.ndim();
+            strides_[ndim - 1] = inColStride;
+            strides_[ndim - 2] = inRowStride;
+            for (uint32 axis = ndim - 2; axis-- > 0;)
+            {
+                strides_[axis] = strides_[axis + 1] * shape_[axis + 1];
+            }
+        }
+
+        //============================================================================
+        /// 各维跨步（以元素计）由 inStrides 给出的视图
+        ///
+        /// @param      inArray
+        /// @param      inShape
+        /// @param      inStrides: shape.ndim() 个跨步
+        ///
+        NdArrayView(dtype* inArray, const Shape& inShape, const uint64* inStrides) noexcept :
+            array_(inArray),
+            shape_(inShape)
+        {
+            std::copy(inStrides, inStrides + shape_.ndim(), strides_);
+        }
+
+        NdArrayView(const NdArrayView<dtype>& inOtherView) = default;
+
+        template<typename dtypeOther, typename = typename std::enable_if<
+            std::is_same<const dtypeOther, dtype>::value && !std::is_same<dtypeOther, dtype>::value>::type>
+        NdArrayView(const NdArrayView<dtypeOther>& inOtherView) noexcept :
+            array_(inOtherView.data()),
+            shape_(inOtherView.shape())
+        {
+            for (uint32 axis = 0; axis < shape_.ndim(); ++axis)
+            {
+                strides_[axis] = inOtherView.stride(axis);
+            }
+        }
+
+        //============================================================================
+        /// 视图之间赋值复制元素而不是重新绑定，形状必须一致
+        ///
+        /// @param      inOtherView
+        ///
+        /// @return     NdArrayView&
+        ///
+        NdArrayView<dtype>& operator=(const NdArrayView<dtype>& inOtherView)
+        {
+            return assign(inOtherView);
+        }
+
+        NdArrayView<dtype>& operator=(const NdArray<value_type>& inArray)
+        {
+            return assign(NdArrayView<const value_type>(inArray.cbegin(), inArray.shape()));
+        }
+
+        template<typename Op, typename Lhs, typename Rhs>
+        NdArrayView<dtype>& operator=(const expr::BinaryExpr<Op, Lhs, Rhs>& inExpr)
+        {
+            // the expression may read from this view, evaluate it fully first
+            return *this = NdArray<value_type>(inExpr);
+        }
+
+        NdArrayView<dtype>& operator=(value_type inValue)
+        {
+            fill(inValue);
+            return *this;
+        }
+
+        template<typename dtypeOther>
+        NdArrayView<dtype>& assign(const NdArrayView<dtypeOther>& inOtherView)
+        {
+            static_assert(!std::is_const<dtype>::value, "Cannot assign to a read-only NdArrayView.");
+
+            if (inOtherView.shape() != shape_)
+            {
+                std::string errStr = "ERROR: NdArrayView::operator=: Array dimensions do not match.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+
+            if (!inOtherView.isempty() && overlaps(inOtherView.data(), &inOtherView[-1] + 1))
+            {
+                // the source aliases this view, go through a temporary
+                const NdArray<value_type> source = inOtherView.copy();
+                return assign(NdArrayView<const value_type>(source.cbegin(), source.shape()));
+            }
+
+            std::copy(inOtherView.cbegin(), inOtherView.cend(), begin());
+            return *this;
+        }
+
+        dtype& operator[](int64 inIndex) const noexcept
+        {
+            const uint64 index = wrapIndex(inIndex, size());
+            return at(index / shape_.cols, index % shape_.cols);
+        }
+
+        dtype& operator()(int64 inRowIndex, int64 inColIndex) const noexcept
+        {
+            return at(wrapIndex(inRowIndex, shape_.rows), wrapIndex(inColIndex, shape_.cols));
+        }
+
+        //============================================================================
+        /// 按各维下标访问元素，例如 v({ i, j, k })，下标个数须等于维数，负数从末尾倒数
+        ///
+        /// @param      inIndices
+        ///
+        /// @return     dtype&
+        ///
+        dtype& operator()(std::initializer_list<int64> inIndices) const noexcept
+        {
+            uint64 offset = 0;
+            uint32 axis = 0;
+            for (int64 index : inIndices)
+            {
+                offset += wrapIndex(index, shape_[axis]) * strides_[axis];
+                ++axis;
+            }
+            return array_[offset];
+        }
+
+        NdArrayView<dtype> operator()(const Slice& inRowSlice, const Slice& inColSlice) const
+        {
+            requireMatrix(shape_, "operator()");
+            return slice({ inRowSlice, inColSlice });
+        }
+
+        NdArrayView<dtype> operator()(const Slice& inRowSlice, int64 inColIndex) const
+        {
+            const uint64 col = wrapIndex(inColIndex, shape_.cols);
+            return this->operator()(inRowSlice, Slice(col, col + 1));
+        }
+
+        NdArrayView<dtype> operator()(int64 inRowIndex, const Slice& inColSlice) const
+        {
+            const uint64 row = wrapIndex(inRowIndex, shape_.rows);
+            return this->operator()(Slice(row, row + 1), inColSlice);
+        }
+
+        iterator begin() const noexcept
+        {
+            return iterator(array_, shape_, strides_, 0);
+        }
+
+        iterator end() const noexcept
+        {
+            return iterator(array_, shape_, strides_, size());
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        NdArray<bool> all(Axis inAxis = Axis::NONE) const
+        {
+            return reduce<bool>(inAxis, [](bool inResult, value_type inValue) noexcept -> bool
+                { return inResult && inValue != static_cast<value_type>(0); });
+        }
+
+        //============================================================================
+        /// 沿第 inAxis 维归约。二维视图直接按跨步归约，更高维的视图先按块复制为连续数组，
+        /// 再由 NdArray 按内存顺序归约
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     NdArray<bool>
+        ///
+        NdArray<bool> all(int32 inAxis) const
+        {
+            Axis axis = Axis::NONE;
+            return matrixAxis(inAxis, axis) ? all(axis) : ascontiguous().all(inAxis);
+        }
+
+        NdArray<bool> any(Axis inAxis = Axis::NONE) const
+        {
+            return reduce<bool>(inAxis, [](bool inResult, value_type inValue) noexcept -> bool
+                { return inResult || inValue != static_cast<value_type>(0); });
+        }
+
+        NdArray<bool> any(int32 inAxis) const
+        {
+            Axis axis = Axis::NONE;
+            return matrixAxis(inAxis, axis) ? any(axis) : ascontiguous().any(inAxis);
+        }
+
+        NdArray<uint64> argmax(Axis inAxis = Axis::NONE) const
+        {
+            return argReduce(inAxis, [](value_type inValue, value_type inBest) noexcept -> bool { return inBest < inValue; });
+        }
+
+        NdArray<uint64> argmax(int32 inAxis) const
+        {
+            Axis axis = Axis::NONE;
+            return matrixAxis(inAxis, axis) ? argmax(axis) : ascontiguous().argmax(inAxis);
+        }
+
+        NdArray<uint64> argmin(Axis inAxis = Axis::NONE) const
+        {
+            return argReduce(inAxis, [](value_type inValue, value_type inBest) noexcept -> bool { return inValue < inBest; });
+        }
+
+        NdArray<uint64> argmin(int32 inAxis) const
+        {
+            Axis axis = Axis::NONE;
+            return matrixAxis(inAxis, axis) ? argmin(axis) : ascontiguous().argmin(inAxis);
+        }
+
+        //============================================================================
+        /// 复制为连续存储的 NdArray。按 TILE_SIZE x TILE_SIZE 分块复制，
+        /// 转置等列跨步很大的视图读写都能留在缓存中
+        ///
+        /// @return     NdArray
+        ///
+        NdArray<value_type> ascontiguous() const
+        {
+            NdArray<value_type> returnArray(shape_);
+            value_type* out = returnArray.begin();
+            const uint64 colStride = this->colStride();
+
+            if (colStride == 1)
+            {
+                for (uint64 row = 0; row < shape_.rows; ++row)
+                {
+                    const dtype* rowStart = array_ + rowOffset(row);
+                    std::copy(rowStart, rowStart + shape_.cols, out + row * shape_.cols);
+                }
+                return returnArray;
+            }
+
+            const dtype* rowStarts[TILE_SIZE];
+            for (uint64 rowTile = 0; rowTile < shape_.rows; rowTile += TILE_SIZE)
+            {
+                const uint64 rowEnd = std::min(shape_.rows, rowTile + TILE_SIZE);
+                for (uint64 row = rowTile; row < rowEnd; ++row)
+                {
+                    rowStarts[row - rowTile] = array_ + rowOffset(row);
+                }
+
+                for (uint64 colTile = 0; colTile < shape_.cols; colTile += TILE_SIZE)
+                {
+                    const uint64 colEnd = std::min(shape_.cols, colTile + TILE_SIZE);
+                    for (uint64 row = rowTile; row < rowEnd; ++row)
+                    {
+                        const dtype* rowStart = rowStarts[row - rowTile];
+                        value_type* outRow = out + row * shape_.cols;
+                        for (uint64 col = colTile; col < colEnd; ++col)
+                        {
+                            outRow[col] = rowStart[col * colStride];
+                        }
+                    }
+                }
+            }
+
+            return returnArray;
+        }
+
+        //============================================================================
+        /// 最后一维的跨步
+        ///
+        /// @return     uint64
+        ///
+        uint64 colStride() const noexcept
+        {
+            return strides_[shape_.ndim() - 1];
+        }
+
+        NdArray<value_type> copy() const
+        {
+            return ascontiguous();
+        }
+
+        //============================================================================
+        /// 矩阵乘法，按跨步直接打包视图元素，不先复制成连续数组
+        ///
+        /// @param      inOtherView
+        ///
+        /// @return     NdArray
+        ///
+        template<typename dtypeOut, typename dtypeOther>
+        NdArray<dtypeOut> dot(const NdArrayView<dtypeOther>& inOtherView) const
+        {
+            const Shape otherShape = inOtherView.shape();
+            requireMatrix(shape_, "dot");
+            requireMatrix(otherShape, "dot");
+
+            if (shape_ == otherShape && (shape_.rows == 1 || shape_.cols == 1))
+            {
+                dtypeOut dotProduct = std::inner_product(cbegin(), cend(), inOtherView.cbegin(), static_cast<dtypeOut>(0));
+                NdArray<dtypeOut> returnArray = { dotProduct };
+                return returnArray;
+            }
+            else if (shape_.cols == otherShape.rows)
+            {
+                NdArray<dtypeOut> returnArray(shape_.rows, otherShape.cols);
+                gemm::gemm(shape_.rows, otherShape.cols, shape_.cols, array_, rowStride(), colStride(),
+                    inOtherView.data(), inOtherView.rowStride(), inOtherView.colStride(), returnArray.begin(), otherShape.cols);
+                return returnArray;
+            }
+            else
+            {
+                std::string errStr = "ERROR: NdArrayView::Array shapes of [" + utils::num2str(shape_.rows) + ", " + utils::num2str(shape_.cols) + "]";
+                errStr += " and [" + utils::num2str(otherShape.rows) + ", " + utils::num2str(otherShape.cols) + "]";
+                errStr += " are not consistent.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+        }
+
+        dtype* data() const noexcept
+        {
+            return array_;
+        }
+
+        void fill(value_type inValue) const
+        {
+            static_assert(!std::is_const<dtype>::value, "Cannot fill a read-only NdArrayView.");
+            std::fill(begin(), end(), inValue);
+        }
+
+        //============================================================================
+        /// 把按行优先顺序从第 inStart 个开始的 inCount 个元素复制到 outValues
+        ///
+        /// @param      inStart
+        /// @param      inCount
+        /// @param      outValues
+        ///
+        void gather(uint64 inStart, uint64 inCount, value_type* outValues) const noexcept
+        {
+            iterator it(array_, shape_, strides_, inStart);
+            for (uint64 i = 0; i < inCount; ++i, ++it)
+            {
+                outValues[i] = *it;
+            }
+        }
+
+        //============================================================================
+        /// 视图首元素地址是否按 BUFFER_ALIGNMENT 对齐
+        ///
+        /// @return     bool
+        ///
+        bool isAligned() const noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(array_) % BUFFER_ALIGNMENT == 0;
+        }
+
+        //============================================================================
+        /// 是否按行优先连续存储，大小为 1 的维的跨步不影响结果
+        ///
+        /// @return     bool
+        ///
+        bool isContiguous() const noexcept
+        {
+            uint64 expected = 1;
+            for (uint32 axis = shape_.ndim(); axis-- > 0;)
+            {
+                if (shape_[axis] > 1 && strides_[axis] != expected)
+                {
+                    return false;
+                }
+                expected *= shape_[axis];
+            }
+            return true;
+        }
+
+        bool isempty() const noexcept
+        {
+            return shape_.size() == 0;
+        }
+
+        NdArray<value_type> max(Axis inAxis = Axis::NONE) const
+        {
+            return reduce<value_type>(inAxis, [](value_type inResult, value_type inValue) noexcept -> value_type
+                { return inResult < inValue ? inValue : inResult; });
+        }
+
+        NdArray<value_type> max(int32 inAxis) const
+        {
+            Axis axis = Axis::NONE;
+            return matrixAxis(inAxis, axis) ? max(axis) : ascontiguous().max(inAxis);
+        }
+
+        NdArray<value_type> min(Axis inAxis = Axis::NONE) const
+        {
+            return reduce<value_type>(inAxis, [](value_type inResult, value_type inValue) noexcept -> value_type
+                { return inValue < inResult ? inValue : inResult; });
+        }
+
+        NdArray<value_type> min(int32 inAxis) const
+        {
+            Axis axis = Axis::NONE;
+            return matrixAxis(inAxis, axis) ? min(axis) : ascontiguous().min(inAxis);
+        }
+
+        //============================================================================
+        /// 倒数第二维的跨步
+        ///
+        /// @return     uint64
+        ///
+        uint64 rowStride() const noexcept
+        {
+            return strides_[shape_.ndim() - 2];
+        }
+
+        Shape shape() const noexcept
+        {
+            return shape_;
+        }
+
+        uint64 size() const noexcept
+        {
+            return shape_.size();
+        }
+
+        //============================================================================
+        /// 按维切片，未给出的后续各维保留全部元素。负步长的切片翻转为正步长，
+        /// 因此各维跨步总是非负
+        ///
+        /// @param      inSlices: 至多 ndim() 个切片
+        ///
+        /// @return     NdArrayView
+        ///
+        NdArrayView<dtype> slice(std::initializer_list<Slice> inSlices) const
+        {
+            if (inSlices.size() > shape_.ndim())
+            {
+                std::string errStr = "ERROR: NdArrayView::slice: " + utils::num2str(static_cast<uint32>(inSlices.size())) + " slices given for a view with "
+                    + utils::num2str(shape_.ndim()) + " dimensions.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+
+            std::vector<uint64> dims = shape_.dims();
+            uint64 strides[Shape::MAX_DIMS];
+            std::copy(strides_, strides_ + shape_.ndim(), strides);
+            dtype* start = array_;
+            uint32 axis = 0;
+            for (Slice axisSlice : inSlices)
+            {
+                dims[axis] = axisSlice.numElements(dims[axis]);
+                start += static_cast<uint64>(axisSlice.start) * strides_[axis];
+                strides[axis] *= axisSlice.step;
+                ++axis;
+            }
+
+            return NdArrayView<dtype>(start, Shape(dims), strides);
+        }
+
+        //============================================================================
+        /// 第 inAxis 维的跨步（以元素计）
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     uint64
+        ///
+        uint64 stride(uint32 inAxis) const noexcept
+        {
+            return strides_[inAxis];
+        }
+
+        //============================================================================
+        /// 转置，颠倒各维的顺序，只交换形状和跨步
+        ///
+        /// @return     NdArrayView
+        ///
+        NdArrayView<dtype> transpose() const
+        {
+            std::vector<uint32> axes(shape_.ndim());
+            for (uint32 axis = 0; axis < shape_.ndim(); ++axis)
+            {
+                axes[axis] = shape_.ndim() - 1 - axis;
+            }
+            return transpose(axes);
+        }
+
+        //============================================================================
+        /// 按 inAxes 重排各维，结果的第 i 维为本视图的第 inAxes[i] 维
+        ///
+        /// @param      inAxes: 0 到 ndim() - 1 的一个排列
+        ///
+        /// @return     NdArrayView
+        ///
+        NdArrayView<dtype> transpose(const std::vector<uint32>& inAxes) const
+        {
+            std::vector<bool> used(shape_.ndim(), false);
+            bool valid = inAxes.size() == shape_.ndim();
+            for (uint32 axis : inAxes)
+            {
+                if (!valid || axis >= shape_.ndim() || used[axis])
+                {
+                    valid = false;
+                    break;
+                }
+                used[axis] = true;
+            }
+            if (!valid)
+            {
+                std::string errStr = "ERROR: NdArrayView::transpose: the axes are not a permutation of the " + utils::num2str(shape_.ndim()) + " dimensions.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+
+            std::vector<uint64> dims(shape_.ndim());
+            uint64 strides[Shape::MAX_DIMS];
+            for (uint32 i = 0; i < shape_.ndim(); ++i)
+            {
+                dims[i] = shape_[inAxes[i]];
+                strides[i] = strides_[inAxes[i]];
+            }
+            return NdArrayView<dtype>(array_, Shape(dims), strides);
+        }
+
+        std::string str() const
+        {
+            return copy().str();
+        }
+
+        operator NdArray<value_type>() const
+        {
+            return copy();
+        }
+
+        friend std::ostream& operator<<(std::ostream& inOStream, const NdArrayView<dtype>& inView)
+        {
+            inOStream << inView.str();
+            return inOStream;
+        }
+    };
+}
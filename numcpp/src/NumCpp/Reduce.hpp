@@ -0,0 +1,475 @@
+#pragma once
+
+#include"NumCpp/Shape.hpp"
+#include"NumCpp/ThreadPool.hpp"
+#include"NumCpp/Types.hpp"
+
+#include<algorithm>
+#include<cmath>
+#include<limits>
+#include<type_traits>
+#include<vector>
+
+// 通用归约引擎：由结合律运算 Op 与逐元素映射 Map 组成，按 Axis 或任意一维归约。
+// Op 提供 identity()/combine()，Map(value, outIndex) 把元素映射为累加值，
+// outIndex 为该元素所属的输出位置，可用于按行/列减去各自的均值等。
+// 沿任意一维归约时把数组看作 外层 x 该维 x 内层，总是按内存顺序遍历。
+// 连续数据使用成对（pairwise）归约，浮点求和的舍入误差为 O(log n)；
+// 按列（Axis::ROW）逐行扫描时浮点求和使用 Kahan 补偿。
+// Axis::NONE 按固定大小分块，块结果再成对归约，结果与线程数无关
+namespace nc
+{
+    namespace reduce
+    {
+        // 成对归约的叶子块大小
+        constexpr uint32 PAIRWISE_BLOCK = 128;
+
+        // Axis::NONE 的分块大小，固定不变以保证结果与线程数无关
+        constexpr uint64 CHUNK_SIZE = 1 << 16;
+
+        // 元素个数超过该值时把块分发到线程池并行归约
+        constexpr uint64 PARALLEL_MIN_ELEMENTS = 1 << 20;
+
+        template<typename T>
+        struct Sum
+        {
+            typedef T value_type;
+            static constexpr bool COMPENSATED = std::is_floating_point<T>::value;
+
+            static T identity() noexcept { return static_cast<T>(0); }
+            static T combine(T a, T b) noexcept { return a + b; }
+        };
+
+        template<typename T>
+        struct Prod
+        {
+            typedef T value_type;
+            static constexpr bool COMPENSATED = false;
+
+            static T identity() noexcept { return static_cast<T>(1); }
+            static T combine(T a, T b) noexcept { return a * b; }
+        };
+
+        template<typename T>
+        struct Max
+        {
+            typedef T value_type;
+            static constexpr bool COMPENSATED = false;
+
+            static T identity() noexcept { return std::numeric_limits<T>::lowest(); }
+            static T combine(T a, T b) noexcept { return a < b ? b : a; }
+        };
+
+        template<typename T>
+        struct Min
+        {
+            typedef T value_type;
+            static constexpr bool COMPENSATED = false;
+
+            static T identity() noexcept { return std::numeric_limits<T>::max(); }
+            static T combine(T a, T b) noexcept { return b < a ? b : a; }
+        };
+
+        struct LogicalAnd
+        {
+            typedef bool value_type;
+            static constexpr bool COMPENSATED = false;
+
+            static bool identity() noexcept { return true; }
+            static bool combine(bool a, bool b) noexcept { return a && b; }
+        };
+
+        struct LogicalOr
+        {
+            typedef bool value_type;
+            static constexpr bool COMPENSATED = false;
+
+            static bool identity() noexcept { return false; }
+            static bool combine(bool a, bool b) noexcept { return a || b; }
+        };
+
+        //============================================================================
+        /// 是否为 NaN，整数类型恒为 false
+        ///
+        template<typename T>
+        bool isNan(T inValue) noexcept
+        {
+            return inValue != inValue;
+        }
+
+        //============================================================================
+        /// Kahan 补偿累加：把 inValue 加到 ioSum，ioCompensation 保存上一次的舍入误差。
+        /// 和为 inf 或 NaN 时不再更新补偿，否则 inf - inf 会把该累加器之后的结果都变成 NaN
+        ///
+        /// @param      ioSum
+        /// @param      ioCompensation
+        /// @param      inValue
+        ///
+        template<typename T>
+        void compensatedAdd(T& ioSum, T& ioCompensation, T inValue) noexcept
+        {
+            const T corrected = inValue - ioCompensation;
+            const T total = ioSum + corrected;
+            if (std::isfinite(total))
+            {
+                ioCompensation = (total - ioSum) - corrected;
+            }
+            ioSum = total;
+        }
+
+        // 常用映射
+        template<typename T>
+        struct Cast
+        {
+            template<typename U>
+            T operator()(U inValue, uint64) const noexcept { return static_cast<T>(inValue); }
+        };
+
+        template<typename T>
+        struct NanAsZero
+        {
+            template<typename U>
+            T operator()(U inValue, uint64) const noexcept { return isNan(inValue) ? static_cast<T>(0) : static_cast<T>(inValue); }
+        };
+
+        template<typename T>
+        struct NotNanCount
+        {
+            template<typename U>
+            T operator()(U inValue, uint64) const noexcept { return isNan(inValue) ? static_cast<T>(0) : static_cast<T>(1); }
+        };
+
+        struct NonZero
+        {
+            template<typename U>
+            bool operator()(U inValue, uint64) const noexcept { return inValue != static_cast<U>(0); }
+        };
+
+        template<typename T>
+        struct SquaredDeviation
+        {
+            const T* means_;
+
+            template<typename U>
+            T operator()(U inValue, uint64 inOutIndex) const noexcept
+            {
+                const T deviation = static_cast<T>(inValue) - means_[inOutIndex];
+                return deviation * deviation;
+            }
+        };
+
+        //============================================================================
+        /// 归约结果的形状：Axis::NONE 为 1x1，Axis::COL 为 1 x 行数，Axis::ROW 为 1 x 列数
+        ///
+        /// @param      inShape
+        /// @param      inAxis
+        ///
+        /// @return     Shape
+        ///
+        inline Shape resultShape(const Shape& inShape, Axis inAxis) noexcept
+        {
+            switch (inAxis)
+            {
+                case Axis::COL:
+                    return Shape(1, inShape.rows);
+                case Axis::ROW:
+                    return Shape(1, inShape.cols);
+                default:
+                    return Shape(1, 1);
+            }
+        }
+
+        //============================================================================
+        /// 沿第 inAxis 维归约的结果形状：去掉该维，不足 2 维时为 1 x n
+        ///
+        /// @param      inShape
+        /// @param      inAxis: 已由 Shape::axis 转换的轴
+        ///
+        /// @return     Shape
+        ///
+        inline Shape resultShape(const Shape& inShape, uint32 inAxis)
+        {
+            return inShape.removeAxis(inAxis);
+        }
+
+        //============================================================================
+        /// 对连续的 inSize 个元素做成对归约，叶子块内用 8 路独立累加以便向量化
+        ///
+        template<typename Op, typename Map, typename dtype>
+        typename Op::value_type pairwise(const dtype* inArray, uint64 inSize, uint64 inOutIndex, const Map& inMap) noexcept
+        {
+            typedef typename Op::value_type Acc;
+
+            if (inSize < PAIRWISE_BLOCK)
+            {
+                Acc acc[8];
+                std::fill(acc, acc + 8, Op::identity());
+
+                uint64 i = 0;
+                for (; i + 8 <= inSize; i += 8)
+                {
+                    for (uint32 lane = 0; lane < 8; ++lane)
+                    {
+                        acc[lane] = Op::combine(acc[lane], inMap(inArray[i + lane], inOutIndex));
+                    }
+                }
+
+                Acc result = Op::combine(Op::combine(Op::combine(acc[0], acc[1]), Op::combine(acc[2], acc[3])),
+                    Op::combine(Op::combine(acc[4], acc[5]), Op::combine(acc[6], acc[7])));
+                for (; i < inSize; ++i)
+                {
+                    result = Op::combine(result, inMap(inArray[i], inOutIndex));
+                }
+                return result;
+            }
+
+            uint64 half = inSize / 2;
+            half -= half % 8;
+            return Op::combine(pairwise<Op>(inArray, half, inOutIndex, inMap),
+                pairwise<Op>(inArray + half, inSize - half, inOutIndex, inMap));
+        }
+
+        //============================================================================
+        /// 把全部元素归约为一个值，大数组按块并行后再成对合并各块结果
+        ///
+        template<typename Op, typename Map, typename dtype>
+        typename Op::value_type all(const dtype* inArray, uint64 inSize, const Map& inMap)
+        {
+            typedef typename Op::value_type Acc;
+
+            if (inSize <= CHUNK_SIZE)
+            {
+                return pairwise<Op>(inArray, inSize, 0, inMap);
+            }
+
+            const uint32 numChunks = static_cast<uint32>((inSize + CHUNK_SIZE - 1) / CHUNK_SIZE);
+            std::vector<Acc> partials(numChunks);
+            auto reduceChunk = [inArray, inSize, &inMap, &partials](uint32 inChunk, uint32) noexcept
+            {
+                const uint64 start = static_cast<uint64>(inChunk) * CHUNK_SIZE;
+                partials[inChunk] = pairwise<Op>(inArray + start, std::min(CHUNK_SIZE, inSize - start), 0, inMap);
+            };
+
+            if (inSize < PARALLEL_MIN_ELEMENTS || getNumThreads() == 1)
+            {
+                for (uint32 chunk = 0; chunk < numChunks; ++chunk)
+                {
+                    reduceChunk(chunk, 0);
+                }
+            }
+            else
+            {
+                ThreadPool::instance().parallelFor(numChunks, reduceChunk);
+            }
+
+            return pairwise<Op>(partials.data(), numChunks, 0, Cast<Acc>());
+        }
+
+        //============================================================================
+        /// 对 [0, inCount) 中的每个下标调用 inFunction(index)。并行时相邻下标合并为一个任务，
+        /// 使任务数不超出线程池的 uint32 任务计数
+        ///
+        /// @param      inCount
+        /// @param      inSerial
+        /// @param      inFunction
+        ///
+        template<typename Function>
+        void forEach(uint64 inCount, bool inSerial, const Function& inFunction)
+        {
+            if (inSerial)
+            {
+                for (uint64 i = 0; i < inCount; ++i)
+                {
+                    inFunction(i);
+                }
+                return;
+            }
+
+            const uint64 perTask = inCount / std::numeric_limits<uint32>::max() + 1;
+            const uint32 numTasks = static_cast<uint32>((inCount + perTask - 1) / perTask);
+            ThreadPool::instance().parallelFor(numTasks, [inCount, perTask, &inFunction](uint32 inTask, uint32)
+            {
+                const uint64 last = std::min(inCount, (inTask + 1) * perTask);
+                for (uint64 i = inTask * perTask; i < last; ++i)
+                {
+                    inFunction(i);
+                }
+            });
+        }
+
+        //============================================================================
+        /// 把连续数组看作 inOuter x inLength x inInner 的三维块，沿中间一维归约，
+        /// 结果为 inOuter x inInner。inInner 为 1 时每段归约的数据连续，直接成对归约；
+        /// 否则按内存顺序逐行扫描，每个内层位置一个累加器，浮点求和使用 Kahan 补偿
+        ///
+        /// @param      inArray
+        /// @param      inOuter
+        /// @param      inLength
+        /// @param      inInner
+        /// @param      inMap
+        /// @param      outResult
+        ///
+        template<typename Op, typename Map, typename dtype>
+        void alongAxis(const dtype* inArray, uint64 inOuter, uint64 inLength, uint64 inInner, const Map& inMap, typename Op::value_type* outResult)
+        {
+            typedef typename Op::value_type Acc;
+
+            const bool serial = inOuter * inLength * inInner < PARALLEL_MIN_ELEMENTS || getNumThreads() == 1;
+            if (inInner == 1)
+            {
+                forEach(inOuter, serial, [inArray, inLength, &inMap, outResult](uint64 inRow) noexcept
+                {
+                    outResult[inRow] = pairwise<Op>(inArray + inRow * inLength, inLength, inRow, inMap);
+                });
+                return;
+            }
+
+            // sweep the rows of each block in memory order with one accumulator per inner position
+            auto reduceBlock = [inArray, inLength, inInner, &inMap, outResult](uint64 inBlock)
+            {
+                Acc* result = outResult + inBlock * inInner;
+                std::fill(result, result + inInner, Op::identity());
+                std::vector<Acc> compensation(Op::COMPENSATED ? inInner : 0, static_cast<Acc>(0));
+                for (uint64 row = 0; row < inLength; ++row)
+                {
+                    const dtype* rowValues = inArray + (inBlock * inLength + row) * inInner;
+                    for (uint64 col = 0; col < inInner; ++col)
+                    {
+                        const Acc value = inMap(rowValues[col], inBlock * inInner + col);
+                        if (Op::COMPENSATED)
+                        {
+                            compensatedAdd(result[col], compensation[col], value);
+                        }
+                        else
+                        {
+                            result[col] = Op::combine(result[col], value);
+                        }
+                    }
+                }
+            };
+
+            forEach(inOuter, serial || inOuter == 1, reduceBlock);
+        }
+
+        //============================================================================
+        /// 把 inShape 在第 inAxis 维处拆成 外层 x 该维 x 内层 三段，内层即该维的跨步
+        ///
+        /// @param      inShape
+        /// @param      inAxis
+        /// @param      outOuter
+        /// @param      outLength
+        /// @param      outInner
+        ///
+        inline void splitAxis(const Shape& inShape, uint32 inAxis, uint64& outOuter, uint64& outLength, uint64& outInner) noexcept
+        {
+            outOuter = 1;
+            for (uint32 axis = 0; axis < inAxis; ++axis)
+            {
+                outOuter *= inShape[axis];
+            }
+            outLength = inShape[inAxis];
+            outInner = inShape.stride(inAxis);
+        }
+
+        //============================================================================
+        /// 按 inAxis 归约 inShape 形状的连续数组，结果写入 outResult，
+        /// 其大小由 resultShape(inShape, inAxis) 给出
+        ///
+        /// @param      inArray
+        /// @param      inShape
+        /// @param      inAxis
+        /// @param      inMap
+        /// @param      outResult
+        ///
+        template<typename Op, typename Map, typename dtype>
+        void reduce(const dtype* inArray, const Shape& inShape, Axis inAxis, const Map& inMap, typename Op::value_type* outResult)
+        {
+            switch (inAxis)
+            {
+                case Axis::NONE:
+                {
+                    outResult[0] = all<Op>(inArray, inShape.size(), inMap);
+                    return;
+                }
+                case Axis::COL:
+                {
+                    alongAxis<Op>(inArray, inShape.rows, inShape.cols, 1, inMap, outResult);
+                    return;
+                }
+                case Axis::ROW:
+                {
+                    alongAxis<Op>(inArray, 1, inShape.rows, inShape.cols, inMap, outResult);
+                    return;
+                }
+                default:
+                {
+                    return;
+                }
+            }
+        }
+
+        //============================================================================
+        /// 沿第 inAxis 维归约 inShape 形状的连续数组，结果形状由 resultShape(inShape, inAxis) 给出
+        ///
+        /// @param      inArray
+        /// @param      inShape
+        /// @param      inAxis: 已由 Shape::axis 转换的轴
+        /// @param      inMap
+        /// @param      outResult
+        ///
+        template<typename Op, typename Map, typename dtype>
+        void reduce(const dtype* inArray, const Shape& inShape, uint32 inAxis, const Map& inMap, typename Op::value_type* outResult)
+        {
+            uint64 outer = 0;
+            uint64 length = 0;
+            uint64 inner = 0;
+            splitAxis(inShape, inAxis, outer, length, inner);
+            alongAxis<Op>(inArray, outer, length, inner, inMap, outResult);
+        }
+
+        //============================================================================
+        /// 沿第 inAxis 维求最优元素在该维上的下标，inBetter(a, b) 表示 a 优于 b，
+        /// 相同时取第一个。与 reduce 一样按内存顺序遍历
+        ///
+        /// @param      inArray
+        /// @param      inShape
+        /// @param      inAxis: 已由 Shape::axis 转换的轴
+        /// @param      inBetter
+        /// @param      outResult
+        ///
+        template<typename Better, typename dtype>
+        void argReduce(const dtype* inArray, const Shape& inShape, uint32 inAxis, Better inBetter, uint64* outResult)
+        {
+            uint64 outer = 0;
+            uint64 length = 0;
+            uint64 inner = 0;
+            splitAxis(inShape, inAxis, outer, length, inner);
+
+            std::fill(outResult, outResult + outer * inner, 0);
+            if (length == 0)
+            {
+                return;
+            }
+
+            std::vector<dtype> bestValues(inner);
+            for (uint64 block = 0; block < outer; ++block)
+            {
+                const dtype* blockValues = inArray + block * length * inner;
+                uint64* result = outResult + block * inner;
+                std::copy(blockValues, blockValues + inner, bestValues.begin());
+                for (uint64 row = 1; row < length; ++row)
+                {
+                    const dtype* rowValues = blockValues + row * inner;
+                    for (uint64 col = 0; col < inner; ++col)
+                    {
+                        if (inBetter(rowValues[col], bestValues[col]))
+                        {
+                            bestValues[col] = rowValues[col];
+                            result[col] = row;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -3,10 +3,17 @@
 #include"NumCpp/Types.hpp"
 #include"NumCpp/Utils.hpp"
 
+#include<algorithm>
+#include<initializer_list>
 #include<iostream>
 #include<stdexcept>
 #include<string>
+#include<vector>
 
+// 任意维数（至多 MAX_DIMS 维）的行优先形状。至少为 2 维：0 维为 1x1，1 维为 1 x n。
+// rows/cols 是形状的矩阵视角，rows 为除最后一维外各维的乘积，cols 为最后一维，
+// 二维代码（逐行迭代、Axis::ROW/COL 归约、矩阵乘法等）都按这一视角工作。
+// 二维形状可以直接修改 rows/cols，更高维的形状只能通过构造或赋值整体修改
 namespace nc
 {
 
@@ -14,24 +21,101 @@ namespace nc
     {
     public:
 
-        uint32	rows{0};
-        uint32	cols{0};
+        // 支持的最大维数
+        static constexpr uint32 MAX_DIMS = 8;
+
+        uint64	rows{0};
+        uint64	cols{0};
+
+    private:
+
+        uint32  ndim_{2};
+        uint64  dims_[MAX_DIMS] = {};   // 只在 ndim_ > 2 时使用，二维时各维即 rows/cols
+
+        //============================================================================
+        /// 各维大小的乘积，超出 int64 的表示范围（负数下标回绕需要）时抛出异常
+        ///
+        /// @param      inDims
+        /// @param      inNumDims
+        ///
+        /// @return     uint64
+        ///
+        static uint64 checkedSize(const uint64* inDims, uint32 inNumDims)
+        {
+            uint64 size = 1;
+            for (uint32 axis = 0; axis < inNumDims; ++axis)
+            {
+                if (utils::mulOverflow(size, inDims[axis], size) || size > static_cast<uint64>(DtypeInfo<int64>::max()))
+                {
+                    std::string errStr = "ERROR: Shape: the number of elements overflows 64-bit indexing.";
+                    std::cerr << errStr << std::endl;
+                    throw std::invalid_argument(errStr);
+                }
+            }
+            return size;
+        }
+
+        void setDims(const uint64* inDims, uint32 inNumDims)
+        {
+            if (inNumDims > MAX_DIMS)
+            {
+                std::string errStr = "ERROR: Shape: " + utils::num2str(inNumDims) + " dimensions exceeds the maximum of " + utils::num2str(MAX_DIMS) + ".";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+            checkedSize(inDims, inNumDims);
+
+            ndim_ = std::max<uint32>(inNumDims, 2);
+            rows = inNumDims < 2 ? 1 : inDims[0];
+            cols = inNumDims == 0 ? 1 : inDims[inNumDims - 1];
+            if (ndim_ > 2)
+            {
+                std::copy(inDims, inDims + ndim_, dims_);
+                for (uint32 axis = 1; axis < ndim_ - 1; ++axis)
+                {
+                    rows *= dims_[axis];
+                }
+            }
+        }
+
+    public:
 
         Shape() = default;
 
-        explicit Shape(uint32 inSquareSize) noexcept :
-            rows(inSquareSize),
-            cols(inSquareSize)
+        explicit Shape(uint64 inSquareSize) :
+            Shape(inSquareSize, inSquareSize)
         {};
 
-        Shape(uint32 inRows, uint32 inCols) noexcept :
+        Shape(uint64 inRows, uint64 inCols) :
             rows(inRows),
             cols(inCols)
-        {};
+        {
+            const uint64 dims[2] = { inRows, inCols };
+            checkedSize(dims, 2);
+        };
+
+        //============================================================================
+        /// 按各维大小构造，例如 Shape({ 2, 3, 4 })
+        ///
+        /// @param      inDims
+        ///
+        Shape(std::initializer_list<uint64> inDims)
+        {
+            setDims(inDims.begin(), static_cast<uint32>(inDims.size()));
+        }
+
+        explicit Shape(const std::vector<uint64>& inDims)
+        {
+            setDims(inDims.data(), static_cast<uint32>(inDims.size()));
+        }
 
         bool operator==(const Shape& inOtherShape) const noexcept
         {
-            return rows == inOtherShape.rows && cols == inOtherShape.cols;
+            if (ndim_ != inOtherShape.ndim_ || rows != inOtherShape.rows || cols != inOtherShape.cols)
+            {
+                return false;
+            }
+            return ndim_ == 2 || std::equal(dims_, dims_ + ndim_, inOtherShape.dims_);
         }
 
         bool operator!=(const Shape& inOtherShape) const noexcept
@@ -39,9 +123,76 @@ namespace nc
             return !(*this == inOtherShape);
         }
 
-        uint32 size() const noexcept
+        //============================================================================
+        /// 第 inAxis 维的大小，inAxis 必须小于 ndim()
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     uint64
+        ///
+        uint64 operator[](uint32 inAxis) const noexcept
         {
-            return rows * cols;
+            if (ndim_ == 2)
+            {
+                return inAxis == 0 ? rows : cols;
+            }
+            return dims_[inAxis];
+        }
+
+        //============================================================================
+        /// 把整数轴（负数从最后一维倒数）转换为 [0, ndim()) 内的轴，越界时抛出异常
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     uint32
+        ///
+        uint32 axis(int32 inAxis) const
+        {
+            const int32 axis = inAxis < 0 ? inAxis + static_cast<int32>(ndim_) : inAxis;
+            if (axis < 0 || axis >= static_cast<int32>(ndim_))
+            {
+                std::string errStr = "ERROR: Shape::axis: axis " + utils::num2str(inAxis) + " is out of bounds for an array of dimension " + utils::num2str(ndim_) + ".";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+            return static_cast<uint32>(axis);
+        }
+
+        std::vector<uint64> dims() const
+        {
+            std::vector<uint64> out(ndim_);
+            for (uint32 axis = 0; axis < ndim_; ++axis)
+            {
+                out[axis] = (*this)[axis];
+            }
+            return out;
+        }
+
+        //============================================================================
+        /// 按 NumPy 规则与 inOther 广播：从最后一维对齐，对应各维相等或其中之一为 1，
+        /// 结果每维取较大者，维数取较多者
+        ///
+        /// @param      inOther
+        /// @param      outShape
+        ///
+        /// @return     bool: 不能广播时为 false
+        ///
+        bool broadcast(const Shape& inOther, Shape& outShape) const
+        {
+            const uint32 ndim = std::max(ndim_, inOther.ndim_);
+            std::vector<uint64> out(ndim);
+            for (uint32 axis = 0; axis < ndim; ++axis)
+            {
+                const uint64 dim = axis + ndim_ >= ndim ? (*this)[axis + ndim_ - ndim] : 1;
+                const uint64 otherDim = axis + inOther.ndim_ >= ndim ? inOther[axis + inOther.ndim_ - ndim] : 1;
+                if (dim != otherDim && dim != 1 && otherDim != 1)
+                {
+                    return false;
+                }
+                out[axis] = dim == 1 ? otherDim : dim;
+            }
+            outShape = Shape(out);
+            return true;
         }
 
         bool isnull() noexcept
@@ -49,9 +200,67 @@ namespace nc
             return rows == 0 && cols == 0;
         }
 
+        uint32 ndim() const noexcept
+        {
+            return ndim_;
+        }
+
+        //============================================================================
+        /// 去掉第 inAxis 维后的形状，即沿该维归约的结果形状，不足 2 维时补为 1 x n
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     Shape
+        ///
+        Shape removeAxis(uint32 inAxis) const
+        {
+            std::vector<uint64> out = dims();
+            out.erase(out.begin() + inAxis);
+            return Shape(out);
+        }
+
+        //============================================================================
+        /// 各维顺序颠倒的形状，即转置后的形状
+        ///
+        /// @return     Shape
+        ///
+        Shape reversed() const
+        {
+            std::vector<uint64> out = dims();
+            std::reverse(out.begin(), out.end());
+            return Shape(out);
+        }
+
+        uint64 size() const noexcept
+        {
+            return rows * cols;
+        }
+
+        //============================================================================
+        /// 行优先连续存储时第 inAxis 维相邻元素之间的元素个数，即其后各维大小的乘积
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     uint64
+        ///
+        uint64 stride(uint32 inAxis) const noexcept
+        {
+            uint64 stride = 1;
+            for (uint32 axis = inAxis + 1; axis < ndim_; ++axis)
+            {
+                stride *= (*this)[axis];
+            }
+            return stride;
+        }
+
         std::string str() const
         {
-            std::string out = "[" + utils::num2str(rows) + ", " + utils::num2str(cols) + "]\n";
+            std::string out = "[";
+            for (uint32 axis = 0; axis < ndim_; ++axis)
+            {
+                out += utils::num2str((*this)[axis]);
+                out += axis + 1 < ndim_ ? ", " : "]\n";
+            }
             return out;
         }
 
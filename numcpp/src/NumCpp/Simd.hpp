@@ -0,0 +1,690 @@
+#pragma once
+
+#include"NumCpp/Types.hpp"
+
+#include<algorithm>
+#include<cstdint>
+#include<cstdlib>
+#include<cstring>
+#include<type_traits>
+
+#if !defined(NUMCPP_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || \
+    (defined(__i386__) && defined(__SSE2__)) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define NUMCPP_SIMD_X86 1
+#include<immintrin.h>
+#ifdef _MSC_VER
+#include<intrin.h>
+#endif
+#endif
+
+#if defined(NUMCPP_SIMD_X86) && defined(__GNUC__)
+#define NUMCPP_TARGET_SSE2 __attribute__((target("sse2")))
+#define NUMCPP_TARGET_AVX2 __attribute__((target("avx2")))
+#define NUMCPP_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define NUMCPP_TARGET_SSE2
+#define NUMCPP_TARGET_AVX2
+#define NUMCPP_TARGET_AVX512
+#endif
+
+// 逐元素运算的 SIMD 内核，运行时根据 CPU 支持的指令集在 SSE2/AVX2/AVX-512 之间分派，
+// 不支持的平台、数据类型或运算使用标量实现。
+// 可通过环境变量 NUMCPP_SIMD=scalar|sse2|avx2|avx512 限制使用的最高指令集，
+// 编译时定义 NUMCPP_NO_SIMD 则完全禁用 SIMD
+namespace nc
+{
+    namespace simd
+    {
+        enum class Isa { SCALAR = 0, SSE2, AVX2, AVX512 };
+
+        //============================================================================
+        /// 检测 CPU 与操作系统支持的最高指令集
+        ///
+        /// @return     Isa
+        ///
+        inline Isa detectIsa() noexcept
+        {
+#if defined(NUMCPP_SIMD_X86) && defined(__GNUC__)
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+            {
+                return Isa::AVX512;
+            }
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return Isa::AVX2;
+            }
+            return Isa::SSE2;
+#elif defined(NUMCPP_SIMD_X86) && defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 1);
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+            __cpuidex(info, 7, 0);
+            if ((info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6)
+            {
+                return Isa::AVX512;
+            }
+            if ((info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6)
+            {
+                return Isa::AVX2;
+            }
+            return Isa::SSE2;
+#else
+            return Isa::SCALAR;
+#endif
+        }
+
+        //============================================================================
+        /// 当前使用的指令集，首次调用时检测并缓存
+        ///
+        /// @return     Isa
+        ///
+        inline Isa activeIsa() noexcept
+        {
+            static const Isa isa = []() noexcept -> Isa
+            {
+                Isa detected = detectIsa();
+                const char* envValue = std::getenv("NUMCPP_SIMD");
+                if (envValue != nullptr)
+                {
+                    Isa requested = detected;
+                    if (std::strcmp(envValue, "scalar") == 0)
+                    {
+                        requested = Isa::SCALAR;
+                    }
+                    else if (std::strcmp(envValue, "sse2") == 0)
+                    {
+                        requested = Isa::SSE2;
+                    }
+                    else if (std::strcmp(envValue, "avx2") == 0)
+                    {
+                        requested = Isa::AVX2;
+                    }
+                    detected = requested < detected ? requested : detected;
+                }
+                return detected;
+            }();
+            return isa;
+        }
+
+        // 运算标签，标量实现同时作为尾部元素和不支持 SIMD 时的后备
+        struct Add { template<typename T> static T scalar(T a, T b) noexcept { return a + b; } };
+        struct Subtract { template<typename T> static T scalar(T a, T b) noexcept { return a - b; } };
+        struct Multiply { template<typename T> static T scalar(T a, T b) noexcept { return a * b; } };
+        struct Divide { template<typename T> static T scalar(T a, T b) noexcept { return a / b; } };
+        struct Equal { template<typename T> static bool scalar(T a, T b) noexcept { return a == b; } };
+        struct NotEqual { template<typename T> static bool scalar(T a, T b) noexcept { return a != b; } };
+        struct Less { template<typename T> static bool scalar(T a, T b) noexcept { return a < b; } };
+        struct LessEqual { template<typename T> static bool scalar(T a, T b) noexcept { return a <= b; } };
+        struct Greater { template<typename T> static bool scalar(T a, T b) noexcept { return a > b; } };
+        struct GreaterEqual { template<typename T> static bool scalar(T a, T b) noexcept { return a >= b; } };
+        // 与 std::max_element/std::min_element 一致：b 为 NaN 时保留 a，向量实现按相同顺序传参
+        struct Maximum { template<typename T> static T scalar(T a, T b) noexcept { return a < b ? b : a; } };
+        struct Minimum { template<typename T> static T scalar(T a, T b) noexcept { return b < a ? b : a; } };
+
+        // 各数据类型在各指令集下的向量类型，void 表示没有对应实现
+        template<typename dtype>
+        struct VectorTypes
+        {
+            typedef void SSE2;
+            typedef void AVX2;
+            typedef void AVX512;
+        };
+
+        // 向量类型是否实现了某个运算，整数除法和 SSE2 下的 32 位整数乘法、最大/最小值没有对应指令
+        template<typename V, typename Op>
+        struct Supports : std::integral_constant<bool, !std::is_void<V>::value> {};
+
+#ifdef NUMCPP_SIMD_X86
+        struct Sse2Float
+        {
+            typedef float value_type;
+            typedef __m128 reg;
+            static constexpr uint32 WIDTH = 4;
+            static constexpr Isa ISA = Isa::SSE2;
+
+            NUMCPP_TARGET_SSE2 static reg load(const float* p) noexcept { return _mm_loadu_ps(p); }
+            NUMCPP_TARGET_SSE2 static void store(float* p, reg a) noexcept { _mm_storeu_ps(p, a); }
+            NUMCPP_TARGET_SSE2 static reg set1(float a) noexcept { return _mm_set1_ps(a); }
+            NUMCPP_TARGET_SSE2 static reg op(Add, reg a, reg b) noexcept { return _mm_add_ps(a, b); }
+            NUMCPP_TARGET_SSE2 static reg op(Subtract, reg a, reg b) noexcept { return _mm_sub_ps(a, b); }
+            NUMCPP_TARGET_SSE2 static reg op(Multiply, reg a, reg b) noexcept { return _mm_mul_ps(a, b); }
+            NUMCPP_TARGET_SSE2 static reg op(Divide, reg a, reg b) noexcept { return _mm_div_ps(a, b); }
+            NUMCPP_TARGET_SSE2 static reg op(Maximum, reg a, reg b) noexcept { return _mm_max_ps(b, a); }
+            NUMCPP_TARGET_SSE2 static reg op(Minimum, reg a, reg b) noexcept { return _mm_min_ps(b, a); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(Equal, reg a, reg b) noexcept { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(NotEqual, reg a, reg b) noexcept { return _mm_movemask_ps(_mm_cmpneq_ps(a, b)); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(Less, reg a, reg b) noexcept { return _mm_movemask_ps(_mm_cmplt_ps(a, b)); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(LessEqual, reg a, reg b) noexcept { return _mm_movemask_ps(_mm_cmple_ps(a, b)); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(Greater, reg a, reg b) noexcept { return _mm_movemask_ps(_mm_cmplt_ps(b, a)); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(GreaterEqual, reg a, reg b) noexcept { return _mm_movemask_ps(_mm_cmple_ps(b, a)); }
+        };
+
+        struct Sse2Double
+        {
+            typedef double value_type;
+            typedef __m128d reg;
+            static constexpr uint32 WIDTH = 2;
+            static constexpr Isa ISA = Isa::SSE2;
+
+            NUMCPP_TARGET_SSE2 static reg load(const double* p) noexcept { return _mm_loadu_pd(p); }
+            NUMCPP_TARGET_SSE2 static void store(double* p, reg a) noexcept { _mm_storeu_pd(p, a); }
+            NUMCPP_TARGET_SSE2 static reg set1(double a) noexcept { return _mm_set1_pd(a); }
+            NUMCPP_TARGET_SSE2 static reg op(Add, reg a, reg b) noexcept { return _mm_add_pd(a, b); }
+            NUMCPP_TARGET_SSE2 static reg op(Subtract, reg a, reg b) noexcept { return _mm_sub_pd(a, b); }
+            NUMCPP_TARGET_SSE2 static reg op(Multiply, reg a, reg b) noexcept { return _mm_mul_pd(a, b); }
+            NUMCPP_TARGET_SSE2 static reg op(Divide, reg a, reg b) noexcept { return _mm_div_pd(a, b); }
+            NUMCPP_TARGET_SSE2 static reg op(Maximum, reg a, reg b) noexcept { return _mm_max_pd(b, a); }
+            NUMCPP_TARGET_SSE2 static reg op(Minimum, reg a, reg b) noexcept { return _mm_min_pd(b, a); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(Equal, reg a, reg b) noexcept { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(NotEqual, reg a, reg b) noexcept { return _mm_movemask_pd(_mm_cmpneq_pd(a, b)); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(Less, reg a, reg b) noexcept { return _mm_movemask_pd(_mm_cmplt_pd(a, b)); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(LessEqual, reg a, reg b) noexcept { return _mm_movemask_pd(_mm_cmple_pd(a, b)); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(Greater, reg a, reg b) noexcept { return _mm_movemask_pd(_mm_cmplt_pd(b, a)); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(GreaterEqual, reg a, reg b) noexcept { return _mm_movemask_pd(_mm_cmple_pd(b, a)); }
+        };
+
+        struct Sse2Int32
+        {
+            typedef int32 value_type;
+            typedef __m128i reg;
+            static constexpr uint32 WIDTH = 4;
+            static constexpr Isa ISA = Isa::SSE2;
+
+            NUMCPP_TARGET_SSE2 static reg load(const int32* p) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            NUMCPP_TARGET_SSE2 static void store(int32* p, reg a) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a); }
+            NUMCPP_TARGET_SSE2 static reg set1(int32 a) noexcept { return _mm_set1_epi32(a); }
+            NUMCPP_TARGET_SSE2 static reg op(Add, reg a, reg b) noexcept { return _mm_add_epi32(a, b); }
+            NUMCPP_TARGET_SSE2 static reg op(Subtract, reg a, reg b) noexcept { return _mm_sub_epi32(a, b); }
+            NUMCPP_TARGET_SSE2 static uint32 bits(reg a) noexcept { return _mm_movemask_ps(_mm_castsi128_ps(a)); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(Equal, reg a, reg b) noexcept { return bits(_mm_cmpeq_epi32(a, b)); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(NotEqual, reg a, reg b) noexcept { return ~bits(_mm_cmpeq_epi32(a, b)) & 0xF; }
+            NUMCPP_TARGET_SSE2 static uint32 mask(Less, reg a, reg b) noexcept { return bits(_mm_cmplt_epi32(a, b)); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(LessEqual, reg a, reg b) noexcept { return ~bits(_mm_cmpgt_epi32(a, b)) & 0xF; }
+            NUMCPP_TARGET_SSE2 static uint32 mask(Greater, reg a, reg b) noexcept { return bits(_mm_cmpgt_epi32(a, b)); }
+            NUMCPP_TARGET_SSE2 static uint32 mask(GreaterEqual, reg a, reg b) noexcept { return ~bits(_mm_cmplt_epi32(a, b)) & 0xF; }
+        };
+
+        struct Avx2Float
+        {
+            typedef float value_type;
+            typedef __m256 reg;
+            static constexpr uint32 WIDTH = 8;
+            static constexpr Isa ISA = Isa::AVX2;
+
+            NUMCPP_TARGET_AVX2 static reg load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+            NUMCPP_TARGET_AVX2 static void store(float* p, reg a) noexcept { _mm256_storeu_ps(p, a); }
+            NUMCPP_TARGET_AVX2 static reg set1(float a) noexcept { return _mm256_set1_ps(a); }
+            NUMCPP_TARGET_AVX2 static reg op(Add, reg a, reg b) noexcept { return _mm256_add_ps(a, b); }
+            NUMCPP_TARGET_AVX2 static reg op(Subtract, reg a, reg b) noexcept { return _mm256_sub_ps(a, b); }
+            NUMCPP_TARGET_AVX2 static reg op(Multiply, reg a, reg b) noexcept { return _mm256_mul_ps(a, b); }
+            NUMCPP_TARGET_AVX2 static reg op(Divide, reg a, reg b) noexcept { return _mm256_div_ps(a, b); }
+            NUMCPP_TARGET_AVX2 static reg op(Maximum, reg a, reg b) noexcept { return _mm256_max_ps(b, a); }
+            NUMCPP_TARGET_AVX2 static reg op(Minimum, reg a, reg b) noexcept { return _mm256_min_ps(b, a); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(Equal, reg a, reg b) noexcept { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(NotEqual, reg a, reg b) noexcept { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_NEQ_UQ)); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(Less, reg a, reg b) noexcept { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(LessEqual, reg a, reg b) noexcept { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ)); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(Greater, reg a, reg b) noexcept { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(GreaterEqual, reg a, reg b) noexcept { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GE_OQ)); }
+        };
+
+        struct Avx2Double
+        {
+            typedef double value_type;
+            typedef __m256d reg;
+            static constexpr uint32 WIDTH = 4;
+            static constexpr Isa ISA = Isa::AVX2;
+
+            NUMCPP_TARGET_AVX2 static reg load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+            NUMCPP_TARGET_AVX2 static void store(double* p, reg a) noexcept { _mm256_storeu_pd(p, a); }
+            NUMCPP_TARGET_AVX2 static reg set1(double a) noexcept { return _mm256_set1_pd(a); }
+            NUMCPP_TARGET_AVX2 static reg op(Add, reg a, reg b) noexcept { return _mm256_add_pd(a, b); }
+            NUMCPP_TARGET_AVX2 static reg op(Subtract, reg a, reg b) noexcept { return _mm256_sub_pd(a, b); }
+            NUMCPP_TARGET_AVX2 static reg op(Multiply, reg a, reg b) noexcept { return _mm256_mul_pd(a, b); }
+            NUMCPP_TARGET_AVX2 static reg op(Divide, reg a, reg b) noexcept { return _mm256_div_pd(a, b); }
+            NUMCPP_TARGET_AVX2 static reg op(Maximum, reg a, reg b) noexcept { return _mm256_max_pd(b, a); }
+            NUMCPP_TARGET_AVX2 static reg op(Minimum, reg a, reg b) noexcept { return _mm256_min_pd(b, a); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(Equal, reg a, reg b) noexcept { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(NotEqual, reg a, reg b) noexcept { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_NEQ_UQ)); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(Less, reg a, reg b) noexcept { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ)); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(LessEqual, reg a, reg b) noexcept { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LE_OQ)); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(Greater, reg a, reg b) noexcept { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ)); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(GreaterEqual, reg a, reg b) noexcept { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GE_OQ)); }
+        };
+
+        struct Avx2Int32
+        {
+            typedef int32 value_type;
+            typedef __m256i reg;
+            static constexpr uint32 WIDTH = 8;
+            static constexpr Isa ISA = Isa::AVX2;
+
+            NUMCPP_TARGET_AVX2 static reg load(const int32* p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            NUMCPP_TARGET_AVX2 static void store(int32* p, reg a) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a); }
+            NUMCPP_TARGET_AVX2 static reg set1(int32 a) noexcept { return _mm256_set1_epi32(a); }
+            NUMCPP_TARGET_AVX2 static reg op(Add, reg a, reg b) noexcept { return _mm256_add_epi32(a, b); }
+            NUMCPP_TARGET_AVX2 static reg op(Subtract, reg a, reg b) noexcept { return _mm256_sub_epi32(a, b); }
+            NUMCPP_TARGET_AVX2 static reg op(Multiply, reg a, reg b) noexcept { return _mm256_mullo_epi32(a, b); }
+            NUMCPP_TARGET_AVX2 static reg op(Maximum, reg a, reg b) noexcept { return _mm256_max_epi32(b, a); }
+            NUMCPP_TARGET_AVX2 static reg op(Minimum, reg a, reg b) noexcept { return _mm256_min_epi32(b, a); }
+            NUMCPP_TARGET_AVX2 static uint32 bits(reg a) noexcept { return _mm256_movemask_ps(_mm256_castsi256_ps(a)); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(Equal, reg a, reg b) noexcept { return bits(_mm256_cmpeq_epi32(a, b)); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(NotEqual, reg a, reg b) noexcept { return ~bits(_mm256_cmpeq_epi32(a, b)) & 0xFF; }
+            NUMCPP_TARGET_AVX2 static uint32 mask(Less, reg a, reg b) noexcept { return bits(_mm256_cmpgt_epi32(b, a)); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(LessEqual, reg a, reg b) noexcept { return ~bits(_mm256_cmpgt_epi32(a, b)) & 0xFF; }
+            NUMCPP_TARGET_AVX2 static uint32 mask(Greater, reg a, reg b) noexcept { return bits(_mm256_cmpgt_epi32(a, b)); }
+            NUMCPP_TARGET_AVX2 static uint32 mask(GreaterEqual, reg a, reg b) noexcept { return ~bits(_mm256_cmpgt_epi32(b, a)) & 0xFF; }
+        };
+
+        struct Avx512Float
+        {
+            typedef float value_type;
+            typedef __m512 reg;
+            static constexpr uint32 WIDTH = 16;
+            static constexpr Isa ISA = Isa::AVX512;
+
+            NUMCPP_TARGET_AVX512 static reg load(const float* p) noexcept { return _mm512_loadu_ps(p); }
+            NUMCPP_TARGET_AVX512 static void store(float* p, reg a) noexcept { _mm512_storeu_ps(p, a); }
+            NUMCPP_TARGET_AVX512 static reg set1(float a) noexcept { return _mm512_set1_ps(a); }
+            NUMCPP_TARGET_AVX512 static reg op(Add, reg a, reg b) noexcept { return _mm512_add_ps(a, b); }
+            NUMCPP_TARGET_AVX512 static reg op(Subtract, reg a, reg b) noexcept { return _mm512_sub_ps(a, b); }
+            NUMCPP_TARGET_AVX512 static reg op(Multiply, reg a, reg b) noexcept { return _mm512_mul_ps(a, b); }
+            NUMCPP_TARGET_AVX512 static reg op(Divide, reg a, reg b) noexcept { return _mm512_div_ps(a, b); }
+            NUMCPP_TARGET_AVX512 static reg op(Maximum, reg a, reg b) noexcept { return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_LT_OQ), a, b); }
+            NUMCPP_TARGET_AVX512 static reg op(Minimum, reg a, reg b) noexcept { return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(b, a, _CMP_LT_OQ), a, b); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(Equal, reg a, reg b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(NotEqual, reg a, reg b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(Less, reg a, reg b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(LessEqual, reg a, reg b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(Greater, reg a, reg b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(GreaterEqual, reg a, reg b) noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ); }
+        };
+
+        struct Avx512Double
+        {
+            typedef double value_type;
+            typedef __m512d reg;
+            static constexpr uint32 WIDTH = 8;
+            static constexpr Isa ISA = Isa::AVX512;
+
+            NUMCPP_TARGET_AVX512 static reg load(const double* p) noexcept { return _mm512_loadu_pd(p); }
+            NUMCPP_TARGET_AVX512 static void store(double* p, reg a) noexcept { _mm512_storeu_pd(p, a); }
+            NUMCPP_TARGET_AVX512 static reg set1(double a) noexcept { return _mm512_set1_pd(a); }
+            NUMCPP_TARGET_AVX512 static reg op(Add, reg a, reg b) noexcept { return _mm512_add_pd(a, b); }
+            NUMCPP_TARGET_AVX512 static reg op(Subtract, reg a, reg b) noexcept { return _mm512_sub_pd(a, b); }
+            NUMCPP_TARGET_AVX512 static reg op(Multiply, reg a, reg b) noexcept { return _mm512_mul_pd(a, b); }
+            NUMCPP_TARGET_AVX512 static reg op(Divide, reg a, reg b) noexcept { return _mm512_div_pd(a, b); }
+            NUMCPP_TARGET_AVX512 static reg op(Maximum, reg a, reg b) noexcept { return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, b, _CMP_LT_OQ), a, b); }
+            NUMCPP_TARGET_AVX512 static reg op(Minimum, reg a, reg b) noexcept { return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(b, a, _CMP_LT_OQ), a, b); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(Equal, reg a, reg b) noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(NotEqual, reg a, reg b) noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(Less, reg a, reg b) noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(LessEqual, reg a, reg b) noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(Greater, reg a, reg b) noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(GreaterEqual, reg a, reg b) noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+        };
+
+        struct Avx512Int32
+        {
+            typedef int32 value_type;
+            typedef __m512i reg;
+            static constexpr uint32 WIDTH = 16;
+            static constexpr Isa ISA = Isa::AVX512;
+
+            NUMCPP_TARGET_AVX512 static reg load(const int32* p) noexcept { return _mm512_loadu_si512(p); }
+            NUMCPP_TARGET_AVX512 static void store(int32* p, reg a) noexcept { _mm512_storeu_si512(p, a); }
+            NUMCPP_TARGET_AVX512 static reg set1(int32 a) noexcept { return _mm512_set1_epi32(a); }
+            NUMCPP_TARGET_AVX512 static reg op(Add, reg a, reg b) noexcept { return _mm512_add_epi32(a, b); }
+            NUMCPP_TARGET_AVX512 static reg op(Subtract, reg a, reg b) noexcept { return _mm512_sub_epi32(a, b); }
+            NUMCPP_TARGET_AVX512 static reg op(Multiply, reg a, reg b) noexcept { return _mm512_mullo_epi32(a, b); }
+            NUMCPP_TARGET_AVX512 static reg op(Maximum, reg a, reg b) noexcept { return _mm512_mask_blend_epi32(_mm512_cmp_epi32_mask(a, b, _MM_CMPINT_LT), a, b); }
+            NUMCPP_TARGET_AVX512 static reg op(Minimum, reg a, reg b) noexcept { return _mm512_mask_blend_epi32(_mm512_cmp_epi32_mask(b, a, _MM_CMPINT_LT), a, b); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(Equal, reg a, reg b) noexcept { return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_EQ); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(NotEqual, reg a, reg b) noexcept { return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_NE); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(Less, reg a, reg b) noexcept { return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_LT); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(LessEqual, reg a, reg b) noexcept { return _mm512_cmp_epi32_mask(a, b, _MM_CMPINT_LE); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(Greater, reg a, reg b) noexcept { return _mm512_cmp_epi32_mask(b, a, _MM_CMPINT_LT); }
+            NUMCPP_TARGET_AVX512 static uint32 mask(GreaterEqual, reg a, reg b) noexcept { return _mm512_cmp_epi32_mask(b, a, _MM_CMPINT_LE); }
+        };
+
+        template<>
+        struct VectorTypes<float>
+        {
+            typedef Sse2Float SSE2;
+            typedef Avx2Float AVX2;
+            typedef Avx512Float AVX512;
+        };
+
+        template<>
+        struct VectorTypes<double>
+        {
+            typedef Sse2Double SSE2;
+            typedef Avx2Double AVX2;
+            typedef Avx512Double AVX512;
+        };
+
+        template<>
+        struct VectorTypes<int32>
+        {
+            typedef Sse2Int32 SSE2;
+            typedef Avx2Int32 AVX2;
+            typedef Avx512Int32 AVX512;
+        };
+
+        template<> struct Supports<Sse2Int32, Multiply> : std::false_type {};
+        template<> struct Supports<Sse2Int32, Divide> : std::false_type {};
+        template<> struct Supports<Sse2Int32, Maximum> : std::false_type {};
+        template<> struct Supports<Sse2Int32, Minimum> : std::false_type {};
+        template<> struct Supports<Avx2Int32, Divide> : std::false_type {};
+        template<> struct Supports<Avx512Int32, Divide> : std::false_type {};
+
+        // 各指令集的循环体完全相同，只是编译目标不同；ScalarA/ScalarB 为 true 时
+        // 对应操作数是广播到所有元素的单个标量
+#define NUMCPP_SIMD_DEFINE_LOOPS(TARGET)                                                                    \
+        template<typename V, typename Op, bool ScalarA, bool ScalarB>                                       \
+        TARGET static void arithmetic(const typename V::value_type* inA, const typename V::value_type* inB, \
+            typename V::value_type* outC, uint64 inSize) noexcept                                           \
+        {                                                                                                   \
+            const typename V::reg broadcastA = V::set1(*inA);                                               \
+            const typename V::reg broadcastB = V::set1(*inB);                                               \
+            const uint64 vectorEnd = inSize - inSize % V::WIDTH;                                            \
+            uint64 i = 0;                                                                                   \
+            for (; i < vectorEnd; i += V::WIDTH)                                                            \
+            {                                                                                               \
+                const typename V::reg a = ScalarA ? broadcastA : V::load(inA + i);                          \
+                const typename V::reg b = ScalarB ? broadcastB : V::load(inB + i);                          \
+                V::store(outC + i, V::op(Op(), a, b));                                                      \
+            }                                                                                               \
+            for (; i < inSize; ++i)                                                                         \
+            {                                                                                               \
+                outC[i] = Op::scalar(inA[ScalarA ? 0 : i], inB[ScalarB ? 0 : i]);                           \
+            }                                                                                               \
+        }                                                                                                   \
+                                                                                                            \
+        template<typename V, typename Op, bool ScalarA, bool ScalarB>                                       \
+        TARGET static void compare(const typename V::value_type* inA, const typename V::value_type* inB,    \
+            bool* outC, uint64 inSize) noexcept                                                             \
+        {                                                                                                   \
+            const typename V::reg broadcastA = V::set1(*inA);                                               \
+            const typename V::reg broadcastB = V::set1(*inB);                                               \
+            const uint64 vectorEnd = inSize - inSize % V::WIDTH;                                            \
+            uint64 i = 0;                                                                                   \
+            for (; i < vectorEnd; i += V::WIDTH)                                                            \
+            {                                                                                               \
+                const typename V::reg a = ScalarA ? broadcastA : V::load(inA + i);                          \
+                const typename V::reg b = ScalarB ? broadcastB : V::load(inB + i);                          \
+                const uint32 bits = V::mask(Op(), a, b);                                                    \
+                for (uint32 lane = 0; lane < V::WIDTH; ++lane)                                              \
+                {                                                                                           \
+                    outC[i + lane] = ((bits >> lane) & 1u) != 0;                                            \
+                }                                                                                           \
+            }                                                                                               \
+            for (; i < inSize; ++i)                                                                         \
+            {                                                                                               \
+                outC[i] = Op::scalar(inA[ScalarA ? 0 : i], inB[ScalarB ? 0 : i]);                           \
+            }                                                                                               \
+        }
+
+        template<Isa I>
+        struct Loops;
+
+        template<>
+        struct Loops<Isa::SSE2>
+        {
+            NUMCPP_SIMD_DEFINE_LOOPS(NUMCPP_TARGET_SSE2)
+        };
+
+        template<>
+        struct Loops<Isa::AVX2>
+        {
+            NUMCPP_SIMD_DEFINE_LOOPS(NUMCPP_TARGET_AVX2)
+        };
+
+        template<>
+        struct Loops<Isa::AVX512>
+        {
+            NUMCPP_SIMD_DEFINE_LOOPS(NUMCPP_TARGET_AVX512)
+        };
+
+#undef NUMCPP_SIMD_DEFINE_LOOPS
+#endif
+
+        // 尝试用向量类型 V 执行，V 不支持该运算时返回 false 交由下一级处理
+        template<typename V, typename Op, bool ScalarA, bool ScalarB, bool = Supports<V, Op>::value>
+        struct Runner
+        {
+            template<typename dtype>
+            static bool arithmetic(const dtype*, const dtype*, dtype*, uint64) noexcept { return false; }
+
+            template<typename dtype>
+            static bool compare(const dtype*, const dtype*, bool*, uint64) noexcept { return false; }
+        };
+
+#ifdef NUMCPP_SIMD_X86
+        template<typename V, typename Op, bool ScalarA, bool ScalarB>
+        struct Runner<V, Op, ScalarA, ScalarB, true>
+        {
+            template<typename dtype>
+            static bool arithmetic(const dtype* inA, const dtype* inB, dtype* outC, uint64 inSize) noexcept
+            {
+                Loops<V::ISA>::template arithmetic<V, Op, ScalarA, ScalarB>(inA, inB, outC, inSize);
+                return true;
+            }
+
+            template<typename dtype>
+            static bool compare(const dtype* inA, const dtype* inB, bool* outC, uint64 inSize) noexcept
+            {
+                Loops<V::ISA>::template compare<V, Op, ScalarA, ScalarB>(inA, inB, outC, inSize);
+                return true;
+            }
+        };
+#endif
+
+        //============================================================================
+        /// 逐元素算术运算 outC[i] = inA[i] op inB[i]，ScalarA/ScalarB 为 true 时
+        /// 对应操作数只读取第一个元素并广播。outC 可以与 inA 或 inB 相同（原地运算）
+        ///
+        /// @param      inA
+        /// @param      inB
+        /// @param      outC
+        /// @param      inSize
+        ///
+        template<typename Op, bool ScalarA, bool ScalarB, typename dtype>
+        void arithmetic(const dtype* inA, const dtype* inB, dtype* outC, uint64 inSize) noexcept
+        {
+            if (inSize == 0)
+            {
+                return;
+            }
+
+            typedef VectorTypes<dtype> Vectors;
+            switch (activeIsa())
+            {
+                case Isa::AVX512:
+                    if (Runner<typename Vectors::AVX512, Op, ScalarA, ScalarB>::arithmetic(inA, inB, outC, inSize))
+                    {
+                        return;
+                    }
+                    // fall through
+                case Isa::AVX2:
+                    if (Runner<typename Vectors::AVX2, Op, ScalarA, ScalarB>::arithmetic(inA, inB, outC, inSize))
+                    {
+                        return;
+                    }
+                    // fall through
+                case Isa::SSE2:
+                    if (Runner<typename Vectors::SSE2, Op, ScalarA, ScalarB>::arithmetic(inA, inB, outC, inSize))
+                    {
+                        return;
+                    }
+                    // fall through
+                default:
+                    break;
+            }
+
+            for (uint64 i = 0; i < inSize; ++i)
+            {
+                outC[i] = Op::scalar(inA[ScalarA ? 0 : i], inB[ScalarB ? 0 : i]);
+            }
+        }
+
+        //============================================================================
+        /// 逐元素比较 outC[i] = inA[i] op inB[i]，标量广播规则同 arithmetic
+        ///
+        /// @param      inA
+        /// @param      inB
+        /// @param      outC
+        /// @param      inSize
+        ///
+        template<typename Op, bool ScalarA, bool ScalarB, typename dtype>
+        void compare(const dtype* inA, const dtype* inB, bool* outC, uint64 inSize) noexcept
+        {
+            if (inSize == 0)
+            {
+                return;
+            }
+
+            typedef VectorTypes<dtype> Vectors;
+            switch (activeIsa())
+            {
+                case Isa::AVX512:
+                    if (Runner<typename Vectors::AVX512, Op, ScalarA, ScalarB>::compare(inA, inB, outC, inSize))
+                    {
+                        return;
+                    }
+                    // fall through
+                case Isa::AVX2:
+                    if (Runner<typename Vectors::AVX2, Op, ScalarA, ScalarB>::compare(inA, inB, outC, inSize))
+                    {
+                        return;
+                    }
+                    // fall through
+                case Isa::SSE2:
+                    if (Runner<typename Vectors::SSE2, Op, ScalarA, ScalarB>::compare(inA, inB, outC, inSize))
+                    {
+                        return;
+                    }
+                    // fall through
+                default:
+                    break;
+            }
+
+            for (uint64 i = 0; i < inSize; ++i)
+            {
+                outC[i] = Op::scalar(inA[ScalarA ? 0 : i], inB[ScalarB ? 0 : i]);
+            }
+        }
+
+        //============================================================================
+        /// 操作数是否按标量广播在运行时才确定的 arithmetic，如广播时一行内为常数的操作数
+        ///
+        /// @param      inA
+        /// @param      inScalarA
+        /// @param      inB
+        /// @param      inScalarB
+        /// @param      outC
+        /// @param      inSize
+        ///
+        template<typename Op, typename dtype>
+        void arithmetic(const dtype* inA, bool inScalarA, const dtype* inB, bool inScalarB, dtype* outC, uint64 inSize) noexcept
+        {
+            if (inScalarA)
+            {
+                inScalarB ? arithmetic<Op, true, true>(inA, inB, outC, inSize) : arithmetic<Op, true, false>(inA, inB, outC, inSize);
+            }
+            else
+            {
+                inScalarB ? arithmetic<Op, false, true>(inA, inB, outC, inSize) : arithmetic<Op, false, false>(inA, inB, outC, inSize);
+            }
+        }
+
+        //============================================================================
+        /// 操作数是否按标量广播在运行时才确定的 compare
+        ///
+        /// @param      inA
+        /// @param      inScalarA
+        /// @param      inB
+        /// @param      inScalarB
+        /// @param      outC
+        /// @param      inSize
+        ///
+        template<typename Op, typename dtype>
+        void compare(const dtype* inA, bool inScalarA, const dtype* inB, bool inScalarB, bool* outC, uint64 inSize) noexcept
+        {
+            if (inScalarA)
+            {
+                inScalarB ? compare<Op, true, true>(inA, inB, outC, inSize) : compare<Op, true, false>(inA, inB, outC, inSize);
+            }
+            else
+            {
+                inScalarB ? compare<Op, false, true>(inA, inB, outC, inSize) : compare<Op, false, false>(inA, inB, outC, inSize);
+            }
+        }
+
+        // 超过该字节数的填充使用非临时存储直接写入内存，避免整块数据把缓存中的有用数据挤出
+        constexpr uint64 STREAM_MIN_BYTES = 1 << 22;
+
+#ifdef NUMCPP_SIMD_X86
+        //============================================================================
+        /// 用非临时存储把 64 字节的 inPattern 重复写入 inNumLines 条缓存行，outLines 按 64 字节对齐
+        ///
+        /// @param      outLines
+        /// @param      inPattern
+        /// @param      inNumLines
+        ///
+        NUMCPP_TARGET_SSE2 inline void streamLines(uint8* outLines, const uint8* inPattern, uint64 inNumLines) noexcept
+        {
+            const __m128i pattern0 = _mm_load_si128(reinterpret_cast<const __m128i*>(inPattern));
+            const __m128i pattern1 = _mm_load_si128(reinterpret_cast<const __m128i*>(inPattern + 16));
+            const __m128i pattern2 = _mm_load_si128(reinterpret_cast<const __m128i*>(inPattern + 32));
+            const __m128i pattern3 = _mm_load_si128(reinterpret_cast<const __m128i*>(inPattern + 48));
+            for (uint64 line = 0; line < inNumLines; ++line)
+            {
+                __m128i* out = reinterpret_cast<__m128i*>(outLines + line * 64);
+                _mm_stream_si128(out, pattern0);
+                _mm_stream_si128(out + 1, pattern1);
+                _mm_stream_si128(out + 2, pattern2);
+                _mm_stream_si128(out + 3, pattern3);
+            }
+            _mm_sfence();
+        }
+#endif
+
+        //============================================================================
+        /// 把 inSize 个元素填充为 inValue，大块填充使用非临时存储
+        ///
+        /// @param      outArray
+        /// @param      inValue
+        /// @param      inSize
+        ///
+        template<typename dtype>
+        void fill(dtype* outArray, dtype inValue, uint64 inSize) noexcept
+        {
+#ifdef NUMCPP_SIMD_X86
+            const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(outArray);
+            const uint64 headBytes = (64 - address % 64) % 64;
+            if (std::is_trivially_copyable<dtype>::value && 64 % sizeof(dtype) == 0 && headBytes % sizeof(dtype) == 0 &&
+                inSize * sizeof(dtype) >= STREAM_MIN_BYTES && activeIsa() != Isa::SCALAR)
+            {
+                const uint64 headCount = headBytes / sizeof(dtype);
+                std::fill(outArray, outArray + headCount, inValue);
+
+                alignas(64) uint8 pattern[64];
+                for (uint32 offset = 0; offset < 64; offset += sizeof(dtype))
+                {
+                    std::memcpy(pattern + offset, &inValue, sizeof(dtype));
+                }
+
+                const uint64 numLines = (inSize - headCount) * sizeof(dtype) / 64;
+                streamLines(reinterpret_cast<uint8*>(outArray + headCount), pattern, numLines);
+
+                std::fill(outArray + headCount + numLines * (64 / sizeof(dtype)), outArray + inSize, inValue);
+                return;
+            }
+#endif
+            std::fill(outArray, outArray + inSize, inValue);
+        }
+    }
+}
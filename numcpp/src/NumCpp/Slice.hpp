@@ -12,22 +12,22 @@ namespace nc
     class Slice
     {
     public:
-        int32	start{0};
-        int32	stop{1};
-        int32	step{1};
+        int64	start{0};
+        int64	stop{1};
+        int64	step{1};
 
         Slice() = default;
 
-        explicit Slice(int32 inStop) noexcept :
+        explicit Slice(int64 inStop) noexcept :
             stop(inStop)
         {};
 
-        Slice(int32 inStart, int32 inStop) noexcept :
+        Slice(int64 inStart, int64 inStop) noexcept :
             start(inStart),
             stop(inStop)
         {};
 
-        Slice(int32 inStart, int32 inStop, int32 inStep) noexcept :
+        Slice(int64 inStart, int64 inStop, int64 inStep) noexcept :
             start(inStart),
             stop(inStop),
             step(inStep)
@@ -50,14 +50,14 @@ namespace nc
             return inOStream;
         }
 
-        void makePositiveAndValidate(uint32 inArraySize)
+        void makePositiveAndValidate(uint64 inArraySize)
         {
             /// convert the start value
             if (start < 0)
             {
-                start += inArraySize;
+                start += static_cast<int64>(inArraySize);
             }
-            if (start > static_cast<int32>(inArraySize - 1))
+            if (start < 0 || start > static_cast<int64>(inArraySize) - 1)
             {
                 std::string errStr = "ERROR: Invalid start value for array of size " + utils::num2str(inArraySize) + ".";
                 std::cerr << errStr << std::endl;
@@ -67,9 +67,9 @@ namespace nc
             /// convert the stop value
             if (stop < 0)
             {
-                stop += inArraySize;
+                stop += static_cast<int64>(inArraySize);
             }
-            if (stop > static_cast<int32>(inArraySize))
+            if (stop < 0 || stop > static_cast<int64>(inArraySize))
             {
                 std::string errStr = "ERROR: Invalid stop value for array of size " + utils::num2str(inArraySize) + ".";
                 std::cerr << errStr << std::endl;
@@ -79,7 +79,7 @@ namespace nc
             /// do some error checking
             if (start < stop)
             {
-                if (step < 0)
+                if (step <= 0)
                 {
                     std::string errStr = "ERROR: Invalid slice values.";
                     std::cerr << errStr << std::endl;
@@ -102,16 +102,15 @@ namespace nc
             }
         }
 
-        uint32 numElements(uint32 inArraySize)
+        uint64 numElements(uint64 inArraySize)
         {
             makePositiveAndValidate(inArraySize);
 
-            uint32 num = 0;
-            for (int32 i = start; i < stop; i += step)
+            if (start >= stop)
             {
-                ++num;
+                return 0;
             }
-            return num;
+            return static_cast<uint64>((stop - start + step - 1) / step);
         }
     };
 }
@@ -0,0 +1,571 @@
+#pragma once
+
+#include"NumCpp/Decomposition.hpp"
+#include"NumCpp/Gemm.hpp"
+#include"NumCpp/ThreadPool.hpp"
+#include"NumCpp/Types.hpp"
+
+#include<algorithm>
+#include<cmath>
+#include<limits>
+#include<numeric>
+#include<vector>
+
+// 对称特征分解与奇异值分解内核，矩阵均为行主序。
+// 特征分解：Householder 三对角化后用带 Wilkinson 位移的隐式 QL 迭代求三对角矩阵的特征值，
+// 特征向量以转置形式（每行一个向量）累积，使每个 Givens 旋转都作用在两条连续的行上。
+// 奇异值分解：单边 Jacobi（Hestenes）方法，同样把被正交化的列存为行，
+// 每轮按循环赛顺序取互不相交的行对并行旋转
+namespace nc
+{
+    namespace decomp
+    {
+        // 单边 Jacobi 的最大轮数，通常 10 轮以内收敛
+        constexpr uint32 JACOBI_MAX_SWEEPS = 60;
+
+        //============================================================================
+        /// 把对称矩阵 A（只读取下三角部分）原地化为三对角矩阵 T = Q^T * A * Q。
+        /// outD 为对角元，outE[k] 为 T(k + 1, k)（长度 inN，最后一个为 0）。
+        /// Q = H_0 * ... * H_{n-2}，H_k 的反射向量按 qr 的格式存放在 A + inLda 的第 k 列（即 A 的第 k 列
+        /// 第 k + 2 行以下），outTau 长度为 inN - 1
+        ///
+        /// @param      inN
+        /// @param      ioA
+        /// @param      inLda
+        /// @param      outD
+        /// @param      outE
+        /// @param      outTau
+        ///
+        template<typename dtype>
+        void tridiagonalize(uint64 inN, dtype* ioA, uint64 inLda, dtype* outD, dtype* outE, dtype* outTau)
+        {
+            if (inN == 0)
+            {
+                return;
+            }
+
+            for (uint64 i = 0; i < inN; ++i)
+            {
+                for (uint64 j = i + 1; j < inN; ++j)
+                {
+                    ioA[i * inLda + j] = ioA[j * inLda + i];
+                }
+            }
+
+            std::vector<dtype> v(inN);
+            std::vector<dtype> w(inN);
+            for (uint64 k = 0; k + 1 < inN; ++k)
+            {
+                const uint64 length = inN - k - 1;
+                dtype* column = ioA + (k + 1) * inLda + k;
+                const dtype tau = makeReflector(length, column, inLda);
+                outTau[k] = tau;
+                outD[k] = ioA[k * inLda + k];
+                outE[k] = column[0];
+                if (tau == static_cast<dtype>(0))
+                {
+                    continue;
+                }
+
+                v[0] = static_cast<dtype>(1);
+                for (uint64 i = 1; i < length; ++i)
+                {
+                    v[i] = column[i * inLda];
+                }
+
+                // A22 = H * A22 * H = A22 - v * w^T - w * v^T，其中 p = tau * A22 * v，w = p - (tau / 2) * (p^T v) * v
+                dtype* a22 = ioA + (k + 1) * inLda + k + 1;
+                const dtype* vData = v.data();
+                dtype* wData = w.data();
+                forEachChunk(length, length * length, [=](uint64 inFirst, uint64 inLast) noexcept
+                {
+                    for (uint64 i = inFirst; i < inLast; ++i)
+                    {
+                        wData[i] = tau * dot(a22 + i * inLda, vData, 1u, length);
+                    }
+                });
+
+                const dtype correction = static_cast<dtype>(-0.5) * tau * dot(wData, vData, 1u, length);
+                for (uint64 i = 0; i < length; ++i)
+                {
+                    wData[i] += correction * vData[i];
+                }
+
+                forEachChunk(length, 2 * length * length, [=](uint64 inFirst, uint64 inLast) noexcept
+                {
+                    for (uint64 i = inFirst; i < inLast; ++i)
+                    {
+                        dtype* row = a22 + i * inLda;
+                        const dtype vi = vData[i];
+                        const dtype wi = wData[i];
+                        for (uint64 j = 0; j < length; ++j)
+                        {
+                            row[j] -= vi * wData[j] + wi * vData[j];
+                        }
+                    }
+                });
+            }
+
+            outD[inN - 1] = ioA[(inN - 1) * inLda + inN - 1];
+            outE[inN - 1] = 0;
+        }
+
+        //============================================================================
+        /// 把 inCount 个 Givens 旋转依次作用到 Z 的相邻行上：第 r 个旋转作用于第 inRows[r] 行和下一行，
+        /// (z_i, z_i+1) <- (c * z_i - s * z_i+1, s * z_i + c * z_i+1)。按列分块并行
+        ///
+        /// @param      inCount
+        /// @param      inRows
+        /// @param      inCos
+        /// @param      inSin
+        /// @param      ioZ
+        /// @param      inCols
+        /// @param      inLdz
+        ///
+        template<typename dtype>
+        void applyRotations(uint64 inCount, const uint64* inRows, const dtype* inCos, const dtype* inSin,
+            dtype* ioZ, uint64 inCols, uint64 inLdz)
+        {
+            forEachChunk(inCols, 6 * inCount * inCols, [=](uint64 inFirst, uint64 inLast) noexcept
+            {
+                for (uint64 r = 0; r < inCount; ++r)
+                {
+                    dtype* rowI = ioZ + inRows[r] * inLdz;
+                    dtype* rowNext = rowI + inLdz;
+                    const dtype c = inCos[r];
+                    const dtype s = inSin[r];
+                    for (uint64 col = inFirst; col < inLast; ++col)
+                    {
+                        const dtype f = rowNext[col];
+                        rowNext[col] = s * rowI[col] + c * f;
+                        rowI[col] = c * rowI[col] - s * f;
+                    }
+                }
+            });
+        }
+
+        //============================================================================
+        /// 带 Wilkinson 位移的隐式 QL 迭代求对称三对角矩阵的全部特征值（未排序，覆盖 ioD）。
+        /// ioZ 不为空时，把每次迭代的旋转作用到 ioZ（inN x inCols）的行上：ioZ 初始为 Q^T 时，
+        /// 结束后第 i 行为第 i 个特征值对应的特征向量
+        ///
+        /// @param      inN
+        /// @param      ioD
+        /// @param      ioE: 次对角元，ioE[k] 为 T(k + 1, k)，最后一个为 0；返回后内容不再有意义
+        /// @param      ioZ
+        /// @param      inCols
+        /// @param      inLdz
+        ///
+        /// @return     bool: 是否收敛
+        ///
+        template<typename dtype>
+        bool tridiagonalEigen(uint64 inN, dtype* ioD, dtype* ioE, dtype* ioZ, uint64 inCols, uint64 inLdz)
+        {
+            const dtype eps = std::numeric_limits<dtype>::epsilon();
+            std::vector<uint64> rows(inN);
+            std::vector<dtype> cosines(inN);
+            std::vector<dtype> sines(inN);
+
+            for (uint64 l = 0; l < inN; ++l)
+            {
+                uint32 iterations = 0;
+                uint64 m = l;
+                do
+                {
+                    for (m = l; m + 1 < inN; ++m)
+                    {
+                        const dtype scale = std::abs(ioD[m]) + std::abs(ioD[m + 1]);
+                        if (std::abs(ioE[m]) <= eps * scale)
+                        {
+                            break;
+                        }
+                    }
+                    if (m == l)
+                    {
+                        break;
+                    }
+                    if (++iterations > 30)
+                    {
+                        return false;
+                    }
+
+                    // 用左上角 2x2 块的特征值作位移，从 m 处向上追赶凸起
+                    dtype g = (ioD[l + 1] - ioD[l]) / (static_cast<dtype>(2) * ioE[l]);
+                    dtype r = std::hypot(g, static_cast<dtype>(1));
+                    g = ioD[m] - ioD[l] + ioE[l] / (g + (g >= static_cast<dtype>(0) ? r : -r));
+                    dtype s = 1;
+                    dtype c = 1;
+                    dtype p = 0;
+                    bool underflow = false;
+                    uint64 numRotations = 0;
+                    for (uint64 i = m; i-- > l;)
+                    {
+                        const dtype f = s * ioE[i];
+                        const dtype b = c * ioE[i];
+                        r = std::hypot(f, g);
+                        ioE[i + 1] = r;
+                        if (r == static_cast<dtype>(0))
+                        {
+                            ioD[i + 1] -= p;
+                            ioE[m] = 0;
+                            underflow = true;
+                            break;
+                        }
+
+                        s = f / r;
+                        c = g / r;
+                        g = ioD[i + 1] - p;
+                        r = (ioD[i] - g) * s + static_cast<dtype>(2) * c * b;
+                        p = s * r;
+                        ioD[i + 1] = g + p;
+                        g = c * r - b;
+
+                        rows[numRotations] = i;
+                        cosines[numRotations] = c;
+                        sines[numRotations] = s;
+                        ++numRotations;
+                    }
+
+                    if (ioZ != nullptr)
+                    {
+                        applyRotations(numRotations, rows.data(), cosines.data(), sines.data(), ioZ, inCols, inLdz);
+                    }
+                    if (underflow)
+                    {
+                        continue;
+                    }
+
+                    ioD[l] -= p;
+                    ioE[l] = g;
+                    ioE[m] = 0;
+                } while (m != l);
+            }
+
+            return true;
+        }
+
+        //============================================================================
+        /// 对称矩阵的特征分解 A = V * diag(w) * V^T，只读取 A 的下三角部分，A 的内容被破坏。
+        /// 特征值按升序写入 outW；outVt 不为空时第 i 行为 outW[i] 对应的单位特征向量
+        ///
+        /// @param      inN
+        /// @param      ioA
+        /// @param      inLda
+        /// @param      outW
+        /// @param      outVt: inN x inN，行距 inN，可以为 nullptr
+        ///
+        /// @return     bool: 是否收敛
+        ///
+        template<typename dtype>
+        bool symmetricEigen(uint64 inN, dtype* ioA, uint64 inLda, dtype* outW, dtype* outVt)
+        {
+            if (inN == 0)
+            {
+                return true;
+            }
+
+            std::vector<dtype> d(inN);
+            std::vector<dtype> e(inN);
+            std::vector<dtype> tau(inN);
+            tridiagonalize(inN, ioA, inLda, d.data(), e.data(), tau.data());
+
+            std::vector<dtype> z;
+            if (outVt != nullptr)
+            {
+                // Z = Q^T = diag(1, H_{n-2} * ... * H_0)
+                z.assign(inN * inN, static_cast<dtype>(0));
+                for (uint64 i = 0; i < inN; ++i)
+                {
+                    z[i * inN + i] = static_cast<dtype>(1);
+                }
+                applyQt(inN - 1, inN - 1, ioA + inLda, inLda, tau.data(), z.data() + inN, inN, inN);
+            }
+
+            if (!tridiagonalEigen(inN, d.data(), e.data(), z.empty() ? nullptr : z.data(), inN, inN))
+            {
+                return false;
+            }
+
+            std::vector<uint64> order(inN);
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&d](uint64 inLhs, uint64 inRhs) { return d[inLhs] < d[inRhs]; });
+            for (uint64 i = 0; i < inN; ++i)
+            {
+                outW[i] = d[order[i]];
+                if (outVt != nullptr)
+                {
+                    std::copy(z.begin() + order[i] * inN, z.begin() + (order[i] + 1) * inN, outVt + i * inN);
+                }
+            }
+
+            return true;
+        }
+
+        //============================================================================
+        /// 单边 Jacobi 正交化：G 为 inK x inP（行距 inP），对行对反复做平面旋转直到各行两两正交，
+        /// 同样的旋转作用到 inK x inK 的 ioVt 上。对矩阵 M（inP x inK）的列做正交化时取 G = M^T、
+        /// ioVt = I，结束后 M * V = G^T，G 第 i 行的范数即第 i 个奇异值
+        ///
+        /// @param      inK
+        /// @param      inP
+        /// @param      ioG
+        /// @param      ioVt
+        ///
+        /// @return     bool: 是否在 JACOBI_MAX_SWEEPS 轮内收敛
+        ///
+        template<typename dtype>
+        bool jacobiOrthogonalize(uint64 inK, uint64 inP, dtype* ioG, dtype* ioVt)
+        {
+            if (inK < 2)
+            {
+                return true;
+            }
+
+            const dtype tolerance = std::numeric_limits<dtype>::epsilon() * std::sqrt(static_cast<dtype>(inP));
+
+            // 循环赛排程：位置 0 固定，其余位置每轮轮转一次，每轮得到 slots / 2 个互不相交的行对，
+            // 行数为奇数时补一个轮空位置
+            const uint64 slots = inK + inK % 2;
+            const uint64 numPairs = slots / 2;
+            std::vector<uint64> players(slots);
+            std::iota(players.begin(), players.end(), 0);
+            std::vector<dtype> norms(inK);
+            std::vector<uint32> rotated(numPairs);
+
+            for (uint32 sweep = 0; sweep < JACOBI_MAX_SWEEPS; ++sweep)
+            {
+                for (uint64 i = 0; i < inK; ++i)
+                {
+                    norms[i] = dot(ioG + i * inP, ioG + i * inP, 1u, inP);
+                }
+
+                bool anyRotation = false;
+                for (uint64 round = 0; round + 1 < slots; ++round)
+                {
+                    auto rotatePair = [&](uint32 inPair, uint32)
+                    {
+                        rotated[inPair] = 0;
+                        uint64 i = players[inPair];
+                        uint64 j = players[slots - 1 - inPair];
+                        if (i >= inK || j >= inK)
+                        {
+                            return;
+                        }
+                        if (i > j)
+                        {
+                            std::swap(i, j);
+                        }
+
+                        const dtype alpha = norms[i];
+                        const dtype beta = norms[j];
+                        if (alpha == static_cast<dtype>(0) || beta == static_cast<dtype>(0))
+                        {
+                            return;
+                        }
+
+                        dtype* rowI = ioG + i * inP;
+                        dtype* rowJ = ioG + j * inP;
+                        const dtype gamma = dot(rowI, rowJ, 1u, inP);
+                        if (std::abs(gamma) <= tolerance * std::sqrt(alpha) * std::sqrt(beta))
+                        {
+                            return;
+                        }
+
+                        const dtype zeta = (beta - alpha) / (static_cast<dtype>(2) * gamma);
+                        const dtype t = (zeta >= static_cast<dtype>(0) ? static_cast<dtype>(1) : static_cast<dtype>(-1)) /
+                            (std::abs(zeta) + std::sqrt(static_cast<dtype>(1) + zeta * zeta));
+                        const dtype c = static_cast<dtype>(1) / std::sqrt(static_cast<dtype>(1) + t * t);
+                        const dtype s = c * t;
+
+                        for (uint64 col = 0; col < inP; ++col)
+                        {
+                            const dtype gi = rowI[col];
+                            rowI[col] = c * gi - s * rowJ[col];
+                            rowJ[col] = s * gi + c * rowJ[col];
+                        }
+                        dtype* vtI = ioVt + i * inK;
+                        dtype* vtJ = ioVt + j * inK;
+                        for (uint64 col = 0; col < inK; ++col)
+                        {
+                            const dtype vi = vtI[col];
+                            vtI[col] = c * vi - s * vtJ[col];
+                            vtJ[col] = s * vi + c * vtJ[col];
+                        }
+
+                        norms[i] = alpha - t * gamma;
+                        norms[j] = beta + t * gamma;
+                        rotated[inPair] = 1;
+                    };
+
+                    if (numPairs * (inP + inK) < PARALLEL_MIN_FLOPS)
+                    {
+                        for (uint32 pair = 0; pair < numPairs; ++pair)
+                        {
+                            rotatePair(pair, 0);
+                        }
+                    }
+                    else
+                    {
+                        ThreadPool::instance().parallelFor(static_cast<uint32>(numPairs), rotatePair);
+                    }
+
+                    for (uint32 flag : rotated)
+                    {
+                        anyRotation = anyRotation || flag != 0;
+                    }
+                    std::rotate(players.begin() + 1, players.end() - 1, players.end());
+                }
+
+                if (!anyRotation)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        //============================================================================
+        /// 奇异值分解 A = U * diag(s) * V^T（约化形式），A 为 inM x inN 且 inM >= inN，A 的内容被破坏。
+        /// 先做 QR 分解 A = Q * R，再用单边 Jacobi 分解 R 的列，U = Q * U_R。
+        /// 奇异值按降序写入 outS；零奇异值对应的左奇异向量补全为与其余向量正交的单位向量
+        ///
+        /// @param      inM
+        /// @param      inN
+        /// @param      ioA
+        /// @param      outU: inM x inN，行距 inN
+        /// @param      outS
+        /// @param      outVt: inN x inN，行距 inN
+        ///
+        /// @return     bool: 是否收敛
+        ///
+        template<typename dtype>
+        bool tallSvd(uint64 inM, uint64 inN, dtype* ioA, dtype* outU, dtype* outS, dtype* outVt)
+        {
+            if (inN == 0)
+            {
+                return true;
+            }
+
+            std::vector<dtype> tau(inN);
+            qr(inM, inN, ioA, inN, tau.data());
+
+            // 再对 R^T 做一次 QR 分解 R^T = P * L^T，R = L * P^T。L 的列比 R 的列更接近正交，
+            // Jacobi 需要的轮数更少（Drmač-Veselić 预处理），取 G = L^T，Jacobi 结束后 V = P * V_L
+            std::vector<dtype> p(inN * inN, static_cast<dtype>(0));
+            for (uint64 i = 0; i < inN; ++i)
+            {
+                for (uint64 j = i; j < inN; ++j)
+                {
+                    p[j * inN + i] = ioA[i * inN + j];
+                }
+            }
+            std::vector<dtype> pTau(inN);
+            qr(inN, inN, p.data(), inN, pTau.data());
+
+            std::vector<dtype> g(inN * inN, static_cast<dtype>(0));
+            std::vector<dtype> vt(inN * inN, static_cast<dtype>(0));
+            for (uint64 i = 0; i < inN; ++i)
+            {
+                std::copy(p.begin() + i * inN + i, p.begin() + (i + 1) * inN, g.begin() + i * inN + i);
+                vt[i * inN + i] = static_cast<dtype>(1);
+            }
+            if (!jacobiOrthogonalize(inN, inN, g.data(), vt.data()))
+            {
+                return false;
+            }
+
+            // V = P * V_L，按列存放后再转置回行
+            std::vector<dtype> v(inN * inN);
+            for (uint64 i = 0; i < inN; ++i)
+            {
+                for (uint64 j = 0; j < inN; ++j)
+                {
+                    v[j * inN + i] = vt[i * inN + j];
+                }
+            }
+            applyQ(inN, inN, p.data(), inN, pTau.data(), v.data(), inN, inN);
+            for (uint64 i = 0; i < inN; ++i)
+            {
+                for (uint64 j = 0; j < inN; ++j)
+                {
+                    vt[i * inN + j] = v[j * inN + i];
+                }
+            }
+
+            std::vector<dtype> sigma(inN);
+            for (uint64 i = 0; i < inN; ++i)
+            {
+                sigma[i] = std::sqrt(dot(g.data() + i * inN, g.data() + i * inN, 1u, inN));
+            }
+            std::vector<uint64> order(inN);
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&sigma](uint64 inLhs, uint64 inRhs) { return sigma[inLhs] > sigma[inRhs]; });
+
+            // 按降序排列后把 G 的各行归一化为 U_R^T 的行，数值上为零的行留到后面补全
+            const dtype threshold = sigma[order[0]] * std::numeric_limits<dtype>::epsilon() * static_cast<dtype>(inN);
+            std::vector<dtype> urt(inN * inN);
+            uint64 rank = 0;
+            for (uint64 i = 0; i < inN; ++i)
+            {
+                const uint64 source = order[i];
+                outS[i] = sigma[source];
+                std::copy(vt.begin() + source * inN, vt.begin() + (source + 1) * inN, outVt + i * inN);
+                if (sigma[source] > threshold && sigma[source] > static_cast<dtype>(0))
+                {
+                    const dtype scale = static_cast<dtype>(1) / sigma[source];
+                    for (uint64 col = 0; col < inN; ++col)
+                    {
+                        urt[i * inN + col] = g[source * inN + col] * scale;
+                    }
+                    ++rank;
+                }
+                else
+                {
+                    std::fill(urt.begin() + i * inN, urt.begin() + (i + 1) * inN, static_cast<dtype>(0));
+                }
+            }
+
+            // 补全：依次取单位向量，减去在已有各行上的投影（做两遍），剩余部分足够大时归一化采用
+            uint64 candidate = 0;
+            for (uint64 i = rank; i < inN; ++i)
+            {
+                dtype* row = urt.data() + i * inN;
+                for (; candidate < inN; ++candidate)
+                {
+                    std::fill(row, row + inN, static_cast<dtype>(0));
+                    row[candidate] = static_cast<dtype>(1);
+                    for (uint32 pass = 0; pass < 2; ++pass)
+                    {
+                        for (uint64 other = 0; other < i; ++other)
+                        {
+                            const dtype* otherRow = urt.data() + other * inN;
+                            const dtype projection = dot(row, otherRow, 1u, inN);
+                            for (uint64 col = 0; col < inN; ++col)
+                            {
+                                row[col] -= projection * otherRow[col];
+                            }
+                        }
+                    }
+
+                    const dtype norm = std::sqrt(dot(row, row, 1u, inN));
+                    if (norm > static_cast<dtype>(0.5))
+                    {
+                        for (uint64 col = 0; col < inN; ++col)
+                        {
+                            row[col] /= norm;
+                        }
+                        ++candidate;
+                        break;
+                    }
+                }
+            }
+
+            // U = Q * U_R = Q * (U_R^T)^T
+            formQ(inM, inN, ioA, inN, tau.data());
+            gemm::gemm(inM, inN, inN, ioA, inN, 1u, urt.data(), 1u, inN, outU, inN);
+
+            return true;
+        }
+    }
+}
@@ -0,0 +1,492 @@
+#pragma once
+
+#include"NumCpp/AsyncIo.hpp"
+#include"NumCpp/Io.hpp"
+#include"NumCpp/NdArray.hpp"
+#include"NumCpp/Reduce.hpp"
+#include"NumCpp/Shape.hpp"
+#include"NumCpp/Types.hpp"
+#include"NumCpp/Utils.hpp"
+
+#include<algorithm>
+#include<fstream>
+#include<functional>
+#include<future>
+#include<memory>
+#include<iostream>
+#include<stdexcept>
+#include<string>
+#include<vector>
+
+// 比内存大的磁盘数组（原始二进制或 .npy）的流式访问：按固定行数的块顺序读取，
+// 通过 io::AsyncIo 预读下一块的同时处理当前块（双缓冲），内存中只有两个块。
+// 归约逐块计算后增量合并，结果与把整个数组读入内存后归约一致
+namespace nc
+{
+    template<typename dtype>
+    class StreamedArray
+    {
+    public:
+        // 每块的默认字节数
+        static constexpr uint64 BLOCK_BYTES = 1 << 26;
+
+        // 处理一块数据，inFirstRow 为该块第一行在整个数组中的行号，返回 false 时提前结束
+        typedef std::function<bool(const NdArray<dtype>& inBlock, uint64 inFirstRow)> BlockFunction;
+
+    private:
+        std::string     filename_;
+        uint64          numRows_{ 0 };
+        uint64          numCols_{ 0 };
+        uint64          offset_{ 0 };
+        Endian          endianess_{ Endian::NATIVE };
+        uint64          rowsPerBlock_{ 1 };
+
+        void setBlockBytes(uint64 inBlockBytes)
+        {
+            const uint64 rowBytes = std::max<uint64>(numCols_ * sizeof(dtype), 1);
+            uint64 rows = std::max<uint64>(inBlockBytes / rowBytes, 1);
+            rowsPerBlock_ = std::min<uint64>(rows, std::max<uint64>(numRows_, 1));
+        }
+
+        void checkNotEmpty(const std::string& inFunctionName) const
+        {
+            if (numRows_ == 0 || numCols_ == 0)
+            {
+                std::string errStr = "ERROR: StreamedArray::" + inFunctionName + ": attempt to reduce an empty array.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+        }
+
+        //============================================================================
+        /// Axis::COL 的归约：每块的逐行结果拼接成 1 x 行数 的数组
+        ///
+        template<typename T, typename Function>
+        NdArray<T> perRow(Function inFunction) const
+        {
+            NdArray<T> returnArray(1, numRows_);
+            forEachBlock([&returnArray, &inFunction](const NdArray<dtype>& inBlock, uint64 inFirstRow) -> bool
+            {
+                const NdArray<T> blockResult = inFunction(inBlock);
+                std::copy(blockResult.cbegin(), blockResult.cend(), returnArray.begin() + inFirstRow);
+                return true;
+            });
+
+            return std::move(returnArray);
+        }
+
+        //============================================================================
+        /// Axis::NONE 与 Axis::ROW 的逐元素合并：inBlockResult 与累计结果按 inCombine 合并
+        ///
+        template<typename T, typename BlockReduce, typename Combine>
+        NdArray<T> combineBlocks(Axis inAxis, BlockReduce inBlockReduce, Combine inCombine) const
+        {
+            NdArray<T> returnArray;
+            forEachBlock([&returnArray, &inBlockReduce, &inCombine, inAxis](const NdArray<dtype>& inBlock, uint64) -> bool
+            {
+                NdArray<T> blockResult = inBlockReduce(inBlock, inAxis);
+                if (returnArray.isempty())
+                {
+                    returnArray = std::move(blockResult);
+                    return true;
+                }
+
+                for (uint64 i = 0; i < returnArray.size(); ++i)
+                {
+                    returnArray[i] = inCombine(returnArray[i], blockResult[i]);
+                }
+                return true;
+            });
+
+            return std::move(returnArray);
+        }
+
+        //============================================================================
+        /// 极值及其位置：inBetter(a, b) 为 b 比 a 更优，相等时保留先出现的
+        ///
+        template<typename ArgReduce, typename Better>
+        NdArray<uint64> argExtreme(Axis inAxis, ArgReduce inArgReduce, Better inBetter, const std::string& inFunctionName) const
+        {
+            checkNotEmpty(inFunctionName);
+
+            if (inAxis == Axis::COL)
+            {
+                return std::move(perRow<uint64>([&inArgReduce](const NdArray<dtype>& inBlock)
+                {
+                    return inArgReduce(inBlock, Axis::COL);
+                }));
+            }
+
+            const uint64 numResults = inAxis == Axis::ROW ? numCols_ : 1;
+            NdArray<uint64> returnArray(1, numResults);
+            std::vector<dtype> bestValues(numResults);
+            bool first = true;
+            forEachBlock([&](const NdArray<dtype>& inBlock, uint64 inFirstRow) -> bool
+            {
+                const NdArray<uint64> blockIndices = inArgReduce(inBlock, inAxis);
+                for (uint64 i = 0; i < numResults; ++i)
+                {
+                    // Axis::NONE gives a flat index into the block, Axis::ROW the row inside the block of column i
+                    const uint64 localIndex = blockIndices[i];
+                    const dtype value = inAxis == Axis::ROW ? inBlock(static_cast<int64>(localIndex), i) : inBlock[static_cast<int64>(localIndex)];
+                    if (first || inBetter(bestValues[i], value))
+                    {
+                        bestValues[i] = value;
+                        returnArray[i] = inAxis == Axis::ROW ? inFirstRow + localIndex : inFirstRow * numCols_ + localIndex;
+                    }
+                }
+                first = false;
+                return true;
+            });
+
+            return std::move(returnArray);
+        }
+
+        //============================================================================
+        /// 求和：块内用归约引擎（成对/Kahan），块间 Axis::NONE 成对合并、Axis::ROW Kahan 补偿合并
+        ///
+        template<typename T, typename Map>
+        NdArray<T> sumWith(Axis inAxis, const Map& inMap) const
+        {
+            typedef reduce::Sum<T> Op;
+
+            if (inAxis == Axis::COL)
+            {
+                return std::move(perRow<T>([&inMap](const NdArray<dtype>& inBlock)
+                {
+                    NdArray<T> blockResult(reduce::resultShape(inBlock.shape(), Axis::COL));
+                    reduce::reduce<Op>(inBlock.cbegin(), inBlock.shape(), Axis::COL, inMap, blockResult.begin());
+                    return blockResult;
+                }));
+            }
+
+            if (inAxis == Axis::NONE)
+            {
+                std::vector<T> partials;
+                forEachBlock([&partials, &inMap](const NdArray<dtype>& inBlock, uint64) -> bool
+                {
+                    partials.push_back(reduce::all<Op>(inBlock.cbegin(), inBlock.size(), inMap));
+                    return true;
+                });
+
+                NdArray<T> returnArray(1, 1);
+                returnArray[0] = reduce::pairwise<Op>(partials.data(), partials.size(), 0, reduce::Cast<T>());
+                return std::move(returnArray);
+            }
+
+            NdArray<T> returnArray(1, numCols_);
+            returnArray.fill(Op::identity());
+            std::vector<T> compensation(numCols_, static_cast<T>(0));
+            NdArray<T> blockResult(1, numCols_);
+            forEachBlock([&](const NdArray<dtype>& inBlock, uint64) -> bool
+            {
+                reduce::reduce<Op>(inBlock.cbegin(), inBlock.shape(), Axis::ROW, inMap, blockResult.begin());
+                for (uint64 col = 0; col < numCols_; ++col)
+                {
+                    if (Op::COMPENSATED)
+                    {
+                        reduce::compensatedAdd(returnArray[col], compensation[col], blockResult[col]);
+                    }
+                    else
+                    {
+                        returnArray[col] = Op::combine(returnArray[col], blockResult[col]);
+                    }
+                }
+                return true;
+            });
+
+            return std::move(returnArray);
+        }
+
+    public:
+        //============================================================================
+        /// 原始二进制文件（如 tofile 写出的文件）中从 inOffset 字节开始的 inNumRows x inNumCols 行优先数组
+        ///
+        /// @param      inFilename
+        /// @param      inNumRows: 行数不受 NdArray 索引范围限制
+        /// @param      inNumCols
+        /// @param      inOffset: 文件头的字节数
+        /// @param      inEndianess: 文件中数据的字节序
+        /// @param      inBlockBytes: 每块的字节数，至少一行
+        ///
+        StreamedArray(const std::string& inFilename, uint64 inNumRows, uint64 inNumCols, uint64 inOffset = 0,
+            Endian inEndianess = Endian::NATIVE, uint64 inBlockBytes = BLOCK_BYTES) :
+            filename_(inFilename),
+            numRows_(inNumCols == 0 ? 0 : inNumRows),
+            numCols_(inNumRows == 0 ? 0 : inNumCols),
+            offset_(inOffset),
+            endianess_(inEndianess)
+        {
+            std::ifstream file(filename_, std::ios::in | std::ios::binary | std::ios::ate);
+            const uint64 numBytes = inOffset + numRows_ * numCols_ * sizeof(dtype);
+            if (!file.is_open() || static_cast<uint64>(file.tellg()) < numBytes)
+            {
+                std::string errStr = "ERROR: StreamedArray: '" + filename_ + "' cannot be opened or is smaller than " + utils::num2str(numBytes) + " bytes.";
+                std::cerr << errStr << std::endl;
+                throw std::runtime_error(errStr);
+            }
+
+            setBlockBytes(inBlockBytes);
+        }
+
+        //============================================================================
+        /// .npy 文件，数据须为行优先（fortran_order 为 False）
+        ///
+        /// @param      inFilename
+        /// @param      inBlockBytes: 每块的字节数，至少一行
+        ///
+        explicit StreamedArray(const std::string& inFilename, uint64 inBlockBytes = BLOCK_BYTES) :
+            filename_(inFilename)
+        {
+            std::ifstream file(filename_, std::ios::in | std::ios::binary);
+            if (!file.is_open())
+            {
+                std::string errStr = "ERROR: StreamedArray: unable to open '" + filename_ + "'.";
+                std::cerr << errStr << std::endl;
+                throw std::runtime_error(errStr);
+            }
+
+            const io::NpyHeader header = io::readNpyHeader<dtype>(file, filename_);
+            if (header.fortranOrder)
+            {
+                std::string errStr = "ERROR: StreamedArray: '" + filename_ + "' must be C ordered to be streamed by rows.";
+                std::cerr << errStr << std::endl;
+                throw std::invalid_argument(errStr);
+            }
+
+            numRows_ = header.numCols == 0 ? 0 : header.numRows;
+            numCols_ = header.numRows == 0 ? 0 : header.numCols;
+            offset_ = header.dataOffset;
+            endianess_ = header.endianess;
+            setBlockBytes(inBlockBytes);
+        }
+
+        //============================================================================
+        /// 按顺序把每块交给 inFunction。下一块由 io::AsyncIo 异步读取，与 inFunction 的执行重叠；
+        /// 块总是本机字节序的 rowsPerBlock() x numCols() 数组（最后一块行数可能更少）
+        ///
+        /// @param      inFunction
+        ///
+        void forEachBlock(const BlockFunction& inFunction) const
+        {
+            if (numRows_ == 0)
+            {
+                return;
+            }
+
+            auto file = std::make_shared<const io::File>(filename_, io::FileMode::READ);
+
+            // allocated here so that they come from this thread's allocator
+            const uint64 tailRows = numRows_ % rowsPerBlock_;
+            NdArray<dtype> buffers[2] = { NdArray<dtype>(rowsPerBlock_, numCols_),
+                NdArray<dtype>(numRows_ > rowsPerBlock_ ? rowsPerBlock_ : 0, numCols_) };
+            NdArray<dtype> tail(tailRows, tailRows == 0 ? 0 : numCols_);
+
+            auto blockFor = [this, &buffers, &tail](uint64 inBlockIndex) -> NdArray<dtype>*
+            {
+                const bool last = (inBlockIndex + 1) * rowsPerBlock_ >= numRows_;
+                return last && !tail.isempty() ? &tail : &buffers[inBlockIndex % 2];
+            };
+            auto readBlock = [this, &file, &blockFor](uint64 inBlockIndex) -> std::future<void>
+            {
+                NdArray<dtype>* block = blockFor(inBlockIndex);
+                const uint64 blockBytes = static_cast<uint64>(rowsPerBlock_) * numCols_ * sizeof(dtype);
+                return io::AsyncIo::instance().read(file, block->begin(), static_cast<uint64>(block->size()) * sizeof(dtype),
+                    offset_ + inBlockIndex * blockBytes);
+            };
+
+            std::future<void> pending = readBlock(0);
+            try
+            {
+                uint64 blockIndex = 0;
+                for (uint64 firstRow = 0; firstRow < numRows_; firstRow += rowsPerBlock_, ++blockIndex)
+                {
+                    pending.get();
+                    NdArray<dtype>* block = blockFor(blockIndex);
+                    if (io::needsSwap(endianess_))
+                    {
+                        io::byteswap(block->begin(), block->size());
+                    }
+                    if (firstRow + rowsPerBlock_ < numRows_)
+                    {
+                        pending = readBlock(blockIndex + 1);
+                    }
+
+                    if (!inFunction(*block, firstRow))
+                    {
+                        break;
+                    }
+                }
+            }
+            catch (...)
+            {
+                // the buffers must outlive the read in flight
+                if (pending.valid())
+                {
+                    pending.wait();
+                }
+                throw;
+            }
+
+            if (pending.valid())
+            {
+                pending.wait();
+            }
+        }
+
+        NdArray<bool> all(Axis inAxis = Axis::NONE) const
+        {
+            if (inAxis == Axis::COL)
+            {
+                return std::move(perRow<bool>([](const NdArray<dtype>& inBlock) { return inBlock.all(Axis::COL); }));
+            }
+
+            if (inAxis == Axis::NONE)
+            {
+                NdArray<bool> returnArray(1, 1);
+                returnArray[0] = true;
+                forEachBlock([&returnArray](const NdArray<dtype>& inBlock, uint64) -> bool
+                {
+                    // stop reading as soon as the answer is known
+                    returnArray[0] = inBlock.all().item();
+                    return returnArray[0];
+                });
+                return std::move(returnArray);
+            }
+
+            NdArray<bool> returnArray = combineBlocks<bool>(inAxis,
+                [](const NdArray<dtype>& inBlock, Axis inBlockAxis) { return inBlock.all(inBlockAxis); },
+                [](bool inA, bool inB) noexcept { return inA && inB; });
+            return std::move(returnArray.isempty() ? NdArray<bool>(Shape(1, numCols_), true) : returnArray);
+        }
+
+        NdArray<bool> any(Axis inAxis = Axis::NONE) const
+        {
+            if (inAxis == Axis::COL)
+            {
+                return std::move(perRow<bool>([](const NdArray<dtype>& inBlock) { return inBlock.any(Axis::COL); }));
+            }
+
+            if (inAxis == Axis::NONE)
+            {
+                NdArray<bool> returnArray(1, 1);
+                returnArray[0] = false;
+                forEachBlock([&returnArray](const NdArray<dtype>& inBlock, uint64) -> bool
+                {
+                    returnArray[0] = inBlock.any().item();
+                    return !returnArray[0];
+                });
+                return std::move(returnArray);
+            }
+
+            NdArray<bool> returnArray = combineBlocks<bool>(inAxis,
+                [](const NdArray<dtype>& inBlock, Axis inBlockAxis) { return inBlock.any(inBlockAxis); },
+                [](bool inA, bool inB) noexcept { return inA || inB; });
+            return std::move(returnArray.isempty() ? NdArray<bool>(Shape(1, numCols_), false) : returnArray);
+        }
+
+        //============================================================================
+        /// 最大值的位置。索引可能超出 32 位，因此返回 uint64：
+        /// Axis::NONE 为整个数组中的扁平索引，Axis::ROW 为每列最大值所在的行
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     NdArray
+        ///
+        NdArray<uint64> argmax(Axis inAxis = Axis::NONE) const
+        {
+            return std::move(argExtreme(inAxis, [](const NdArray<dtype>& inBlock, Axis inBlockAxis) { return inBlock.argmax(inBlockAxis); },
+                [](dtype inBest, dtype inValue) noexcept { return inBest < inValue; }, "argmax"));
+        }
+
+        //============================================================================
+        /// 最小值的位置，索引的含义同 argmax
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     NdArray
+        ///
+        NdArray<uint64> argmin(Axis inAxis = Axis::NONE) const
+        {
+            return std::move(argExtreme(inAxis, [](const NdArray<dtype>& inBlock, Axis inBlockAxis) { return inBlock.argmin(inBlockAxis); },
+                [](dtype inBest, dtype inValue) noexcept { return inValue < inBest; }, "argmin"));
+        }
+
+        const std::string& filename() const noexcept
+        {
+            return filename_;
+        }
+
+        NdArray<dtype> max(Axis inAxis = Axis::NONE) const
+        {
+            checkNotEmpty("max");
+            if (inAxis == Axis::COL)
+            {
+                return std::move(perRow<dtype>([](const NdArray<dtype>& inBlock) { return inBlock.max(Axis::COL); }));
+            }
+
+            return std::move(combineBlocks<dtype>(inAxis,
+                [](const NdArray<dtype>& inBlock, Axis inBlockAxis) { return inBlock.max(inBlockAxis); },
+                [](dtype inA, dtype inB) noexcept { return inA < inB ? inB : inA; }));
+        }
+
+        //============================================================================
+        /// 平均值，Axis::ROW 为每列的平均值
+        ///
+        /// @param      inAxis
+        ///
+        /// @return     NdArray
+        ///
+        NdArray<double> mean(Axis inAxis = Axis::NONE) const
+        {
+            NdArray<double> returnArray = sumWith<double>(inAxis, reduce::Cast<double>());
+            switch (inAxis)
+            {
+                case Axis::COL:
+                    returnArray /= static_cast<double>(numCols_);
+                    break;
+                case Axis::ROW:
+                    returnArray /= static_cast<double>(numRows_);
+                    break;
+                default:
+                    returnArray /= static_cast<double>(numRows_) * static_cast<double>(numCols_);
+                    break;
+            }
+
+            return std::move(returnArray);
+        }
+
+        NdArray<dtype> min(Axis inAxis = Axis::NONE) const
+        {
+            checkNotEmpty("min");
+            if (inAxis == Axis::COL)
+            {
+                return std::move(perRow<dtype>([](const NdArray<dtype>& inBlock) { return inBlock.min(Axis::COL); }));
+            }
+
+            return std::move(combineBlocks<dtype>(inAxis,
+                [](const NdArray<dtype>& inBlock, Axis inBlockAxis) { return inBlock.min(inBlockAxis); },
+                [](dtype inA, dtype inB) noexcept { return inB < inA ? inB : inA; }));
+        }
+
+        uint64 numCols() const noexcept
+        {
+            return numCols_;
+        }
+
+        uint64 numRows() const noexcept
+        {
+            return numRows_;
+        }
+
+        uint64 rowsPerBlock() const noexcept
+        {
+            return rowsPerBlock_;
+        }
+
+        NdArray<dtype> sum(Axis inAxis = Axis::NONE) const
+        {
+            return std::move(sumWith<dtype>(inAxis, reduce::Cast<dtype>()));
+        }
+    };
+}
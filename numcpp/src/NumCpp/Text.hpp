@@ -0,0 +1,1002 @@
+#pragma once
+
+#include"NumCpp/Io.hpp"
+#include"NumCpp/Types.hpp"
+
+#include<cmath>
+#include<cstdio>
+#include<cstdlib>
+#include<cstring>
+#include<iostream>
+#include<limits>
+#include<stdexcept>
+#include<string>
+#include<type_traits>
+#include<vector>
+
+// 数字与文本之间的转换，供 loadtxt/savetxt 与 str() 使用。
+// 解析不依赖 locale：整数与常见的浮点数（有效数字不超过 19 位且指数较小）
+// 由手写代码一次 8 位（SWAR）地转换，Clinger 快速路径或 Eisel-Lemire 算法给出正确舍入的结果，
+// 两者都无法确定时才交给 strtod。浮点数用 Grisu2 输出能精确读回的最短形式，小数点固定为 '.'
+namespace nc
+{
+    namespace text
+    {
+        // 任何数值格式化后的最大字符数
+        constexpr uint32 MAX_CHARS = 48;
+
+        // loadtxt 每个并行任务处理的字节数，任务边界对齐到行首
+        constexpr uint64 CHUNK_BYTES = 1 << 22;
+
+        // savetxt 每个并行任务格式化的元素个数
+        constexpr uint64 FORMAT_BLOCK = 1 << 16;
+
+        //============================================================================
+        /// 字符是否为十进制数字
+        ///
+        inline bool isDigit(char inChar) noexcept
+        {
+            return static_cast<uint8>(inChar - '0') < 10;
+        }
+
+        namespace detail
+        {
+            //============================================================================
+            /// 若 inFirst 开始的 8 个字符都是数字则把它们转换为整数并返回 true（SWAR，仅限小端）
+            ///
+            inline bool parseEightDigits(const char* inFirst, uint64& outValue) noexcept
+            {
+                uint64 chunk;
+                std::memcpy(&chunk, inFirst, 8);
+                if ((((chunk & 0xF0F0F0F0F0F0F0F0ull) | (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4))
+                    != 0x3333333333333333ull))
+                {
+                    return false;
+                }
+
+                chunk -= 0x3030303030303030ull;
+                chunk = (chunk * 10) + (chunk >> 8);
+                chunk = (((chunk & 0x000000FF000000FFull) * (100 + (1000000ull << 32)))
+                    + (((chunk >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+                outValue = chunk;
+                return true;
+            }
+
+            //============================================================================
+            /// 读取连续的数字累加到 ioValue，最多累加到 19 位有效数字，多余的数字只计数
+            ///
+            /// @return     指向第一个非数字字符
+            ///
+            inline const char* parseDigits(const char* inFirst, const char* inLast, uint64& ioValue, uint32& ioNumDigits, uint32& outDropped) noexcept
+            {
+                const bool littleEndian = io::nativeIsLittle();
+                while (ioNumDigits + 8 <= 19 && inLast - inFirst >= 8 && littleEndian)
+                {
+                    uint64 eight;
+                    if (!parseEightDigits(inFirst, eight))
+                    {
+                        break;
+                    }
+                    if (ioValue == 0)
+                    {
+                        // leading zeros do not count towards the significant digits
+                        for (uint64 rest = eight; rest != 0; rest /= 10)
+                        {
+                            ++ioNumDigits;
+                        }
+                    }
+                    else
+                    {
+                        ioNumDigits += 8;
+                    }
+                    ioValue = ioValue * 100000000ull + eight;
+                    inFirst += 8;
+                }
+
+                for (; inFirst != inLast && isDigit(*inFirst); ++inFirst)
+                {
+                    if (ioNumDigits < 19)
+                    {
+                        ioValue = ioValue * 10 + static_cast<uint64>(*inFirst - '0');
+                        ioNumDigits += ioValue == 0 ? 0 : 1;
+                    }
+                    else
+                    {
+                        ++outDropped;
+                    }
+                }
+                return inFirst;
+            }
+
+            inline bool matchWord(const char* inFirst, const char* inLast, const char* inWord) noexcept
+            {
+                const uint64 length = std::strlen(inWord);
+                if (static_cast<uint64>(inLast - inFirst) < length)
+                {
+                    return false;
+                }
+
+                for (uint64 i = 0; i < length; ++i)
+                {
+                    if ((inFirst[i] | 0x20) != inWord[i])
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            template<typename dtype>
+            struct FloatTraits
+            {
+                // 非 IEEE 单/双精度的类型（long double）只走 C 库
+                static constexpr bool IEEE = false;
+
+                // 尾数不超过该值且 |10 的指数| 不超过 MAX_EXACT_POW10 时，
+                // 一次乘或除即得到正确舍入的结果
+                static constexpr uint64 MAX_EXACT_MANTISSA = 0;
+                static constexpr int32 MAX_EXACT_POW10 = -1;
+
+                // 依次尝试的有效数字位数，最后一个保证能精确读回
+                static constexpr int32 MIN_DIGITS = 18;
+                static constexpr int32 MAX_DIGITS = 21;
+
+                static dtype fallback(const char* inText) { return static_cast<dtype>(std::strtold(inText, nullptr)); }
+            };
+
+            template<>
+            struct FloatTraits<float>
+            {
+                typedef uint32 Bits;
+                static constexpr bool IEEE = true;
+                static constexpr int32 SIGNIFICAND_BITS = 23;
+                static constexpr int32 EXPONENT_BIAS = 127;
+
+                static constexpr uint64 MAX_EXACT_MANTISSA = 1ull << 24;
+                static constexpr int32 MAX_EXACT_POW10 = 10;
+
+                static float fallback(const char* inText) { return std::strtof(inText, nullptr); }
+            };
+
+            template<>
+            struct FloatTraits<double>
+            {
+                typedef uint64 Bits;
+                static constexpr bool IEEE = true;
+                static constexpr int32 SIGNIFICAND_BITS = 52;
+                static constexpr int32 EXPONENT_BIAS = 1023;
+
+                static constexpr uint64 MAX_EXACT_MANTISSA = 1ull << 53;
+                static constexpr int32 MAX_EXACT_POW10 = 22;
+
+                static double fallback(const char* inText) { return std::strtod(inText, nullptr); }
+            };
+
+            //============================================================================
+            /// 64 位乘 64 位的 128 位乘积
+            ///
+            inline void multiply64(uint64 inA, uint64 inB, uint64& outHi, uint64& outLo) noexcept
+            {
+#if defined(__SIZEOF_INT128__)
+                __extension__ typedef unsigned __int128 uint128;
+                const uint128 product = static_cast<uint128>(inA) * inB;
+                outHi = static_cast<uint64>(product >> 64);
+                outLo = static_cast<uint64>(product);
+#else
+                const uint64 aLo = inA & 0xFFFFFFFFull;
+                const uint64 aHi = inA >> 32;
+                const uint64 bLo = inB & 0xFFFFFFFFull;
+                const uint64 bHi = inB >> 32;
+                const uint64 loLo = aLo * bLo;
+                const uint64 hiLo = aHi * bLo;
+                const uint64 cross = (loLo >> 32) + (hiLo & 0xFFFFFFFFull) + aLo * bHi;
+                outHi = aHi * bHi + (hiLo >> 32) + (cross >> 32);
+                outLo = (cross << 32) | (loLo & 0xFFFFFFFFull);
+#endif
+            }
+
+            inline int32 leadingZeros(uint64 inValue) noexcept
+            {
+#if defined(__GNUC__)
+                return inValue == 0 ? 64 : __builtin_clzll(inValue);
+#else
+                int32 count = 0;
+                for (uint64 mask = 1ull << 63; mask != 0 && (inValue & mask) == 0; mask >>= 1)
+                {
+                    ++count;
+                }
+                return count;
+#endif
+            }
+
+            // 10 的幂的表覆盖的指数范围
+            constexpr int32 POW10_MIN = -348;
+            constexpr int32 POW10_MAX = 347;
+
+            // 10^q ≈ (hi * 2^64 + lo) * 2^exponent，hi 的最高位为 1，低位截断
+            struct Pow10
+            {
+                uint64  hi;
+                uint64  lo;
+                int32   exponent;
+            };
+
+            //============================================================================
+            /// 10^inExponent 的 128 位近似。表在第一次使用时用大整数精确算出，
+            /// 正指数为 10^q 的最高 128 位，负指数为 floor(2^1312 / 10^-q) 的最高 128 位
+            ///
+            inline const Pow10& pow10(int32 inExponent) noexcept
+            {
+                static const std::vector<Pow10> table = []()
+                {
+                    std::vector<Pow10> entries(POW10_MAX - POW10_MIN + 1);
+
+                    // little endian 32-bit words; bits outside the number read as zero
+                    auto record = [](const std::vector<uint32>& inWords, int32 inScale) -> Pow10
+                    {
+                        int32 numBits = static_cast<int32>(inWords.size()) * 32;
+                        while (numBits > 0 && ((inWords[(numBits - 1) / 32] >> ((numBits - 1) % 32)) & 1) == 0)
+                        {
+                            --numBits;
+                        }
+
+                        auto bitsFrom = [&inWords](int32 inStart) noexcept -> uint64
+                        {
+                            uint64 bits = 0;
+                            for (int32 bit = 63; bit >= 0; --bit)
+                            {
+                                const int32 position = inStart + bit;
+                                const bool set = position >= 0 && position < static_cast<int32>(inWords.size()) * 32
+                                    && ((inWords[position / 32] >> (position % 32)) & 1) != 0;
+                                bits = (bits << 1) | (set ? 1 : 0);
+                            }
+                            return bits;
+                        };
+
+                        const int32 shift = numBits - 128;
+                        return Pow10{ bitsFrom(shift + 64), bitsFrom(shift), shift - inScale };
+                    };
+
+                    std::vector<uint32> power(1, 1);
+                    for (int32 exponent = 0; exponent <= POW10_MAX; ++exponent)
+                    {
+                        entries[exponent - POW10_MIN] = record(power, 0);
+                        uint64 carry = 0;
+                        for (uint32& word : power)
+                        {
+                            carry += static_cast<uint64>(word) * 10;
+                            word = static_cast<uint32>(carry);
+                            carry >>= 32;
+                        }
+                        if (carry != 0)
+                        {
+                            power.push_back(static_cast<uint32>(carry));
+                        }
+                    }
+
+                    constexpr int32 SCALE = 1312;
+                    std::vector<uint32> inverse(SCALE / 32 + 1, 0);
+                    inverse.back() = 1;
+                    for (int32 exponent = -1; exponent >= POW10_MIN; --exponent)
+                    {
+                        // floor(floor(x / 10^n) / 10) == floor(x / 10^(n + 1))
+                        uint64 remainder = 0;
+                        for (auto word = inverse.rbegin(); word != inverse.rend(); ++word)
+                        {
+                            const uint64 current = (remainder << 32) | *word;
+                            *word = static_cast<uint32>(current / 10);
+                            remainder = current % 10;
+                        }
+                        entries[exponent - POW10_MIN] = record(inverse, SCALE);
+                    }
+                    return entries;
+                }();
+
+                return table[inExponent - POW10_MIN];
+            }
+
+            //============================================================================
+            /// Eisel-Lemire 算法：用 128 位的 10 的幂把 inMantissa * 10^inExponent 正确舍入为 dtype，
+            /// 无法确定舍入方向或结果为非规格化数、溢出时返回 false，由调用者改用 C 库
+            ///
+            template<typename dtype>
+            bool eiselLemire(uint64 inMantissa, int32 inExponent, bool inNegative, dtype& outValue, std::true_type) noexcept
+            {
+                typedef FloatTraits<dtype> Traits;
+                constexpr int32 SHIFT = 64 - Traits::SIGNIFICAND_BITS - 3;
+                constexpr uint64 MASK = (1ull << SHIFT) - 1;
+
+                if (inExponent < POW10_MIN || inExponent > POW10_MAX)
+                {
+                    return false;
+                }
+
+                const Pow10& power = pow10(inExponent);
+                const int32 zeros = leadingZeros(inMantissa);
+                inMantissa <<= zeros;
+                int64 exponent2 = static_cast<int64>(power.exponent) + 127 + 64 + Traits::EXPONENT_BIAS - zeros;
+
+                uint64 hi;
+                uint64 lo;
+                multiply64(inMantissa, power.hi, hi, lo);
+                if ((hi & MASK) == MASK && lo + inMantissa < inMantissa)
+                {
+                    // the truncated low bits of the power may carry into the result, look at them too
+                    uint64 lowerHi;
+                    uint64 lowerLo;
+                    multiply64(inMantissa, power.lo, lowerHi, lowerLo);
+                    uint64 mergedHi = hi;
+                    const uint64 mergedLo = lo + lowerHi;
+                    if (mergedLo < lo)
+                    {
+                        ++mergedHi;
+                    }
+                    if ((mergedHi & MASK) == MASK && mergedLo + 1 == 0 && lowerLo + inMantissa < inMantissa)
+                    {
+                        return false;
+                    }
+                    hi = mergedHi;
+                    lo = mergedLo;
+                }
+
+                const uint64 msb = hi >> 63;
+                uint64 significand = hi >> (msb + SHIFT);
+                exponent2 -= static_cast<int64>(1 ^ msb);
+
+                if (lo == 0 && (hi & MASK) == 0 && (significand & 3) == 1)
+                {
+                    // exactly half way, the discarded bits cannot tell which way to round
+                    return false;
+                }
+
+                significand += significand & 1;
+                significand >>= 1;
+                if ((significand >> (Traits::SIGNIFICAND_BITS + 1)) != 0)
+                {
+                    significand >>= 1;
+                    ++exponent2;
+                }
+
+                if (exponent2 <= 0 || exponent2 >= 2 * Traits::EXPONENT_BIAS + 1)
+                {
+                    return false;
+                }
+
+                typename Traits::Bits bits = static_cast<typename Traits::Bits>((static_cast<uint64>(exponent2) << Traits::SIGNIFICAND_BITS)
+                    | (significand & ((1ull << Traits::SIGNIFICAND_BITS) - 1)));
+                if (inNegative)
+                {
+                    bits |= static_cast<typename Traits::Bits>(1) << (sizeof(dtype) * 8 - 1);
+                }
+                std::memcpy(&outValue, &bits, sizeof(dtype));
+                return true;
+            }
+
+            template<typename dtype>
+            bool eiselLemire(uint64, int32, bool, dtype&, std::false_type) noexcept
+            {
+                return false;
+            }
+
+            template<typename dtype>
+            dtype exactPow10(int32 inExponent) noexcept
+            {
+                static const dtype powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+                return powers[inExponent];
+            }
+
+            template<typename dtype>
+            const char* parseInteger(const char* inFirst, const char* inLast, dtype& outValue) noexcept
+            {
+                bool negative = false;
+                if (inFirst != inLast && (*inFirst == '-' || *inFirst == '+'))
+                {
+                    negative = *inFirst == '-';
+                    ++inFirst;
+                }
+
+                uint64 magnitude = 0;
+                uint32 numDigits = 0;
+                uint32 dropped = 0;
+                const char* digitsEnd = parseDigits(inFirst, inLast, magnitude, numDigits, dropped);
+                if (dropped == 1)
+                {
+                    // the 20th digit still fits a uint64 as long as it does not overflow
+                    const uint64 lastDigit = static_cast<uint64>(digitsEnd[-1] - '0');
+                    if (magnitude > (std::numeric_limits<uint64>::max() - lastDigit) / 10)
+                    {
+                        return nullptr;
+                    }
+                    magnitude = magnitude * 10 + lastDigit;
+                }
+                else if (digitsEnd == inFirst || dropped != 0)
+                {
+                    return nullptr;
+                }
+
+                typedef typename std::conditional<std::is_same<dtype, bool>::value, uint8, dtype>::type Limits;
+                if (negative)
+                {
+                    if (magnitude != 0 && (!std::is_signed<dtype>::value
+                        || magnitude > static_cast<uint64>(std::numeric_limits<Limits>::max()) + 1))
+                    {
+                        return nullptr;
+                    }
+                    outValue = static_cast<dtype>(0 - magnitude);
+                }
+                else
+                {
+                    if (magnitude > static_cast<uint64>(std::numeric_limits<Limits>::max()))
+                    {
+                        return nullptr;
+                    }
+                    outValue = static_cast<dtype>(magnitude);
+                }
+                return digitsEnd;
+            }
+
+            template<typename dtype>
+            const char* parseFloat(const char* inFirst, const char* inLast, dtype& outValue)
+            {
+                const char* start = inFirst;
+                bool negative = false;
+                if (inFirst != inLast && (*inFirst == '-' || *inFirst == '+'))
+                {
+                    negative = *inFirst == '-';
+                    ++inFirst;
+                }
+
+                if (inFirst != inLast && !isDigit(*inFirst) && *inFirst != '.')
+                {
+                    if (matchWord(inFirst, inLast, "nan"))
+                    {
+                        outValue = std::numeric_limits<dtype>::quiet_NaN();
+                        return inFirst + 3;
+                    }
+                    if (matchWord(inFirst, inLast, "inf"))
+                    {
+                        outValue = negative ? -std::numeric_limits<dtype>::infinity() : std::numeric_limits<dtype>::infinity();
+                        return inFirst + (matchWord(inFirst, inLast, "infinity") ? 8 : 3);
+                    }
+                    return nullptr;
+                }
+
+                uint64 mantissa = 0;
+                uint32 numDigits = 0;
+                uint32 dropped = 0;
+                const char* cursor = parseDigits(inFirst, inLast, mantissa, numDigits, dropped);
+                bool anyDigits = cursor != inFirst;
+                int32 exponent = static_cast<int32>(dropped);
+
+                if (cursor != inLast && *cursor == '.')
+                {
+                    const char* fraction = ++cursor;
+                    uint32 fractionDropped = 0;
+                    cursor = parseDigits(cursor, inLast, mantissa, numDigits, fractionDropped);
+                    anyDigits = anyDigits || cursor != fraction;
+                    // every fraction digit that made it into the mantissa scales it by 10,
+                    // including leading zeros that did not count as significant
+                    exponent -= static_cast<int32>(cursor - fraction) - static_cast<int32>(fractionDropped);
+                    dropped += fractionDropped;
+                }
+
+                if (!anyDigits)
+                {
+                    return nullptr;
+                }
+
+                if (cursor != inLast && (*cursor == 'e' || *cursor == 'E'))
+                {
+                    int32 exponentValue = 0;
+                    const char* exponentEnd = parseInteger(cursor + 1, inLast, exponentValue);
+                    if (exponentEnd == nullptr)
+                    {
+                        return nullptr;
+                    }
+                    exponent += exponentValue;
+                    cursor = exponentEnd;
+                }
+
+                typedef FloatTraits<dtype> Traits;
+                if (dropped == 0 && mantissa <= Traits::MAX_EXACT_MANTISSA
+                    && exponent >= -Traits::MAX_EXACT_POW10 && exponent <= Traits::MAX_EXACT_POW10)
+                {
+                    // both operands are exact, so the single rounding of * or / is the correct one
+                    dtype value = static_cast<dtype>(mantissa);
+                    value = exponent < 0 ? value / exactPow10<dtype>(-exponent) : value * exactPow10<dtype>(exponent);
+                    outValue = negative ? -value : value;
+                    return cursor;
+                }
+
+                if (mantissa == 0)
+                {
+                    outValue = negative ? -static_cast<dtype>(0) : static_cast<dtype>(0);
+                    return cursor;
+                }
+
+                if (dropped == 0 && eiselLemire(mantissa, exponent, negative, outValue, std::integral_constant<bool, Traits::IEEE>()))
+                {
+                    return cursor;
+                }
+
+                // long mantissa or large exponent, let the C library do the correctly rounded conversion
+                char buffer[128];
+                const uint64 length = static_cast<uint64>(cursor - start);
+                if (length >= sizeof(buffer))
+                {
+                    std::string copy(start, cursor);
+                    outValue = Traits::fallback(copy.c_str());
+                }
+                else
+                {
+                    std::memcpy(buffer, start, length);
+                    buffer[length] = '\0';
+                    outValue = Traits::fallback(buffer);
+                }
+                return cursor;
+            }
+
+            template<typename dtype>
+            const char* parseNumber(const char* inFirst, const char* inLast, dtype& outValue, std::true_type)
+            {
+                return parseFloat(inFirst, inLast, outValue);
+            }
+
+            template<typename dtype>
+            const char* parseNumber(const char* inFirst, const char* inLast, dtype& outValue, std::false_type) noexcept
+            {
+                return parseInteger(inFirst, inLast, outValue);
+            }
+
+            //============================================================================
+            /// 把 inValue 的十进制表示写到 outBuffer，返回写入的字符数
+            ///
+            inline uint32 formatUnsigned(uint64 inValue, char* outBuffer) noexcept
+            {
+                static const char pairs[] =
+                    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                    "8081828384858687888990919293949596979899";
+
+                char digits[20];
+                char* cursor = digits + 20;
+                while (inValue >= 100)
+                {
+                    const uint64 pair = (inValue % 100) * 2;
+                    inValue /= 100;
+                    *--cursor = pairs[pair + 1];
+                    *--cursor = pairs[pair];
+                }
+                if (inValue >= 10)
+                {
+                    *--cursor = pairs[inValue * 2 + 1];
+                    *--cursor = pairs[inValue * 2];
+                }
+                else
+                {
+                    *--cursor = static_cast<char>('0' + inValue);
+                }
+
+                const uint32 length = static_cast<uint32>(digits + 20 - cursor);
+                std::memcpy(outBuffer, cursor, length);
+                return length;
+            }
+
+            // 浮点数 f * 2^e，Grisu 算法的中间表示
+            struct DiyFp
+            {
+                uint64  f;
+                int32   e;
+            };
+
+            inline DiyFp multiply(const DiyFp& inA, const DiyFp& inB) noexcept
+            {
+                uint64 hi;
+                uint64 lo;
+                multiply64(inA.f, inB.f, hi, lo);
+                return DiyFp{ hi + (lo >> 63), inA.e + inB.e + 64 };
+            }
+
+            inline DiyFp normalize(const DiyFp& inValue) noexcept
+            {
+                const int32 shift = leadingZeros(inValue.f);
+                return DiyFp{ inValue.f << shift, inValue.e - shift };
+            }
+
+            //============================================================================
+            /// 10^inExponent 四舍五入到 64 位
+            ///
+            inline DiyFp cachedPower(int32 inExponent) noexcept
+            {
+                const Pow10& power = pow10(inExponent);
+                const uint64 f = power.hi + (power.lo >> 63);
+                return f == 0 ? DiyFp{ 1ull << 63, power.exponent + 65 } : DiyFp{ f, power.exponent + 64 };
+            }
+
+            static const uint32 POW10_32[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+            inline void grisuRound(char* ioDigits, int32 inLength, uint64 inDelta, uint64 inRest, uint64 inTenKappa, uint64 inDistance) noexcept
+            {
+                while (inRest < inDistance && inDelta - inRest >= inTenKappa
+                    && (inRest + inTenKappa < inDistance || inDistance - inRest > inRest + inTenKappa - inDistance))
+                {
+                    --ioDigits[inLength - 1];
+                    inRest += inTenKappa;
+                }
+            }
+
+            //============================================================================
+            /// 逐位生成落在 (inHigh - inDelta, inHigh] 内的最短十进制数字，并尽量靠近 inValue
+            ///
+            inline void digitGen(const DiyFp& inValue, const DiyFp& inHigh, uint64 inDelta, char* outDigits, int32& outLength, int32& ioExponent) noexcept
+            {
+                const int32 shift = -inHigh.e;
+                const uint64 one = 1ull << shift;
+                const uint64 distance = inHigh.f - inValue.f;
+                uint32 integral = static_cast<uint32>(inHigh.f >> shift);
+                uint64 fraction = inHigh.f & (one - 1);
+
+                int32 kappa = 1;
+                while (kappa < 10 && integral >= POW10_32[kappa])
+                {
+                    ++kappa;
+                }
+
+                outLength = 0;
+                while (kappa > 0)
+                {
+                    const uint32 digit = integral / POW10_32[kappa - 1];
+                    integral %= POW10_32[kappa - 1];
+                    if (digit != 0 || outLength != 0)
+                    {
+                        outDigits[outLength++] = static_cast<char>('0' + digit);
+                    }
+                    --kappa;
+
+                    const uint64 rest = (static_cast<uint64>(integral) << shift) + fraction;
+                    if (rest <= inDelta)
+                    {
+                        ioExponent += kappa;
+                        grisuRound(outDigits, outLength, inDelta, rest, static_cast<uint64>(POW10_32[kappa]) << shift, distance);
+                        return;
+                    }
+                }
+
+                while (true)
+                {
+                    fraction *= 10;
+                    inDelta *= 10;
+                    const char digit = static_cast<char>(fraction >> shift);
+                    if (digit != 0 || outLength != 0)
+                    {
+                        outDigits[outLength++] = static_cast<char>('0' + digit);
+                    }
+                    fraction &= one - 1;
+                    --kappa;
+
+                    if (fraction < inDelta)
+                    {
+                        ioExponent += kappa;
+                        grisuRound(outDigits, outLength, inDelta, fraction, one, -kappa < 10 ? distance * POW10_32[-kappa] : 0);
+                        return;
+                    }
+                }
+            }
+
+            //============================================================================
+            /// Grisu2：正的有限非零 inValue 的最短十进制数字 outDigits * 10^outExponent，
+            /// 读回一定得到 inValue，极少数情况下比最短表示多一位
+            ///
+            template<typename dtype>
+            void grisu2(dtype inValue, char* outDigits, int32& outLength, int32& outExponent) noexcept
+            {
+                typedef FloatTraits<dtype> Traits;
+                constexpr uint64 HIDDEN_BIT = 1ull << Traits::SIGNIFICAND_BITS;
+
+                typename Traits::Bits bits;
+                std::memcpy(&bits, &inValue, sizeof(dtype));
+                const int32 biased = static_cast<int32>(bits >> Traits::SIGNIFICAND_BITS);
+                const uint64 significand = static_cast<uint64>(bits) & (HIDDEN_BIT - 1);
+                const DiyFp value = biased != 0
+                    ? DiyFp{ significand + HIDDEN_BIT, biased - Traits::EXPONENT_BIAS - Traits::SIGNIFICAND_BITS }
+                    : DiyFp{ significand, 1 - Traits::EXPONENT_BIAS - Traits::SIGNIFICAND_BITS };
+
+                // the neighbours half way to the adjacent floats bound the digits that still read back as inValue
+                const DiyFp high = normalize(DiyFp{ (value.f << 1) + 1, value.e - 1 });
+                DiyFp low = value.f == HIDDEN_BIT ? DiyFp{ (value.f << 2) - 1, value.e - 2 } : DiyFp{ (value.f << 1) - 1, value.e - 1 };
+                low.f <<= low.e - high.e;
+                low.e = high.e;
+
+                // scale by a power of ten so the binary exponent of the product lies in [-60, -32]
+                int32 decimal = static_cast<int32>(std::ceil((-61 - high.e) * 0.30102999566398114));
+                DiyFp power = cachedPower(decimal);
+                while (high.e + power.e + 64 < -60)
+                {
+                    power = cachedPower(++decimal);
+                }
+                while (high.e + power.e + 64 > -32)
+                {
+                    power = cachedPower(--decimal);
+                }
+
+                const DiyFp scaled = multiply(normalize(value), power);
+                DiyFp scaledHigh = multiply(high, power);
+                DiyFp scaledLow = multiply(low, power);
+                ++scaledLow.f;
+                --scaledHigh.f;
+
+                outExponent = -decimal;
+                digitGen(scaled, scaledHigh, scaledHigh.f - scaledLow.f, outDigits, outLength, outExponent);
+            }
+
+            //============================================================================
+            /// 把数字 inDigits * 10^inExponent 写成定点或科学计数法
+            ///
+            inline uint32 layoutDigits(const char* inDigits, int32 inLength, int32 inExponent, char* outBuffer) noexcept
+            {
+                const int32 point = inLength + inExponent;
+                char* cursor = outBuffer;
+                if (point > inLength && point <= 17)
+                {
+                    // 1.5e3 -> 1500
+                    std::memcpy(cursor, inDigits, inLength);
+                    std::memset(cursor + inLength, '0', point - inLength);
+                    cursor += point;
+                }
+                else if (point > 0 && point <= inLength)
+                {
+                    // 1.25
+                    std::memcpy(cursor, inDigits, point);
+                    cursor += point;
+                    if (point < inLength)
+                    {
+                        *cursor++ = '.';
+                        std::memcpy(cursor, inDigits + point, inLength - point);
+                        cursor += inLength - point;
+                    }
+                }
+                else if (point <= 0 && point > -4)
+                {
+                    // 0.00125
+                    *cursor++ = '0';
+                    *cursor++ = '.';
+                    std::memset(cursor, '0', -point);
+                    cursor += -point;
+                    std::memcpy(cursor, inDigits, inLength);
+                    cursor += inLength;
+                }
+                else
+                {
+                    // 1.25e-07, 1e+300
+                    *cursor++ = inDigits[0];
+                    if (inLength > 1)
+                    {
+                        *cursor++ = '.';
+                        std::memcpy(cursor, inDigits + 1, inLength - 1);
+                        cursor += inLength - 1;
+                    }
+                    *cursor++ = 'e';
+                    const int32 exponent = point - 1;
+                    *cursor++ = exponent < 0 ? '-' : '+';
+                    const uint32 magnitude = static_cast<uint32>(exponent < 0 ? -exponent : exponent);
+                    if (magnitude < 10)
+                    {
+                        *cursor++ = '0';
+                    }
+                    cursor += formatUnsigned(magnitude, cursor);
+                }
+                return static_cast<uint32>(cursor - outBuffer);
+            }
+
+            template<typename dtype>
+            uint32 formatShortest(dtype inValue, char* outBuffer, std::true_type) noexcept
+            {
+                char digits[24];
+                int32 length;
+                int32 exponent;
+                grisu2(inValue, digits, length, exponent);
+                return layoutDigits(digits, length, exponent, outBuffer);
+            }
+
+            template<typename dtype>
+            uint32 formatShortest(dtype inValue, char* outBuffer, std::false_type)
+            {
+                typedef FloatTraits<dtype> Traits;
+                int32 numChars = 0;
+                for (int32 precision = Traits::MIN_DIGITS; precision <= Traits::MAX_DIGITS; ++precision)
+                {
+                    numChars = std::snprintf(outBuffer, MAX_CHARS - 1, "%.*Lg", precision, static_cast<long double>(inValue));
+                    for (int32 i = 0; i < numChars; ++i)
+                    {
+                        // the C library follows LC_NUMERIC, the file format does not
+                        if (outBuffer[i] != 'e' && outBuffer[i] != '-' && outBuffer[i] != '+' && !isDigit(outBuffer[i]))
+                        {
+                            outBuffer[i] = '.';
+                        }
+                    }
+
+                    dtype readBack;
+                    if (precision == Traits::MAX_DIGITS || (parseFloat(outBuffer, outBuffer + numChars, readBack) != nullptr && readBack == inValue))
+                    {
+                        break;
+                    }
+                }
+                return static_cast<uint32>(numChars);
+            }
+        }
+
+        //============================================================================
+        /// 从 [inFirst, inLast) 开头解析一个 dtype 类型的数，不跳过前导空白。
+        /// 整数类型只接受整数写法且不能越界，bool 按整数解析
+        ///
+        /// @param      inFirst
+        /// @param      inLast
+        /// @param      outValue
+        ///
+        /// @return     指向数字之后的第一个字符，失败时为 nullptr
+        ///
+        template<typename dtype>
+        const char* parse(const char* inFirst, const char* inLast, dtype& outValue)
+        {
+            static_assert(std::is_arithmetic<dtype>::value, "Only arithmetic dtypes can be parsed from text.");
+
+            return detail::parseNumber(inFirst, inLast, outValue, std::is_floating_point<dtype>());
+        }
+
+        //============================================================================
+        /// 把 inValue 格式化到 outBuffer（至少 MAX_CHARS 字节，不写结尾的 '\0'）。
+        /// 浮点数取能精确读回的最短表示，整数值的浮点数不带小数部分
+        ///
+        /// @param      inValue
+        /// @param      outBuffer
+        ///
+        /// @return     写入的字符数
+        ///
+        template<typename dtype>
+        typename std::enable_if<!std::is_floating_point<dtype>::value, uint32>::type format(dtype inValue, char* outBuffer) noexcept
+        {
+            static_assert(std::is_arithmetic<dtype>::value, "Only arithmetic dtypes can be formatted as text.");
+
+            if (inValue < static_cast<dtype>(0))
+            {
+                outBuffer[0] = '-';
+                return 1 + detail::formatUnsigned(0 - static_cast<uint64>(inValue), outBuffer + 1);
+            }
+            return detail::formatUnsigned(static_cast<uint64>(inValue), outBuffer);
+        }
+
+        template<typename dtype>
+        typename std::enable_if<std::is_floating_point<dtype>::value, uint32>::type format(dtype inValue, char* outBuffer)
+        {
+            if (std::isnan(inValue))
+            {
+                std::memcpy(outBuffer, "nan", 3);
+                return 3;
+            }
+
+            uint32 length = 0;
+            if (std::signbit(inValue))
+            {
+                outBuffer[length++] = '-';
+                inValue = -inValue;
+            }
+
+            if (std::isinf(inValue))
+            {
+                std::memcpy(outBuffer + length, "inf", 3);
+                return length + 3;
+            }
+
+            if (inValue < static_cast<dtype>(1e15) && inValue == std::floor(inValue))
+            {
+                // integral values are common in exports and need no search for the shortest form
+                return length + detail::formatUnsigned(static_cast<uint64>(inValue), outBuffer + length);
+            }
+
+            return length + detail::formatShortest(inValue, outBuffer + length,
+                std::integral_constant<bool, detail::FloatTraits<dtype>::IEEE>());
+        }
+    
+        //============================================================================
+        /// 跳过空格与制表符，但不跳过分隔符本身（分隔符为 ' ' 时跳过所有空白）
+        ///
+        inline const char* skipBlanks(const char* inFirst, const char* inLast, char inDelimiter) noexcept
+        {
+            while (inFirst != inLast && (*inFirst == ' ' || *inFirst == '\t') && (*inFirst != inDelimiter || inDelimiter == ' '))
+            {
+                ++inFirst;
+            }
+            return inFirst;
+        }
+
+        //============================================================================
+        /// 行尾位置（不含 "\r\n"/"\n"）与下一行的起始位置
+        ///
+        inline const char* lineEnd(const char* inFirst, const char* inLast, const char*& outNextLine) noexcept
+        {
+            const char* newline = static_cast<const char*>(std::memchr(inFirst, '\n', static_cast<size_t>(inLast - inFirst)));
+            outNextLine = newline == nullptr ? inLast : newline + 1;
+            const char* stop = newline == nullptr ? inLast : newline;
+            return stop != inFirst && stop[-1] == '\r' ? stop - 1 : stop;
+        }
+
+        //============================================================================
+        /// 是否为数据行，空行与 '#' 开头的注释行不是
+        ///
+        inline bool isDataLine(const char* inFirst, const char* inStop) noexcept
+        {
+            inFirst = skipBlanks(inFirst, inStop, ' ');
+            return inFirst != inStop && *inFirst != '#';
+        }
+
+        //============================================================================
+        /// [inFirst, inLast) 中数据行的行数
+        ///
+        inline uint64 countDataLines(const char* inFirst, const char* inLast) noexcept
+        {
+            uint64 numLines = 0;
+            while (inFirst != inLast)
+            {
+                const char* next;
+                const char* stop = lineEnd(inFirst, inLast, next);
+                numLines += isDataLine(inFirst, stop) ? 1 : 0;
+                inFirst = next;
+            }
+            return numLines;
+        }
+
+        //============================================================================
+        /// 解析一行中以 inDelimiter 分隔的数，'#' 之后为注释。超过 inCapacity 个数或格式错误时抛出异常
+        ///
+        /// @param      inFirst
+        /// @param      inStop: 行尾
+        /// @param      inDelimiter: ' ' 表示任意长度的空白
+        /// @param      outValues
+        /// @param      inCapacity
+        ///
+        /// @return     该行数的个数
+        ///
+        template<typename dtype>
+        uint64 parseLine(const char* inFirst, const char* inStop, char inDelimiter, dtype* outValues, uint64 inCapacity)
+        {
+            auto fail = [inFirst, inStop](const std::string& inWhat)
+            {
+                std::string errStr = "ERROR: text::parseLine: " + inWhat + " in line \"" + std::string(inFirst, std::min<uint64>(inStop - inFirst, 80)) + "\".";
+                std::cerr << errStr << std::endl;
+                throw std::runtime_error(errStr);
+            };
+
+            uint64 numValues = 0;
+            const char* cursor = skipBlanks(inFirst, inStop, inDelimiter);
+            while (true)
+            {
+                if (numValues == inCapacity)
+                {
+                    fail("too many values");
+                }
+
+                const char* valueEnd = parse(cursor, inStop, outValues[numValues]);
+                if (valueEnd == nullptr)
+                {
+                    fail("invalid value");
+                }
+                ++numValues;
+
+                cursor = skipBlanks(valueEnd, inStop, inDelimiter);
+                if (cursor == inStop || *cursor == '#')
+                {
+                    return numValues;
+                }
+                if (inDelimiter != ' ')
+                {
+                    if (*cursor != inDelimiter)
+                    {
+                        fail("unexpected character '" + std::string(1, *cursor) + "'");
+                    }
+                    cursor = skipBlanks(cursor + 1, inStop, inDelimiter);
+                }
+            }
+        }
+    }
+}
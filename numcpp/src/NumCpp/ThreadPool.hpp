@@ -0,0 +1,259 @@
+#pragma once
+
+#include"NumCpp/Types.hpp"
+
+#include<algorithm>
+#include<atomic>
+#include<condition_variable>
+#include<cstdlib>
+#include<exception>
+#include<functional>
+#include<mutex>
+#include<thread>
+#include<vector>
+
+// 全库共享的线程池，大规模计算内核把输出划分为互不重叠的任务分发到各线程执行
+// 线程数默认取硬件并发数，可由环境变量 NUMCPP_NUM_THREADS 或 nc::setNumThreads 设置
+namespace nc
+{
+    class ThreadPool
+    {
+    public:
+
+        typedef std::function<void(uint32, uint32)> Task;
+
+    private:
+
+        std::vector<std::thread>    workers_;
+        std::mutex                  mutex_;
+        std::mutex                  runMutex_;
+        std::condition_variable     wakeCondition_;
+        std::condition_variable     doneCondition_;
+        const Task*                 task_{ nullptr };
+        uint32                      numTasks_{ 0 };
+        std::atomic<uint32>         nextTask_{ 0 };
+        uint32                      activeWorkers_{ 0 };
+        uint64                      generation_{ 0 };
+        bool                        stop_{ false };
+        std::exception_ptr          exception_{ nullptr };
+
+        static bool& insideParallelRegion() noexcept
+        {
+            thread_local bool inside = false;
+            return inside;
+        }
+
+        static uint32 defaultNumThreads() noexcept
+        {
+            const char* envValue = std::getenv("NUMCPP_NUM_THREADS");
+            if (envValue != nullptr)
+            {
+                const long numThreads = std::strtol(envValue, nullptr, 10);
+                if (numThreads > 0)
+                {
+                    return static_cast<uint32>(numThreads);
+                }
+            }
+
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        void runTasks(uint32 inThreadIndex) noexcept
+        {
+            for (uint32 task = nextTask_++; task < numTasks_; task = nextTask_++)
+            {
+                try
+                {
+                    (*task_)(task, inThreadIndex);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (exception_ == nullptr)
+                    {
+                        exception_ = std::current_exception();
+                    }
+                }
+            }
+        }
+
+        void workerLoop(uint32 inThreadIndex, uint64 inGeneration)
+        {
+            insideParallelRegion() = true;
+
+            uint64 seenGeneration = inGeneration;
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true)
+            {
+                wakeCondition_.wait(lock, [this, seenGeneration]() noexcept -> bool
+                    { return stop_ || generation_ != seenGeneration; });
+                if (stop_)
+                {
+                    return;
+                }
+                seenGeneration = generation_;
+
+                lock.unlock();
+                runTasks(inThreadIndex);
+                lock.lock();
+
+                if (--activeWorkers_ == 0)
+                {
+                    doneCondition_.notify_one();
+                }
+            }
+        }
+
+        void startWorkers(uint32 inNumThreads)
+        {
+            stop_ = false;
+            for (uint32 threadIndex = 1; threadIndex < inNumThreads; ++threadIndex)
+            {
+                workers_.emplace_back(&ThreadPool::workerLoop, this, threadIndex, generation_);
+            }
+        }
+
+        void stopWorkers() noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            wakeCondition_.notify_all();
+
+            for (auto& worker : workers_)
+            {
+                worker.join();
+            }
+            workers_.clear();
+        }
+
+        ThreadPool()
+        {
+            startWorkers(defaultNumThreads());
+        }
+
+    public:
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool()
+        {
+            stopWorkers();
+        }
+
+        //============================================================================
+        /// 返回全局线程池
+        ///
+        /// @return     ThreadPool&
+        ///
+        static ThreadPool& instance()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        //============================================================================
+        /// 线程数（包含调用线程）
+        ///
+        /// @return     uint32
+        ///
+        uint32 numThreads() const noexcept
+        {
+            return static_cast<uint32>(workers_.size()) + 1;
+        }
+
+        //============================================================================
+        /// 重新设置线程数，为 0 时使用硬件并发数；会等待正在执行的并行任务结束，
+        /// 但不应与其他线程中正在准备的计算同时调用
+        ///
+        /// @param      inNumThreads
+        ///
+        void setNumThreads(uint32 inNumThreads)
+        {
+            if (inNumThreads == 0)
+            {
+                inNumThreads = std::max(1u, std::thread::hardware_concurrency());
+            }
+
+            std::lock_guard<std::mutex> runLock(runMutex_);
+            if (inNumThreads == numThreads())
+            {
+                return;
+            }
+
+            stopWorkers();
+            startWorkers(inNumThreads);
+        }
+
+        //============================================================================
+        /// 并行执行 inNumTasks 个任务，inFunction(task, threadIndex) 中 threadIndex
+        /// 小于 numThreads()，可用于索引每个线程私有的缓冲区。
+        /// 嵌套调用或线程池正被其他线程占用时退化为在调用线程上串行执行。
+        ///
+        /// @param      inNumTasks
+        /// @param      inFunction
+        ///
+        void parallelFor(uint32 inNumTasks, const Task& inFunction)
+        {
+            std::unique_lock<std::mutex> runLock(runMutex_, std::defer_lock);
+            if (inNumTasks <= 1 || workers_.empty() || insideParallelRegion() || !runLock.try_lock())
+            {
+                for (uint32 task = 0; task < inNumTasks; ++task)
+                {
+                    inFunction(task, 0);
+                }
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                task_ = &inFunction;
+                numTasks_ = inNumTasks;
+                nextTask_ = 0;
+                activeWorkers_ = static_cast<uint32>(workers_.size());
+                exception_ = nullptr;
+                ++generation_;
+            }
+            wakeCondition_.notify_all();
+
+            insideParallelRegion() = true;
+            runTasks(0);
+            insideParallelRegion() = false;
+
+            std::exception_ptr exception = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                doneCondition_.wait(lock, [this]() noexcept -> bool { return activeWorkers_ == 0; });
+                task_ = nullptr;
+                std::swap(exception, exception_);
+            }
+
+            if (exception != nullptr)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+    };
+
+    //============================================================================
+    /// 设置全库使用的线程数，为 0 时使用硬件并发数
+    ///
+    /// @param      inNumThreads
+    ///
+    inline void setNumThreads(uint32 inNumThreads)
+    {
+        ThreadPool::instance().setNumThreads(inNumThreads);
+    }
+
+    //============================================================================
+    /// 返回全库使用的线程数
+    ///
+    /// @return     uint32
+    ///
+    inline uint32 getNumThreads()
+    {
+        return ThreadPool::instance().numThreads();
+    }
+}
@@ -13,6 +13,8 @@ namespace nc
     typedef uint16_t	uint16;
     typedef uint8_t		uint8;
 
+    // 按形状的矩阵视角归约：ROW 沿行方向（结果每列一个值），COL 沿列方向（结果每行一个值）。
+    // 任意一维用 int32 整数轴指定，负数从最后一维倒数，二维时 0 等同 ROW，1 等同 COL
     enum class Axis { NONE = 0, ROW, COL };
 
     enum class Endian { NATIVE = 0, BIG, LITTLE };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include"NumCpp/DtypeInfo.hpp"
+#include"NumCpp/Types.hpp"
 
 #include<cmath>
 #include<string>
@@ -38,6 +39,21 @@ namespace nc
             return std::to_string(inNumber);
         }
 
+        //============================================================================
+        /// 无符号 64 位乘法，乘积溢出时返回 true
+        ///
+        /// @param      inValue1
+        /// @param      inValue2
+        /// @param      outProduct
+        ///
+        /// @return     bool
+        ///
+        inline bool mulOverflow(uint64 inValue1, uint64 inValue2, uint64& outProduct) noexcept
+        {
+            outProduct = inValue1 * inValue2;
+            return inValue1 != 0 && outProduct / inValue1 != inValue2;
+        }
+
         //============================================================================
         /// 平方
         ///
@@ -0,0 +1,161 @@
+#include "test_utils.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// ArenaAllocator、PoolAllocator 的分配、回收与对齐，以及 AllocatorScope 范围内 NdArray 的缓冲来源
+
+namespace
+{
+    // 记录向上游申请和归还次数的分配器
+    class CountingAllocator : public nc::Allocator
+    {
+    public:
+        nc::uint64  allocations{ 0 };
+        nc::uint64  deallocations{ 0 };
+
+        void* allocate(nc::uint64 inNumBytes, nc::uint64 inAlignment) override
+        {
+            ++allocations;
+            return nc::defaultAllocator()->allocate(inNumBytes, inAlignment);
+        }
+
+        void deallocate(void* inPtr, nc::uint64 inNumBytes, nc::uint64 inAlignment) noexcept override
+        {
+            ++deallocations;
+            nc::defaultAllocator()->deallocate(inPtr, inNumBytes, inAlignment);
+        }
+    };
+
+    bool aligned(const void* inPtr, nc::uint64 inAlignment)
+    {
+        return reinterpret_cast<std::uintptr_t>(inPtr) % inAlignment == 0;
+    }
+
+    void testMalloc()
+    {
+        nc::Allocator* allocator = nc::defaultAllocator();
+        for (nc::uint64 alignment : { 8, 16, 64, 4096 })
+        {
+            void* ptr = allocator->allocate(1000, alignment);
+            CHECK(aligned(ptr, alignment));
+            std::memset(ptr, 1, 1000);
+            allocator->deallocate(ptr, 1000, alignment);
+
+            unsigned char* zeroed = static_cast<unsigned char*>(allocator->allocateZeroed(5000, alignment));
+            CHECK(aligned(zeroed, alignment));
+            CHECK(zeroed[0] == 0 && zeroed[4999] == 0);
+            allocator->deallocate(zeroed, 5000, alignment);
+        }
+    }
+
+    void testArena()
+    {
+        CountingAllocator upstream;
+        {
+            nc::ArenaAllocator arena(4096, &upstream);
+            unsigned char* previous = nullptr;
+            void* first = arena.allocate(100, 1);
+            for (nc::uint64 alignment : { 1, 16, 64, 256 })
+            {
+                unsigned char* ptr = static_cast<unsigned char*>(arena.allocate(100, alignment));
+                CHECK(aligned(ptr, alignment));
+                CHECK(ptr >= (previous == nullptr ? static_cast<unsigned char*>(first) : previous) + 100);
+                std::memset(ptr, 2, 100);
+                previous = ptr;
+            }
+            CHECK(upstream.allocations == 1);
+            CHECK(arena.capacity() == 4096);
+
+            // 超过块大小的请求单独申请一块
+            void* large = arena.allocate(10000, 64);
+            CHECK(aligned(large, 64));
+            CHECK(upstream.allocations == 2);
+
+            // reset 之后从第一块重新切分，不再向上游申请
+            arena.reset();
+            CHECK(arena.allocate(100, 1) == first);
+            const nc::uint64 capacity = arena.capacity();
+            for (int i = 0; i < 10; ++i)
+            {
+                arena.reset();
+                arena.allocate(3000, 64);
+                arena.allocate(8000, 64);
+            }
+            CHECK(arena.capacity() == capacity);
+
+            // 作用域内新建的 NdArray 从 arena 分配，仍按 BUFFER_ALIGNMENT 对齐
+            arena.reset();
+            nc::NdArray<double> inArena;
+            {
+                nc::AllocatorScope scope(arena);
+                inArena = nc::NdArray<double>(7, 9);
+            }
+            CHECK(inArena.isAligned());
+            CHECK(arena.capacity() == capacity);
+        }
+        CHECK(upstream.allocations == upstream.deallocations);
+    }
+
+    void testPool()
+    {
+        CountingAllocator upstream;
+        {
+            nc::PoolAllocator pool(1 << 16, &upstream);
+
+            // 同一级的缓冲释放后被复用
+            void* a = pool.allocate(100, 64);
+            CHECK(aligned(a, 64));
+            pool.deallocate(a, 100, 64);
+            void* b = pool.allocate(120, 16);
+            CHECK(b == a);
+            CHECK(upstream.allocations == 1);
+
+            // 复用的缓冲也要清零
+            std::memset(b, 7, 120);
+            pool.deallocate(b, 120, 16);
+            unsigned char* zeroed = static_cast<unsigned char*>(pool.allocateZeroed(128, 64));
+            CHECK(static_cast<void*>(zeroed) == a);
+            bool allZero = true;
+            for (int i = 0; i < 128; ++i)
+            {
+                allZero = allZero && zeroed[i] == 0;
+            }
+            CHECK(allZero);
+            pool.deallocate(zeroed, 128, 64);
+
+            // 不同级别互不混用
+            void* small = pool.allocate(64, 64);
+            void* bigger = pool.allocate(129, 64);
+            CHECK(small != bigger);
+            CHECK(aligned(bigger, 64));
+            pool.deallocate(small, 64, 64);
+            pool.deallocate(bigger, 129, 64);
+
+            // 超过上限或对齐要求更大的请求直接交给上游
+            const nc::uint64 before = upstream.allocations;
+            void* huge = pool.allocate(1 << 20, 64);
+            void* page = pool.allocate(100, 4096);
+            CHECK(aligned(page, 4096));
+            CHECK(upstream.allocations == before + 2);
+            pool.deallocate(huge, 1 << 20, 64);
+            pool.deallocate(page, 100, 4096);
+            CHECK(upstream.deallocations == 2);
+
+            pool.release();
+            CHECK(upstream.allocations == upstream.deallocations);
+        }
+        CHECK(upstream.allocations == upstream.deallocations);
+    }
+}
+
+int main()
+{
+    testMalloc();
+    testArena();
+    testPool();
+
+    std::printf("allocator_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
@@ -0,0 +1,106 @@
+#include "test_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 异步读写与同步读写得到的文件逐字节相同。ctest 中另以 NUMCPP_IO=threads 运行一次，
+// 两种后端都与同一份同步结果比较，因此 io_uring 与线程后端写出的字节相同
+
+namespace
+{
+    std::vector<char> readAll(const std::string& inFilename)
+    {
+        std::ifstream file(inFilename, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    void testSaveLoad()
+    {
+        // 超过 AsyncIo::CHUNK，请求被拆成多个片段
+        std::mt19937_64 generator(6);
+        const nc::NdArray<double> a = test::randomArray(1100, 1000, generator);
+        CHECK(a.size() * sizeof(double) > nc::io::AsyncIo::CHUNK);
+
+        const std::string syncName = "async_io_test_sync.npy";
+        const std::string asyncName = "async_io_test_async.npy";
+        nc::save(syncName, a);
+        std::future<void> saved = nc::saveAsync(asyncName, a);
+        saved.get();
+        const std::vector<char> expected = readAll(syncName);
+        CHECK(!expected.empty());
+        CHECK(readAll(asyncName) == expected);
+
+        std::future<nc::NdArray<double>> loaded = nc::loadAsync<double>(syncName);
+        const nc::NdArray<double> fromAsync = loaded.get();
+        CHECK(fromAsync.shape() == a.shape());
+        CHECK(std::memcmp(fromAsync.cbegin(), a.cbegin(), a.size() * sizeof(double)) == 0);
+
+        std::remove(syncName.c_str());
+        std::remove(asyncName.c_str());
+    }
+
+    void testOffsets()
+    {
+        // 多个不按片段对齐的写请求拼出与顺序写出相同的文件，再按任意偏移读回
+        const std::string filename = "async_io_test_raw.bin";
+        std::vector<char> data(3 * nc::io::AsyncIo::CHUNK + 12345);
+        std::mt19937_64 generator(7);
+        for (char& byte : data)
+        {
+            byte = static_cast<char>(generator());
+        }
+
+        {
+            auto file = std::make_shared<const nc::io::File>(filename, nc::io::FileMode::WRITE);
+            const nc::uint64 split = nc::io::AsyncIo::CHUNK + 777;
+            std::future<void> second = nc::io::AsyncIo::instance().write(file, data.data() + split, data.size() - split, split);
+            std::future<void> first = nc::io::AsyncIo::instance().write(file, data.data(), split, 0);
+            first.get();
+            second.get();
+        }
+        CHECK(readAll(filename) == data);
+
+        auto file = std::make_shared<const nc::io::File>(filename, nc::io::FileMode::READ);
+        std::vector<char> part(nc::io::AsyncIo::CHUNK + 3);
+        nc::io::AsyncIo::instance().read(file, part.data(), part.size(), 5).get();
+        CHECK(std::memcmp(part.data(), data.data() + 5, part.size()) == 0);
+
+        // 读到文件末尾之外报告错误
+        bool threw = false;
+        try
+        {
+            nc::io::AsyncIo::instance().read(file, part.data(), part.size(), data.size() - 10).get();
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+        std::remove(filename.c_str());
+    }
+}
+
+int main()
+{
+    const char* requested = std::getenv("NUMCPP_IO");
+    const bool threads = nc::io::AsyncIo::instance().backend() == nc::io::AsyncIo::Backend::THREADS;
+    if (requested != nullptr && std::strcmp(requested, "threads") == 0)
+    {
+        CHECK(threads);
+    }
+
+    testSaveLoad();
+    testOffsets();
+
+    std::printf("async_io_test (%s): %d failure(s)\n", threads ? "threads" : "io_uring", test::failures());
+    return test::failures();
+}
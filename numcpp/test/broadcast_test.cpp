@@ -0,0 +1,109 @@
+#include "test_utils.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+// 逐元素运算与广播的行为测试
+
+namespace
+{
+    nc::NdArray<double> iota(const nc::Shape& inShape)
+    {
+        nc::NdArray<double> returnArray(inShape);
+        for (nc::uint64 i = 0; i < returnArray.size(); ++i)
+        {
+            returnArray[i] = static_cast<double>(i);
+        }
+        return returnArray;
+    }
+
+    void testBroadcasting()
+    {
+        bool threw = false;
+        const nc::NdArray<double> a = iota(nc::Shape(3, 4));
+        const nc::NdArray<double> row = iota(nc::Shape(1, 4));
+        const nc::NdArray<double> col = iota(nc::Shape(3, 1));
+
+        nc::NdArray<double> rowSum = a + row;
+        nc::NdArray<double> colProduct = a * col;
+        nc::NdArray<double> outer = col - row;
+        CHECK(rowSum.shape() == nc::Shape(3, 4));
+        CHECK(outer.shape() == nc::Shape(3, 4));
+        for (nc::uint64 i = 0; i < 3; ++i)
+        {
+            for (nc::uint64 j = 0; j < 4; ++j)
+            {
+                CHECK(rowSum(i, j) == a(i, j) + row(0, j));
+                CHECK(colProduct(i, j) == a(i, j) * col(i, 0));
+                CHECK(outer(i, j) == col(i, 0) - row(0, j));
+            }
+        }
+
+        // 三维与二维广播，跨越块边界
+        const nc::NdArray<double> cube = iota(nc::Shape({ 5, 7, 300 }));
+        const nc::NdArray<double> plane = iota(nc::Shape(7, 300));
+        nc::NdArray<double> cubeSum = cube + plane;
+        CHECK(cubeSum.shape() == cube.shape());
+        bool ok = true;
+        for (nc::uint64 i = 0; i < cube.size(); ++i)
+        {
+            ok = ok && cubeSum[i] == cube[i] + plane[i % plane.size()];
+        }
+        CHECK(ok);
+
+        // 两边各有长度为 1 的轴，结果形状取各轴较大者
+        const nc::NdArray<double> left = iota(nc::Shape({ 3, 1, 4 }));
+        const nc::NdArray<double> right = iota(nc::Shape(5, 1));
+        nc::NdArray<double> mixed = left * right;
+        CHECK(mixed.shape() == nc::Shape({ 3, 5, 4 }));
+        ok = true;
+        for (nc::int64 i = 0; i < 3; ++i)
+        {
+            for (nc::int64 j = 0; j < 5; ++j)
+            {
+                for (nc::int64 k = 0; k < 4; ++k)
+                {
+                    ok = ok && mixed({ i, j, k }) == left({ i, 0, k }) * right({ j, 0 });
+                }
+            }
+        }
+        CHECK(ok);
+
+        nc::NdArray<double> compound = a;
+        compound += row;
+        CHECK(test::allClose(compound, rowSum));
+
+        // 复合赋值不能改变左侧的形状
+        threw = false;
+        try
+        {
+            nc::NdArray<double> narrow = row;
+            narrow += a;
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+
+        threw = false;
+        try
+        {
+            nc::NdArray<double> bad = a + iota(nc::Shape(1, 3));
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+}
+
+int main()
+{
+    testBroadcasting();
+
+    std::printf("broadcast_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
@@ -0,0 +1,129 @@
+#include "test_utils.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// 分块压缩格式的读写往返：各编码、部分行读取、整数的压缩率，以及非法参数
+
+namespace
+{
+    nc::uint64 fileSize(const std::string& inFilename)
+    {
+        std::ifstream file(inFilename, std::ios::binary | std::ios::ate);
+        return static_cast<nc::uint64>(file.tellg());
+    }
+
+    void testCompressed()
+    {
+        std::mt19937_64 generator(3);
+        const std::string filename = "compressed_test.nca";
+
+        const nc::NdArray<double> a = test::randomArray(1000, 7, generator);
+        nc::savecompressed(filename, a, nc::Codec::SHUFFLE_LZ, 64);
+        CHECK(test::allClose(nc::loadcompressed<double>(filename), a));
+
+        // 只读取跨越块边界的部分行
+        const nc::NdArray<double> part = nc::loadcompressed<double>(filename, 60, 10);
+        CHECK(part.shape() == nc::Shape(10, 7));
+        CHECK(test::allClose(part, a(nc::Slice(60, 70), nc::Slice(0, 7)).copy()));
+
+        nc::NdArray<nc::int32> ints(500, 4);
+        for (nc::uint64 i = 0; i < ints.size(); ++i)
+        {
+            ints[i] = static_cast<nc::int32>(i % 97) * 1000 - 5;
+        }
+        for (nc::Codec codec : { nc::Codec::NONE, nc::Codec::DELTA_PACK, nc::Codec::AUTO })
+        {
+            nc::savecompressed(filename, ints, codec);
+            CHECK(test::allClose(nc::loadcompressed<nc::int32>(filename), ints));
+        }
+        std::remove(filename.c_str());
+    }
+
+    void testIntegers()
+    {
+        const std::string filename = "compressed_test_ints.nca";
+
+        // 缓慢变化的 uint16 特征用 DELTA_PACK 应远小于原始大小
+        nc::NdArray<nc::uint16> features(4000, 16);
+        for (nc::uint64 row = 0; row < 4000; ++row)
+        {
+            for (nc::uint64 col = 0; col < 16; ++col)
+            {
+                features(row, col) = static_cast<nc::uint16>(1000 * col + row % 50);
+            }
+        }
+        nc::savecompressed(filename, features);
+        CHECK(test::allClose(nc::loadcompressed<nc::uint16>(filename), features));
+        CHECK(fileSize(filename) * 4 < features.size() * sizeof(nc::uint16));
+
+        // 差分溢出 int64 范围时 zigzag 仍能还原
+        nc::NdArray<nc::int64> extremes(300, 2);
+        for (nc::uint64 i = 0; i < extremes.size(); ++i)
+        {
+            extremes[i] = i % 2 == 0 ? std::numeric_limits<nc::int64>::min() : std::numeric_limits<nc::int64>::max() - static_cast<nc::int64>(i);
+        }
+        nc::savecompressed(filename, extremes, nc::Codec::DELTA_PACK, 32);
+        const nc::NdArray<nc::int64> loaded = nc::loadcompressed<nc::int64>(filename);
+        bool same = loaded.shape() == extremes.shape();
+        for (nc::uint64 i = 0; same && i < extremes.size(); ++i)
+        {
+            same = loaded[i] == extremes[i];
+        }
+        CHECK(same);
+        std::remove(filename.c_str());
+    }
+
+    void testIncompressible()
+    {
+        // 随机数据压缩后变大的块按原样存储，文件不会明显大于原始数据
+        const std::string filename = "compressed_test_random.nca";
+        std::mt19937_64 generator(8);
+        nc::NdArray<nc::uint64> noise(2000, 8);
+        for (auto& value : noise)
+        {
+            value = generator();
+        }
+        nc::savecompressed(filename, noise, nc::Codec::SHUFFLE_LZ, 100);
+        CHECK(test::allClose(nc::loadcompressed<nc::uint64>(filename), noise));
+        CHECK(fileSize(filename) < noise.size() * sizeof(nc::uint64) + 4096);
+
+        // 浮点数不能用 DELTA_PACK，越界的行范围抛出异常
+        bool threw = false;
+        try
+        {
+            nc::savecompressed(filename, nc::ones<double>(3, 3), nc::Codec::DELTA_PACK);
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+
+        threw = false;
+        try
+        {
+            nc::loadcompressed<nc::uint64>(filename, 1990, 20);
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+        std::remove(filename.c_str());
+    }
+}
+
+int main()
+{
+    testCompressed();
+    testIntegers();
+    testIncompressible();
+
+    std::printf("compressed_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
@@ -0,0 +1,95 @@
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+
+// linalg::det：小矩阵直接展开、LU 分解的符号与块边界、中间结果不溢出，以及非法输入
+
+namespace
+{
+    const double TOLERANCE = 1e-9;
+
+    void testTriangular(nc::uint64 inOrder, std::mt19937_64& ioGenerator)
+    {
+        // 上三角矩阵打乱行后行列式为对角元之积乘以置换的符号
+        nc::NdArray<double> triangular = test::randomArray(inOrder, inOrder, ioGenerator);
+        double expected = 1;
+        for (nc::uint64 i = 0; i < inOrder; ++i)
+        {
+            for (nc::uint64 j = 0; j < i; ++j)
+            {
+                triangular(i, j) = 0;
+            }
+            triangular(i, i) = 1.0 + static_cast<double>(i % 3) * 0.25;
+            expected *= triangular(i, i);
+        }
+        nc::NdArray<double> swapped = triangular;
+        for (nc::uint64 j = 0; j < inOrder; ++j)
+        {
+            std::swap(swapped(0, j), swapped(inOrder - 1, j));
+        }
+        CHECK(std::abs(nc::linalg::det(triangular) - expected) <= TOLERANCE * expected);
+        CHECK(std::abs(nc::linalg::det(swapped) + expected) <= TOLERANCE * expected);
+
+        // 两行相同的矩阵奇异
+        const nc::NdArray<double> a = test::randomArray(inOrder, inOrder, ioGenerator);
+        nc::NdArray<double> singular = a;
+        for (nc::uint64 j = 0; j < inOrder; ++j)
+        {
+            singular(inOrder - 1, j) = singular(0, j);
+        }
+        CHECK(std::abs(nc::linalg::det(singular)) < TOLERANCE * std::abs(nc::linalg::det(a)));
+    }
+
+    void testSmallAndIntegral()
+    {
+        CHECK(nc::linalg::det(nc::NdArray<double>(nc::Shape(0, 0))) == 1.0);
+        CHECK(nc::linalg::det(nc::NdArray<nc::int32>(nc::Shape(1, 1), -7)) == -7);
+        CHECK(nc::linalg::det(nc::NdArray<nc::int32>({ { 3, 8 }, { 4, 6 } })) == -14);
+        CHECK(nc::linalg::det(nc::NdArray<nc::int32>({ { 6, 1, 1 }, { 4, -2, 5 }, { 2, 8, 7 } })) == -306);
+
+        // 4 阶以上走 LU 分解，整数结果四舍五入回精确值
+        const nc::NdArray<nc::int64> integral = { { 2, -1, 0, 0, 0 }, { -1, 2, -1, 0, 0 }, { 0, -1, 2, -1, 0 }, { 0, 0, -1, 2, -1 },
+            { 0, 0, 0, -1, 2 } };
+        CHECK(nc::linalg::det(integral) == 6);
+    }
+
+    void testScaling()
+    {
+        // 对角元交替为 1e200 和 1e-200，逐个相乘会溢出，分解后的行列式仍为 1
+        const nc::uint64 order = 100;
+        nc::NdArray<double> diagonal = nc::zeros<double>(order, order);
+        for (nc::uint64 i = 0; i < order; ++i)
+        {
+            diagonal(i, i) = i % 4 < 2 ? 1e200 : 1e-200;
+        }
+        CHECK(std::abs(nc::linalg::det(diagonal) - 1.0) < TOLERANCE);
+
+        bool threw = false;
+        try
+        {
+            nc::linalg::det(nc::NdArray<double>(nc::Shape(3, 4)));
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 generator(21);
+    for (nc::uint64 order : { 63, 64, 65 })
+    {
+        testTriangular(order, generator);
+    }
+    testSmallAndIntegral();
+    testScaling();
+
+    std::printf("det_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
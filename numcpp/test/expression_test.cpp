@@ -0,0 +1,122 @@
+#include "test_utils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <stdexcept>
+
+// 运算返回表达式后，对结果调用 NdArray 成员和 nc:: 函数的代码仍能编译，且与先求值再调用的结果相同
+
+namespace
+{
+    nc::NdArray<double> iota(const nc::Shape& inShape)
+    {
+        nc::NdArray<double> returnArray(inShape);
+        for (nc::uint64 i = 0; i < returnArray.size(); ++i)
+        {
+            returnArray[i] = static_cast<double>(i);
+        }
+        return returnArray;
+    }
+
+    void testReductions()
+    {
+        const nc::NdArray<double> a = iota(nc::Shape(3, 4));
+        const nc::NdArray<double> evaluated = a * 2.0 + 1.0;
+        CHECK((a * 2.0 + 1.0).max().item() == 23.0);
+        CHECK(nc::amax(a * 2.0 + 1.0).item() == 23.0);
+        CHECK(test::allClose((a * 2.0 + 1.0).sum(nc::Axis::ROW), evaluated.sum(nc::Axis::ROW)));
+        CHECK(test::allClose(nc::mean(a + a, 1), (a * 2.0).mean(1)));
+        CHECK(nc::all(a * 2.0 == a + a).item());
+        CHECK(!nc::any(a + 1.0 == a).item());
+        CHECK(nc::all(1.0 <= a + 1.0).item());
+        CHECK(test::allClose((a + a).dot<double>(a.transpose().copy()), nc::dot(a * 2.0, a.transpose().copy())));
+        CHECK(test::allClose(nc::copy(a - 1.0), nc::NdArray<double>(a - 1.0)));
+        CHECK(test::allClose((a * 0.5).astype<nc::int32>(), nc::NdArray<nc::int32>(evaluated.astype<nc::int32>() / 4)));
+    }
+
+    void testElementAccess()
+    {
+        const nc::NdArray<double> a = iota(nc::Shape(2, 2));
+        CHECK((a.sum() + 1.0).item() == 7.0);
+        CHECK(!(a + 1.0).isempty());
+        CHECK((a + 1.0)(0, 0) == 1.0);
+        CHECK((a + 1.0)(1, 0) == 3.0);
+        CHECK((a + 1.0)(-1, -1) == 4.0);
+        CHECK((a + 1.0).at(1, 1) == 4.0);
+        CHECK((a + 1.0).at(-4) == 1.0);
+        CHECK((a + 1.0).front() == 1.0);
+        CHECK((a + 1.0).back() == 4.0);
+
+        bool threw = false;
+        try
+        {
+            (a + 1.0).item();
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+
+        threw = false;
+        try
+        {
+            (a + 1.0).at(2, 0);
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+
+    void testShapeChanges()
+    {
+        const nc::NdArray<double> a = iota(nc::Shape(2, 3));
+        const nc::NdArray<double> evaluated = a + 1.0;
+
+        const nc::NdArray<double> reshaped = (a + 1.0).reshape(1, 6);
+        CHECK(reshaped.shape() == nc::Shape(1, 6));
+        CHECK(std::equal(reshaped.cbegin(), reshaped.cend(), evaluated.cbegin()));
+        CHECK((a + 1.0).reshape(nc::Shape(3, 2)).shape() == nc::Shape(3, 2));
+
+        const nc::NdArray<double> transposed = (a + 1.0).transpose();
+        CHECK(transposed.shape() == nc::Shape(3, 2));
+        CHECK(test::allClose(transposed, evaluated.transpose().copy()));
+        CHECK(test::allClose((a + 1.0).transpose({ 1, 0 }), transposed));
+    }
+
+    void testIterators()
+    {
+        const nc::NdArray<double> a = iota(nc::Shape(3, 4));
+        const nc::NdArray<double> evaluated = a * a;
+
+        // 迭代器按下标计算元素，不引用已销毁的临时数组
+        auto first = (a * a).cbegin();
+        auto last = (a * a).cend();
+        CHECK(last - first == 12);
+        CHECK(first[5] == 25.0);
+        CHECK(std::accumulate((a * a).cbegin(), (a * a).cend(), 0.0) == evaluated.sum().item());
+        CHECK(std::equal((a * a).begin(), (a * a).end(), evaluated.cbegin()));
+        CHECK(*std::max_element((a - 5.0).cbegin(), (a - 5.0).cend()) == 6.0);
+
+        nc::uint32 count = 0;
+        for (double value : a + 1.0)
+        {
+            count += value > 6.0 ? 1 : 0;
+        }
+        CHECK(count == 6);
+    }
+}
+
+int main()
+{
+    testReductions();
+    testElementAccess();
+    testShapeChanges();
+    testIterators();
+
+    std::printf("expression_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
@@ -0,0 +1,90 @@
+#include "test_utils.hpp"
+
+#include <cstdio>
+#include <random>
+
+// NdArray::dot 的分块 GEMM 与朴素三重循环对比，形状取 MR/NR/MC/KC 的非整数倍以覆盖各处尾部
+
+namespace
+{
+    template<typename dtypeOut, typename dtype>
+    nc::NdArray<dtypeOut> naiveDot(const nc::NdArray<dtype>& inA, const nc::NdArray<dtype>& inB)
+    {
+        nc::NdArray<dtypeOut> returnArray(nc::Shape(inA.shape().rows, inB.shape().cols));
+        for (nc::uint64 i = 0; i < inA.shape().rows; ++i)
+        {
+            for (nc::uint64 j = 0; j < inB.shape().cols; ++j)
+            {
+                dtypeOut total = 0;
+                for (nc::uint64 k = 0; k < inA.shape().cols; ++k)
+                {
+                    total += static_cast<dtypeOut>(inA(i, k)) * static_cast<dtypeOut>(inB(k, j));
+                }
+                returnArray(i, j) = total;
+            }
+        }
+        return returnArray;
+    }
+
+    template<typename dtype>
+    nc::NdArray<dtype> randomIntegers(nc::uint64 inRows, nc::uint64 inCols, std::mt19937_64& ioGenerator)
+    {
+        std::uniform_int_distribution<int> dist(-8, 8);
+        nc::NdArray<dtype> returnArray(nc::Shape(inRows, inCols));
+        for (auto& value : returnArray)
+        {
+            value = static_cast<dtype>(dist(ioGenerator));
+        }
+        return returnArray;
+    }
+
+    void testIntegerShapes(std::mt19937_64& ioGenerator)
+    {
+        // 小整数的乘积和在各类型中都是精确的，结果必须逐元素相等
+        const nc::uint64 sizes[] = { 1, 3, 5, 17, 67, 130, 259, 390 };
+        for (nc::uint64 m : sizes)
+        {
+            for (nc::uint64 k : { nc::uint64(1), nc::uint64(7), nc::uint64(257), nc::uint64(390) })
+            {
+                const nc::uint64 n = sizes[(m + k) % 8];
+                const nc::NdArray<nc::int32> a = randomIntegers<nc::int32>(m, k, ioGenerator);
+                const nc::NdArray<nc::int32> b = randomIntegers<nc::int32>(k, n, ioGenerator);
+                CHECK(test::allClose(a.dot<nc::int32>(b), naiveDot<nc::int32>(a, b)));
+
+                const nc::NdArray<float> af = a.astype<float>();
+                const nc::NdArray<float> bf = b.astype<float>();
+                CHECK(test::allClose(af.dot<float>(bf), naiveDot<float>(af, bf)));
+            }
+        }
+    }
+
+    void testDoubleShapes(std::mt19937_64& ioGenerator)
+    {
+        for (nc::uint64 size : { 2, 63, 97, 200 })
+        {
+            const nc::NdArray<double> a = test::randomArray(size + 1, size + 3, ioGenerator);
+            const nc::NdArray<double> b = test::randomArray(size + 3, size, ioGenerator);
+            CHECK(test::allClose(a.dot<double>(b), naiveDot<double>(a, b), 1e-12 * static_cast<double>(size)));
+        }
+
+        // 行向量与列向量的内积
+        const nc::NdArray<double> u = test::randomArray(1, 50, ioGenerator);
+        const nc::NdArray<double> v = test::randomArray(1, 50, ioGenerator);
+        double expected = 0;
+        for (nc::uint64 i = 0; i < 50; ++i)
+        {
+            expected += u[i] * v[i];
+        }
+        CHECK(std::abs(u.dot<double>(v).item() - expected) < 1e-12);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 generator(1);
+    testIntegerShapes(generator);
+    testDoubleShapes(generator);
+
+    std::printf("gemm_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
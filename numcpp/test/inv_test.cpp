@@ -0,0 +1,81 @@
+#include "test_utils.hpp"
+
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+
+// linalg::inv：块边界两侧的残差、需要换行的主元、整数输入，以及奇异与非方阵的异常
+
+namespace
+{
+    const double TOLERANCE = 1e-9;
+
+    void testResidual(nc::uint64 inOrder, std::mt19937_64& ioGenerator)
+    {
+        const nc::NdArray<double> a = test::randomArray(inOrder, inOrder, ioGenerator);
+        const nc::NdArray<double> inverse = nc::linalg::inv(a);
+        CHECK(inverse.shape() == a.shape());
+        CHECK(test::maxAbs(test::matmul(a, inverse) - test::identity(inOrder)) < TOLERANCE);
+        CHECK(test::maxAbs(test::matmul(inverse, a) - test::identity(inOrder)) < TOLERANCE);
+    }
+
+    void testPivoting(nc::uint64 inOrder)
+    {
+        // 循环移位的置换矩阵对角元全为零，不选主元无法分解；其逆为转置
+        nc::NdArray<double> permutation = nc::zeros<double>(inOrder, inOrder);
+        for (nc::uint64 i = 0; i < inOrder; ++i)
+        {
+            permutation(i, (i + 1) % inOrder) = 1.0;
+        }
+        CHECK(test::allClose(nc::linalg::inv(permutation), test::transpose(permutation)));
+
+        // 主元很小时换行保持精度
+        nc::NdArray<double> tiny = test::identity(inOrder);
+        tiny(0, 0) = 1e-18;
+        tiny(0, 1) = 1.0;
+        tiny(1, 0) = 1.0;
+        CHECK(test::maxAbs(test::matmul(tiny, nc::linalg::inv(tiny)) - test::identity(inOrder)) < TOLERANCE);
+    }
+
+    void testErrors()
+    {
+        const nc::NdArray<nc::int32> integral = { { 4, 7 }, { 2, 6 } };
+        CHECK(test::allClose(nc::linalg::inv(integral), nc::NdArray<double>({ { 0.6, -0.7 }, { -0.2, 0.4 } }), 1e-15));
+
+        bool threw = false;
+        try
+        {
+            nc::linalg::inv(nc::NdArray<double>({ { 1.0, 2.0 }, { 2.0, 4.0 } }));
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+
+        threw = false;
+        try
+        {
+            nc::linalg::inv(nc::NdArray<double>(nc::Shape(2, 3)));
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 generator(22);
+    for (nc::uint64 order : { 63, 64, 65, 130 })
+    {
+        testResidual(order, generator);
+        testPivoting(order);
+    }
+    testErrors();
+
+    std::printf("inv_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
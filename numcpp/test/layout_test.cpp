@@ -0,0 +1,122 @@
+#include "test_utils.hpp"
+
+#include <cstdio>
+
+// NdArray 缓冲区的布局约定：起始地址按 BUFFER_ALIGNMENT 对齐，各行紧密存储，rowStride() 等于列数；
+// empty/zeros/ones/full 工厂函数一次完成分配与初始化
+
+namespace
+{
+    nc::NdArray<double> iota(nc::uint64 inRows, nc::uint64 inCols)
+    {
+        nc::NdArray<double> returnArray(inRows, inCols);
+        for (nc::uint64 i = 0; i < returnArray.size(); ++i)
+        {
+            returnArray[i] = static_cast<double>(i);
+        }
+        return returnArray;
+    }
+
+    template<typename dtype>
+    void checkAligned()
+    {
+        for (nc::uint64 cols : { 1, 3, 7, 16, 1001 })
+        {
+            nc::NdArray<dtype> a(5, cols);
+            CHECK(a.isAligned());
+            CHECK(a.rowStride() == cols);
+            CHECK(&a(1, 0) == &a(0, 0) + cols);
+
+            nc::NdArray<dtype> filled(nc::Shape(3, cols), static_cast<dtype>(1));
+            CHECK(filled.isAligned());
+
+            // 复制、移动、类型转换和运算结果都重新分配对齐的缓冲
+            nc::NdArray<dtype> copied(a);
+            CHECK(copied.isAligned());
+            nc::NdArray<dtype> moved(std::move(copied));
+            CHECK(moved.isAligned());
+            CHECK(a.template astype<double>().isAligned());
+            CHECK(filled.copy().isAligned());
+        }
+    }
+
+    void testAlignment()
+    {
+        checkAligned<nc::uint8>();
+        checkAligned<nc::int16>();
+        checkAligned<nc::int32>();
+        checkAligned<float>();
+        checkAligned<double>();
+        checkAligned<nc::uint64>();
+
+        const nc::NdArray<double> a = iota(9, 13);
+        const nc::NdArray<double> sum = a + a;
+        CHECK(sum.isAligned());
+        CHECK(nc::NdArray<double>(a.transpose()).isAligned());
+        CHECK(a.transpose().ascontiguous().isAligned());
+
+        // 三维数组按矩阵视角的行跨步为最后一维
+        nc::NdArray<float> cube(nc::Shape({ 4, 5, 6 }));
+        CHECK(cube.isAligned());
+        CHECK(cube.rowStride() == 6);
+
+        // 视图报告自身首元素的对齐与跨步
+        auto window = a(nc::Slice(1, 5), nc::Slice(2, 9));
+        CHECK(window.rowStride() == 13);
+        CHECK(!window.isAligned());
+        CHECK(a(nc::Slice(0, 5), nc::Slice(0, 9)).isAligned());
+
+        // 改变形状不移动数据
+        nc::NdArray<double> reshaped = a;
+        const double* data = &reshaped[0];
+        reshaped.reshape(13, 9);
+        CHECK(&reshaped[0] == data);
+        CHECK(reshaped.rowStride() == 9);
+    }
+    void testFactories()
+    {
+        const nc::NdArray<double> z = nc::zeros<double>(3, 4);
+        CHECK(z.shape() == nc::Shape(3, 4));
+        CHECK(z.isAligned());
+        CHECK(test::maxAbs(z) == 0.0);
+        CHECK(nc::empty<float>(nc::Shape({ 2, 3, 4 })).shape() == nc::Shape({ 2, 3, 4 }));
+        CHECK(nc::empty<float>(2, 5).isAligned());
+        CHECK(nc::ones<nc::int32>(nc::Shape({ 2, 2, 2 })).sum().item() == 8);
+        const nc::NdArray<nc::int16> sevens = nc::full<nc::int16>(5, 3, 7);
+        CHECK(sevens.min().item() == 7 && sevens.max().item() == 7);
+
+        // 超过 simd::STREAM_MIN_BYTES 的数组走 calloc 清零页和非临时存储填充
+        const nc::uint64 large = nc::simd::STREAM_MIN_BYTES / sizeof(double) + 37;
+        const nc::NdArray<double> bigZeros = nc::zeros<double>(1, large);
+        CHECK(test::maxAbs(bigZeros) == 0.0);
+        const nc::NdArray<double> bigFull = nc::full<double>(nc::Shape(1, large), -2.5);
+        bool filled = true;
+        for (double value : bigFull)
+        {
+            filled = filled && value == -2.5;
+        }
+        CHECK(filled);
+        CHECK(bigZeros.isAligned() && bigFull.isAligned());
+
+        // 从池中复用的缓冲残留旧数据，zeros 仍须全为零
+        nc::PoolAllocator pool;
+        {
+            nc::AllocatorScope scope(pool);
+            {
+                nc::NdArray<double> dirty = nc::full<double>(16, 16, 9.0);
+            }
+            const nc::NdArray<double> recycled = nc::zeros<double>(16, 16);
+            CHECK(recycled.isAligned());
+            CHECK(test::maxAbs(recycled) == 0.0);
+        }
+    }
+}
+
+int main()
+{
+    testAlignment();
+    testFactories();
+
+    std::printf("layout_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
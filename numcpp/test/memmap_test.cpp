@@ -0,0 +1,144 @@
+#include "test_utils.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+// 内存映射数组：各映射模式的读写语义，以及只读映射上的写入和可写视图抛出异常
+
+namespace
+{
+    nc::NdArray<double> iota(const nc::Shape& inShape)
+    {
+        nc::NdArray<double> returnArray(inShape);
+        for (nc::uint64 i = 0; i < returnArray.size(); ++i)
+        {
+            returnArray[i] = static_cast<double>(i);
+        }
+        return returnArray;
+    }
+
+    void testMemmap()
+    {
+        const std::string filename = "memmap_test.bin";
+        const nc::NdArray<double> source = iota(nc::Shape(4, 4));
+        source.tofile(filename);
+        const nc::NdArray<double> other = source * 10.0;
+
+        // 只读映射：拷贝赋值分离出私有缓冲，原地写入抛出异常，文件不变
+        nc::NdArray<double> readOnly = nc::memmap<double>(filename, nc::Shape(4, 4));
+        CHECK(readOnly.ismapped());
+        CHECK(test::allClose(readOnly, source));
+        nc::NdArray<double> detached = nc::memmap<double>(filename, nc::Shape(4, 4));
+        detached = other;
+        CHECK(!detached.ismapped());
+        CHECK(test::allClose(detached, other));
+        bool threw = false;
+        try
+        {
+            readOnly = 5.0;
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+        nc::NdArray<double> onDisk = nc::fromfile<double>(filename);
+        onDisk.reshape(4, 4);
+        CHECK(test::allClose(onDisk, source));
+
+        // 写时复制：修改只在本进程可见
+        {
+            nc::NdArray<double> private_ = nc::memmap<double>(filename, nc::Shape(4, 4), nc::MapMode::COPY_ON_WRITE);
+            private_.fill(-1.0);
+            CHECK(private_[5] == -1.0);
+        }
+        CHECK(test::allClose(nc::memmap<double>(filename, nc::Shape(4, 4)), source));
+
+        // 读写：同尺寸赋值写回文件
+        {
+            nc::NdArray<double> shared = nc::memmap<double>(filename, nc::Shape(4, 4), nc::MapMode::READ_WRITE);
+            shared = other;
+            CHECK(shared.ismapped());
+            shared.flush();
+        }
+        CHECK(test::allClose(nc::memmap<double>(filename, nc::Shape(4, 4)), other));
+
+        // 创建
+        const std::string created = "memmap_test_create.bin";
+        {
+            nc::NdArray<double> fresh = nc::memmap<double>(created, nc::Shape(3, 5), nc::MapMode::CREATE);
+            fresh.fill(2.5);
+        }
+        nc::NdArray<double> reopened = nc::memmap<double>(created);
+        CHECK(reopened.size() == 15);
+        CHECK(reopened[14] == 2.5);
+
+        std::remove(filename.c_str());
+        std::remove(created.c_str());
+    }
+
+    template<typename Function>
+    bool throwsInvalidArgument(Function inFunction)
+    {
+        try
+        {
+            inFunction();
+        }
+        catch (const std::invalid_argument&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    void testReadOnlyGuards()
+    {
+        const std::string filename = "memmap_test_guard.bin";
+        const nc::NdArray<double> source = iota(nc::Shape(4, 4));
+        source.tofile(filename);
+
+        // 只读映射上的原地修改和可写视图都抛出异常，而不是写入只读页面
+        nc::NdArray<double> readOnly = nc::memmap<double>(filename, nc::Shape(4, 4));
+        CHECK(throwsInvalidArgument([&readOnly]() { readOnly.byteswap(); }));
+        CHECK(throwsInvalidArgument([&readOnly]() { readOnly(nc::Slice(0, 2), nc::Slice(0, 1)) = 9.0; }));
+        CHECK(throwsInvalidArgument([&readOnly]() { readOnly(nc::Slice(0, 2), 1)(0, 0) = 9.0; }));
+        CHECK(throwsInvalidArgument([&readOnly]() { readOnly(1, nc::Slice(0, 2)).fill(9.0); }));
+        CHECK(throwsInvalidArgument([&readOnly]() { readOnly[nc::Slice(0, 4)][0] = 9.0; }));
+        CHECK(throwsInvalidArgument([&readOnly]() { readOnly.slice({ nc::Slice(0, 1) }) = 9.0; }));
+        CHECK(throwsInvalidArgument([&readOnly]() { readOnly.transpose()(0, 1) = 9.0; }));
+        CHECK(throwsInvalidArgument([&readOnly]() { readOnly.transpose({ 1, 0 }) = 9.0; }));
+        CHECK(throwsInvalidArgument([&readOnly, &source]() { readOnly.view() = source; }));
+        CHECK(throwsInvalidArgument([&readOnly]() { readOnly.zeros(); }));
+        CHECK(throwsInvalidArgument([&readOnly]() { readOnly += 1.0; }));
+        CHECK(test::allClose(readOnly, source));
+
+        // 通过 const 引用读取视图不受影响
+        const nc::NdArray<double>& reader = readOnly;
+        CHECK(reader(nc::Slice(0, 2), nc::Slice(0, 1)).copy()[1] == 4.0);
+        CHECK(reader.transpose()(0, 1) == 4.0);
+        CHECK(reader[nc::Slice(2, 4)][1] == 3.0);
+        CHECK(reader.newbyteorder(nc::Endian::BIG).newbyteorder(nc::Endian::LITTLE)[5] == 5.0);
+
+        // 读写映射可以通过视图写回文件
+        {
+            nc::NdArray<double> shared = nc::memmap<double>(filename, nc::Shape(4, 4), nc::MapMode::READ_WRITE);
+            shared(nc::Slice(0, 2), nc::Slice(0, 1)) = -1.0;
+            shared.transpose()(3, 0) = -2.0;
+            shared.flush();
+        }
+        const nc::NdArray<double> reread = nc::memmap<double>(filename, nc::Shape(4, 4));
+        CHECK(reread(0, 0) == -1.0 && reread(1, 0) == -1.0 && reread(0, 3) == -2.0 && reread(2, 0) == 8.0);
+
+        std::remove(filename.c_str());
+    }
+}
+
+int main()
+{
+    testMemmap();
+    testReadOnlyGuards();
+
+    std::printf("memmap_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
@@ -0,0 +1,148 @@
+#include "test_utils.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// 原始二进制 tofile/fromfile 与 .npy 的读写：往返、字节序、文件头格式，以及按 NumPy 写出的文件头读取
+
+namespace
+{
+    // 按 NumPy 的格式手工写出 v1 文件头和数据，用于检查读取端对 descr/fortran_order/shape 的解析
+    void writeNpy(const std::string& inFilename, const std::string& inDict, const void* inData, std::size_t inNumBytes)
+    {
+        std::string header = inDict;
+        while ((10 + header.size() + 1) % 64 != 0)
+        {
+            header.push_back(' ');
+        }
+        header.push_back('\n');
+
+        std::ofstream file(inFilename, std::ios::binary);
+        file.write("\x93NUMPY\x01\x00", 8);
+        const char length[2] = { static_cast<char>(header.size() & 0xFF), static_cast<char>(header.size() >> 8) };
+        file.write(length, 2);
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+        file.write(static_cast<const char*>(inData), static_cast<std::streamsize>(inNumBytes));
+    }
+
+    void testBinary()
+    {
+        std::mt19937_64 generator(1);
+        const nc::NdArray<double> a = test::randomArray(17, 9, generator);
+
+        const std::string raw = "npy_test_raw.bin";
+        a.tofile(raw);
+        nc::NdArray<double> fromRaw = nc::fromfile<double>(raw);
+        CHECK(fromRaw.size() == a.size());
+        fromRaw.reshape(a.shape());
+        CHECK(test::allClose(fromRaw, a));
+
+        // 按大端字节序写出后按大端读回
+        a.newbyteorder(nc::Endian::BIG).tofile(raw);
+        nc::NdArray<double> fromBig = nc::fromfile<double>(raw, nc::Endian::BIG);
+        fromBig.reshape(a.shape());
+        CHECK(test::allClose(fromBig, a));
+        std::remove(raw.c_str());
+
+        const std::string npy = "npy_test_array.npy";
+        nc::save(npy, a);
+        CHECK(test::allClose(nc::load<double>(npy), a));
+        nc::save(npy, a.newbyteorder(nc::Endian::BIG));
+        CHECK(test::allClose(nc::load<double>(npy), a));
+
+        nc::NdArray<nc::int32> ints(nc::Shape({ 2, 3, 4 }));
+        for (nc::uint64 i = 0; i < ints.size(); ++i)
+        {
+            ints[i] = static_cast<nc::int32>(i * i) - 100;
+        }
+        nc::save(npy, ints);
+        const nc::NdArray<nc::int32> loadedInts = nc::load<nc::int32>(npy);
+        CHECK(loadedInts.shape() == ints.shape());
+        CHECK(test::allClose(loadedInts, ints));
+        std::remove(npy.c_str());
+    }
+
+    void testNpyHeader()
+    {
+        const std::string npy = "npy_test_header.npy";
+        const nc::NdArray<double> a = { { 1.0, 2.0, 3.0 }, { 4.0, 5.0, 6.0 } };
+
+        // 写出的文件头以魔数和版本开始，数据按 64 字节对齐
+        nc::save(npy, a);
+        std::ifstream file(npy, std::ios::binary);
+        char preamble[10];
+        file.read(preamble, 10);
+        CHECK(std::memcmp(preamble, "\x93NUMPY\x01\x00", 8) == 0);
+        const std::size_t headerLength = static_cast<unsigned char>(preamble[8]) | (static_cast<unsigned char>(preamble[9]) << 8);
+        CHECK((10 + headerLength) % 64 == 0);
+        std::string dict(headerLength, ' ');
+        file.read(&dict[0], static_cast<std::streamsize>(headerLength));
+        file.close();
+        CHECK(dict.find("'descr': '<f8'") != std::string::npos);
+        CHECK(dict.find("'shape': (2, 3)") != std::string::npos);
+        CHECK(dict.back() == '\n');
+
+        // fortran_order 为 True 的数据按列存放
+        const double columnMajor[] = { 1.0, 4.0, 2.0, 5.0, 3.0, 6.0 };
+        writeNpy(npy, "{'descr': '<f8', 'fortran_order': True, 'shape': (2, 3), }", columnMajor, sizeof(columnMajor));
+        CHECK(test::allClose(nc::load<double>(npy), a));
+
+        // 一维大端数组读为 1 x n
+        const unsigned char bigEndian[] = { 0x00, 0x01, 0xFF, 0xFE, 0x01, 0x00 };
+        writeNpy(npy, "{'descr': '>i2', 'fortran_order': False, 'shape': (3,), }", bigEndian, sizeof(bigEndian));
+        const nc::NdArray<nc::int16> shorts = nc::load<nc::int16>(npy);
+        CHECK(shorts.shape() == nc::Shape(1, 3));
+        CHECK(shorts[0] == 1 && shorts[1] == -2 && shorts[2] == 256);
+
+        // dtype 不匹配或不是 .npy 文件时抛出异常
+        bool threw = false;
+        try
+        {
+            nc::load<float>(npy);
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+
+        a.tofile(npy);
+        threw = false;
+        try
+        {
+            nc::load<double>(npy);
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+
+        // 元素个数超出 64 位下标的 shape 在分配之前就被拒绝
+        writeNpy(npy, "{'descr': '<f8', 'fortran_order': False, 'shape': (4294967296, 4294967296), }", bigEndian, 0);
+        threw = false;
+        try
+        {
+            nc::load<double>(npy);
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+        std::remove(npy.c_str());
+    }
+}
+
+int main()
+{
+    testBinary();
+    testNpyHeader();
+
+    std::printf("npy_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
@@ -0,0 +1,135 @@
+#include "test_utils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+
+// linalg::qr 与 linalg::cholesky：块边界两侧及多块并行时的残差、正交性、三角结构，float 输入与异常
+
+namespace
+{
+    const double TOLERANCE = 1e-9;
+
+    bool isUpper(const nc::NdArray<double>& inArray)
+    {
+        for (nc::uint64 i = 0; i < inArray.shape().rows; ++i)
+        {
+            for (nc::uint64 j = 0; j < i && j < inArray.shape().cols; ++j)
+            {
+                if (inArray(i, j) != 0.0)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void testQr(nc::uint64 inRows, nc::uint64 inCols, std::mt19937_64& ioGenerator)
+    {
+        const nc::uint64 k = std::min(inRows, inCols);
+        const nc::NdArray<double> a = test::randomArray(inRows, inCols, ioGenerator);
+        nc::NdArray<double> q = a;
+        nc::NdArray<double> r;
+        nc::linalg::qr(q, r);
+        CHECK(q.shape() == nc::Shape(inRows, k));
+        CHECK(r.shape() == nc::Shape(k, inCols));
+        CHECK(test::maxAbs(test::matmul(q, r) - a) < TOLERANCE);
+        CHECK(test::maxAbs(test::matmul(test::transpose(q), q) - test::identity(k)) < TOLERANCE);
+        CHECK(isUpper(r));
+    }
+
+    void testCholesky(nc::uint64 inOrder, std::mt19937_64& ioGenerator)
+    {
+        const nc::NdArray<double> spd = test::spdMatrix(inOrder, ioGenerator);
+        nc::NdArray<double> lower = spd;
+        nc::linalg::cholesky(lower);
+        CHECK(test::maxAbs(test::matmul(lower, test::transpose(lower)) - spd) < TOLERANCE * inOrder);
+        CHECK(isUpper(test::transpose(lower)));
+
+        // 只读取下三角，上三角的内容不影响结果
+        nc::NdArray<double> scribbled = spd;
+        for (nc::uint64 i = 0; i < inOrder; ++i)
+        {
+            for (nc::uint64 j = i + 1; j < inOrder; ++j)
+            {
+                scribbled(i, j) = -1e30;
+            }
+        }
+        nc::linalg::cholesky(scribbled);
+        CHECK(test::allClose(scribbled, lower));
+
+        nc::NdArray<double> indefinite = spd;
+        indefinite(inOrder - 1, inOrder - 1) = -1.0;
+        bool threw = false;
+        try
+        {
+            nc::linalg::cholesky(indefinite);
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+
+    void testFloatAndErrors(std::mt19937_64& ioGenerator)
+    {
+        const nc::NdArray<double> a = test::randomArray(90, 70, ioGenerator);
+        nc::NdArray<float> q = a.astype<float>();
+        nc::NdArray<float> r;
+        nc::linalg::qr(q, r);
+        CHECK(test::maxAbs(test::matmul(q.astype<double>(), r.astype<double>()) - a) < 1e-4);
+
+        const nc::NdArray<double> spd = test::spdMatrix(70, ioGenerator);
+        nc::NdArray<float> lower = spd.astype<float>();
+        nc::linalg::cholesky(lower);
+        const nc::NdArray<double> factor = lower.astype<double>();
+        CHECK(test::maxAbs(test::matmul(factor, test::transpose(factor)) - spd) < 1e-3);
+
+        bool threw = false;
+        try
+        {
+            nc::NdArray<double> wide(nc::Shape(3, 4));
+            nc::linalg::cholesky(wide);
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+
+        threw = false;
+        try
+        {
+            nc::NdArray<double> cube(nc::Shape({ 2, 3, 4 }));
+            nc::NdArray<double> cubeR;
+            nc::linalg::qr(cube, cubeR);
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 generator(24);
+    for (nc::uint64 order : { 63, 64, 65 })
+    {
+        testQr(order + 7, order, generator);
+        testQr(order, order + 7, generator);
+        testCholesky(order, generator);
+    }
+
+    // 多个 64 列的块，面板更新分到多个线程
+    testQr(400, 260, generator);
+    testCholesky(300, generator);
+    testFloatAndErrors(generator);
+
+    std::printf("qr_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
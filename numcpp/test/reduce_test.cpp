@@ -0,0 +1,154 @@
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+
+// 沿轴归约与逐元素循环的对比：Axis::ROW 按内存顺序扫描各行、逐列累积，数组与转置视图结果相同；
+// 补偿求和的列中出现 inf 或溢出时结果保持为 inf
+
+namespace
+{
+    // Axis::ROW 的参考实现：逐列遍历各行
+    template<typename Reducer>
+    nc::NdArray<double> columnReference(const nc::NdArray<double>& inArray, Reducer inReducer)
+    {
+        const nc::Shape shape = inArray.shape();
+        nc::NdArray<double> returnArray(1, shape.cols);
+        for (nc::uint64 col = 0; col < shape.cols; ++col)
+        {
+            double result = inArray(0, col);
+            nc::uint64 best = 0;
+            for (nc::uint64 row = 1; row < shape.rows; ++row)
+            {
+                inReducer(result, best, inArray(row, col), row);
+            }
+            returnArray[col] = inReducer.finish(result, best);
+        }
+        return returnArray;
+    }
+
+    struct MaxValue
+    {
+        void operator()(double& ioResult, nc::uint64&, double inValue, nc::uint64) const { ioResult = inValue > ioResult ? inValue : ioResult; }
+        double finish(double inResult, nc::uint64) const { return inResult; }
+    };
+
+    struct MinIndex
+    {
+        void operator()(double& ioResult, nc::uint64& ioBest, double inValue, nc::uint64 inRow) const
+        {
+            if (inValue < ioResult)
+            {
+                ioResult = inValue;
+                ioBest = inRow;
+            }
+        }
+        double finish(double, nc::uint64 inBest) const { return static_cast<double>(inBest); }
+    };
+
+    struct MaxIndex
+    {
+        void operator()(double& ioResult, nc::uint64& ioBest, double inValue, nc::uint64 inRow) const
+        {
+            if (inValue > ioResult)
+            {
+                ioResult = inValue;
+                ioBest = inRow;
+            }
+        }
+        double finish(double, nc::uint64 inBest) const { return static_cast<double>(inBest); }
+    };
+
+    struct Sum
+    {
+        void operator()(double& ioResult, nc::uint64&, double inValue, nc::uint64) const { ioResult += inValue; }
+        double finish(double inResult, nc::uint64) const { return inResult; }
+    };
+
+    void testColumnReductions()
+    {
+        std::mt19937_64 generator(7);
+        for (nc::uint64 rows : { 1, 5, 37 })
+        {
+            for (nc::uint64 cols : { 1, 3, 8, 301 })
+            {
+                nc::NdArray<double> a = test::randomArray(rows, cols, generator);
+                // 取整制造相等的元素，检查 argmax/argmin 取第一个
+                for (double& value : a)
+                {
+                    value = std::round(value * 3.0);
+                }
+                CHECK(test::allClose(a.max(nc::Axis::ROW), columnReference(a, MaxValue())));
+                CHECK(test::allClose(a.argmax(nc::Axis::ROW).astype<double>(), columnReference(a, MaxIndex())));
+                CHECK(test::allClose(a.argmin(nc::Axis::ROW).astype<double>(), columnReference(a, MinIndex())));
+                CHECK(test::allClose(a.sum(nc::Axis::ROW), columnReference(a, Sum()), 1e-12));
+                CHECK(test::allClose(a.mean(nc::Axis::ROW), nc::NdArray<double>(columnReference(a, Sum()) / static_cast<double>(rows)), 1e-12));
+
+                nc::NdArray<bool> positive = a > 0.0;
+                nc::NdArray<bool> allPositive(1, cols);
+                nc::NdArray<bool> anyPositive(1, cols);
+                for (nc::uint64 col = 0; col < cols; ++col)
+                {
+                    allPositive[col] = true;
+                    anyPositive[col] = false;
+                    for (nc::uint64 row = 0; row < rows; ++row)
+                    {
+                        allPositive[col] = allPositive[col] && positive(row, col);
+                        anyPositive[col] = anyPositive[col] || positive(row, col);
+                    }
+                }
+                CHECK(test::allClose(positive.all(nc::Axis::ROW), allPositive));
+                CHECK(test::allClose(positive.any(nc::Axis::ROW), anyPositive));
+
+                // 转置视图沿 COL 归约与原数组沿 ROW 归约相同
+                auto transposed = a.transpose();
+                CHECK(test::allClose(transposed.max(nc::Axis::COL), a.max(nc::Axis::ROW)));
+                CHECK(test::allClose(transposed.argmin(nc::Axis::COL), a.argmin(nc::Axis::ROW)));
+            }
+        }
+    }
+    void testNonFiniteColumns()
+    {
+        // 补偿求和遇到 inf 或溢出时结果为 inf，不能变成 NaN，也不影响其他列
+        const double inf = std::numeric_limits<double>::infinity();
+        const double big = std::numeric_limits<double>::max();
+        const nc::NdArray<double> a = { { inf, 1.0, big, -inf }, { 1.0, 2.0, big, 1.0 }, { 4.0, 3.0, 1.0, 2.0 } };
+
+        const nc::NdArray<double> sums = a.sum(nc::Axis::ROW);
+        CHECK(sums[0] == inf);
+        CHECK(sums[1] == 6.0);
+        CHECK(sums[2] == inf);
+        CHECK(sums[3] == -inf);
+        CHECK(test::allClose(a.sum(0), sums));
+
+        const nc::NdArray<double> means = a.mean(nc::Axis::ROW);
+        CHECK(means[0] == inf);
+        CHECK(means[1] == 2.0);
+        CHECK(means[3] == -inf);
+
+        // inf 与 -inf 相加才是 NaN
+        const nc::NdArray<double> mixed = { { inf, 1.0 }, { -inf, 2.0 } };
+        const nc::NdArray<double> mixedSums = mixed.sum(nc::Axis::ROW);
+        CHECK(std::isnan(mixedSums[0]));
+        CHECK(mixedSums[1] == 3.0);
+
+        // 三维数组沿中间一维归约走同一条补偿累加路径
+        nc::NdArray<double> cube = nc::zeros<double>(nc::Shape({ 2, 3, 2 }));
+        cube({ 0, 1, 0 }) = inf;
+        cube({ 1, 2, 1 }) = 5.0;
+        const nc::NdArray<double> cubeSums = cube.sum(1);
+        CHECK(cubeSums[0] == inf);
+        CHECK(cubeSums[3] == 5.0);
+    }
+}
+
+int main()
+{
+    testColumnReductions();
+    testNonFiniteColumns();
+
+    std::printf("reduce_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
@@ -0,0 +1,242 @@
+#include "test_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// 多维形状：整数轴归约与逐元素循环对比，负轴、非法轴、跨步视图，以及超过 32 位的大小与溢出检查
+
+namespace
+{
+    // 按行主序把多维下标展开成扁平偏移
+    nc::uint64 flatIndex(const std::vector<nc::uint64>& inDims, const std::vector<nc::uint64>& inIndex)
+    {
+        nc::uint64 offset = 0;
+        for (std::size_t axis = 0; axis < inDims.size(); ++axis)
+        {
+            offset = offset * inDims[axis] + inIndex[axis];
+        }
+        return offset;
+    }
+
+    // 逐元素循环计算沿 inAxis 的和、最大值与其下标，作为归约的参照
+    void loopReduce(const nc::NdArray<double>& inArray, nc::uint32 inAxis, std::vector<double>& outSum, std::vector<double>& outMax,
+        std::vector<nc::uint64>& outArgmax)
+    {
+        const std::vector<nc::uint64> dims = inArray.shape().dims();
+        std::vector<nc::uint64> reducedDims = dims;
+        reducedDims.erase(reducedDims.begin() + inAxis);
+
+        const nc::uint64 outSize = inArray.size() / dims[inAxis];
+        outSum.assign(outSize, 0.0);
+        outMax.assign(outSize, -1.0e300);
+        outArgmax.assign(outSize, 0);
+
+        std::vector<nc::uint64> index(dims.size(), 0);
+        for (nc::uint64 i = 0; i < inArray.size(); ++i)
+        {
+            std::vector<nc::uint64> reducedIndex = index;
+            reducedIndex.erase(reducedIndex.begin() + inAxis);
+            const nc::uint64 out = flatIndex(reducedDims, reducedIndex);
+            const double value = inArray[flatIndex(dims, index)];
+
+            outSum[out] += value;
+            if (value > outMax[out])
+            {
+                outMax[out] = value;
+                outArgmax[out] = index[inAxis];
+            }
+
+            for (nc::int64 axis = static_cast<nc::int64>(dims.size()) - 1; axis >= 0; --axis)
+            {
+                if (++index[axis] < dims[axis])
+                {
+                    break;
+                }
+                index[axis] = 0;
+            }
+        }
+    }
+
+    void checkReductions(const nc::NdArray<double>& inArray)
+    {
+        const nc::int32 ndim = static_cast<nc::int32>(inArray.shape().ndim());
+        for (nc::int32 axis = -ndim; axis < ndim; ++axis)
+        {
+            const nc::uint32 positive = static_cast<nc::uint32>(axis < 0 ? axis + ndim : axis);
+            std::vector<double> sum;
+            std::vector<double> max;
+            std::vector<nc::uint64> argmax;
+            loopReduce(inArray, positive, sum, max, argmax);
+
+            const nc::NdArray<double> sums = inArray.sum(axis);
+            const nc::NdArray<double> maxes = inArray.max(axis);
+            const nc::NdArray<nc::uint64> argmaxes = inArray.argmax(axis);
+            const nc::NdArray<double> means = inArray.mean(axis);
+
+            CHECK(sums.shape() == inArray.shape().removeAxis(positive));
+            CHECK(sums.size() == sum.size() && maxes.size() == max.size() && argmaxes.size() == argmax.size());
+
+            double sumError = 0.0;
+            double meanError = 0.0;
+            bool sameMax = true;
+            for (nc::uint64 i = 0; i < sum.size(); ++i)
+            {
+                sumError = std::max(sumError, std::abs(sums[i] - sum[i]));
+                meanError = std::max(meanError, std::abs(means[i] - sum[i] / static_cast<double>(inArray.shape()[positive])));
+                sameMax = sameMax && maxes[i] == max[i] && argmaxes[i] == argmax[i];
+            }
+            CHECK(sumError < 1e-9);
+            CHECK(meanError < 1e-9);
+            CHECK(sameMax);
+        }
+    }
+
+    void testIntegerAxes()
+    {
+        std::mt19937_64 generator(18);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+        nc::NdArray<double> cube(nc::Shape({ 3, 5, 7 }));
+        for (auto& value : cube)
+        {
+            value = distribution(generator);
+        }
+        checkReductions(cube);
+
+        nc::NdArray<double> tensor(nc::Shape({ 2, 3, 4, 5 }));
+        for (auto& value : tensor)
+        {
+            value = distribution(generator);
+        }
+        checkReductions(tensor);
+
+        // 多维下标与负下标
+        CHECK(tensor({ 1, 2, 3, 4 }) == tensor[tensor.size() - 1]);
+        CHECK(tensor({ -1, -1, -1, -1 }) == tensor({ 1, 2, 3, 4 }));
+        CHECK(tensor({ 0, 1, 0, 2 }) == tensor[1 * 20 + 2]);
+
+        // 越界的轴抛出 invalid_argument
+        for (nc::int32 axis : { 4, -5 })
+        {
+            bool threw = false;
+            try
+            {
+                tensor.sum(axis);
+            }
+            catch (const std::invalid_argument&)
+            {
+                threw = true;
+            }
+            CHECK(threw);
+        }
+    }
+
+    void testStridedViews()
+    {
+        nc::NdArray<double> cube(nc::Shape({ 2, 3, 4 }));
+        for (nc::uint64 i = 0; i < cube.size(); ++i)
+        {
+            cube[i] = static_cast<double>(i);
+        }
+
+        // 轴置换后的视图按跨步读取原数据
+        const auto permuted = cube.transpose({ 2, 0, 1 });
+        CHECK(permuted.shape() == nc::Shape({ 4, 2, 3 }));
+        const nc::NdArray<double> contiguous = permuted.ascontiguous();
+        bool same = true;
+        for (nc::int64 i = 0; i < 4; ++i)
+        {
+            for (nc::int64 j = 0; j < 2; ++j)
+            {
+                for (nc::int64 k = 0; k < 3; ++k)
+                {
+                    same = same && contiguous({ i, j, k }) == cube({ j, k, i });
+                }
+            }
+        }
+        CHECK(same);
+
+        // 视图上的整数轴归约与连续副本一致
+        for (nc::int32 axis = 0; axis < 3; ++axis)
+        {
+            CHECK(test::allClose(permuted.max(axis), contiguous.max(axis)));
+            CHECK(test::allClose(permuted.argmax(axis), contiguous.argmax(axis)));
+        }
+
+        // 视图与原数组共享内存
+        cube.transpose({ 1, 2, 0 })[0] = -1.0;
+        CHECK(cube[0] == -1.0);
+    }
+
+    void testSizes()
+    {
+        // 只构造形状不分配内存，元素个数超过 2^32 时不再截断
+        const nc::uint64 big = nc::uint64(1) << 20;
+        CHECK(nc::Shape({ 6, big, big / 4 }).size() == 6 * big * (big / 4));
+        CHECK(nc::Shape(big * 8, big).size() == (big * 8) * big);
+        CHECK(nc::Shape({ 3, big, big }).stride(0) == big * big);
+
+        // 乘积超出 64 位或 int64 下标范围时抛出 invalid_argument
+        const nc::uint64 huge = nc::uint64(1) << 32;
+        for (int i = 0; i < 3; ++i)
+        {
+            bool threw = false;
+            try
+            {
+                if (i == 0)
+                {
+                    nc::Shape(huge, huge);
+                }
+                else if (i == 1)
+                {
+                    nc::Shape({ 2, huge, huge / 2 });
+                }
+                else
+                {
+                    nc::Shape({ 3, 5, huge, huge });
+                }
+            }
+            catch (const std::invalid_argument&)
+            {
+                threw = true;
+            }
+            CHECK(threw);
+        }
+
+        // 切片字段为 64 位，2^31 以上的负下标能正确回绕
+        nc::Slice slice(-static_cast<nc::int64>(big * 4), -1);
+        slice.makePositiveAndValidate(big * big);
+        CHECK(slice.start == static_cast<nc::int64>(big * big - big * 4));
+        CHECK(slice.stop == static_cast<nc::int64>(big * big - 1));
+        CHECK(slice.numElements(big * big) == big * 4 - 1);
+
+        // reshape 的元素个数不一致时抛出 runtime_error
+        nc::NdArray<double> array(nc::Shape({ 2, 3, 4 }));
+        array.reshape(nc::Shape({ 4, 6 }));
+        CHECK(array.shape() == nc::Shape(4, 6));
+        bool threw = false;
+        try
+        {
+            array.reshape(nc::Shape({ 5, 5 }));
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+}
+
+int main()
+{
+    testIntegerAxes();
+    testStridedViews();
+    testSizes();
+
+    std::printf("shape_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
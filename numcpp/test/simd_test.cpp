@@ -0,0 +1,149 @@
+#include "test_utils.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+// SIMD 内核与运算标签的标量实现逐位对比：覆盖各数据类型、标量操作数、未对齐的起点和尾部元素。
+// ctest 中另以 NUMCPP_SIMD=scalar 运行一次，检查强制标量分派时结果相同
+
+namespace
+{
+    template<typename dtype>
+    std::vector<dtype> randomValues(nc::uint64 inSize, std::mt19937_64& ioGenerator)
+    {
+        std::uniform_int_distribution<int> dist(-50, 50);
+        std::vector<dtype> values(inSize);
+        for (auto& value : values)
+        {
+            const int draw = dist(ioGenerator);
+            // 整数除法的除数不能为零
+            value = static_cast<dtype>(draw == 0 ? 7 : draw) / static_cast<dtype>(std::is_integral<dtype>::value ? 1 : 4);
+        }
+        if (std::numeric_limits<dtype>::has_quiet_NaN && inSize > 5)
+        {
+            values[5] = std::numeric_limits<dtype>::quiet_NaN();
+        }
+        return values;
+    }
+
+    template<typename dtype>
+    bool sameBits(const dtype* inA, const dtype* inB, nc::uint64 inSize)
+    {
+        return std::memcmp(inA, inB, inSize * sizeof(dtype)) == 0;
+    }
+
+    template<typename Op, typename dtype>
+    void checkArithmetic(std::mt19937_64& ioGenerator)
+    {
+        for (nc::uint64 size : { 0, 1, 3, 7, 8, 15, 17, 33, 64, 71, 1000 })
+        {
+            for (nc::uint64 offset = 0; offset < 3; ++offset)
+            {
+                const std::vector<dtype> a = randomValues<dtype>(size + offset, ioGenerator);
+                const std::vector<dtype> b = randomValues<dtype>(size + offset, ioGenerator);
+                const dtype* pa = a.data() + offset;
+                const dtype* pb = b.data() + offset;
+                std::vector<dtype> expected(size + 1);
+                std::vector<dtype> actual(size + 1);
+
+                for (nc::uint64 i = 0; i < size; ++i)
+                {
+                    expected[i] = Op::scalar(pa[i], pb[i]);
+                }
+                nc::simd::arithmetic<Op, false, false>(pa, pb, actual.data(), size);
+                CHECK(sameBits(expected.data(), actual.data(), size));
+
+                for (nc::uint64 i = 0; i < size; ++i)
+                {
+                    expected[i] = Op::scalar(pa[i], pb[0]);
+                }
+                nc::simd::arithmetic<Op, false, true>(pa, pb, actual.data(), size);
+                CHECK(sameBits(expected.data(), actual.data(), size));
+
+                for (nc::uint64 i = 0; i < size; ++i)
+                {
+                    expected[i] = Op::scalar(pa[0], pb[i]);
+                }
+                nc::simd::arithmetic<Op, true, false>(pa, pb, actual.data(), size);
+                CHECK(sameBits(expected.data(), actual.data(), size));
+            }
+        }
+    }
+
+    template<typename Op, typename dtype>
+    void checkCompare(std::mt19937_64& ioGenerator)
+    {
+        for (nc::uint64 size : { 1, 5, 16, 37, 1000 })
+        {
+            const std::vector<dtype> a = randomValues<dtype>(size, ioGenerator);
+            std::vector<dtype> b = randomValues<dtype>(size, ioGenerator);
+            b[size / 2] = a[size / 2];
+            std::vector<char> expected(size);
+            bool actual[1000];
+            for (nc::uint64 i = 0; i < size; ++i)
+            {
+                expected[i] = Op::scalar(a[i], b[i]);
+            }
+            nc::simd::compare<Op, false, false>(a.data(), b.data(), actual, size);
+            bool same = true;
+            for (nc::uint64 i = 0; i < size; ++i)
+            {
+                same = same && actual[i] == (expected[i] != 0);
+            }
+            CHECK(same);
+        }
+    }
+
+    template<typename dtype>
+    void checkType(std::mt19937_64& ioGenerator)
+    {
+        checkArithmetic<nc::simd::Add, dtype>(ioGenerator);
+        checkArithmetic<nc::simd::Subtract, dtype>(ioGenerator);
+        checkArithmetic<nc::simd::Multiply, dtype>(ioGenerator);
+        checkArithmetic<nc::simd::Divide, dtype>(ioGenerator);
+        checkArithmetic<nc::simd::Maximum, dtype>(ioGenerator);
+        checkArithmetic<nc::simd::Minimum, dtype>(ioGenerator);
+        checkCompare<nc::simd::Equal, dtype>(ioGenerator);
+        checkCompare<nc::simd::NotEqual, dtype>(ioGenerator);
+        checkCompare<nc::simd::Less, dtype>(ioGenerator);
+        checkCompare<nc::simd::LessEqual, dtype>(ioGenerator);
+        checkCompare<nc::simd::Greater, dtype>(ioGenerator);
+        checkCompare<nc::simd::GreaterEqual, dtype>(ioGenerator);
+    }
+
+    void testFill()
+    {
+        // 超过 STREAM_MIN_BYTES 时走非临时存储，起点故意不按 64 字节对齐
+        std::vector<double> buffer(nc::simd::STREAM_MIN_BYTES / sizeof(double) + 100, 0.0);
+        nc::simd::fill(buffer.data() + 3, 2.5, buffer.size() - 5);
+        bool filled = buffer[0] == 0.0 && buffer[1] == 0.0 && buffer[2] == 0.0 && buffer[buffer.size() - 2] == 0.0;
+        for (nc::uint64 i = 3; i + 2 < buffer.size(); ++i)
+        {
+            filled = filled && buffer[i] == 2.5;
+        }
+        CHECK(filled);
+    }
+}
+
+int main()
+{
+    const char* requested = std::getenv("NUMCPP_SIMD");
+    if (requested != nullptr && std::strcmp(requested, "scalar") == 0)
+    {
+        CHECK(nc::simd::activeIsa() == nc::simd::Isa::SCALAR);
+    }
+
+    std::mt19937_64 generator(3);
+    checkType<float>(generator);
+    checkType<double>(generator);
+    checkType<nc::int32>(generator);
+    checkType<nc::int64>(generator);
+    testFill();
+
+    std::printf("simd_test (isa %d): %d failure(s)\n", static_cast<int>(nc::simd::activeIsa()), test::failures());
+    return test::failures();
+}
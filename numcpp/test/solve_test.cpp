@@ -0,0 +1,167 @@
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+
+// linalg::solve、linalg::lstsq 以及可复用的 LU/Cholesky 分解对象：残差、重复求解、分解结果与异常
+
+namespace
+{
+    const double TOLERANCE = 1e-9;
+
+    void testSolve(nc::uint64 inOrder, std::mt19937_64& ioGenerator)
+    {
+        const nc::NdArray<double> a = test::randomArray(inOrder, inOrder, ioGenerator);
+        const nc::NdArray<double> b = test::randomArray(inOrder, 3, ioGenerator);
+        const nc::NdArray<double> x = nc::linalg::solve(a, b);
+        CHECK(x.shape() == b.shape());
+        CHECK(test::maxAbs(test::matmul(a, x) - b) < TOLERANCE);
+
+        const nc::NdArray<double> vector = test::randomArray(1, inOrder, ioGenerator);
+        const nc::NdArray<double> y = nc::linalg::solve(a, vector);
+        CHECK(y.shape() == vector.shape());
+        CHECK(test::maxAbs(test::matmul(a, test::transpose(y)) - test::transpose(vector)) < TOLERANCE);
+    }
+
+    void testFactorizations(nc::uint64 inOrder, std::mt19937_64& ioGenerator)
+    {
+        // 一次分解多次求解，结果与 linalg::solve 一致
+        const nc::NdArray<double> a = test::randomArray(inOrder, inOrder, ioGenerator);
+        const nc::linalg::LUFactorization<double> lu(a);
+        CHECK(lu.order() == inOrder);
+        CHECK(!lu.singular());
+        for (int i = 0; i < 3; ++i)
+        {
+            const nc::NdArray<double> b = test::randomArray(inOrder, 2, ioGenerator);
+            CHECK(test::allClose(lu.solve(b), nc::linalg::solve(a, b), TOLERANCE));
+        }
+        CHECK(std::abs(lu.det() - nc::linalg::det(a)) <= TOLERANCE * std::abs(lu.det()));
+
+        // 依次执行 pivots 中的行交换后 P * A = L * U
+        nc::NdArray<double> permuted = a;
+        for (nc::uint64 i = 0; i < inOrder; ++i)
+        {
+            for (nc::uint64 j = 0; j < inOrder; ++j)
+            {
+                std::swap(permuted(i, j), permuted(lu.pivots()[i], j));
+            }
+        }
+        nc::NdArray<double> lower = test::identity(inOrder);
+        nc::NdArray<double> upper = nc::zeros<double>(inOrder, inOrder);
+        for (nc::uint64 i = 0; i < inOrder; ++i)
+        {
+            for (nc::uint64 j = 0; j < inOrder; ++j)
+            {
+                (j < i ? lower(i, j) : upper(i, j)) = lu.lu()(i, j);
+            }
+        }
+        CHECK(test::maxAbs(test::matmul(lower, upper) - permuted) < TOLERANCE);
+
+        // 对称正定矩阵用 Cholesky 分解求解，与 LU 的结果一致
+        const nc::NdArray<double> spd = test::spdMatrix(inOrder, ioGenerator);
+        const nc::linalg::CholeskyFactorization<double> cholesky(spd);
+        const nc::NdArray<double> rhs = test::randomArray(inOrder, 4, ioGenerator);
+        CHECK(test::maxAbs(test::matmul(spd, cholesky.solve(rhs)) - rhs) < TOLERANCE);
+        CHECK(test::allClose(cholesky.solve(rhs), nc::linalg::LUFactorization<double>(spd).solve(rhs), TOLERANCE));
+        const nc::NdArray<double> factor = cholesky.lower();
+        CHECK(test::maxAbs(test::matmul(factor, test::transpose(factor)) - spd) < TOLERANCE * inOrder);
+    }
+
+    void testLeastSquares(nc::uint64 inOrder, std::mt19937_64& ioGenerator)
+    {
+        // 超定方程组的残差与 A 的列空间正交
+        const nc::NdArray<double> a = test::randomArray(2 * inOrder, inOrder, ioGenerator);
+        const nc::NdArray<double> b = test::randomArray(2 * inOrder, 2, ioGenerator);
+        const nc::NdArray<double> x = nc::linalg::lstsq(a, b);
+        CHECK(x.shape() == nc::Shape(inOrder, 2));
+        CHECK(test::maxAbs(test::matmul(test::transpose(a), test::matmul(a, x) - b)) < TOLERANCE);
+
+        // 欠定方程组取最小范数解：精确满足方程且位于 A 的行空间
+        const nc::NdArray<double> wide = test::transpose(a);
+        const nc::NdArray<double> c = test::randomArray(inOrder, 1, ioGenerator);
+        const nc::NdArray<double> z = nc::linalg::lstsq(wide, c);
+        CHECK(test::maxAbs(test::matmul(wide, z) - c) < TOLERANCE);
+        const nc::NdArray<double> coefficients = nc::linalg::lstsq(a, z);
+        CHECK(test::maxAbs(test::matmul(a, coefficients) - z) < TOLERANCE);
+
+        // 方阵满秩时与 solve 相同
+        const nc::NdArray<double> square = test::randomArray(inOrder, inOrder, ioGenerator);
+        const nc::NdArray<double> d = test::randomArray(inOrder, 1, ioGenerator);
+        CHECK(test::allClose(nc::linalg::lstsq(square, d), nc::linalg::solve(square, d), 1e-8));
+    }
+
+    void testErrors()
+    {
+        // 奇异矩阵可以分解，但求解时抛出异常
+        const nc::NdArray<double> singular = { { 1.0, 2.0, 3.0 }, { 2.0, 4.0, 6.0 }, { 1.0, 0.0, 1.0 } };
+        const nc::linalg::LUFactorization<double> lu(singular);
+        CHECK(lu.singular());
+        CHECK(lu.det() == 0.0);
+
+        bool threw = false;
+        try
+        {
+            nc::linalg::solve(singular, nc::ones<double>(3, 1));
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+
+        // 右端项行数不匹配
+        threw = false;
+        try
+        {
+            nc::linalg::solve(test::identity(3), nc::ones<double>(4, 1));
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+
+        // 不正定矩阵的 Cholesky 分解
+        threw = false;
+        try
+        {
+            nc::linalg::CholeskyFactorization<double> cholesky(nc::NdArray<double>({ { 1.0, 2.0 }, { 2.0, 1.0 } }));
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+
+        // 列秩亏损的最小二乘
+        nc::NdArray<double> deficient = nc::ones<double>(5, 3);
+        deficient(0, 0) = 2.0;
+        threw = false;
+        try
+        {
+            nc::linalg::lstsq(deficient, nc::ones<double>(5, 1));
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 generator(23);
+    for (nc::uint64 order : { 63, 64, 65 })
+    {
+        testSolve(order, generator);
+        testFactorizations(order, generator);
+        testLeastSquares(order, generator);
+    }
+    testErrors();
+
+    std::printf("solve_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
@@ -0,0 +1,177 @@
+#include "test_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+
+// linalg::eigh/eigvalsh、linalg::svd 与 randomizedSvd：块边界两侧的残差与正交性、已知谱、秩亏损、可复现性与异常
+
+namespace
+{
+    const double TOLERANCE = 1e-9;
+
+    void testSpectral(nc::uint64 inOrder, std::mt19937_64& ioGenerator)
+    {
+        const nc::NdArray<double> b = test::randomArray(inOrder, inOrder, ioGenerator);
+        const nc::NdArray<double> symmetric = b + test::transpose(b);
+        nc::NdArray<double> w;
+        nc::NdArray<double> v;
+        nc::linalg::eigh(symmetric, w, v);
+        nc::NdArray<double> scaled = v;
+        bool ascending = true;
+        for (nc::uint64 i = 0; i < inOrder; ++i)
+        {
+            for (nc::uint64 j = 0; j < inOrder; ++j)
+            {
+                scaled(i, j) *= w[j];
+            }
+            ascending = ascending && (i == 0 || w[i - 1] <= w[i]);
+        }
+        CHECK(ascending);
+        CHECK(test::maxAbs(test::matmul(symmetric, v) - scaled) < TOLERANCE);
+        CHECK(test::maxAbs(test::matmul(test::transpose(v), v) - test::identity(inOrder)) < TOLERANCE);
+        CHECK(test::allClose(nc::linalg::eigvalsh(symmetric), w, TOLERANCE));
+
+        for (const nc::Shape& shape : { nc::Shape(inOrder + 10, inOrder), nc::Shape(inOrder, inOrder + 10) })
+        {
+            const nc::NdArray<double> a = test::randomArray(shape.rows, shape.cols, ioGenerator);
+            const nc::uint64 k = std::min(shape.rows, shape.cols);
+            nc::NdArray<double> u;
+            nc::NdArray<double> s;
+            nc::NdArray<double> vt;
+            nc::linalg::svd(a, u, s, vt);
+            CHECK(u.shape() == nc::Shape(shape.rows, k));
+            CHECK(vt.shape() == nc::Shape(k, shape.cols));
+            nc::NdArray<double> us = u;
+            bool descending = true;
+            for (nc::uint64 i = 0; i < us.shape().rows; ++i)
+            {
+                for (nc::uint64 j = 0; j < k; ++j)
+                {
+                    us(i, j) *= s[j];
+                }
+            }
+            for (nc::uint64 j = 1; j < k; ++j)
+            {
+                descending = descending && s[j - 1] >= s[j];
+            }
+            CHECK(descending);
+            CHECK(test::maxAbs(test::matmul(us, vt) - a) < TOLERANCE);
+            CHECK(test::maxAbs(test::matmul(test::transpose(u), u) - test::identity(k)) < TOLERANCE);
+            CHECK(test::maxAbs(test::matmul(vt, test::transpose(vt)) - test::identity(k)) < TOLERANCE);
+        }
+    }
+
+    void testRandomizedSvd(std::mt19937_64& ioGenerator)
+    {
+        // 秩为 5 的高矩阵，前 5 个分量与完整 SVD 一致
+        const nc::NdArray<double> a = test::matmul(test::randomArray(400, 5, ioGenerator), test::randomArray(5, 65, ioGenerator));
+        nc::NdArray<double> u;
+        nc::NdArray<double> s;
+        nc::NdArray<double> vt;
+        nc::linalg::svd(a, u, s, vt);
+        nc::NdArray<double> uk;
+        nc::NdArray<double> sk;
+        nc::NdArray<double> vtk;
+        nc::linalg::randomizedSvd(a, 5, uk, sk, vtk);
+        CHECK(sk.size() == 5);
+        for (nc::uint64 i = 0; i < 5; ++i)
+        {
+            CHECK(std::abs(sk[i] - s[i]) < TOLERANCE * s[0]);
+        }
+        CHECK(uk.shape() == nc::Shape(400, 5));
+        CHECK(vtk.shape() == nc::Shape(5, 65));
+        CHECK(test::maxAbs(test::matmul(test::transpose(uk), uk) - test::identity(5)) < TOLERANCE);
+
+        // 秩不超过 k 时截断分解即可精确重建
+        nc::NdArray<double> us = uk;
+        for (nc::uint64 i = 0; i < us.shape().rows; ++i)
+        {
+            for (nc::uint64 j = 0; j < 5; ++j)
+            {
+                us(i, j) *= sk[j];
+            }
+        }
+        CHECK(test::maxAbs(test::matmul(us, vtk) - a) < TOLERANCE * s[0]);
+
+        // 相同的种子得到相同的结果
+        nc::NdArray<double> again;
+        nc::NdArray<double> againS;
+        nc::NdArray<double> againVt;
+        nc::linalg::randomizedSvd(a, 5, again, againS, againVt);
+        CHECK(test::allClose(again, uk) && test::allClose(againS, sk) && test::allClose(againVt, vtk));
+
+        for (nc::uint64 components : { 0, 66 })
+        {
+            bool threw = false;
+            try
+            {
+                nc::linalg::randomizedSvd(a, components, again, againS, againVt);
+            }
+            catch (const std::invalid_argument&)
+            {
+                threw = true;
+            }
+            CHECK(threw);
+        }
+    }
+
+    void testKnownSpectra(nc::uint64 inOrder)
+    {
+        // 一维离散拉普拉斯矩阵 tridiag(-1, 2, -1) 的特征值为 2 - 2cos(k * pi / (n + 1))
+        const double pi = std::acos(-1.0);
+        nc::NdArray<double> laplacian = nc::zeros<double>(inOrder, inOrder);
+        for (nc::uint64 i = 0; i < inOrder; ++i)
+        {
+            laplacian(i, i) = 2.0;
+            if (i > 0)
+            {
+                laplacian(i, i - 1) = -1.0;
+                // 只读取下三角，上三角写入无关的值
+                laplacian(i - 1, i) = 1e30;
+            }
+        }
+        const nc::NdArray<double> w = nc::linalg::eigvalsh(laplacian);
+        double error = 0.0;
+        for (nc::uint64 k = 0; k < inOrder; ++k)
+        {
+            const double expected = 2.0 - 2.0 * std::cos(static_cast<double>(k + 1) * pi / static_cast<double>(inOrder + 1));
+            error = std::max(error, std::abs(w[k] - expected));
+        }
+        CHECK(error < TOLERANCE);
+
+        // 重特征值时特征向量仍然正交
+        nc::NdArray<double> repeated = test::identity(inOrder) * 3.0;
+        repeated(0, 0) = 5.0;
+        nc::NdArray<double> values;
+        nc::NdArray<double> vectors;
+        nc::linalg::eigh(repeated, values, vectors);
+        CHECK(std::abs(values[inOrder - 1] - 5.0) < TOLERANCE && std::abs(values[0] - 3.0) < TOLERANCE);
+        CHECK(test::maxAbs(test::matmul(test::transpose(vectors), vectors) - test::identity(inOrder)) < TOLERANCE);
+
+        // 秩亏损矩阵尾部的奇异值为零
+        std::mt19937_64 generator(inOrder);
+        const nc::NdArray<double> lowRank = test::matmul(test::randomArray(inOrder, 3, generator), test::randomArray(3, inOrder, generator));
+        nc::NdArray<double> u;
+        nc::NdArray<double> s;
+        nc::NdArray<double> vt;
+        nc::linalg::svd(lowRank, u, s, vt);
+        CHECK(s[3] < TOLERANCE * s[0]);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 generator(25);
+    for (nc::uint64 order : { 63, 64, 65 })
+    {
+        testSpectral(order, generator);
+        testKnownSpectra(order);
+    }
+    testRandomizedSvd(generator);
+
+    std::printf("spectral_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
@@ -0,0 +1,91 @@
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+
+// 流式归约与整个数组读入内存后的归约对比：块大小不整除行数、大端原始文件、.npy 文件，
+// 以及块间补偿合并遇到 inf 的列
+
+namespace
+{
+    void checkMatches(const nc::StreamedArray<double>& inStreamed, const nc::NdArray<double>& inArray)
+    {
+        for (nc::Axis axis : { nc::Axis::NONE, nc::Axis::ROW, nc::Axis::COL })
+        {
+            CHECK(test::allClose(inStreamed.max(axis), inArray.max(axis)));
+            CHECK(test::allClose(inStreamed.min(axis), inArray.min(axis)));
+            CHECK(test::allClose(inStreamed.argmax(axis), inArray.argmax(axis)));
+            CHECK(test::allClose(inStreamed.argmin(axis), inArray.argmin(axis)));
+            CHECK(test::allClose(inStreamed.sum(axis), inArray.sum(axis), 1e-9));
+            CHECK(test::allClose(inStreamed.mean(axis), inArray.mean(axis), 1e-12));
+            CHECK(test::allClose(inStreamed.all(axis), inArray.all(axis)));
+            CHECK(test::allClose(inStreamed.any(axis), inArray.any(axis)));
+        }
+    }
+
+    void testReductions()
+    {
+        std::mt19937_64 generator(5);
+        nc::NdArray<double> a = test::randomArray(1003, 7, generator);
+        // 零元素让 all/any 在各轴上都有 true 和 false
+        for (nc::uint64 row = 0; row < 1003; row += 2)
+        {
+            a(row, 1) = 0.0;
+        }
+        for (nc::uint64 col = 0; col < 7; ++col)
+        {
+            a(500, col) = 0.0;
+        }
+        a(nc::Slice(0, 1003), 4) = 0.0;
+        const nc::uint64 blockBytes = 13 * 7 * sizeof(double);
+
+        const std::string raw = "streamed_test.bin";
+        a.tofile(raw);
+        const nc::StreamedArray<double> streamedRaw(raw, 1003, 7, 0, nc::Endian::NATIVE, blockBytes);
+        CHECK(streamedRaw.rowsPerBlock() == 13);
+        checkMatches(streamedRaw, a);
+
+        a.newbyteorder(nc::Endian::BIG).tofile(raw);
+        checkMatches(nc::StreamedArray<double>(raw, 1003, 7, 0, nc::Endian::BIG, blockBytes), a);
+        std::remove(raw.c_str());
+
+        const std::string npy = "streamed_test.npy";
+        nc::save(npy, a);
+        checkMatches(nc::StreamedArray<double>(npy, blockBytes), a);
+        std::remove(npy.c_str());
+    }
+
+    void testNonFiniteColumns()
+    {
+        // inf 落在不同的块中，块间的补偿合并不能把它变成 NaN
+        const double inf = std::numeric_limits<double>::infinity();
+        nc::NdArray<double> a = nc::ones<double>(40, 3);
+        a(5, 0) = inf;
+        a(33, 2) = -inf;
+        a(7, 1) = std::numeric_limits<double>::max();
+        a(21, 1) = std::numeric_limits<double>::max();
+
+        const std::string raw = "streamed_test_inf.bin";
+        a.tofile(raw);
+        const nc::StreamedArray<double> streamed(raw, 40, 3, 0, nc::Endian::NATIVE, 4 * 3 * sizeof(double));
+        const nc::NdArray<double> sums = streamed.sum(nc::Axis::ROW);
+        CHECK(sums[0] == inf);
+        CHECK(sums[1] == inf);
+        CHECK(sums[2] == -inf);
+        const nc::NdArray<double> means = streamed.mean(nc::Axis::ROW);
+        CHECK(means[0] == inf && means[2] == -inf);
+        std::remove(raw.c_str());
+    }
+}
+
+int main()
+{
+    testReductions();
+    testNonFiniteColumns();
+
+    std::printf("streamed_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "../src/NumCpp.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+// 测试程序共用的检查宏和辅助函数。CHECK 失败时打印位置并计数，不中止，
+// main 返回 failures() 作为进程退出码，由 ctest 判断是否通过
+
+namespace test
+{
+    inline int& failures()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    inline void check(bool inCondition, const char* inExpression, const char* inFile, int inLine)
+    {
+        if (!inCondition)
+        {
+            std::printf("%s:%d: CHECK(%s) failed\n", inFile, inLine, inExpression);
+            ++failures();
+        }
+    }
+
+    // 形状相同且所有元素之差不超过 inTolerance
+    template<typename dtype1, typename dtype2>
+    bool allClose(const nc::NdArray<dtype1>& inA, const nc::NdArray<dtype2>& inB, double inTolerance = 0.0)
+    {
+        if (inA.shape() != inB.shape())
+        {
+            return false;
+        }
+        for (nc::uint64 i = 0; i < inA.size(); ++i)
+        {
+            if (std::abs(static_cast<double>(inA[i]) - static_cast<double>(inB[i])) > inTolerance)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    inline double maxAbs(const nc::NdArray<double>& inArray)
+    {
+        double result = 0;
+        for (double value : inArray)
+        {
+            result = std::max(result, std::abs(value));
+        }
+        return result;
+    }
+
+    inline nc::NdArray<double> randomArray(nc::uint64 inRows, nc::uint64 inCols, std::mt19937_64& ioGenerator)
+    {
+        std::normal_distribution<double> dist;
+        nc::NdArray<double> returnArray(nc::Shape(inRows, inCols));
+        for (double& value : returnArray)
+        {
+            value = dist(ioGenerator);
+        }
+        return returnArray;
+    }
+
+    inline nc::NdArray<double> matmul(const nc::NdArray<double>& inA, const nc::NdArray<double>& inB)
+    {
+        return inA.dot<double>(inB);
+    }
+
+    inline nc::NdArray<double> transpose(const nc::NdArray<double>& inArray)
+    {
+        return inArray.transpose().copy();
+    }
+
+    inline nc::NdArray<double> identity(nc::uint64 inSize)
+    {
+        nc::NdArray<double> returnArray = nc::zeros<double>(inSize, inSize);
+        for (nc::uint64 i = 0; i < inSize; ++i)
+        {
+            returnArray(i, i) = 1;
+        }
+        return returnArray;
+    }
+
+    // 随机对称正定矩阵 B * B^T + n * I
+    inline nc::NdArray<double> spdMatrix(nc::uint64 inOrder, std::mt19937_64& ioGenerator)
+    {
+        const nc::NdArray<double> b = randomArray(inOrder, inOrder, ioGenerator);
+        nc::NdArray<double> returnArray = matmul(b, transpose(b));
+        for (nc::uint64 i = 0; i < inOrder; ++i)
+        {
+            returnArray(i, i) += static_cast<double>(inOrder);
+        }
+        return returnArray;
+    }
+}
+
+#define CHECK(condition) test::check((condition), #condition, __FILE__, __LINE__)
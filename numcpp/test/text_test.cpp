@@ -0,0 +1,155 @@
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// 数字与文本的转换及 loadtxt/savetxt：解析结果与 strtod 逐位相同，格式化结果能精确读回，
+// 注释、空行、CRLF 与跨越并行分块边界的文件
+
+namespace
+{
+    template<typename dtype>
+    bool sameBits(dtype inA, dtype inB)
+    {
+        return std::memcmp(&inA, &inB, sizeof(dtype)) == 0;
+    }
+
+    double parseDouble(const std::string& inText)
+    {
+        double value = 0.0;
+        const char* end = nc::text::parse(inText.data(), inText.data() + inText.size(), value);
+        CHECK(end == inText.data() + inText.size());
+        return value;
+    }
+
+    void testParseFormat()
+    {
+        // 舍入的边界情况
+        for (const char* literal : { "0.1", "1e23", "9007199254740993", "2.2250738585072011e-308", "4.9406564584124654e-324",
+                 "1.7976931348623157e308", "123456789012345678901234567890", "0.000001", "-0.0", "3.14159265358979323846",
+                 "7.038531e-26", "1.00000000000000011102230246251565404236316680908203125" })
+        {
+            CHECK(sameBits(parseDouble(literal), std::strtod(literal, nullptr)));
+        }
+        CHECK(std::isinf(parseDouble("inf")) && std::isnan(parseDouble("nan")));
+
+        // 最短表示读回后逐位相同
+        std::mt19937_64 generator(4);
+        char buffer[nc::text::MAX_CHARS];
+        bool roundTrips = true;
+        bool matchesStrtod = true;
+        for (int i = 0; i < 20000; ++i)
+        {
+            nc::uint64 bits = generator();
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            if (!std::isfinite(value))
+            {
+                continue;
+            }
+            const nc::uint32 length = nc::text::format(value, buffer);
+            const std::string formatted(buffer, length);
+            roundTrips = roundTrips && sameBits(parseDouble(formatted), value);
+
+            std::snprintf(buffer, sizeof(buffer), "%.17g", value * 1e-3);
+            matchesStrtod = matchesStrtod && sameBits(parseDouble(buffer), std::strtod(buffer, nullptr));
+        }
+        CHECK(roundTrips);
+        CHECK(matchesStrtod);
+
+        nc::uint32 length = nc::text::format(0.1, buffer);
+        CHECK(std::string(buffer, length) == "0.1");
+        length = nc::text::format(-42.0, buffer);
+        CHECK(std::string(buffer, length) == "-42");
+        length = nc::text::format(std::numeric_limits<nc::int64>::min(), buffer);
+        CHECK(std::string(buffer, length) == "-9223372036854775808");
+
+        float single = 0.0f;
+        const std::string third = "0.33333334";
+        nc::text::parse(third.data(), third.data() + third.size(), single);
+        CHECK(sameBits(single, 1.0f / 3.0f));
+    }
+
+    void testText()
+    {
+        std::mt19937_64 generator(2);
+        nc::NdArray<double> a = test::randomArray(25, 6, generator);
+        a(0, 0) = 1e-300;
+        a(0, 1) = -std::numeric_limits<double>::max();
+        a(0, 2) = 0.1;
+
+        const std::string filename = "text_test.txt";
+        nc::savetxt(filename, a, ',', "header line");
+        const nc::NdArray<double> loaded = nc::loadtxt<double>(filename, ',', 1);
+        CHECK(test::allClose(loaded, a));
+
+        nc::NdArray<nc::int64> ints(4, 3);
+        for (nc::uint64 i = 0; i < ints.size(); ++i)
+        {
+            ints[i] = static_cast<nc::int64>(i) * -123456789;
+        }
+        nc::savetxt(filename, ints);
+        CHECK(test::allClose(nc::loadtxt<nc::int64>(filename), ints));
+        std::remove(filename.c_str());
+    }
+
+    void testTextLayout()
+    {
+        const std::string filename = "text_test_layout.txt";
+        {
+            std::ofstream file(filename, std::ios::binary);
+            file << "x\ty\tz\r\n# comment\r\n\r\n1\t2.5\t-3 # trailing\r\n  4\t\t5\t6\r\n";
+        }
+        const nc::NdArray<double> loaded = nc::loadtxt<double>(filename, ' ', 1);
+        CHECK(loaded.shape() == nc::Shape(2, 3));
+        CHECK(loaded(0, 1) == 2.5 && loaded(0, 2) == -3.0 && loaded(1, 0) == 4.0 && loaded(1, 2) == 6.0);
+
+        // 列数不一致或无法解析时抛出异常
+        for (const char* content : { "1,2,3\n4,5\n", "1,2,3\n4,x,6\n" })
+        {
+            {
+                std::ofstream file(filename, std::ios::binary);
+                file << content;
+            }
+            bool threw = false;
+            try
+            {
+                nc::loadtxt<double>(filename, ',');
+            }
+            catch (const std::runtime_error&)
+            {
+                threw = true;
+            }
+            CHECK(threw);
+        }
+
+        // 超过 text::CHUNK_BYTES 的文件分块并行解析，行序不变
+        nc::NdArray<nc::int32> large(300000, 3);
+        for (nc::uint64 i = 0; i < large.size(); ++i)
+        {
+            large[i] = static_cast<nc::int32>(i * 7919 % 1000003) - 500000;
+        }
+        nc::savetxt(filename, large, ',');
+        const nc::NdArray<nc::int32> reloaded = nc::loadtxt<nc::int32>(filename, ',');
+        CHECK(reloaded.shape() == large.shape());
+        CHECK(test::allClose(reloaded, large));
+        std::remove(filename.c_str());
+    }
+}
+
+int main()
+{
+    testParseFormat();
+    testText();
+    testTextLayout();
+
+    std::printf("text_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
@@ -0,0 +1,95 @@
+#include "test_utils.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// 线程池和多线程 GEMM：结果与线程数无关，任务中的异常传回调用线程
+
+namespace
+{
+    bool bitIdentical(const nc::NdArray<double>& inA, const nc::NdArray<double>& inB)
+    {
+        return inA.shape() == inB.shape() && std::memcmp(inA.cbegin(), inB.cbegin(), inA.nbytes()) == 0;
+    }
+
+    void testDeterministicDot()
+    {
+        std::mt19937_64 generator(2);
+        const nc::NdArray<double> a = test::randomArray(301, 270, generator);
+        const nc::NdArray<double> b = test::randomArray(270, 333, generator);
+
+        nc::setNumThreads(1);
+        CHECK(nc::getNumThreads() == 1);
+        const nc::NdArray<double> serial = a.dot<double>(b);
+
+        for (nc::uint32 numThreads : { 2, 3, 4 })
+        {
+            nc::setNumThreads(numThreads);
+            CHECK(nc::getNumThreads() == numThreads);
+            CHECK(bitIdentical(a.dot<double>(b), serial));
+        }
+    }
+
+    void testParallelFor()
+    {
+        nc::setNumThreads(4);
+
+        // 每个任务恰好执行一次，线程下标小于线程数
+        std::vector<std::atomic<int> > counts(1000);
+        std::atomic<bool> badThread{ false };
+        nc::ThreadPool::instance().parallelFor(1000, [&](nc::uint32 inTask, nc::uint32 inThread)
+        {
+            counts[inTask]++;
+            badThread = badThread || inThread >= 4;
+        });
+        bool once = true;
+        for (const auto& count : counts)
+        {
+            once = once && count == 1;
+        }
+        CHECK(once);
+        CHECK(!badThread);
+
+        // 工作线程中的异常在 parallelFor 返回时重新抛出，线程池之后仍可使用
+        bool threw = false;
+        try
+        {
+            nc::ThreadPool::instance().parallelFor(64, [](nc::uint32 inTask, nc::uint32)
+            {
+                if (inTask == 37)
+                {
+                    throw std::runtime_error("task failed");
+                }
+            });
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+
+        // 嵌套调用在当前线程上串行执行
+        std::atomic<int> total{ 0 };
+        nc::ThreadPool::instance().parallelFor(8, [&total](nc::uint32, nc::uint32)
+        {
+            nc::ThreadPool::instance().parallelFor(8, [&total](nc::uint32, nc::uint32 inThread)
+            {
+                total += inThread == 0 ? 1 : 100;
+            });
+        });
+        CHECK(total == 64);
+    }
+}
+
+int main()
+{
+    testDeterministicDot();
+    testParallelFor();
+
+    std::printf("thread_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}
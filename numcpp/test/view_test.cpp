@@ -0,0 +1,154 @@
+#include "test_utils.hpp"
+
+#include <cstdio>
+#include <numeric>
+#include <stdexcept>
+
+// 切片视图的读写、迭代、传入 nc:: 函数，转置视图与 ascontiguous，以及视图与赋值目标重叠时的求值顺序
+
+namespace
+{
+    nc::NdArray<double> iota(const nc::Shape& inShape)
+    {
+        nc::NdArray<double> returnArray(inShape);
+        for (nc::uint64 i = 0; i < returnArray.size(); ++i)
+        {
+            returnArray[i] = static_cast<double>(i);
+        }
+        return returnArray;
+    }
+
+    void testSlicing()
+    {
+        nc::NdArray<double> a = iota(nc::Shape(6, 8));
+
+        // 视图引用父数组的存储，不复制
+        auto window = a(nc::Slice(1, 5), nc::Slice(2, 8, 2));
+        CHECK(window.shape() == nc::Shape(4, 3));
+        CHECK(&window(0, 0) == &a(1, 2));
+        CHECK(window.rowStride() == 8);
+        CHECK(window.colStride() == 2);
+        CHECK(window(0, 0) == a(1, 2));
+        CHECK(window(3, 2) == a(4, 6));
+        CHECK(window(-1, -1) == a(4, 6));
+
+        // 一维跨步切片，负下标从末尾倒数
+        auto strided = a[nc::Slice(1, -1, 5)];
+        CHECK(strided.size() == 10);
+        CHECK(strided[0] == 1.0);
+        CHECK(strided[-1] == 46.0);
+
+        // 写入视图修改父数组
+        window(1, 1) = -1.0;
+        CHECK(a(2, 4) == -1.0);
+        window = 7.0;
+        CHECK(a(4, 6) == 7.0);
+        CHECK(a(4, 7) == 39.0);
+        CHECK(a(0, 2) == 2.0);
+
+        // 迭代按行主序遍历视图元素
+        const nc::NdArray<double> b = iota(nc::Shape(4, 5));
+        auto column = b(nc::Slice(0, 4), 3);
+        CHECK(std::accumulate(column.cbegin(), column.cend(), 0.0) == 3.0 + 8.0 + 13.0 + 18.0);
+
+        // 视图可直接传入 nc:: 函数
+        auto inner = b(nc::Slice(1, 3), nc::Slice(1, 4));
+        CHECK(nc::amax(inner).item() == 13.0);
+        const nc::NdArray<double> innerCopy = nc::copy(inner);
+        CHECK(innerCopy.shape() == nc::Shape(2, 3));
+        CHECK(innerCopy(1, 0) == 11.0);
+        const nc::NdArray<double> rowMins = nc::amin(inner, nc::Axis::COL);
+        CHECK(rowMins.size() == 2 && rowMins[0] == 6.0 && rowMins[1] == 11.0);
+    }
+
+    void testTranspose()
+    {
+        // 转置只交换形状和跨步，与父数组共享存储
+        nc::NdArray<double> a = iota(nc::Shape(70, 90));
+        auto transposed = a.transpose();
+        CHECK(transposed.shape() == nc::Shape(90, 70));
+        CHECK(&transposed(5, 3) == &a(3, 5));
+        transposed(5, 3) = -1.0;
+        CHECK(a(3, 5) == -1.0);
+        CHECK(&transposed.transpose()(3, 5) == &a(3, 5));
+
+        // 分块复制跨越 TILE_SIZE 边界，与逐元素复制相同
+        const nc::NdArray<double> contiguous = transposed.ascontiguous();
+        CHECK(contiguous.shape() == nc::Shape(90, 70));
+        bool same = true;
+        for (nc::uint64 row = 0; row < 90; ++row)
+        {
+            for (nc::uint64 col = 0; col < 70; ++col)
+            {
+                same = same && contiguous(row, col) == a(col, row);
+            }
+        }
+        CHECK(same);
+
+        // 切片视图的转置
+        auto window = a(nc::Slice(10, 50, 3), nc::Slice(7, 80, 2)).transpose();
+        const nc::NdArray<double> windowCopy = window.ascontiguous();
+        CHECK(windowCopy.shape() == nc::Shape(37, 14));
+        CHECK(windowCopy(36, 13) == a(10 + 13 * 3, 7 + 36 * 2));
+        CHECK(window(4, 2) == a(16, 15));
+
+        // 三维按给定顺序重排
+        const nc::NdArray<double> cube = iota(nc::Shape({ 3, 4, 5 }));
+        auto permuted = cube.transpose({ 2, 0, 1 });
+        CHECK(permuted.shape() == nc::Shape({ 5, 3, 4 }));
+        CHECK(permuted({ 4, 2, 1 }) == cube({ 2, 1, 4 }));
+        const nc::NdArray<double> permutedCopy = permuted.ascontiguous();
+        CHECK(permutedCopy({ 3, 1, 2 }) == cube({ 1, 2, 3 }));
+
+        bool threw = false;
+        try
+        {
+            cube.transpose({ 0, 0, 1 });
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+
+    void testAliasing()
+    {
+        // 结果写回被引用的数组
+        nc::NdArray<double> a = iota(nc::Shape(40, 40));
+        const nc::NdArray<double> doubled = a * 2.0;
+        a = a + a;
+        CHECK(test::allClose(a, doubled));
+
+        // 被广播的操作数是目标数组的一行
+        nc::NdArray<double> b = iota(nc::Shape(40, 40));
+        const nc::NdArray<double> firstRow = b(0, nc::Slice(0, 40)).copy();
+        nc::NdArray<double> expected = b + firstRow;
+        b = b + b(0, nc::Slice(0, 40));
+        CHECK(test::allClose(b, expected));
+
+        // 目标数组的转置视图逐元素读取的位置与结果不同，必须先求值再写回
+        nc::NdArray<double> square = iota(nc::Shape(40, 40));
+        const nc::NdArray<double> transposed = square.transpose().copy();
+        square = square.transpose() + 0.0;
+        CHECK(test::allClose(square, transposed));
+        square = square.transpose() * square;
+        CHECK(test::allClose(square, nc::NdArray<double>(transposed * transposed.transpose())));
+
+        // 切片视图参与运算
+        const nc::NdArray<double> c = iota(nc::Shape(10, 10));
+        nc::NdArray<double> sliced = c(nc::Slice(0, 10, 2), nc::Slice(1, 10, 3)) * 3.0;
+        CHECK(sliced.shape() == nc::Shape(5, 3));
+        CHECK(sliced(2, 1) == c(4, 4) * 3.0);
+    }
+}
+
+int main()
+{
+    testSlicing();
+    testTranspose();
+    testAliasing();
+
+    std::printf("view_test: %d failure(s)\n", test::failures());
+    return test::failures();
+}